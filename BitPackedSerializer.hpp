@@ -0,0 +1,544 @@
+﻿# pragma once
+# include <Siv3D.hpp>
+
+namespace s3d
+{
+	/// @brief ネットワーク送信向けのビット単位で詰めて書き込むアーカイブ
+	/// @remark SIV3D_SERIALIZE を持つ型をそのままシリアライズできます。
+	/// @remark bool は 1 ビット、2 バイト以上の整数は可変長（符号付きはジグザグ符号化）、サイズタグは可変長で書き込まれます。
+	class BitPackedSerializer : public cereal::OutputArchive<BitPackedSerializer, cereal::AllowEmptyClassElision>
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		BitPackedSerializer();
+
+		/// @brief 値の下位 bitCount ビットを書き込みます。
+		/// @param value 書き込む値
+		/// @param bitCount 書き込むビット数（0 以上 64 以下）
+		void writeBits(uint64 value, uint32 bitCount);
+
+		/// @brief 符号なし整数を可変長（7 ビットごと）で書き込みます。
+		/// @param value 書き込む値
+		void writeVarint(uint64 value);
+
+		/// @brief 符号付き整数をジグザグ符号化して可変長で書き込みます。
+		/// @param value 書き込む値
+		void writeZigZag(int64 value);
+
+		/// @brief バイト列をそのまま書き込みます。
+		/// @param data 書き込むデータ
+		/// @param size 書き込むデータのサイズ（バイト）
+		void saveBinary(const void* data, size_t size);
+
+		/// @brief 書き込まれたデータの先頭ポインタを返します。
+		[[nodiscard]]
+		const Byte* data() const noexcept;
+
+		/// @brief 書き込まれたデータのサイズ（バイト）を返します。最後のバイトの余りビットは 0 で埋められます。
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		/// @brief 書き込まれたデータのサイズ（ビット）を返します。
+		[[nodiscard]]
+		size_t bitSize() const noexcept;
+
+	private:
+
+		Array<Byte> m_buffer;
+
+		size_t m_bitPos = 0;
+	};
+
+	/// @brief BitPackedSerializer で書き込まれたデータを読み込むアーカイブ
+	class BitPackedDeserializer : public cereal::InputArchive<BitPackedDeserializer, cereal::AllowEmptyClassElision>
+	{
+	public:
+
+		/// @param data 読み込むデータ
+		/// @param size 読み込むデータのサイズ（バイト）
+		/// @remark data の内容はこのオブジェクトが破棄されるまで有効である必要があります。
+		SIV3D_NODISCARD_CXX20
+		BitPackedDeserializer(const void* data, size_t size);
+
+		/// @brief bitCount ビットを読み込みます。
+		/// @param bitCount 読み込むビット数（0 以上 64 以下）
+		/// @throw cereal::Exception データの終端を超えた場合
+		[[nodiscard]]
+		uint64 readBits(uint32 bitCount);
+
+		/// @brief 可変長の符号なし整数を読み込みます。
+		/// @throw cereal::Exception データの終端を超えた場合、または値が 64 ビットを超える場合
+		[[nodiscard]]
+		uint64 readVarint();
+
+		/// @brief ジグザグ符号化された可変長の符号付き整数を読み込みます。
+		/// @throw cereal::Exception データの終端を超えた場合、または値が 64 ビットを超える場合
+		[[nodiscard]]
+		int64 readZigZag();
+
+		/// @brief バイト列をそのまま読み込みます。
+		/// @param data 読み込んだデータの格納先
+		/// @param size 読み込むデータのサイズ（バイト）
+		/// @throw cereal::Exception データの終端を超えた場合
+		void loadBinary(void* data, size_t size);
+
+		/// @brief 残りのビット数を返します。
+		[[nodiscard]]
+		size_t remainingBits() const noexcept;
+
+	private:
+
+		const Byte* m_data = nullptr;
+
+		size_t m_bitSize = 0;
+
+		size_t m_bitPos = 0;
+	};
+
+	/// @brief 浮動小数点数を [Min, Max] の範囲で Bits ビットに量子化してシリアライズするラッパー
+	/// @tparam Float 浮動小数点数型
+	/// @tparam Min 範囲の最小値（浮動小数点数の非型テンプレート引数に対応していないコンパイラでは整数で指定してください）
+	/// @tparam Max 範囲の最大値
+	/// @tparam Bits 量子化に用いるビット数（1 以上 32 以下）
+	/// @remark BitPackedSerializer 以外のアーカイブでは Float のままシリアライズされます。
+	template <class Float, auto Min, auto Max, uint32 Bits>
+	struct Quantized
+	{
+		static_assert(std::is_floating_point_v<Float>);
+		static_assert((1 <= Bits) && (Bits <= 32));
+		static_assert(static_cast<Float>(Min) < static_cast<Float>(Max));
+
+		static constexpr Float MinValue = static_cast<Float>(Min);
+
+		static constexpr Float MaxValue = static_cast<Float>(Max);
+
+		static constexpr uint32 QuantizedBits = Bits;
+
+		static constexpr uint32 MaxIndex = static_cast<uint32>((uint64{ 1 } << Bits) - 1);
+
+		Float value = MinValue;
+
+		SIV3D_NODISCARD_CXX20
+		Quantized() = default;
+
+		SIV3D_NODISCARD_CXX20
+		constexpr Quantized(Float _value) noexcept
+			: value{ _value } {}
+
+		[[nodiscard]]
+		constexpr operator Float() const noexcept
+		{
+			return value;
+		}
+
+		/// @brief 値を量子化したインデックスを返します。範囲外の値は範囲内に丸められます。
+		/// @remark NaN は 0 （`MinValue`）になります。
+		[[nodiscard]]
+		static constexpr uint32 Encode(const Float v) noexcept
+		{
+			// NaN は Clamp() を素通りし、整数への変換が未定義動作になるため先に除く
+			if (v != v)
+			{
+				return 0;
+			}
+
+			// float では MaxIndex が表せない（32 ビットで 2^32 に丸められる）ため、double で計算する
+			const double t = ((static_cast<double>(Clamp(v, MinValue, MaxValue)) - MinValue) / (static_cast<double>(MaxValue) - MinValue));
+			return static_cast<uint32>(t * MaxIndex + 0.5);
+		}
+
+		/// @brief 量子化されたインデックスから値を復元します。
+		[[nodiscard]]
+		static constexpr Float Decode(const uint32 index) noexcept
+		{
+			return (MinValue + (MaxValue - MinValue) * (static_cast<Float>(s3d::Min(index, MaxIndex)) / MaxIndex));
+		}
+
+		template <class Archive>
+		void SIV3D_SERIALIZE_SAVE(Archive& archive) const
+		{
+			if constexpr (std::is_same_v<Archive, BitPackedSerializer>)
+			{
+				archive.writeBits(Encode(value), Bits);
+			}
+			else
+			{
+				archive(value);
+			}
+		}
+
+		template <class Archive>
+		void SIV3D_SERIALIZE_LOAD(Archive& archive)
+		{
+			if constexpr (std::is_same_v<Archive, BitPackedDeserializer>)
+			{
+				value = Decode(static_cast<uint32>(archive.readBits(Bits)));
+			}
+			else
+			{
+				archive(value);
+			}
+		}
+	};
+
+	/// @brief Multiplayer_Photon のイベント引数として BitPackedSerializer で送受信できる型であることを示す特性
+	/// @remark 算術型、String, Quantized は既定で true です。
+	/// @remark SIV3D_SERIALIZE を持つ独自の型を EventEncoding::BitPacked のイベントで送受信する場合は、std::true_type を継承するように特殊化してください。
+	template <class Type>
+	struct IsBitPackedEventArg : std::bool_constant<std::is_arithmetic_v<Type>> {};
+
+	template <>
+	struct IsBitPackedEventArg<String> : std::true_type {};
+
+	template <class Float, auto Min, auto Max, uint32 Bits>
+	struct IsBitPackedEventArg<Quantized<Float, Min, Max, Bits>> : std::true_type {};
+
+	namespace detail
+	{
+		template <class Float, auto Min, auto Max, uint32 Bits>
+		struct QuantizedReference
+		{
+			using QuantizedType = Quantized<Float, Min, Max, Bits>;
+
+			Float& value;
+
+			template <class Archive>
+			void SIV3D_SERIALIZE_SAVE(Archive& archive) const
+			{
+				archive(QuantizedType{ value });
+			}
+
+			template <class Archive>
+			void SIV3D_SERIALIZE_LOAD(Archive& archive)
+			{
+				QuantizedType quantized;
+				archive(quantized);
+				value = quantized.value;
+			}
+		};
+
+		template <class Type>
+		struct DeltaReference
+		{
+			Type& value;
+
+			const Type& base;
+
+			template <class Archive>
+			void SIV3D_SERIALIZE_SAVE(Archive& archive) const
+			{
+				if constexpr (std::is_same_v<Archive, BitPackedSerializer>)
+				{
+					archive.writeZigZag(static_cast<int64>(static_cast<uint64>(value) - static_cast<uint64>(base)));
+				}
+				else
+				{
+					archive(value);
+				}
+			}
+
+			template <class Archive>
+			void SIV3D_SERIALIZE_LOAD(Archive& archive)
+			{
+				if constexpr (std::is_same_v<Archive, BitPackedDeserializer>)
+				{
+					value = static_cast<Type>(static_cast<uint64>(base) + static_cast<uint64>(archive.readZigZag()));
+				}
+				else
+				{
+					archive(value);
+				}
+			}
+		};
+	}
+
+	/// @brief 既存の浮動小数点数のメンバを、量子化してシリアライズするためのラッパーを返します。
+	/// @tparam Min 範囲の最小値
+	/// @tparam Max 範囲の最大値
+	/// @tparam Bits 量子化に用いるビット数（1 以上 32 以下）
+	/// @param value シリアライズする値
+	/// @return `archive(Quantize<0, 1600, 16>(pos.x))` のようにアーカイブに渡すラッパー
+	template <auto Min, auto Max, uint32 Bits, class Float, std::enable_if_t<std::is_floating_point_v<Float>>* = nullptr>
+	[[nodiscard]]
+	inline detail::QuantizedReference<Float, Min, Max, Bits> Quantize(Float& value) noexcept
+	{
+		return{ value };
+	}
+
+	/// @brief 整数を前回送信した値からの差分としてシリアライズするためのラッパーを返します。
+	/// @param value シリアライズする値
+	/// @param previous 差分の基準となる値。読み込み時も同じ値を指定する必要があります。
+	/// @return `archive(DeltaFrom(frame, lastFrame))` のようにアーカイブに渡すラッパー
+	/// @remark BitPackedSerializer 以外のアーカイブでは value がそのままシリアライズされます。
+	template <class Int, std::enable_if_t<std::is_integral_v<Int>>* = nullptr>
+	[[nodiscard]]
+	inline detail::DeltaReference<Int> DeltaFrom(Int& value, const Int& previous) noexcept
+	{
+		return{ value, previous };
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	BitPackedSerializer
+	//
+
+	inline BitPackedSerializer::BitPackedSerializer()
+		: cereal::OutputArchive<BitPackedSerializer, cereal::AllowEmptyClassElision>{ this } {}
+
+	inline void BitPackedSerializer::writeBits(uint64 value, uint32 bitCount)
+	{
+		assert(bitCount <= 64);
+
+		if (bitCount < 64)
+		{
+			value &= ((uint64{ 1 } << bitCount) - 1);
+		}
+
+		m_buffer.resize((m_bitPos + bitCount + 7) / 8);
+
+		while (bitCount)
+		{
+			const size_t bitOffset = (m_bitPos % 8);
+			const uint32 n = Min<uint32>(static_cast<uint32>(8 - bitOffset), bitCount);
+
+			m_buffer[m_bitPos / 8] |= Byte{ static_cast<uint8>((value & ((1u << n) - 1)) << bitOffset) };
+
+			value >>= n;
+			bitCount -= n;
+			m_bitPos += n;
+		}
+	}
+
+	inline void BitPackedSerializer::writeVarint(uint64 value)
+	{
+		while (0x80 <= value)
+		{
+			writeBits(((value & 0x7F) | 0x80), 8);
+			value >>= 7;
+		}
+
+		writeBits(value, 8);
+	}
+
+	inline void BitPackedSerializer::writeZigZag(const int64 value)
+	{
+		writeVarint((static_cast<uint64>(value) << 1) ^ static_cast<uint64>(value >> 63));
+	}
+
+	inline void BitPackedSerializer::saveBinary(const void* data, const size_t size)
+	{
+		if ((m_bitPos % 8) == 0)
+		{
+			const size_t offset = (m_bitPos / 8);
+			m_buffer.resize(offset + size);
+			std::memcpy(m_buffer.data() + offset, data, size);
+			m_bitPos += (size * 8);
+			return;
+		}
+
+		const uint8* p = static_cast<const uint8*>(data);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			writeBits(p[i], 8);
+		}
+	}
+
+	inline const Byte* BitPackedSerializer::data() const noexcept
+	{
+		return m_buffer.data();
+	}
+
+	inline size_t BitPackedSerializer::size() const noexcept
+	{
+		return m_buffer.size();
+	}
+
+	inline size_t BitPackedSerializer::bitSize() const noexcept
+	{
+		return m_bitPos;
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	BitPackedDeserializer
+	//
+
+	inline BitPackedDeserializer::BitPackedDeserializer(const void* data, const size_t size)
+		: cereal::InputArchive<BitPackedDeserializer, cereal::AllowEmptyClassElision>{ this }
+		, m_data{ static_cast<const Byte*>(data) }
+		, m_bitSize{ size * 8 } {}
+
+	inline uint64 BitPackedDeserializer::readBits(uint32 bitCount)
+	{
+		assert(bitCount <= 64);
+
+		if (remainingBits() < bitCount)
+		{
+			throw cereal::Exception{ "Failed to read " + std::to_string(bitCount) + " bits from input stream! Remaining " + std::to_string(remainingBits()) };
+		}
+
+		uint64 result = 0;
+		uint32 shift = 0;
+
+		while (bitCount)
+		{
+			const size_t bitOffset = (m_bitPos % 8);
+			const uint32 n = Min<uint32>(static_cast<uint32>(8 - bitOffset), bitCount);
+			const uint64 bits = ((static_cast<uint8>(m_data[m_bitPos / 8]) >> bitOffset) & ((1u << n) - 1));
+
+			result |= (bits << shift);
+
+			shift += n;
+			bitCount -= n;
+			m_bitPos += n;
+		}
+
+		return result;
+	}
+
+	inline uint64 BitPackedDeserializer::readVarint()
+	{
+		uint64 result = 0;
+
+		for (uint32 shift = 0; shift < 64; shift += 7)
+		{
+			const uint64 byte = readBits(8);
+
+			result |= ((byte & 0x7F) << shift);
+
+			if ((byte & 0x80) == 0)
+			{
+				return result;
+			}
+		}
+
+		throw cereal::Exception{ "Varint is too long" };
+	}
+
+	inline int64 BitPackedDeserializer::readZigZag()
+	{
+		const uint64 value = readVarint();
+		return static_cast<int64>((value >> 1) ^ (~(value & 1) + 1));
+	}
+
+	inline void BitPackedDeserializer::loadBinary(void* const data, const size_t size)
+	{
+		if ((remainingBits() / 8) < size)
+		{
+			throw cereal::Exception{ "Failed to read " + std::to_string(size) + " bytes from input stream! Remaining " + std::to_string(remainingBits() / 8) };
+		}
+
+		if ((m_bitPos % 8) == 0)
+		{
+			std::memcpy(data, m_data + (m_bitPos / 8), size);
+			m_bitPos += (size * 8);
+			return;
+		}
+
+		uint8* p = static_cast<uint8*>(data);
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			p[i] = static_cast<uint8>(readBits(8));
+		}
+	}
+
+	inline size_t BitPackedDeserializer::remainingBits() const noexcept
+	{
+		return (m_bitSize - m_bitPos);
+	}
+
+	//////////////////////////////////////////////////////
+	//
+	//	arithmetic types
+	//
+	template <class Type, std::enable_if_t<std::is_arithmetic_v<Type>>* = nullptr>
+	inline void SIV3D_SERIALIZE_SAVE(BitPackedSerializer& archive, const Type& value)
+	{
+		if constexpr (std::is_same_v<Type, bool>)
+		{
+			archive.writeBits(value, 1);
+		}
+		else if constexpr (std::is_floating_point_v<Type> || (sizeof(Type) == 1))
+		{
+			archive.saveBinary(std::addressof(value), sizeof(value));
+		}
+		else if constexpr (std::is_signed_v<Type>)
+		{
+			archive.writeZigZag(value);
+		}
+		else
+		{
+			archive.writeVarint(value);
+		}
+	}
+
+	template <class Type, std::enable_if_t<std::is_arithmetic_v<Type>>* = nullptr>
+	inline void SIV3D_SERIALIZE_LOAD(BitPackedDeserializer& archive, Type& value)
+	{
+		if constexpr (std::is_same_v<Type, bool>)
+		{
+			value = (archive.readBits(1) != 0);
+		}
+		else if constexpr (std::is_floating_point_v<Type> || (sizeof(Type) == 1))
+		{
+			archive.loadBinary(std::addressof(value), sizeof(value));
+		}
+		else if constexpr (std::is_signed_v<Type>)
+		{
+			value = static_cast<Type>(archive.readZigZag());
+		}
+		else
+		{
+			value = static_cast<Type>(archive.readVarint());
+		}
+	}
+
+	//////////////////////////////////////////////////////
+	//
+	//	cereal::BinaryData
+	//
+	template <class Type>
+	inline void SIV3D_SERIALIZE_SAVE(BitPackedSerializer& archive, const cereal::BinaryData<Type>& value)
+	{
+		archive.saveBinary(value.data, static_cast<size_t>(value.size));
+	}
+
+	template <class Type>
+	inline void SIV3D_SERIALIZE_LOAD(BitPackedDeserializer& archive, cereal::BinaryData<Type>& value)
+	{
+		archive.loadBinary(value.data, static_cast<size_t>(value.size));
+	}
+
+	//////////////////////////////////////////////////////
+	//
+	//	String (UTF-8)
+	//
+	inline void SIV3D_SERIALIZE_SAVE(BitPackedSerializer& archive, const String& value)
+	{
+		const std::string utf8 = value.toUTF8();
+		archive.writeVarint(utf8.size());
+		archive.saveBinary(utf8.data(), utf8.size());
+	}
+
+	inline void SIV3D_SERIALIZE_LOAD(BitPackedDeserializer& archive, String& value)
+	{
+		const size_t size = static_cast<size_t>(archive.readVarint());
+
+		if ((archive.remainingBits() / 8) < size)
+		{
+			throw cereal::Exception{ "String length exceeds the remaining input" };
+		}
+
+		std::string utf8(size, '\0');
+		archive.loadBinary(utf8.data(), size);
+		value = Unicode::FromUTF8(utf8);
+	}
+}
+
+CEREAL_REGISTER_ARCHIVE(s3d::BitPackedSerializer)
+CEREAL_REGISTER_ARCHIVE(s3d::BitPackedDeserializer)
+
+CEREAL_SETUP_ARCHIVE_TRAITS(s3d::BitPackedDeserializer, s3d::BitPackedSerializer)
@@ -1,9 +1,36 @@
 #!/bin/bash
+#
+# OpenSiv3D のパッケージを更新します。
+# 使い方: CI/UpdateOpenSiv3D.sh <パッケージ (.tgz) の URL>
+#
+# OpenSiv3D/include には、このリポジトリで追加・変更したエンジンのヘッダがあります。
+# CI/OpenSiv3D.base に記録したコミット (手を加える前のパッケージ) からの差分を保存し、
+# 新しいパッケージをそのままコミットした後で、その差分を 3-way マージで適用し直します。
+#
+
+set -e
+
+if [ -z "$1" ]; then
+    echo "usage: $0 <OpenSiv3D package URL>" >&2
+    exit 1
+fi
+
+if ! git diff --quiet HEAD -- OpenSiv3D CI/OpenSiv3D.base; then
+    echo "OpenSiv3D に未コミットの変更があります。コミットしてから実行してください。" >&2
+    exit 1
+fi
+
+# パッケージに加えた変更を保存する
+BASE=$(cat CI/OpenSiv3D.base)
+PATCH=$(mktemp)
+git diff --binary "$BASE" HEAD -- OpenSiv3D/include > "$PATCH"
 
 curl -L -o OpenSiv3D.tgz $1
 
 # Extract & Overwrite
 tar -xvf OpenSiv3D.tgz
+# パッケージから削除されたヘッダが残らないよう、include は入れ替える
+rm -r OpenSiv3D/include
 cp -r Package/* OpenSiv3D
 
 # Clean up
@@ -15,3 +42,18 @@ rm -r example
 
 mv OpenSiv3D/resources .
 mv OpenSiv3D/example .
+
+# 手を加えていないパッケージをコミットし、次の更新の基準にする
+git add -A OpenSiv3D resources example
+git commit -m "Update OpenSiv3D ($1)"
+git rev-parse HEAD > CI/OpenSiv3D.base
+
+# 保存した変更を適用し直す
+if git apply --3way "$PATCH"; then
+    rm "$PATCH"
+    echo "エンジンのヘッダへの変更を適用し直しました。ビルドを確認してから、CI/OpenSiv3D.base と一緒にコミットしてください。"
+else
+    echo "エンジンのヘッダへの変更の一部が衝突しました。衝突を解消してから、CI/OpenSiv3D.base と一緒にコミットしてください。" >&2
+    echo "適用した差分: $PATCH" >&2
+    exit 1
+fi
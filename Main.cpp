@@ -27,6 +27,8 @@ enum EventCode : uint8
 	CustomDataTest3,
 	CustomDataTest4,
 	FallbackTest,
+	FixedLayoutTest,
+	BitPackedTest,
 };
 
 class MyNetwork : public Multiplayer_Photon
@@ -44,6 +46,21 @@ public:
 		RegisterEventCallback(EventCode::CustomDataTest2, &MyNetwork::onCustomDataTest2);
 		RegisterEventCallback(EventCode::CustomDataTest3, &MyNetwork::onCustomDataTest3);
 		RegisterEventCallback(EventCode::CustomDataTest4, &MyNetwork::onCustomDataTest4);
+		RegisterEventCallback(EventCode::FixedLayoutTest, &MyNetwork::onFixedLayoutTest);
+		RegisterEventCallback(EventCode::BitPackedTest, &MyNetwork::onBitPackedTest);
+
+		// トリビアルコピー可能な型のみを送るイベントは、固定レイアウトを指定すると cereal を経由せずに送信される
+		setEventEncoding(EventCode::FixedLayoutTest, EventEncoding::FixedLayout);
+
+		// 頻繁に送信する状態は BitPackedSerializer で送信して帯域を節約する
+		setEventEncoding(EventCode::BitPackedTest, EventEncoding::BitPacked);
+
+		// 高リフレッシュレートのディスプレイでもルームに送りすぎないよう、通信頻度を固定する
+		setTickRate(NetworkTickRate{ .serviceRate = 60.0, .sendRate = 20.0 });
+
+		// キャッシュが 4 件を超えたら最後のイベント 1 件に圧縮し、後から入室するプレイヤーへの再送を抑える
+		// （CacheForever のイベントは、他のプレイヤーからも StringEvent2 を受信している場合は、そのプレイヤーのキャッシュを消さないよう圧縮されない）
+		setEventCacheCompaction(EventCode::StringEvent2, EventCacheCompaction{ .maxEvents = 4 });
 	}
 
 	Optional<LocalPlayer> getLocalPlayerByName(StringView userName) const
@@ -91,6 +108,15 @@ private:
 		debugLog(U"<<< CustomDataTest4 を受信: {}"_fmt(a));
 	}
 
+	// EventEncoding::FixedLayout で送信されたイベントは cereal を経由せずに受信される
+	void onFixedLayoutTest(LocalPlayerID sender, const Vec2& pos, Point cell) {
+		debugLog(U"<<< FixedLayoutTest を受信: {}, {}"_fmt(pos, cell));
+	}
+
+	void onBitPackedTest(LocalPlayerID sender, int32 score, bool alive, const String& name) {
+		debugLog(U"<<< BitPackedTest を受信: {}, {}, {}"_fmt(score, alive, name));
+	}
+
 	// シリアライズデータを受信したときに呼ばれる関数をオーバーライドしてカスタマイズする
 	void customEventAction(const LocalPlayerID playerID, const uint8 eventCode, Deserializer<MemoryViewReader>& reader) override
 	{
@@ -111,6 +137,28 @@ private:
 	}
 };
 
+// 接続からルームへの参加までを、コールバックを待たずにコルーチンで順に記述する
+MultiplayerTask ConnectAndJoinRoom(MyNetwork& network, const String roomName)
+{
+	if (not network.isInLobby())
+	{
+		if (const auto result = co_await network.connectAsync(U"Siv", U"jp"); not result)
+		{
+			network.debugLog(U"connectAsync failed: {}"_fmt(result.errorString));
+			co_return;
+		}
+	}
+
+	if (const auto result = co_await network.joinOrCreateRoomAsync(roomName, RoomCreateOption().maxPlayers(2)))
+	{
+		network.debugLog(U"joinOrCreateRoomAsync succeeded: playerID {}"_fmt(result.playerID));
+	}
+	else
+	{
+		network.debugLog(U"joinOrCreateRoomAsync failed: {}"_fmt(result.errorString));
+	}
+}
+
 void Main()
 {
 	Scene::Resize(1600, 1200);
@@ -120,6 +168,8 @@ void Main()
 
 	MyNetwork network{};
 
+	MultiplayerTask task;
+
 	TextEditState text{};
 
 	Font font{ 20 };
@@ -180,6 +230,7 @@ void Main()
 			network.debugLog(U"serverTime: {}ms"_fmt(Format(network.getServerTimeMillisec())));
 			network.debugLog(U"serverTimeOffset: {}ms"_fmt(Format(network.getServerTimeOffsetMillisec())));
 			network.debugLog(U"ping: {}ms"_fmt(Format(network.getPingMillisec())));
+			network.debugLog(U"eventCache(StringEvent2): {} events, {} bytes"_fmt(network.getEventCacheSize(EventCode::StringEvent2).events, network.getEventCacheSize(EventCode::StringEvent2).bytes));
 		}
 
 		if (SimpleGUI::Button(U"getPingInterval", { x += offsetX, y }, ButtonWidth))
@@ -235,6 +286,11 @@ void Main()
 			network.joinRandomRoom();
 		}
 
+		if (SimpleGUI::Button(U"connect and joinOrCreateRoom (co_await)", { x += offsetX, y }, ButtonWidth, task.isDone()))
+		{
+			task = ConnectAndJoinRoom(network, text.text);
+		}
+
 		if (SimpleGUI::Button(U"joinEventTargetGroup 1", { x = initX, y += offsetY }, ButtonWidth))
 		{
 			network.joinEventTargetGroup(1);
@@ -280,6 +336,11 @@ void Main()
 			network.sendEvent(MultiplayerEvent(EventCode::FallbackTest));
 		}
 
+		if (SimpleGUI::Button(U"sendEventTest FixedLayout", { x += offsetX, y }, ButtonWidth))
+		{
+			network.sendEvent(MultiplayerEvent(EventCode::FixedLayoutTest), Cursor::PosF(), Cursor::Pos() / 40);
+		}
+
 		if (SimpleGUI::Button(U"sendEventTo TargetGroup 1, 2, 3, 4", { x += offsetX, y }, ButtonWidth))
 		{
 			network.sendEvent(MultiplayerEvent(EventCode::IntEvent, TargetGroup(1)), 1);
@@ -303,6 +364,11 @@ void Main()
 			network.sendEvent(MultiplayerEvent(EventCode::StringEvent, ReceiverOption::Host), String(U"ToHost"));
 		}
 
+		if (SimpleGUI::Button(U"sendEventTest BitPacked", { x += offsetX, y }, ButtonWidth))
+		{
+			network.sendEvent(MultiplayerEvent(EventCode::BitPackedTest), -42, true, String(U"BitPacked"));
+		}
+
 		if (SimpleGUI::Button(U"sendEvent Others_CacheUntilLeaveRoom", { x = initX, y += offsetY }, ButtonWidth))
 		{
 			network.sendEvent(MultiplayerEvent(EventCode::StringEvent, ReceiverOption::Others_CacheUntilLeaveRoom), String(U"Others_CacheUntilLeaveRoom"));
@@ -26,7 +26,36 @@ mergeInto(LibraryManager.library, {
         CustomEvent: 35,
         OnRoomListUpdate: 41,
         OnRoomPropertiesChange: 42,
+
+        // JavaScript 側でのみ使う (C++ 側には JoinRoomReturn として通知する)
+        ReconnectAndRejoinReturn: 91,
+    },
+
+    $siv3dPhotonWaitCallback: function (type, operationID) {
+        // C++ 側の操作 ID を記録し、応答とともに返す
+        siv3dPhotonClient.waitingCallbacks.push({ type: type, id: operationID });
+        siv3dPhotonClient.lastOperationID = operationID;
+    },
+    $siv3dPhotonWaitCallback__deps: ["$siv3dPhotonClient"],
+
+    $siv3dPhotonTakeWaitingCallback: function (types, lastID) {
+        // 応答の種類に対応する待機中の操作のうち、最も古いものを取り出す
+        // タイムアウトした操作も応答が返るまで残しておき、遅れて届いた応答が後の操作に対応付けられないようにする
+        const index = siv3dPhotonClient.waitingCallbacks.findIndex(waiting => types.includes(waiting.type) && (lastID === undefined || waiting.id <= lastID));
+
+        if (index < 0) {
+            return null;
+        }
+
+        return siv3dPhotonClient.waitingCallbacks.splice(index, 1)[0];
+    },
+    $siv3dPhotonTakeWaitingCallback__deps: ["$siv3dPhotonClient"],
+
+    $siv3dPhotonDropWaitingCallbacks: function (lastID) {
+        // 切断より前に開始した操作には応答が返らないため破棄する
+        siv3dPhotonClient.waitingCallbacks = siv3dPhotonClient.waitingCallbacks.filter(waiting => lastID < waiting.id);
     },
+    $siv3dPhotonDropWaitingCallbacks__deps: ["$siv3dPhotonClient"],
 
     $siv3dPhotonClientState: {
 		Disconnected: 0,
@@ -48,7 +77,8 @@ mergeInto(LibraryManager.library, {
 
         siv3dPhotonClient = new Photon.LoadBalancing.LoadBalancingClient(protocol, appID, appVersion);
 
-        siv3dPhotonClient.waitingCallback = null;
+        siv3dPhotonClient.waitingCallbacks = [];
+        siv3dPhotonClient.lastOperationID = 0;
         siv3dPhotonClient.callbackCacheList = [];
 
         siv3dPhotonClient.setLogLevel(verbose ? Photon.LogLevel.DEBUG : Photon.LogLevel.WARN);
@@ -86,15 +116,28 @@ mergeInto(LibraryManager.library, {
             peer.addResponseListener(Photon.LoadBalancing.Constants.OperationCode.Leave, function (data) {
                 siv3dPhotonClient.callbackCacheList.push({ type: siv3dPhotonCallbackCode.LeaveRoomReturn, errCode: data.errCode, errMsg: data.errMsg ? data.errMsg : "" });
             });
+            // reconnectAndRejoin() はマスターサーバを経由しないため、ゲームサーバの JoinGame の応答で完了する
+            peer.addResponseListener(Photon.LoadBalancing.Constants.OperationCode.JoinGame, function (data) {
+                siv3dPhotonClient.callbackCacheList.push({ type: siv3dPhotonCallbackCode.ReconnectAndRejoinReturn, errCode: data.errCode, errMsg: data.errMsg ? data.errMsg : "", actorNr: siv3dPhotonClient.myActor().actorNr });
+            });
         };
 
         siv3dPhotonClient.onStateChange = function (state) {
             let clientState;
             const State = Photon.LoadBalancing.LoadBalancingClient.State;
+            const previousState = siv3dPhotonClient.lastState;
+            siv3dPhotonClient.lastState = state;
             switch (state) {
+                case State.Disconnected:
+                    // 接続していない状態での disconnect() (接続前の切断など) は、切断を待っている場合のみ通知する
+                    if ((previousState !== undefined && previousState != State.Uninitialized && previousState != State.Disconnected)
+                        || siv3dPhotonClient.waitingCallbacks.some(waiting => waiting.type == siv3dPhotonCallbackCode.DisconnectReturn)) {
+                        siv3dPhotonClient.callbackCacheList.push({ type: siv3dPhotonCallbackCode.DisconnectReturn, errCode: 0, errMsg: "", lastID: siv3dPhotonClient.lastOperationID });
+                    }
+                    clientState = siv3dPhotonClientState.Disconnected;
+                    break;
                 case State.Error:
                 case State.Uninitialized:
-                case State.Disconnected:
                     clientState = siv3dPhotonClientState.Disconnected;
                     break;
                 case State.ConnectingToNameServer:
@@ -156,7 +199,7 @@ mergeInto(LibraryManager.library, {
 
         siv3dPhotonClient.onError = function (errorCode, errorMsg) {
             if (errorCode) {
-                siv3dPhotonClient.callbackCacheList.push({ type: siv3dPhotonCallbackCode.ConnectionErrorReturn, errCode: errorCode, errMsg: errorMsg });
+                siv3dPhotonClient.callbackCacheList.push({ type: siv3dPhotonCallbackCode.ConnectionErrorReturn, errCode: errorCode, errMsg: errorMsg, lastID: siv3dPhotonClient.lastOperationID });
             }
         };
 
@@ -167,7 +210,7 @@ mergeInto(LibraryManager.library, {
     siv3dPhotonInitClient__sig: "viiii",
     siv3dPhotonInitClient__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$siv3dPhotonClientState", "$siv3dPhotonSetPingInterval"],
 
-    siv3dPhotonConnect: function (userId_ptr, region_ptr) {
+    siv3dPhotonConnect: function (userId_ptr, region_ptr, operationID) {
         siv3dPhotonClient.disconnect();
 
         siv3dPhotonClient.setUserId(UTF32ToString(userId_ptr));
@@ -182,19 +225,19 @@ mergeInto(LibraryManager.library, {
             return false;
         }
 
-        siv3dPhotonClient.waitingCallback = siv3dPhotonCallbackCode.ConnectReturn;
+        siv3dPhotonWaitCallback(siv3dPhotonCallbackCode.ConnectReturn, operationID);
 
         return true;
     },
-    siv3dPhotonConnect__sig: "iii",
-    siv3dPhotonConnect__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode"],
+    siv3dPhotonConnect__sig: "iiii",
+    siv3dPhotonConnect__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$siv3dPhotonWaitCallback"],
 
-    siv3dPhotonDisconnect: function () {
-        siv3dPhotonClient.waitingCallback = siv3dPhotonCallbackCode.DisconnectReturn;
+    siv3dPhotonDisconnect: function (operationID) {
+        siv3dPhotonWaitCallback(siv3dPhotonCallbackCode.DisconnectReturn, operationID);
         siv3dPhotonClient.disconnect();
     },
-    siv3dPhotonDisconnect__sig: "v",
-    siv3dPhotonDisconnect__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode"],
+    siv3dPhotonDisconnect__sig: "vi",
+    siv3dPhotonDisconnect__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$siv3dPhotonWaitCallback"],
 
     siv3dPhotonService: function () {
         if (siv3dPhotonClient.isJoinedToRoom())
@@ -212,54 +255,63 @@ mergeInto(LibraryManager.library, {
         for (const callback of callbackCacheList) {
             console.log("[Multiplayer_Photon] [js] siv3dPhotonService");
             console.log("[Multiplayer_Photon] [js] callback: ", callback.type);
-            console.log("[Multiplayer_Photon] [js] waiting: ", siv3dPhotonClient.waitingCallback);
+            console.log("[Multiplayer_Photon] [js] waiting: ", siv3dPhotonClient.waitingCallbacks);
             switch (callback.type) {
                 case siv3dPhotonCallbackCode.ConnectionErrorReturn:
-                    siv3dPhotonClient.waitingCallback = null;
-                    _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), -1);
+                    // 接続エラーより前に開始した操作には応答が返らないため、C++ 側でも失敗させる
+                    siv3dPhotonDropWaitingCallbacks(callback.lastID);
+                    _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), -1, 0, callback.lastID);
                     break;
 
-                case siv3dPhotonCallbackCode.DisconnectReturn:
-                    if (!siv3dPhotonClient.waitingCallback || siv3dPhotonClient.waitingCallback == callback.type) {
-                        siv3dPhotonClient.waitingCallback = null;
-                        _siv3dPhotonGeneralCallback(callback.type, 0, siv3dStringToNewUTF32(callback.errMsg), -1);
-                    }
+                case siv3dPhotonCallbackCode.DisconnectReturn: {
+                    // 切断は常に通知し、切断より前に開始した操作をすべて失敗させる
+                    const waiting = siv3dPhotonTakeWaitingCallback([callback.type], callback.lastID);
+                    siv3dPhotonDropWaitingCallbacks(callback.lastID);
+                    _siv3dPhotonGeneralCallback(callback.type, 0, siv3dStringToNewUTF32(callback.errMsg), -1, waiting ? waiting.id : 0, callback.lastID);
                     break;
+                }
 
                 case siv3dPhotonCallbackCode.ConnectReturn:
-                case siv3dPhotonCallbackCode.LeaveRoomReturn:
-                    if (siv3dPhotonClient.waitingCallback == callback.type) {
-                        siv3dPhotonClient.waitingCallback = null;
-                        _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), -1);
+                case siv3dPhotonCallbackCode.LeaveRoomReturn: {
+                    const waiting = siv3dPhotonTakeWaitingCallback([callback.type]);
+                    if (waiting !== null) {
+                        _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), -1, waiting.id, 0);
+                    }
+                    break;
+                }
+
+                case siv3dPhotonCallbackCode.JoinRandomRoomReturn: {
+                    const waiting = siv3dPhotonTakeWaitingCallback([siv3dPhotonCallbackCode.JoinRandomRoomReturn, siv3dPhotonCallbackCode.JoinRandomOrCreateRoomReturn]);
+                    if (waiting !== null) {
+                        _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), callback.actorNr, waiting.id, 0);
                     }
                     break;
+                }
 
-                case siv3dPhotonCallbackCode.JoinRandomRoomReturn:
-                    if (siv3dPhotonClient.waitingCallback == siv3dPhotonCallbackCode.JoinRandomRoomReturn) {
-                        siv3dPhotonClient.waitingCallback = null;
-                        _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), callback.actorNr);
-                    } else if (siv3dPhotonClient.waitingCallback == siv3dPhotonCallbackCode.JoinRandomOrCreateRoomReturn) {
-                        siv3dPhotonClient.waitingCallback = null;
-                        _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), callback.actorNr);
+                case siv3dPhotonCallbackCode.JoinRoomReturn: {
+                    const waiting = siv3dPhotonTakeWaitingCallback([siv3dPhotonCallbackCode.JoinRoomReturn, siv3dPhotonCallbackCode.JoinOrCreateRoomReturn]);
+                    if (waiting !== null) {
+                        _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), callback.actorNr, waiting.id, 0);
                     }
                     break;
+                }
 
-                case siv3dPhotonCallbackCode.JoinRoomReturn:
-                    if (siv3dPhotonClient.waitingCallback == siv3dPhotonCallbackCode.JoinRoomReturn) {
-                        siv3dPhotonClient.waitingCallback = null;
-                        _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), callback.actorNr);
-                    } else if (siv3dPhotonClient.waitingCallback == siv3dPhotonCallbackCode.JoinOrCreateRoomReturn) {
-                        siv3dPhotonClient.waitingCallback = null;
-                        _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), callback.actorNr);
+                case siv3dPhotonCallbackCode.ReconnectAndRejoinReturn: {
+                    // 通常の入室でもゲームサーバから JoinGame の応答が届くため、reconnectAndRejoin() を待っている場合のみ通知する
+                    const waiting = siv3dPhotonTakeWaitingCallback([callback.type]);
+                    if (waiting !== null) {
+                        _siv3dPhotonGeneralCallback(siv3dPhotonCallbackCode.JoinRoomReturn, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), callback.actorNr, waiting.id, 0);
                     }
                     break;
+                }
 
-                case siv3dPhotonCallbackCode.CreateRoomReturn:
-                    if (siv3dPhotonClient.waitingCallback == callback.type) {
-                        siv3dPhotonClient.waitingCallback = null;
-                        _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), callback.actorNr);
+                case siv3dPhotonCallbackCode.CreateRoomReturn: {
+                    const waiting = siv3dPhotonTakeWaitingCallback([callback.type]);
+                    if (waiting !== null) {
+                        _siv3dPhotonGeneralCallback(callback.type, callback.errCode, siv3dStringToNewUTF32(callback.errMsg), callback.actorNr, waiting.id, 0);
                     }
                     break;
+                }
 
                 case siv3dPhotonCallbackCode.ClientStateChange:
                     _siv3dPhotonClientStateChangeCallback(callback.state);
@@ -294,6 +346,8 @@ mergeInto(LibraryManager.library, {
     siv3dPhotonService__deps: [
         "$siv3dPhotonClient",
         "$siv3dPhotonCallbackCode",
+        "$siv3dPhotonTakeWaitingCallback",
+        "$siv3dPhotonDropWaitingCallbacks",
         "siv3dPhotonGeneralCallback",
         "siv3dPhotonClientStateChangeCallback",
         "siv3dPhotonAppStateChangeCallback",
@@ -317,6 +371,46 @@ mergeInto(LibraryManager.library, {
     },
     $siv3dPhotonSetPingInterval__deps: ["$siv3dPhotonClient"],
 
+    $siv3dPhotonBackgroundService: {
+        interval: null,
+        listener: null,
+    },
+
+    siv3dPhotonSetBackgroundService: function (interval) {
+        const state = siv3dPhotonBackgroundService;
+
+        if (state.listener) {
+            document.removeEventListener("visibilitychange", state.listener);
+        }
+
+        clearInterval(state.interval);
+        state.interval = null;
+        state.listener = null;
+
+        if (interval <= 0) {
+            return;
+        }
+
+        // ページが非表示の間は requestAnimationFrame が止まり update() が呼ばれないため、タイマーでイベントキャッシュの圧縮を続ける
+        // 受信したコールバックは callbackCacheList に溜まり、次の update() で siv3dPhotonService() から通知される
+        // 非表示のページのタイマーは 1 秒に 1 回以上 (強い制限では 1 分に 1 回) に間引かれるため、指定した間隔で実行されるとは限らない
+        state.listener = function () {
+            clearInterval(state.interval);
+            state.interval = null;
+
+            if (document.hidden) {
+                state.interval = setInterval(function () {
+                    _siv3dPhotonBackgroundServiceCallback();
+                }, interval);
+            }
+        };
+
+        document.addEventListener("visibilitychange", state.listener);
+        state.listener();
+    },
+    siv3dPhotonSetBackgroundService__sig: "vi",
+    siv3dPhotonSetBackgroundService__deps: ["$siv3dPhotonBackgroundService", "siv3dPhotonBackgroundServiceCallback"],
+
     siv3dPhotonGetServerTime: function () {
         return siv3dPhotonClient.getServerTimeMs();
     },
@@ -329,11 +423,7 @@ mergeInto(LibraryManager.library, {
     siv3dPhotonGetRoundTripTime__sig: "i",
     siv3dPhotonGetRoundTripTime__deps: ["$siv3dPhotonClient"],
 
-    siv3dPhotonJoinRandomRoom: function (maxPlayers, matchmakingMode, filter_ptr) {
-        if (siv3dPhotonClient.waitingCallback) {
-            return false;
-        }
-
+    siv3dPhotonJoinRandomRoom: function (maxPlayers, matchmakingMode, filter_ptr, operationID) {
         const result = siv3dPhotonClient.joinRandomRoom({
             expectedMaxPlayers: maxPlayers,
             matchmakingMode: matchmakingMode,
@@ -341,19 +431,15 @@ mergeInto(LibraryManager.library, {
         });
 
         if (result) {
-            siv3dPhotonClient.waitingCallback = siv3dPhotonCallbackCode.JoinRandomRoomReturn;
+            siv3dPhotonWaitCallback(siv3dPhotonCallbackCode.JoinRandomRoomReturn, operationID);
         }
 
         return result;
     },
-    siv3dPhotonJoinRandomRoom__sig: "iiii",
-    siv3dPhotonJoinRandomRoom__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$UTF32ToString"],
-
-    siv3dPhotonJoinRandomOrCreateRoom: function (roomName_ptr, opt_ptr, maxPlayers, matchmakingMode, filter_ptr) {
-        if (siv3dPhotonClient.waitingCallback) {
-            return false;
-        }
+    siv3dPhotonJoinRandomRoom__sig: "iiiii",
+    siv3dPhotonJoinRandomRoom__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$siv3dPhotonWaitCallback", "$UTF32ToString"],
 
+    siv3dPhotonJoinRandomOrCreateRoom: function (roomName_ptr, opt_ptr, maxPlayers, matchmakingMode, filter_ptr, operationID) {
         const result = siv3dPhotonClient.joinRandomOrCreateRoom(
             {
                 expectedMaxPlayers: maxPlayers,
@@ -365,38 +451,30 @@ mergeInto(LibraryManager.library, {
         );
 
         if (result) {
-            siv3dPhotonClient.waitingCallback = siv3dPhotonCallbackCode.JoinRandomOrCreateRoomReturn;
+            siv3dPhotonWaitCallback(siv3dPhotonCallbackCode.JoinRandomOrCreateRoomReturn, operationID);
         }
 
         return result;
     },
-    siv3dPhotonJoinRandomOrCreateRoom__sig: "iiiiii",
-    siv3dPhotonJoinRandomOrCreateRoom__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$UTF32ToString"],
-
-    siv3dPhotonJoinRoom: function (roomName_ptr, rejoin) {
-        if (siv3dPhotonClient.waitingCallback) {
-            return false;
-        }
+    siv3dPhotonJoinRandomOrCreateRoom__sig: "iiiiiii",
+    siv3dPhotonJoinRandomOrCreateRoom__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$siv3dPhotonWaitCallback", "$UTF32ToString"],
 
+    siv3dPhotonJoinRoom: function (roomName_ptr, rejoin, operationID) {
         const result = siv3dPhotonClient.joinRoom(
             UTF32ToString(roomName_ptr),
             { rejoin: rejoin },
         );
 
         if (result) {
-            siv3dPhotonClient.waitingCallback = siv3dPhotonCallbackCode.JoinRoomReturn;
+            siv3dPhotonWaitCallback(siv3dPhotonCallbackCode.JoinRoomReturn, operationID);
         }
 
         return result;
     },
-    siv3dPhotonJoinRoom__sig: "iii",
-    siv3dPhotonJoinRoom__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$UTF32ToString"],
-
-    siv3dPhotonCreateRoom: function (join, roomName_ptr, opt_ptr) {
-        if (siv3dPhotonClient.waitingCallback) {
-            return false;
-        }
+    siv3dPhotonJoinRoom__sig: "iiii",
+    siv3dPhotonJoinRoom__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$siv3dPhotonWaitCallback", "$UTF32ToString"],
 
+    siv3dPhotonCreateRoom: function (join, roomName_ptr, opt_ptr, operationID) {
         let result;
 
         if (join) {
@@ -413,38 +491,30 @@ mergeInto(LibraryManager.library, {
         }
 
         if (result) {
-            siv3dPhotonClient.waitingCallback = join ? siv3dPhotonCallbackCode.JoinOrCreateRoomReturn : siv3dPhotonCallbackCode.CreateRoomReturn;
+            siv3dPhotonWaitCallback(join ? siv3dPhotonCallbackCode.JoinOrCreateRoomReturn : siv3dPhotonCallbackCode.CreateRoomReturn, operationID);
         }
 
         return result;
     },
-    siv3dPhotonCreateRoom__sig: "iii",
-    siv3dPhotonCreateRoom__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$UTF32ToString"],
-
-    siv3dPhotonReconnectAndRejoin: function () {
-        if (siv3dPhotonClient.waitingCallback) {
-            return false;
-        }
+    siv3dPhotonCreateRoom__sig: "iiiii",
+    siv3dPhotonCreateRoom__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$siv3dPhotonWaitCallback", "$UTF32ToString"],
 
+    siv3dPhotonReconnectAndRejoin: function (operationID) {
         siv3dPhotonClient.disconnect();
 
         const result = siv3dPhotonClient.reconnectAndRejoin();
 
         if (result) {
-            siv3dPhotonClient.waitingCallback = siv3dPhotonCallbackCode.ConnectReturn;
+            siv3dPhotonWaitCallback(siv3dPhotonCallbackCode.ReconnectAndRejoinReturn, operationID);
         }
 
         return result;
     },
-    siv3dPhotonCreateRoom__sig: "i",
-    siv3dPhotonCreateRoom__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode"],
-
-    siv3dPhotonLeaveRoom: function (willComeBack) {
-        if (siv3dPhotonClient.waitingCallback) {
-            return;
-        }
+    siv3dPhotonReconnectAndRejoin__sig: "ii",
+    siv3dPhotonReconnectAndRejoin__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$siv3dPhotonWaitCallback"],
 
-        siv3dPhotonClient.waitingCallback = siv3dPhotonCallbackCode.LeaveRoomReturn;
+    siv3dPhotonLeaveRoom: function (willComeBack, operationID) {
+        siv3dPhotonWaitCallback(siv3dPhotonCallbackCode.LeaveRoomReturn, operationID);
 
         if (willComeBack) {
             siv3dPhotonClient.suspendRoom();
@@ -452,8 +522,8 @@ mergeInto(LibraryManager.library, {
             siv3dPhotonClient.leaveRoom();
         }
     },
-    siv3dPhotonLeaveRoom__sig: "vi",
-    siv3dPhotonLeaveRoom__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode"],
+    siv3dPhotonLeaveRoom__sig: "vii",
+    siv3dPhotonLeaveRoom__deps: ["$siv3dPhotonClient", "$siv3dPhotonCallbackCode", "$siv3dPhotonWaitCallback"],
 
     siv3dPhotonChangeInterestGroup: function (join_len, join_ptr, leave_len, leave_ptr) {
         const join = join_len > 0 ? Array.from(HEAPU8.subarray(join_ptr, join_ptr + join_len)) : join_len == 0 ? null : [];
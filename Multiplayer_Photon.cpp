@@ -39,10 +39,10 @@ namespace s3d::detail
 		void siv3dPhotonInitClient(const char32* appID, const char32* appVersion, bool verbose, uint8 protocol);
 
 		__attribute__((import_name("siv3dPhotonConnect")))
-		bool siv3dPhotonConnect(const char32* userID, const char32* region);
+		bool siv3dPhotonConnect(const char32* userID, const char32* region, uint32 operationID);
 
 		__attribute__((import_name("siv3dPhotonDisconnect")))
-		void siv3dPhotonDisconnect();
+		void siv3dPhotonDisconnect(uint32 operationID);
 
 		__attribute__((import_name("siv3dPhotonService")))
 		void siv3dPhotonService();
@@ -59,23 +59,26 @@ namespace s3d::detail
 		__attribute__((import_name("siv3dPhotonSetPingInterval")))
 		void siv3dPhotonSetPingInterval(int32 interval);
 
+		__attribute__((import_name("siv3dPhotonSetBackgroundService")))
+		void siv3dPhotonSetBackgroundService(int32 interval);
+
 		__attribute__((import_name("siv3dPhotonJoinRandomRoom")))
-		bool siv3dPhotonJoinRandomRoom(uint8 maxPlayers, MatchmakingMode matchmakingMode, const char32* filter);
+		bool siv3dPhotonJoinRandomRoom(uint8 maxPlayers, MatchmakingMode matchmakingMode, const char32* filter, uint32 operationID);
 
 		__attribute__((import_name("siv3dPhotonJoinRandomOrCreateRoom")))
-		bool siv3dPhotonJoinRandomOrCreateRoom(const char32* roomName, const char32* opt, uint8 maxPlayers, MatchmakingMode matchmakingMode, const char32* filter);
+		bool siv3dPhotonJoinRandomOrCreateRoom(const char32* roomName, const char32* opt, uint8 maxPlayers, MatchmakingMode matchmakingMode, const char32* filter, uint32 operationID);
 
 		__attribute__((import_name("siv3dPhotonJoinRoom")))
-		bool siv3dPhotonJoinRoom(const char32* roomName, bool rejoin);
+		bool siv3dPhotonJoinRoom(const char32* roomName, bool rejoin, uint32 operationID);
 
 		__attribute__((import_name("siv3dPhotonCreateRoom")))
-		bool siv3dPhotonCreateRoom(bool join, const char32* roomName, const char32* roomOpt);
+		bool siv3dPhotonCreateRoom(bool join, const char32* roomName, const char32* roomOpt, uint32 operationID);
 
 		__attribute__((import_name("siv3dPhotonReconnectAndRejoin")))
-		bool siv3dPhotonReconnectAndRejoin();
+		bool siv3dPhotonReconnectAndRejoin(uint32 operationID);
 
 		__attribute__((import_name("siv3dPhotonLeaveRoom")))
-		void siv3dPhotonLeaveRoom(bool willComeBack);
+		void siv3dPhotonLeaveRoom(bool willComeBack, uint32 operationID);
 
 		__attribute__((import_name("siv3dPhotonChangeInterestGroup")))
 		void siv3dPhotonChangeInterestGroup(int32 joinLen, const uint8* join, int32 leaveLen, const uint8* leave);
@@ -136,6 +139,29 @@ namespace s3d::detail
 namespace s3d::detail
 {
 	void receiveRoomProperties(RoomPropertyTable& table);
+
+	String MultiplayerEventToJSON(const MultiplayerEvent& eventOption);
+
+	/// @brief 固定レイアウトイベントのメッセージの先頭に付ける文字（Base64 のアルファベットに含まれない）
+	constexpr char FixedLayoutEventPrefix = '!';
+
+	/// @brief BitPackedSerializer でエンコードされたイベントのメッセージの先頭に付ける文字（Base64 のアルファベットに含まれない）
+	constexpr char BitPackedEventPrefix = '#';
+
+	/// @brief イベントキャッシュの圧縮でキャッシュに追加し直したイベントのメッセージの先頭に付ける文字（他の先頭文字よりも前に付ける）
+	constexpr char CacheReplayEventPrefix = '~';
+
+	enum class PhotonCallbackCode : uint8 {
+		ConnectionErrorReturn = 1,
+		ConnectReturn = 11,
+		DisconnectReturn = 12,
+		LeaveRoomReturn = 21,
+		JoinRandomRoomReturn = 22,
+		JoinRandomOrCreateRoomReturn = 23,
+		JoinRoomReturn = 24,
+		JoinOrCreateRoomReturn = 25,
+		CreateRoomReturn = 26,
+	};
 }
 
 // [WEB] PhotonDetail
@@ -162,61 +188,569 @@ namespace s3d
 
 		int32 m_pingInterval = 2000;
 
-		bool joinRandomRoom(const int32 expectedMaxPlayers, MatchmakingMode matchmakingMode, StringView filter)
+		/// @brief 次に開始する非同期操作の ID（JavaScript 側に渡し、応答とともに返される）
+		uint32 m_nextOperationID = 1;
+
+		/// @brief 結果を待っている非同期操作（開始順）
+		Array<std::shared_ptr<detail::PendingOperation>> m_pendingOperations;
+
+		/// @brief 結果が確定し、コルーチンの再開を待っている非同期操作
+		Array<std::shared_ptr<detail::PendingOperation>> m_completedOperations;
+
+		/// @brief 非同期操作を開始します。
+		/// @param callbackCode 操作の完了を通知するコールバックのコード
+		/// @param timeout タイムアウトまでの時間
+		/// @param request 操作 ID を受け取ってリクエストを送信する関数。送信できた場合は true を返す
+		/// @return 開始した操作。リクエストを送信できなかった場合は status が MultiplayerOperationStatus::Failed
+		/// @remark 応答は操作 ID で対応付けるため、複数の操作を同時に実行できます。
+		template <class Request>
+		std::shared_ptr<detail::PendingOperation> beginOperation(const detail::PhotonCallbackCode callbackCode, const Duration& timeout, Request request)
 		{
-			if (not InRange(expectedMaxPlayers, 0, 255))
+			auto operation = std::make_shared<detail::PendingOperation>();
+			operation->id = m_nextOperationID++;
+			operation->callbackCode = FromEnum(callbackCode);
+			operation->deadlineMillisec = (Time::GetMillisec() + static_cast<uint64>(Max(timeout.count(), 0.0) * 1000.0));
+
+			const bool requested = request(static_cast<uint32>(operation->id));
+
+			m_context.debugLog(U"[Multiplayer_Photon] operation #{} started (callback: {}, requested: {})"_fmt(operation->id, operation->callbackCode, requested));
+
+			if (requested)
 			{
-				return false;
+				m_pendingOperations << operation;
+			}
+			else
+			{
+				operation->result.status = MultiplayerOperationStatus::Failed;
+				operation->result.errorString = U"The request could not be sent in the current state";
 			}
 
-			bool result = detail::siv3dPhotonJoinRandomRoom(expectedMaxPlayers, matchmakingMode, filter.data());
+			return operation;
+		}
 
-			return result;
+		/// @brief リクエストを送信せずに失敗した非同期操作を返します。
+		std::shared_ptr<detail::PendingOperation> rejectOperation(const detail::PhotonCallbackCode callbackCode, const Duration& timeout)
+		{
+			return beginOperation(callbackCode, timeout, [](uint32) { return false; });
 		}
 
-		bool joinRandomOrCreateRoom(RoomNameView roomName, StringView opt, StringView filter, int32 expectedMaxPlayers, MatchmakingMode matchmakingMode)
+		void finishOperation(std::shared_ptr<detail::PendingOperation> operation, const MultiplayerOperationStatus status, const int32 errorCode, const String& errorString, const LocalPlayerID playerID)
 		{
-			if (not InRange(expectedMaxPlayers, 0, 255))
+			m_context.debugLog(U"[Multiplayer_Photon] operation #{} finished (status: {})"_fmt(operation->id, FromEnum(status)));
+
+			operation->result.status = status;
+			operation->result.errorCode = errorCode;
+			operation->result.errorString = errorString;
+			operation->result.playerID = playerID;
+
+			m_completedOperations << std::move(operation);
+		}
+
+		/// @brief 応答に対応する非同期操作の結果を確定させます。
+		/// @param operationID JavaScript 側から返された操作 ID。タイムアウトした操作の応答が遅れて届いた場合は何もしません。
+		void completeOperation(const uint32 operationID, const int32 errorCode, const String& errorString, const LocalPlayerID playerID = 0)
+		{
+			const auto it = std::find_if(m_pendingOperations.begin(), m_pendingOperations.end(),
+				[operationID](const auto& operation) { return (operation->id == operationID); });
+
+			if (it == m_pendingOperations.end())
+			{
+				return;
+			}
+
+			auto operation = std::move(*it);
+			m_pendingOperations.erase(it);
+
+			finishOperation(std::move(operation), ((errorCode == 0) ? MultiplayerOperationStatus::Succeeded : MultiplayerOperationStatus::Failed), errorCode, errorString, playerID);
+		}
+
+		/// @brief 指定した ID 以前に開始した、結果を待っている非同期操作をすべて失敗させます。
+		/// @param lastOperationID 失敗させる最後の操作 ID
+		void failOperations(const uint32 lastOperationID, const int32 errorCode, const String& errorString)
+		{
+			for (auto it = m_pendingOperations.begin(); it != m_pendingOperations.end();)
+			{
+				if (lastOperationID < (*it)->id)
+				{
+					++it;
+					continue;
+				}
+
+				auto operation = std::move(*it);
+				it = m_pendingOperations.erase(it);
+
+				finishOperation(std::move(operation), MultiplayerOperationStatus::Failed, errorCode, errorString, 0);
+			}
+		}
+
+		/// @brief タイムアウトを処理し、結果が確定した非同期操作を待っているコルーチンを再開します。
+		void resumeOperations()
+		{
+			const uint64 now = Time::GetMillisec();
+
+			for (auto it = m_pendingOperations.begin(); it != m_pendingOperations.end();)
+			{
+				if (now < (*it)->deadlineMillisec)
+				{
+					++it;
+					continue;
+				}
+
+				auto operation = std::move(*it);
+				it = m_pendingOperations.erase(it);
+
+				finishOperation(std::move(operation), MultiplayerOperationStatus::TimedOut, 0, U"Timed out", 0);
+			}
+
+			// 再開したコルーチンが新しい操作を開始することがあるため、先に取り出しておく
+			for (const auto& operation : std::exchange(m_completedOperations, {}))
+			{
+				if (auto continuation = std::exchange(operation->continuation, nullptr))
+				{
+					continuation.resume();
+				}
+			}
+		}
+
+		struct EventCacheEntry
+		{
+			/// @brief 送信オプション（MultiplayerEventToJSON() の結果）。同じイベントコードでも送信オプションごとに記録する
+			String options;
+
+			/// @brief 最後にキャッシュしたイベント（圧縮時にキャッシュに追加し直す）
+			MultiplayerEvent latestEvent;
+
+			std::string latestMessage;
+
+			size_t events = 0;
+
+			size_t bytes = 0;
+
+			uint64 oldestMillisec = 0;
+		};
+
+		/// @brief 現在のルームで自身が送信してキャッシュされたイベントの記録（イベントコードごと）
+		HashTable<uint8, Array<EventCacheEntry>> m_eventCaches;
+
+		/// @brief 現在のルームでイベントを受信した送信者（イベントコードごと）。圧縮時に追加し直されたイベントの重複受信を防ぐ
+		HashTable<uint8, HashSet<LocalPlayerID>> m_eventSenders;
+
+		HashTable<uint8, EventCacheCompaction> m_eventCacheCompactions;
+
+		NetworkTickRate m_tickRate;
+
+		uint64 m_lastTickMicrosec = Time::GetMicrosec();
+
+		double m_serviceAccumulator = 0.0;
+
+		double m_sendAccumulator = 0.0;
+
+		/// @brief 経過時間を蓄積し、実行するティックの数を返します。
+		/// @param accumulator 蓄積した時間（秒）
+		/// @param deltaSeconds 前回からの経過時間（秒）
+		/// @param rate ティックの頻度（回/秒）。0 以下の場合は常に 1 を返します。
+		/// @param maxTicks ティックの最大数
+		/// @return 実行するティックの数
+		[[nodiscard]]
+		static int32 AdvanceTicks(double& accumulator, const double deltaSeconds, const double rate, const int32 maxTicks)
+		{
+			if (rate <= 0.0)
+			{
+				return 1;
+			}
+
+			const double interval = (1.0 / rate);
+
+			accumulator += deltaSeconds;
+
+			const int32 ticks = static_cast<int32>(Min(std::floor(accumulator / interval), static_cast<double>(Max(maxTicks, 1))));
+
+			accumulator -= (ticks * interval);
+
+			// 上限で切り捨てた遅れは取り戻さない（非表示から復帰した直後などに送信が集中しないようにする）
+			accumulator = Min(accumulator, interval);
+
+			return ticks;
+		}
+
+		void tick()
+		{
+			const uint64 now = Time::GetMicrosec();
+			const double deltaSeconds = ((now - m_lastTickMicrosec) / 1'000'000.0);
+			m_lastTickMicrosec = now;
+
+			// 受信処理は 1 回で溜まったコールバックをすべて処理するため、複数回行う必要はない
+			if (0 < AdvanceTicks(m_serviceAccumulator, deltaSeconds, m_tickRate.serviceRate, 1))
+			{
+				service();
+			}
+
+			const int32 sendTicks = AdvanceTicks(m_sendAccumulator, deltaSeconds, m_tickRate.sendRate, m_tickRate.maxTicksPerUpdate);
+
+			for (int32 i = 0; i < sendTicks; ++i)
 			{
+				m_context.onSendTick();
+			}
+		}
+
+		void service()
+		{
+			detail::siv3dPhotonService();
+
+			compactEventCaches();
+
+			resumeOperations();
+		}
+
+		/// @brief ページが非表示で update() が呼ばれない間に、タイマーから呼ばれます。
+		/// @remark 受信は JavaScript 側のクライアントが続けるため、ここではイベントキャッシュの圧縮だけを行います。
+		/// @remark コールバックの呼び出しとコルーチンの再開は、結果が update() の中で通知されるように次の update() まで遅らせます。
+		void backgroundService()
+		{
+			compactEventCaches();
+		}
+
+		void setBackgroundService(const Optional<Duration>& interval)
+		{
+			detail::siv3dPhotonSetBackgroundService(interval ? Max(static_cast<int32>(interval->count() * 1000.0), 1) : 0);
+		}
+
+		[[nodiscard]]
+		static bool IsCachedEvent(const ReceiverOption receiverOption) noexcept
+		{
+			switch (receiverOption)
+			{
+			case ReceiverOption::Others_CacheUntilLeaveRoom:
+			case ReceiverOption::Others_CacheForever:
+			case ReceiverOption::All_CacheUntilLeaveRoom:
+			case ReceiverOption::All_CacheForever:
+				return true;
+			default:
 				return false;
 			}
+		}
 
-			bool result = detail::siv3dPhotonJoinRandomOrCreateRoom(roomName.data(), opt.data(), expectedMaxPlayers, matchmakingMode, filter.data());
+		/// @brief 送信するメッセージのバッファ（送信のたびに使い回す）
+		std::string m_sendBuffer;
 
-			return result;
+		/// @brief 受信したメッセージをデコードするバッファ（受信のたびに使い回す）
+		Blob m_receiveBuffer;
+
+		/// @brief データを Base64 エンコードして送信します。
+		/// @param prefix メッセージの先頭に付ける文字。0 の場合は付けない
+		void raiseEvent(const MultiplayerEvent& event, const char prefix, const void* data, const size_t size)
+		{
+			const size_t prefixLength = ((prefix != '\0') ? 1 : 0);
+
+			m_sendBuffer.resize(prefixLength + Base64::EncodedLength(size));
+
+			if (prefixLength)
+			{
+				m_sendBuffer[0] = prefix;
+			}
+
+			m_sendBuffer.resize(prefixLength + Base64::Encode(data, size, (m_sendBuffer.data() + prefixLength)));
+
+			raiseEvent(event, m_sendBuffer);
 		}
 
-		bool joinRoom(const RoomNameView roomName, bool rejoin)
+		void raiseEvent(const MultiplayerEvent& event, const std::string& message)
 		{
-			bool result = detail::siv3dPhotonJoinRoom(roomName.data(), rejoin);
+			const String options = detail::MultiplayerEventToJSON(event);
 
-			return result;
+			detail::siv3dPhotonRaiseEvent(
+				event.eventCode(),
+				message.data(),
+				options.data()
+			);
+
+			if (IsCachedEvent(event.receiverOption()))
+			{
+				recordEventCache(event, options, message);
+			}
 		}
 
-		bool joinOrCreateRoom(RoomNameView roomName, StringView opt)
+		void recordEventCache(const MultiplayerEvent& event, const String& options, const std::string& message)
 		{
-			bool result = detail::siv3dPhotonCreateRoom(true, roomName.data(), opt.data());
+			auto& entries = m_eventCaches[event.eventCode()];
 
-			return result;
+			for (auto& entry : entries)
+			{
+				if (entry.options == options)
+				{
+					entry.latestEvent = event;
+					entry.latestMessage = message;
+					++entry.events;
+					entry.bytes += message.size();
+					return;
+				}
+			}
+
+			entries.push_back(EventCacheEntry{ options, event, message, 1, message.size(), Time::GetMillisec() });
 		}
 
-		bool createRoom(RoomNameView roomName, StringView opt)
+		/// @brief removeEventCache() に合わせて自身が送信したイベントキャッシュの記録を削除します。
+		/// @param eventCode イベントコード。0 の場合は全てのイベントコード
+		/// @param untilLeaveRoomOnly ReceiverOption::○○○_CacheUntilLeaveRoom の記録のみを削除する場合 true
+		void eraseEventCacheRecords(const uint8 eventCode, const bool untilLeaveRoomOnly)
 		{
-			bool result = detail::siv3dPhotonCreateRoom(false, roomName.data(), opt.data());
+			const auto eraseEntries = [untilLeaveRoomOnly](Array<EventCacheEntry>& entries)
+			{
+				if (not untilLeaveRoomOnly)
+				{
+					entries.clear();
+					return;
+				}
+
+				entries.remove_if([](const EventCacheEntry& entry)
+					{
+						const ReceiverOption receiverOption = entry.latestEvent.receiverOption();
+						return ((receiverOption == ReceiverOption::Others_CacheUntilLeaveRoom) or (receiverOption == ReceiverOption::All_CacheUntilLeaveRoom));
+					});
+			};
+
+			if (eventCode == 0)
+			{
+				for (auto& [code, entries] : m_eventCaches)
+				{
+					eraseEntries(entries);
+				}
+			}
+			else if (auto it = m_eventCaches.find(eventCode); it != m_eventCaches.end())
+			{
+				eraseEntries(it->second);
+			}
 
-			return result;
+			for (auto it = m_eventCaches.begin(); it != m_eventCaches.end();)
+			{
+				if (it->second.isEmpty())
+				{
+					it = m_eventCaches.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
 		}
 
-		void leaveRoom(bool willComeBack)
+		[[nodiscard]]
+		EventCacheSize getEventCacheSize(const uint8 eventCode) const
 		{
-			if (not m_context.isInRoom())
+			const auto it = m_eventCaches.find(eventCode);
+
+			if (it == m_eventCaches.end())
+			{
+				return{};
+			}
+
+			size_t events = 0;
+			size_t bytes = 0;
+			uint64 oldestMillisec = Time::GetMillisec();
+
+			for (const auto& entry : it->second)
+			{
+				events += entry.events;
+				bytes += entry.bytes;
+				oldestMillisec = Min(oldestMillisec, entry.oldestMillisec);
+			}
+
+			return{ events, bytes, SecondsF{ (Time::GetMillisec() - oldestMillisec) / 1000.0 } };
+		}
+
+		[[nodiscard]]
+		static bool IsCachedForever(const Array<EventCacheEntry>& entries) noexcept
+		{
+			return entries.any([](const EventCacheEntry& entry)
+				{
+					const ReceiverOption receiverOption = entry.latestEvent.receiverOption();
+					return ((receiverOption == ReceiverOption::Others_CacheForever) or (receiverOption == ReceiverOption::All_CacheForever));
+				});
+		}
+
+		/// @brief イベントコードのキャッシュを、他のプレイヤーのイベントを消さずに圧縮できるかを返します。
+		/// @remark ReceiverOption::○○○_CacheForever のイベントはプレイヤーに紐づかず、送信者を指定して削除できないため、圧縮するとイベントコードのキャッシュ全体が削除されます。
+		/// そのため、現在のルームで自分以外からそのイベントコードを受信している場合（入室時に受信したキャッシュを含む）は圧縮しません。
+		[[nodiscard]]
+		bool isCompactable(const uint8 eventCode, const Array<EventCacheEntry>& entries) const
+		{
+			if (not IsCachedForever(entries))
+			{
+				return true;
+			}
+
+			const auto it = m_eventSenders.find(eventCode);
+
+			if (it == m_eventSenders.end())
+			{
+				return true;
+			}
+
+			const LocalPlayerID localPlayerID = m_context.getLocalPlayerID();
+
+			return std::all_of(it->second.begin(), it->second.end(), [=](const LocalPlayerID sender) { return (sender == localPlayerID); });
+		}
+
+		void compactEventCache(const uint8 eventCode)
+		{
+			const auto it = m_eventCaches.find(eventCode);
+
+			if (it == m_eventCaches.end())
 			{
 				return;
 			}
 
-			m_clientState = ClientState::LeavingRoom;
+			const EventCacheSize size = getEventCacheSize(eventCode);
+
+			// 送信オプションごとに最新の 1 つしか残っていない場合は圧縮する必要がない
+			if (size.events <= it->second.size())
+			{
+				return;
+			}
 
-			detail::siv3dPhotonLeaveRoom(willComeBack);
+			if (not isCompactable(eventCode, it->second))
+			{
+				m_context.debugLog(U"[Multiplayer_Photon] compactEventCache skipped: other players have cached events with the same eventCode (eventCode: {})"_fmt(eventCode));
+				return;
+			}
+
+			// removeEventCache() で記録が削除されるため、先に取り出しておく
+			const Array<EventCacheEntry> entries = std::move(it->second);
+
+			m_context.debugLog(U"[Multiplayer_Photon] compactEventCache (eventCode: {}, events: {}, bytes: {})"_fmt(eventCode, size.events, size.bytes));
+
+			if (IsCachedForever(entries))
+			{
+				m_context.removeEventCache(eventCode);
+			}
+			else
+			{
+				m_context.removeEventCache(eventCode, { m_context.getLocalPlayerID() });
+			}
+
+			// 最新のイベントをキャッシュに追加し直す。ルーム内のプレイヤーは受信済みのため、受信側で破棄される
+			for (const auto& entry : entries)
+			{
+				std::string message = entry.latestMessage;
+				message.insert(message.begin(), detail::CacheReplayEventPrefix);
+
+				detail::siv3dPhotonRaiseEvent(
+					eventCode,
+					message.data(),
+					entry.options.data()
+				);
+
+				recordEventCache(entry.latestEvent, entry.options, entry.latestMessage);
+			}
+		}
+
+		/// @brief 条件を超えたイベントキャッシュを圧縮します。
+		void compactEventCaches()
+		{
+			if (m_eventCacheCompactions.empty() or (not m_context.isInRoom()))
+			{
+				return;
+			}
+
+			for (const auto& [eventCode, compaction] : m_eventCacheCompactions)
+			{
+				const auto it = m_eventCaches.find(eventCode);
+
+				// 圧縮できないキャッシュは、毎フレーム判定してログを出さないよう飛ばす
+				if ((it == m_eventCaches.end()) or (not isCompactable(eventCode, it->second)))
+				{
+					continue;
+				}
+
+				const EventCacheSize size = getEventCacheSize(eventCode);
+
+				const bool exceeded = (((compaction.maxEvents != 0) and (compaction.maxEvents < size.events))
+					or ((compaction.maxBytes != 0) and (compaction.maxBytes < size.bytes))
+					or (compaction.maxAge and (*compaction.maxAge < size.age)));
+
+				if (exceeded)
+				{
+					compactEventCache(eventCode);
+				}
+			}
+		}
+
+		std::shared_ptr<detail::PendingOperation> joinRandomRoom(const int32 expectedMaxPlayers, MatchmakingMode matchmakingMode, StringView filter, const Duration& timeout)
+		{
+			if (not InRange(expectedMaxPlayers, 0, 255))
+			{
+				return rejectOperation(detail::PhotonCallbackCode::JoinRandomRoomReturn, timeout);
+			}
+
+			return beginOperation(detail::PhotonCallbackCode::JoinRandomRoomReturn, timeout, [&](const uint32 operationID)
+				{
+					return detail::siv3dPhotonJoinRandomRoom(expectedMaxPlayers, matchmakingMode, filter.data(), operationID);
+				});
+		}
+
+		std::shared_ptr<detail::PendingOperation> joinRandomOrCreateRoom(RoomNameView roomName, StringView opt, StringView filter, int32 expectedMaxPlayers, MatchmakingMode matchmakingMode, const Duration& timeout)
+		{
+			// JavaScript 側からは JoinRandomGame の応答として JoinRandomRoomReturn が通知される
+			if (not InRange(expectedMaxPlayers, 0, 255))
+			{
+				return rejectOperation(detail::PhotonCallbackCode::JoinRandomRoomReturn, timeout);
+			}
+
+			return beginOperation(detail::PhotonCallbackCode::JoinRandomRoomReturn, timeout, [&](const uint32 operationID)
+				{
+					return detail::siv3dPhotonJoinRandomOrCreateRoom(roomName.data(), opt.data(), expectedMaxPlayers, matchmakingMode, filter.data(), operationID);
+				});
+		}
+
+		std::shared_ptr<detail::PendingOperation> joinRoom(const RoomNameView roomName, bool rejoin, const Duration& timeout)
+		{
+			return beginOperation(detail::PhotonCallbackCode::JoinRoomReturn, timeout, [&](const uint32 operationID)
+				{
+					return detail::siv3dPhotonJoinRoom(roomName.data(), rejoin, operationID);
+				});
+		}
+
+		std::shared_ptr<detail::PendingOperation> joinOrCreateRoom(RoomNameView roomName, StringView opt, const Duration& timeout)
+		{
+			// JavaScript 側からは JoinGame の応答として JoinRoomReturn が通知される
+			return beginOperation(detail::PhotonCallbackCode::JoinRoomReturn, timeout, [&](const uint32 operationID)
+				{
+					return detail::siv3dPhotonCreateRoom(true, roomName.data(), opt.data(), operationID);
+				});
+		}
+
+		std::shared_ptr<detail::PendingOperation> createRoom(RoomNameView roomName, StringView opt, const Duration& timeout)
+		{
+			return beginOperation(detail::PhotonCallbackCode::CreateRoomReturn, timeout, [&](const uint32 operationID)
+				{
+					return detail::siv3dPhotonCreateRoom(false, roomName.data(), opt.data(), operationID);
+				});
+		}
+
+		std::shared_ptr<detail::PendingOperation> leaveRoom(bool willComeBack, const Duration& timeout)
+		{
+			if (not m_context.isInRoom())
+			{
+				return rejectOperation(detail::PhotonCallbackCode::LeaveRoomReturn, timeout);
+			}
+
+			return beginOperation(detail::PhotonCallbackCode::LeaveRoomReturn, timeout, [&](const uint32 operationID)
+				{
+					m_clientState = ClientState::LeavingRoom;
+
+					detail::siv3dPhotonLeaveRoom(willComeBack, operationID);
+
+					return true;
+				});
+		}
+
+		std::shared_ptr<detail::PendingOperation> reconnectAndRejoin(const Duration& timeout)
+		{
+			// JavaScript 側からはゲームサーバの JoinGame の応答として JoinRoomReturn が通知される
+			return beginOperation(detail::PhotonCallbackCode::JoinRoomReturn, timeout, [](const uint32 operationID)
+				{
+					return detail::siv3dPhotonReconnectAndRejoin(operationID);
+				});
 		}
 
 		void updateLocalPlayer()
@@ -247,15 +781,18 @@ namespace s3d
 			return result;
 		}
 
-		void connectionErrorReturn(int32 errorCode)
+		void connectionErrorReturn(int32 errorCode, const uint32 lastOperationID)
 		{
 			m_context.debugLog(U"[Multiplayer_Photon] Multiplayer_Photon::connectionErrorReturn() [サーバへの接続が失敗したときに呼ばれる]");
 			m_context.debugLog(U"- [Multiplayer_Photon] errorCode: ", errorCode);
 
+			// エラーより前に開始した操作には応答が返らないため失敗させる
+			failOperations(lastOperationID, errorCode, U"Connection error");
+
 			m_context.connectionErrorReturn(errorCode);
 		}
 
-		void connectReturn(int32 errorCode, const String& errorString)
+		void connectReturn(int32 errorCode, const String& errorString, const uint32 operationID)
 		{
 			const auto& region = m_context.m_requestedRegion.value();
 
@@ -264,72 +801,99 @@ namespace s3d
 
 			detail::LogIfError(m_context, errorCode, errorString);
 
+			completeOperation(operationID, errorCode, errorString);
+
 			m_context.connectReturn(errorCode, errorString, region, U"");
 		}
 
-		void disconnectReturn()
+		void disconnectReturn(const uint32 operationID, const uint32 lastOperationID)
 		{
 			m_context.debugLog(U"[Multiplayer_Photon] Multiplayer_Photon::disconnectReturn() [サーバから切断されたときに呼ばれる]");
 
+			completeOperation(operationID, 0, U"");
+
+			// 切断より前に開始した操作には応答が返らないため失敗させる（切断後に開始した connect などはそのまま）
+			failOperations(lastOperationID, 0, U"Disconnected");
+
+			m_eventCaches.clear();
+
+			m_eventSenders.clear();
+
 			m_context.disconnectReturn();
 		}
 
-		void leaveRoomReturn(int32 errorCode, const String& errorString)
+		void leaveRoomReturn(int32 errorCode, const String& errorString, const uint32 operationID)
 		{
 			m_context.debugLog(U"[Multiplayer_Photon] Multiplayer_Photon::leaveRoomReturn() [ルームから退出した結果を処理する]");
 
 			detail::LogIfError(m_context, errorCode, errorString);
 
+			completeOperation(operationID, errorCode, errorString);
+
+			m_eventCaches.clear();
+
+			m_eventSenders.clear();
+
 			m_context.leaveRoomReturn(errorCode, errorString);
 		}
 
-		void joinRandomRoomReturn(LocalPlayerID playerID, int32 errorCode, const String& errorString)
+		void joinRandomRoomReturn(LocalPlayerID playerID, int32 errorCode, const String& errorString, const uint32 operationID)
 		{
 			m_context.debugLog(U"[Multiplayer_Photon] Multiplayer_Photon::joinRandomRoomReturn()");
 			m_context.debugLog(U"- [Multiplayer_Photon] playerID: ", playerID);
 
 			detail::LogIfError(m_context, errorCode, errorString);
 
+			completeOperation(operationID, errorCode, errorString, playerID);
+
 			m_context.joinRandomRoomReturn(playerID, errorCode, errorString);
 		}
 
-		void joinRandomOrCreateRoomReturn(LocalPlayerID playerID, int32 errorCode, const String& errorString)
+		void joinRandomOrCreateRoomReturn(LocalPlayerID playerID, int32 errorCode, const String& errorString, const uint32 operationID)
 		{
 			m_context.debugLog(U"[Multiplayer_Photon] Multiplayer_Photon::joinRandomOrCreateRoomReturn()");
 			m_context.debugLog(U"- [Multiplayer_Photon] playerID: ", playerID);
 
 			detail::LogIfError(m_context, errorCode, errorString);
 
+			completeOperation(operationID, errorCode, errorString, playerID);
+
 			m_context.joinRandomOrCreateRoomReturn(playerID, errorCode, errorString);
 		}
 
-		void joinRoomReturn(LocalPlayerID playerID, int32 errorCode, const String& errorString)
+		void joinRoomReturn(LocalPlayerID playerID, int32 errorCode, const String& errorString, const uint32 operationID)
 		{
 			m_context.debugLog(U"[Multiplayer_Photon] Multiplayer_Photon::joinRoomReturn()");
 			m_context.debugLog(U"- [Multiplayer_Photon] playerID: ", playerID);
 
 			detail::LogIfError(m_context, errorCode, errorString);
 
+			completeOperation(operationID, errorCode, errorString, playerID);
+
 			m_context.joinRoomReturn(playerID, errorCode, errorString);
 		}
 
-		void joinOrCreateRoomReturn(LocalPlayerID playerID, int32 errorCode, const String& errorString)
+		void joinOrCreateRoomReturn(LocalPlayerID playerID, int32 errorCode, const String& errorString, const uint32 operationID)
 		{
 			m_context.debugLog(U"[Multiplayer_Photon] Multiplayer_Photon::joinOrCreateRoomReturn()");
 			m_context.debugLog(U"- [Multiplayer_Photon] playerID: ", playerID);
 
 			detail::LogIfError(m_context, errorCode, errorString);
 
+			completeOperation(operationID, errorCode, errorString, playerID);
+
 			m_context.joinRoomReturn(playerID, errorCode, errorString);
 		}
 
-		void createRoomReturn(LocalPlayerID playerID, int32 errorCode, const String& errorString)
+		void createRoomReturn(LocalPlayerID playerID, int32 errorCode, const String& errorString, const uint32 operationID)
 		{
 			m_context.debugLog(U"[Multiplayer_Photon] Multiplayer_Photon::createRoomReturn()");
 			m_context.debugLog(U"- [Multiplayer_Photon] playerID: ", playerID);
 
 			detail::LogIfError(m_context, errorCode, errorString);
 
+			completeOperation(operationID, errorCode, errorString, playerID);
+
 			m_context.createRoomReturn(playerID, errorCode, errorString);
 		}
 
@@ -356,25 +920,105 @@ namespace s3d
 			m_context.leaveRoomEventAction(playerID, isSuspended);
 		}
 
-		void customEventAction(LocalPlayerID playerID, uint8 eventCode, char* message)
-		{
-			Blob blob = Base64::Decode(message, s3d::SkipValidation::Yes);
+		void customEventAction(LocalPlayerID playerID, uint8 eventCode, char* message)
+		{
+			auto& senders = m_eventSenders[eventCode];
+
+			if (message[0] == detail::CacheReplayEventPrefix)
+			{
+				// 圧縮でキャッシュに追加し直されたイベントは、同じ送信者から受信済みであれば重複になる
+				if (senders.contains(playerID))
+				{
+					m_context.debugLog(U"[Multiplayer_Photon] Dropped a compacted event cache already received (playerID: {}, eventCode: {})"_fmt(playerID, eventCode));
+					return;
+				}
+
+				++message;
+			}
+
+			senders.insert(playerID);
+
+			// 固定レイアウトイベントと BitPacked イベントは Base64 に含まれない文字を先頭に付けて送信される
+			const bool isFixedLayout = (message[0] == detail::FixedLayoutEventPrefix);
+			const bool isBitPacked = (message[0] == detail::BitPackedEventPrefix);
+
+			Base64::Decode(std::string_view{ (isFixedLayout or isBitPacked) ? (message + 1) : message }, m_receiveBuffer, s3d::SkipValidation::Yes);
+
+			const Byte* data = m_receiveBuffer.data();
+			size_t size = m_receiveBuffer.size();
+			uint32 layoutHash = 0;
+
+			if (isFixedLayout)
+			{
+				if (size < sizeof(layoutHash))
+				{
+					m_context.debugLog(U"[Multiplayer_Photon] Dropped a broken fixed layout event");
+					m_context.debugLog(U"- [Multiplayer_Photon] playerID: ", playerID);
+					m_context.debugLog(U"- [Multiplayer_Photon] eventCode: ", eventCode);
+					m_context.debugLog(U"- [Multiplayer_Photon] data: ", size, U" bytes");
+					return;
+				}
+
+				std::memcpy(&layoutHash, data, sizeof(layoutHash));
+				data += sizeof(layoutHash);
+				size -= sizeof(layoutHash);
+			}
+
+			const StringView encoding = (isFixedLayout ? U" bytes (fixed layout)" : isBitPacked ? U" bytes (bit-packed)" : U" bytes (serialized)");
 
-			Deserializer<MemoryViewReader> reader{blob.data(), blob.size()};
+			if (auto it = m_context.m_table.find(eventCode); it != m_context.m_table.end()) {
+				const auto& receiver = it->second;
 
-			if (m_context.m_table.contains(eventCode)) {
 				m_context.debugLog(U"[Multiplayer_Photon] MultiplayerEvent received (dispatched to registered event handler)");
 				m_context.debugLog(U"- [Multiplayer_Photon] playerID: ", playerID);
 				m_context.debugLog(U"- [Multiplayer_Photon] eventCode: ", eventCode);
-				m_context.debugLog(U"- [Multiplayer_Photon] data: ", blob.size(), U" bytes (serialized)");
-				auto& receiver = m_context.m_table[eventCode];
-				(receiver.second)(m_context, receiver.first, playerID, reader);
+				m_context.debugLog(U"- [Multiplayer_Photon] data: ", size, encoding);
+
+				if (isBitPacked)
+				{
+					if (not receiver.bitPackedWrapper)
+					{
+						m_context.debugLog(U"[Multiplayer_Photon] Dropped a bit-packed event for a callback that cannot receive it");
+						return;
+					}
+
+					(receiver.bitPackedWrapper)(m_context, receiver.callback, playerID, data, size);
+					return;
+				}
+
+				if (isFixedLayout)
+				{
+					if ((not receiver.fixedLayoutWrapper) or (receiver.layoutHash != layoutHash) or (receiver.layoutSize != size))
+					{
+						// 送信側と引数の型が異なるイベントは破棄する
+						m_context.debugLog(U"[Multiplayer_Photon] Dropped a fixed layout event with mismatched layout");
+						m_context.debugLog(U"- [Multiplayer_Photon] layoutHash: {:#x} (expected: {:#x})"_fmt(layoutHash, receiver.layoutHash));
+						m_context.debugLog(U"- [Multiplayer_Photon] size: {} (expected: {})"_fmt(size, receiver.layoutSize));
+						return;
+					}
+
+					(receiver.fixedLayoutWrapper)(m_context, receiver.callback, playerID, data, size);
+					return;
+				}
+
+				(receiver.wrapper)(m_context, receiver.callback, playerID, data, size);
+			}
+			else if (isBitPacked) {
+				BitPackedDeserializer reader{ data, size };
+
+				m_context.debugLog(U"[Multiplayer_Photon] Multiplayer_Photon::bitPackedEventAction(BitPackedDeserializer)");
+				m_context.debugLog(U"- [Multiplayer_Photon] playerID: ", playerID);
+				m_context.debugLog(U"- [Multiplayer_Photon] eventCode: ", eventCode);
+				m_context.debugLog(U"- [Multiplayer_Photon] data: ", size, encoding);
+				m_context.bitPackedEventAction(playerID, eventCode, reader);
 			}
 			else {
+				Deserializer<MemoryViewReader> reader{ data, size };
+
 				m_context.debugLog(U"[Multiplayer_Photon] Multiplayer_Photon::customEventAction(Deserializer<MemoryReader>)");
 				m_context.debugLog(U"- [Multiplayer_Photon] playerID: ", playerID);
 				m_context.debugLog(U"- [Multiplayer_Photon] eventCode: ", eventCode);
-				m_context.debugLog(U"- [Multiplayer_Photon] data: ", blob.size(), U" bytes (serialized)");
+				m_context.debugLog(U"- [Multiplayer_Photon] data: ", size, encoding);
 				m_context.customEventAction(playerID, eventCode, reader);
 			}
 		}
@@ -421,18 +1065,6 @@ static Multiplayer_Photon::PhotonDetail* g_detail = nullptr;
 // [WEB] extern C callback functions
 namespace s3d::detail
 {
-	enum class PhotonCallbackCode : uint8 {
-    	ConnectionErrorReturn = 1,
-    	ConnectReturn = 11,
-    	DisconnectReturn = 12,
-    	LeaveRoomReturn = 21,
-    	JoinRandomRoomReturn = 22,
-    	JoinRandomOrCreateRoomReturn = 23,
-    	JoinRoomReturn = 24,
-        JoinOrCreateRoomReturn = 25,
-    	CreateRoomReturn = 26,
-	};
-
 	extern "C"
 	{
 		__attribute__((used, export_name("siv3dPhotonGetRoomListCallback")))
@@ -469,7 +1101,7 @@ namespace s3d::detail
 		}
 
 		__attribute__((used, export_name("siv3dPhotonGeneralCallback")))
-		void siv3dPhotonGeneralCallback(uint8 callback, int32 errorCode, char32* errorString_, LocalPlayerID player)
+		void siv3dPhotonGeneralCallback(uint8 callback, int32 errorCode, char32* errorString_, LocalPlayerID player, uint32 operationID, uint32 lastOperationID)
 		{
 			if (not g_detail) return;
 
@@ -480,31 +1112,31 @@ namespace s3d::detail
 				switch (static_cast<PhotonCallbackCode>(callback))
 				{
 				case PhotonCallbackCode::ConnectionErrorReturn:
-					g_detail->connectionErrorReturn(errorCode);
+					g_detail->connectionErrorReturn(errorCode, lastOperationID);
 					break;
 				case PhotonCallbackCode::ConnectReturn:
-					g_detail->connectReturn(errorCode, errorString);
+					g_detail->connectReturn(errorCode, errorString, operationID);
 					break;
 				case PhotonCallbackCode::DisconnectReturn:
-					g_detail->disconnectReturn();
+					g_detail->disconnectReturn(operationID, lastOperationID);
 					break;
 				case PhotonCallbackCode::LeaveRoomReturn:
-					g_detail->leaveRoomReturn(errorCode, errorString);
+					g_detail->leaveRoomReturn(errorCode, errorString, operationID);
 					break;
 				case PhotonCallbackCode::JoinRandomRoomReturn:
-					g_detail->joinRandomRoomReturn(player, errorCode, errorString);
+					g_detail->joinRandomRoomReturn(player, errorCode, errorString, operationID);
 					break;
 				case PhotonCallbackCode::JoinRandomOrCreateRoomReturn:
-					g_detail->joinRandomOrCreateRoomReturn(player, errorCode, errorString);
+					g_detail->joinRandomOrCreateRoomReturn(player, errorCode, errorString, operationID);
 					break;
 				case PhotonCallbackCode::JoinRoomReturn:
-					g_detail->joinRoomReturn(player, errorCode, errorString);
+					g_detail->joinRoomReturn(player, errorCode, errorString, operationID);
 					break;
 				case PhotonCallbackCode::JoinOrCreateRoomReturn:
-					g_detail->joinOrCreateRoomReturn(player, errorCode, errorString);
+					g_detail->joinOrCreateRoomReturn(player, errorCode, errorString, operationID);
 					break;
 				case PhotonCallbackCode::CreateRoomReturn:
-					g_detail->createRoomReturn(player, errorCode, errorString);
+					g_detail->createRoomReturn(player, errorCode, errorString, operationID);
 					break;
 				};
 			}
@@ -512,6 +1144,14 @@ namespace s3d::detail
 			free(errorString_);
 		}
 
+		__attribute__((used, export_name("siv3dPhotonBackgroundServiceCallback")))
+		void siv3dPhotonBackgroundServiceCallback()
+		{
+			if (not g_detail) return;
+
+			g_detail->backgroundService();
+		}
+
 		__attribute__((used, export_name("siv3dPhotonClientStateChangeCallback")))
 		void siv3dPhotonClientStateChangeCallback(int32 state)
 		{
@@ -741,6 +1381,14 @@ namespace s3d::detail
 			}
 		}
 	}
+
+	/// @brief 非同期操作のリクエストを送信できたかを返します。
+	template <class Result>
+	[[nodiscard]]
+	static bool IsRequested(const MultiplayerOperation<Result>& operation)
+	{
+		return (operation.result().status != MultiplayerOperationStatus::Failed);
+	}
 }
 
 // [Common] RoomCreateOption, TargetGroup, MultiplayerEvent
@@ -929,6 +1577,12 @@ namespace s3d {
 	Multiplayer_Photon::~Multiplayer_Photon()
 	{
 		disconnect();
+
+		if (m_detail)
+		{
+			m_detail->setBackgroundService(none);
+		}
+
 		g_detail = nullptr;
 	}
 
@@ -967,10 +1621,23 @@ namespace s3d
 		m_verbose	= verbose.getBool();
 
 		detail::siv3dPhotonInitClient(m_secretPhotonAppID.data(), m_photonAppVersion.data(), m_verbose, static_cast<uint8>(protocol));
+
+		m_detail->m_tickRate = m_tickRate;
+		m_detail->setBackgroundService(m_tickRate.backgroundServiceInterval);
 	}
 
 	bool Multiplayer_Photon::connect(const StringView userName, const Optional<String>& region)
 	{
+		return detail::IsRequested(connectAsync(userName, region));
+	}
+
+	MultiplayerOperation<MultiplayerResult> Multiplayer_Photon::connectAsync(const StringView userName, const Optional<String>& region, const Duration& timeout)
+	{
+		if (not m_detail)
+		{
+			return{};
+		}
+
 		m_requestedRegion = region;
 
 		if (region)
@@ -980,17 +1647,6 @@ namespace s3d
 			m_detail->m_localPlayer.userID = userID;
 
 			setUserName(userName);
-
-			bool result = detail::siv3dPhotonConnect(getUserID().data(), region.value().data());
-
-			if (not result)
-			{
-				if (m_verbose)
-				{
-					debugLog(U"[Multiplayer_Photon] ConnectToNameServer failed.");
-				}	
-				return false;
-			}
 		}
 		else
 		{
@@ -998,18 +1654,60 @@ namespace s3d
 			{
 				debugLog(U"[Multiplayer_Photon] Region must be specified");
 			}
-			return false;
+			return MultiplayerOperation<MultiplayerResult>{ m_detail->rejectOperation(detail::PhotonCallbackCode::ConnectReturn, timeout) };
+		}
+
+		// 接続前に切断するため、実行中の操作は切断により失敗する
+		auto operation = m_detail->beginOperation(detail::PhotonCallbackCode::ConnectReturn, timeout, [&](const uint32 operationID)
+			{
+				return detail::siv3dPhotonConnect(getUserID().data(), region.value().data(), operationID);
+			});
+
+		if (operation->result.status == MultiplayerOperationStatus::Failed)
+		{
+			if (m_verbose)
+			{
+				debugLog(U"[Multiplayer_Photon] ConnectToNameServer failed.");
+			}
+			return MultiplayerOperation<MultiplayerResult>{ std::move(operation) };
 		}
 
 		m_detail->m_clientState = ClientState::ConnectingToLobby;
 
-		return true;
+		return MultiplayerOperation<MultiplayerResult>{ std::move(operation) };
 	}
 
 	void Multiplayer_Photon::disconnect()
 	{
-		detail::siv3dPhotonDisconnect();
+		(void)disconnectAsync();
+	}
+
+	MultiplayerOperation<MultiplayerResult> Multiplayer_Photon::disconnectAsync(const Duration& timeout)
+	{
+		if (not m_detail)
+		{
+			return{};
+		}
+
+		// 既に切断されている場合は状態が変化せず通知も来ないため、すぐに成功させる
+		if (isDisconnected())
+		{
+			auto operation = m_detail->rejectOperation(detail::PhotonCallbackCode::DisconnectReturn, timeout);
+			operation->result.status = MultiplayerOperationStatus::Succeeded;
+			operation->result.errorString.clear();
+			return MultiplayerOperation<MultiplayerResult>{ std::move(operation) };
+		}
+
+		// 実行中の操作は切断により失敗する
+		auto operation = m_detail->beginOperation(detail::PhotonCallbackCode::DisconnectReturn, timeout, [](const uint32 operationID)
+			{
+				detail::siv3dPhotonDisconnect(operationID);
+				return true;
+			});
+
 		detail::siv3dPhotonService();
+
+		return MultiplayerOperation<MultiplayerResult>{ std::move(operation) };
 	}
 
 	void Multiplayer_Photon::update()
@@ -1019,7 +1717,28 @@ namespace s3d
 			return;
 		}
 
-		detail::siv3dPhotonService();
+		m_detail->tick();
+	}
+
+	void Multiplayer_Photon::setTickRate(const NetworkTickRate& tickRate)
+	{
+		m_tickRate = tickRate;
+
+		if (not m_detail)
+		{
+			return;
+		}
+
+		m_detail->m_tickRate = tickRate;
+		m_detail->m_serviceAccumulator = 0.0;
+		m_detail->m_sendAccumulator = 0.0;
+
+		m_detail->setBackgroundService(tickRate.backgroundServiceInterval);
+	}
+
+	NetworkTickRate Multiplayer_Photon::getTickRate() const
+	{
+		return m_tickRate;
 	}
 
 	bool Multiplayer_Photon::isActive() const noexcept
@@ -1102,127 +1821,142 @@ namespace s3d
 
 	bool Multiplayer_Photon::joinRandomRoom(const int32 expectedMaxPlayers, MatchmakingMode matchmakingMode)
 	{
-		if (not m_detail)
-		{
-			return false;
-		}
-
-		if (not InRange(expectedMaxPlayers, 0, 255))
-		{
-			return false;
-		}
-
-		return m_detail->joinRandomRoom(expectedMaxPlayers, matchmakingMode, U"{}");
+		return detail::IsRequested(joinRandomRoomAsync(expectedMaxPlayers, matchmakingMode));
 	}
 
 	bool Multiplayer_Photon::joinRandomRoom(const RoomPropertyTable& propertyFilter, int32 expectedMaxPlayers, MatchmakingMode matchmakingMode)
+	{
+		return detail::IsRequested(joinRandomRoomAsync(propertyFilter, expectedMaxPlayers, matchmakingMode));
+	}
+
+	bool Multiplayer_Photon::joinRandomOrCreateRoom(const int32 maxPlayers, const RoomNameView roomName)
 	{
 		if (not m_detail)
 		{
 			return false;
 		}
 
-		if (not InRange(expectedMaxPlayers, 0, 255))
-		{
-			return false;
-		}
+		return detail::IsRequested(MultiplayerOperation<JoinRoomResult>{ m_detail->joinRandomOrCreateRoom(roomName, U"{}", U"{}", maxPlayers, MatchmakingMode::FillOldestRoom, DefaultOperationTimeout) });
+	}
 
-		return m_detail->joinRandomRoom(expectedMaxPlayers, matchmakingMode, detail::PropertyTableToJSON(propertyFilter));
+	bool Multiplayer_Photon::joinRandomOrCreateRoom(RoomNameView roomName, const RoomCreateOption& roomCreateOption, const RoomPropertyTable& propertyFilter, int32 expectedMaxPlayers, MatchmakingMode matchmakingMode)
+	{
+		return detail::IsRequested(joinRandomOrCreateRoomAsync(roomName, roomCreateOption, propertyFilter, expectedMaxPlayers, matchmakingMode));
 	}
 
-	bool Multiplayer_Photon::joinRandomOrCreateRoom(const int32 maxPlayers, const RoomNameView roomName)
+	bool Multiplayer_Photon::joinOrCreateRoom(RoomNameView roomName, const RoomCreateOption& option)
 	{
-		if (not m_detail)
-		{
-			return false;
-		}
+		return detail::IsRequested(joinOrCreateRoomAsync(roomName, option));
+	}
+
+	bool Multiplayer_Photon::joinRoom(const RoomNameView roomName)
+	{
+		return detail::IsRequested(joinRoomAsync(roomName));
+	}
 
+	bool Multiplayer_Photon::createRoom(const RoomNameView roomName, const int32 maxPlayers)
+	{
 		if (not InRange(maxPlayers, 0, 255))
 		{
 			return false;
 		}
 
-		return m_detail->joinRandomOrCreateRoom(roomName, U"{}", U"{}", maxPlayers, MatchmakingMode::FillOldestRoom);
+		return detail::IsRequested(createRoomAsync(roomName, RoomCreateOption().maxPlayers(maxPlayers)));
 	}
 
-	bool Multiplayer_Photon::joinRandomOrCreateRoom(RoomNameView roomName, const RoomCreateOption& roomCreateOption, const RoomPropertyTable& propertyFilter, int32 expectedMaxPlayers, MatchmakingMode matchmakingMode)
+	bool Multiplayer_Photon::createRoom(RoomNameView roomName, const RoomCreateOption& option)
 	{
-		if (not m_detail)
-		{
-			return false;
-		}
+		return detail::IsRequested(createRoomAsync(roomName, option));
+	}
+
+	void Multiplayer_Photon::leaveRoom(bool willComeBack)
+	{
+		(void)leaveRoomAsync(willComeBack);
+	}
+	
+	bool Multiplayer_Photon::reconnectAndRejoin()
+	{
+		return detail::IsRequested(reconnectAndRejoinAsync());
+	}
 
-		if (not InRange(expectedMaxPlayers, 0, 255))
+	MultiplayerOperation<JoinRoomResult> Multiplayer_Photon::reconnectAndRejoinAsync(const Duration& timeout)
+	{
+		if (not m_detail)
 		{
-			return false;
+			return{};
 		}
 
-		return m_detail->joinRandomOrCreateRoom(roomName, detail::RoomCreateOptionToJSON(roomCreateOption), detail::PropertyTableToJSON(propertyFilter), expectedMaxPlayers, matchmakingMode);
+		return MultiplayerOperation<JoinRoomResult>{ m_detail->reconnectAndRejoin(timeout) };
 	}
 
-	bool Multiplayer_Photon::joinOrCreateRoom(RoomNameView roomName, const RoomCreateOption& option)
+	MultiplayerOperation<JoinRoomResult> Multiplayer_Photon::joinRandomRoomAsync(const int32 expectedMaxPlayers, const MatchmakingMode matchmakingMode, const Duration& timeout)
 	{
 		if (not m_detail)
 		{
-			return false;
+			return{};
 		}
 
-		return m_detail->joinOrCreateRoom(roomName, detail::RoomCreateOptionToJSON(option));
+		return MultiplayerOperation<JoinRoomResult>{ m_detail->joinRandomRoom(expectedMaxPlayers, matchmakingMode, U"{}", timeout) };
 	}
 
-	bool Multiplayer_Photon::joinRoom(const RoomNameView roomName)
+	MultiplayerOperation<JoinRoomResult> Multiplayer_Photon::joinRandomRoomAsync(const RoomPropertyTable& propertyFilter, const int32 expectedMaxPlayers, const MatchmakingMode matchmakingMode, const Duration& timeout)
 	{
 		if (not m_detail)
 		{
-			return false;
+			return{};
 		}
 
-		return m_detail->joinRoom(roomName, false);
+		return MultiplayerOperation<JoinRoomResult>{ m_detail->joinRandomRoom(expectedMaxPlayers, matchmakingMode, detail::PropertyTableToJSON(propertyFilter), timeout) };
 	}
 
-	bool Multiplayer_Photon::createRoom(const RoomNameView roomName, const int32 maxPlayers)
+	MultiplayerOperation<JoinRoomResult> Multiplayer_Photon::joinRandomOrCreateRoomAsync(const RoomNameView roomName, const RoomCreateOption& roomCreateOption, const RoomPropertyTable& propertyFilter, const int32 expectedMaxPlayers, const MatchmakingMode matchmakingMode, const Duration& timeout)
 	{
 		if (not m_detail)
 		{
-			return false;
+			return{};
 		}
 
-		if (not InRange(maxPlayers, 0, 255))
+		return MultiplayerOperation<JoinRoomResult>{ m_detail->joinRandomOrCreateRoom(roomName, detail::RoomCreateOptionToJSON(roomCreateOption), detail::PropertyTableToJSON(propertyFilter), expectedMaxPlayers, matchmakingMode, timeout) };
+	}
+
+	MultiplayerOperation<JoinRoomResult> Multiplayer_Photon::joinRoomAsync(const RoomNameView roomName, const Duration& timeout)
+	{
+		if (not m_detail)
 		{
-			return false;
+			return{};
 		}
 
-		return m_detail->createRoom(roomName, detail::RoomCreateOptionToJSON(RoomCreateOption().maxPlayers(maxPlayers)));
+		return MultiplayerOperation<JoinRoomResult>{ m_detail->joinRoom(roomName, false, timeout) };
 	}
 
-	bool Multiplayer_Photon::createRoom(RoomNameView roomName, const RoomCreateOption& option)
+	MultiplayerOperation<JoinRoomResult> Multiplayer_Photon::joinOrCreateRoomAsync(const RoomNameView roomName, const RoomCreateOption& option, const Duration& timeout)
 	{
 		if (not m_detail)
 		{
-			return false;
+			return{};
 		}
 
-		return m_detail->createRoom(roomName, detail::RoomCreateOptionToJSON(option));
+		return MultiplayerOperation<JoinRoomResult>{ m_detail->joinOrCreateRoom(roomName, detail::RoomCreateOptionToJSON(option), timeout) };
 	}
 
-	void Multiplayer_Photon::leaveRoom(bool willComeBack)
+	MultiplayerOperation<JoinRoomResult> Multiplayer_Photon::createRoomAsync(const RoomNameView roomName, const RoomCreateOption& option, const Duration& timeout)
 	{
 		if (not m_detail)
 		{
-			return;
+			return{};
 		}
 
-		m_detail->leaveRoom(willComeBack);
+		return MultiplayerOperation<JoinRoomResult>{ m_detail->createRoom(roomName, detail::RoomCreateOptionToJSON(option), timeout) };
 	}
-	
-	bool Multiplayer_Photon::reconnectAndRejoin()
+
+	MultiplayerOperation<MultiplayerResult> Multiplayer_Photon::leaveRoomAsync(const bool willComeBack, const Duration& timeout)
 	{
 		if (not m_detail)
 		{
-			return false;
+			return{};
 		}
 
-		return detail::siv3dPhotonReconnectAndRejoin();
+		return MultiplayerOperation<MultiplayerResult>{ m_detail->leaveRoom(willComeBack, timeout) };
 	}
 
 	int32 Multiplayer_Photon::getServerTimeMillisec() const
@@ -1379,17 +2113,70 @@ namespace s3d
 			return;
 		}
 
-		int32 size = static_cast<int32>(writer->size());
-		const auto src = static_cast<const void*>(writer->getBlob().data());
+		m_detail->raiseEvent(event, '\0', writer->getBlob().data(), writer->size());
+	}
 
-		std::string message{};
-		Base64::Encode(src, size, message);
+	void Multiplayer_Photon::sendFixedLayoutEvent(const MultiplayerEvent& event, const Byte* data, const size_t size)
+	{
+		if (not m_detail)
+		{
+			return;
+		}
 
-		detail::siv3dPhotonRaiseEvent(
-			event.eventCode(),
-			message.data(),
-			detail::MultiplayerEventToJSON(event).data()
-		);
+		m_detail->raiseEvent(event, detail::FixedLayoutEventPrefix, data, size);
+	}
+
+	void Multiplayer_Photon::sendEvent(const MultiplayerEvent& event, const BitPackedSerializer& writer)
+	{
+		if (not m_detail)
+		{
+			return;
+		}
+
+		m_detail->raiseEvent(event, detail::BitPackedEventPrefix, writer.data(), writer.size());
+	}
+
+	void Multiplayer_Photon::setEventEncoding(const uint8 eventCode, const EventEncoding encoding)
+	{
+		if (not InRange(static_cast<int>(eventCode), 1, 199))
+		{
+			throw Error{ U"[Multiplayer_Photon] EventCode must be in a range of 1 to 199" };
+		}
+
+		if (encoding == EventEncoding::FixedLayout)
+		{
+			if (auto it = m_table.find(eventCode); (it != m_table.end()) and (not it->second.fixedLayoutWrapper))
+			{
+				throw Error{ U"[Multiplayer_Photon] EventCode {} cannot use EventEncoding::FixedLayout because the registered callback arguments are not trivially copyable"_fmt(eventCode) };
+			}
+		}
+		else if (encoding == EventEncoding::BitPacked)
+		{
+			if (auto it = m_table.find(eventCode); (it != m_table.end()) and (not it->second.bitPackedWrapper))
+			{
+				throw Error{ U"[Multiplayer_Photon] EventCode {} cannot use EventEncoding::BitPacked because the registered callback arguments are not IsBitPackedEventArg"_fmt(eventCode) };
+			}
+		}
+
+		m_eventEncodings[eventCode] = encoding;
+	}
+
+	EventEncoding Multiplayer_Photon::getEventEncoding(const uint8 eventCode) const noexcept
+	{
+		return m_eventEncodings[eventCode];
+	}
+
+	void Multiplayer_Photon::checkFixedLayoutEvent(const uint8 eventCode, const uint32 layoutHash) const
+	{
+		if (layoutHash == 0)
+		{
+			throw Error{ U"[Multiplayer_Photon] EventCode {} uses EventEncoding::FixedLayout, but the event arguments are not trivially copyable"_fmt(eventCode) };
+		}
+
+		if (auto it = m_table.find(eventCode); (it != m_table.end()) and (it->second.layoutHash != layoutHash))
+		{
+			throw Error{ U"[Multiplayer_Photon] EventCode {} was sent with arguments that do not match the registered callback (layoutHash: {:#x}, expected: {:#x})"_fmt(eventCode, layoutHash, it->second.layoutHash) };
+		}
 	}
 }
 
@@ -1403,9 +2190,9 @@ namespace s3d
 			return;
 		}
 
-		if (not InRange(static_cast<int>(eventCode), 1, 199))
+		if (not InRange(static_cast<int>(eventCode), 0, 199))
 		{
-			throw Error{ U"[Multiplayer_Photon] EventCode must be in a range of 1 to 199" };
+			throw Error{ U"[Multiplayer_Photon] EventCode must be in a range of 0 to 199" };
 		}
 
 		detail::siv3dPhotonRaiseEvent(
@@ -1413,6 +2200,8 @@ namespace s3d
 			nullptr,
 			detail::MultiplayerEventToJSON(detail::EventCaching::RemoveFromRoomCache).data()
 		);
+
+		m_detail->eraseEventCacheRecords(eventCode, false);
 	}
 
 	void Multiplayer_Photon::removeEventCache(uint8 eventCode, const Array<LocalPlayerID>& targets)
@@ -1422,9 +2211,9 @@ namespace s3d
 			return;
 		}
 
-		if (not InRange(static_cast<int>(eventCode), 1, 199))
+		if (not InRange(static_cast<int>(eventCode), 0, 199))
 		{
-			throw Error{ U"[Multiplayer_Photon] EventCode must be in a range of 1 to 199" };
+			throw Error{ U"[Multiplayer_Photon] EventCode must be in a range of 0 to 199" };
 		}
 
 		detail::siv3dPhotonRaiseEvent(
@@ -1432,6 +2221,59 @@ namespace s3d
 			nullptr,
 			detail::MultiplayerEventToJSON(detail::EventCaching::RemoveFromRoomCache, targets).data()
 		);
+
+		// ReceiverOption::○○○_CacheForever のイベントはプレイヤーに紐づかないため削除されない
+		if (targets.contains(getLocalPlayerID()))
+		{
+			m_detail->eraseEventCacheRecords(eventCode, true);
+		}
+	}
+
+	void Multiplayer_Photon::setEventCacheCompaction(const uint8 eventCode, const Optional<EventCacheCompaction>& compaction)
+	{
+		if (not m_detail)
+		{
+			return;
+		}
+
+		if (not InRange(static_cast<int>(eventCode), 1, 199))
+		{
+			throw Error{ U"[Multiplayer_Photon] EventCode must be in a range of 1 to 199" };
+		}
+
+		if (compaction)
+		{
+			m_detail->m_eventCacheCompactions.insert_or_assign(eventCode, *compaction);
+		}
+		else
+		{
+			m_detail->m_eventCacheCompactions.erase(eventCode);
+		}
+	}
+
+	void Multiplayer_Photon::compactEventCache(const uint8 eventCode)
+	{
+		if (not m_detail)
+		{
+			return;
+		}
+
+		if (not InRange(static_cast<int>(eventCode), 1, 199))
+		{
+			throw Error{ U"[Multiplayer_Photon] EventCode must be in a range of 1 to 199" };
+		}
+
+		m_detail->compactEventCache(eventCode);
+	}
+
+	EventCacheSize Multiplayer_Photon::getEventCacheSize(const uint8 eventCode) const
+	{
+		if (not m_detail)
+		{
+			return{};
+		}
+
+		return m_detail->getEventCacheSize(eventCode);
 	}
 
 	LocalPlayer Multiplayer_Photon::getLocalPlayer() const
@@ -1726,6 +2568,12 @@ namespace s3d
 	template<>
 	void Multiplayer_Photon::sendEvent<>(const MultiplayerEvent& event)
 	{
+		if (getEventEncoding(event.eventCode()) == EventEncoding::BitPacked)
+		{
+			sendEvent(event, BitPackedSerializer{});
+			return;
+		}
+
 		sendEvent(event, Serializer<MemoryWriter> {});
 	}
 	
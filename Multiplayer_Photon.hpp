@@ -17,7 +17,9 @@
 //-----------------------------------------------
 
 # pragma once
+# include <coroutine>
 # include <Siv3D.hpp>
+# include "BitPackedSerializer.hpp"
 
 # if SIV3D_PLATFORM(WINDOWS)
 #	if SIV3D_BUILD(DEBUG)
@@ -223,6 +225,65 @@ namespace s3d
 		Host,
 	};
 
+	/// @brief イベントの送信エンコーディング
+	enum class EventEncoding : uint8
+	{
+		/// @brief 既定のエンコーディング（cereal）
+		Default,
+
+		/// @brief 固定レイアウト（引数をメモリコピーで送信。すべての引数がトリビアルコピー可能である必要があります）
+		/// @remark 受信側も同じ引数型で RegisterEventCallback() している必要があります。
+		FixedLayout,
+
+		/// @brief BitPackedSerializer によるビット単位のエンコーディング
+		BitPacked,
+	};
+
+	/// @brief イベントキャッシュを自動で圧縮する条件。いずれかを超えると圧縮されます。
+	struct EventCacheCompaction
+	{
+		/// @brief キャッシュされたイベントの数の上限（0 の場合は無制限）
+		size_t maxEvents = 0;
+
+		/// @brief キャッシュされたデータの合計サイズ（バイト）の上限（0 の場合は無制限）
+		size_t maxBytes = 0;
+
+		/// @brief 最も古いキャッシュされたイベントの経過時間の上限（none の場合は無制限）
+		Optional<Duration> maxAge;
+	};
+
+	/// @brief 自身が送信してキャッシュされているイベントの大きさ
+	struct EventCacheSize
+	{
+		/// @brief キャッシュされたイベントの数
+		size_t events = 0;
+
+		/// @brief キャッシュされたデータの合計サイズ（バイト）
+		size_t bytes = 0;
+
+		/// @brief 最も古いキャッシュされたイベントの経過時間
+		Duration age{ 0.0 };
+	};
+
+	/// @brief Multiplayer_Photon::update() の通信頻度の設定
+	struct NetworkTickRate
+	{
+		/// @brief 受信したイベントなどを処理する頻度（回/秒）。0 の場合は update() のたびに処理します。
+		double serviceRate = 0.0;
+
+		/// @brief onSendTick() を呼ぶ頻度（回/秒）。0 の場合は update() のたびに 1 回呼びます。
+		double sendRate = 0.0;
+
+		/// @brief 1 回の update() で onSendTick() を呼ぶ最大回数。これを超えた遅れは切り捨てられます。
+		int32 maxTicksPerUpdate = 4;
+
+		/// @brief ページが非表示で update() が呼ばれない間に、タイマーでイベントキャッシュの圧縮を続ける間隔。none の場合は続けません。
+		/// @remark Web 版でのみ有効です。
+		/// @remark 非表示の間に受信したイベントや操作の結果は、次の update() の中でまとめて通知されます（タイマーからコールバックが呼ばれることはありません）。
+		/// @remark 非表示のページのタイマーはブラウザによって 1 秒に 1 回以上の間隔に制限され、強い制限がかかると 1 分に 1 回になるため、一定の頻度で実行されるティックではありません。
+		Optional<Duration> backgroundServiceInterval = SecondsF{ 0.5 };
+	};
+
 	/// @brief イベントターゲットグループを指定するためのクラス
 	class TargetGroup
 	{
@@ -307,14 +368,433 @@ namespace s3d
 		Disconnecting,
 	};
 
+	/// @brief 非同期操作の状態
+	enum class MultiplayerOperationStatus : uint8
+	{
+		/// @brief 結果を待っている
+		Pending,
+
+		/// @brief 成功した
+		Succeeded,
+
+		/// @brief サーバからエラーが返された、またはリクエストを送信できなかった
+		Failed,
+
+		/// @brief 結果が返る前にタイムアウトした
+		TimedOut,
+	};
+
+	/// @brief 非同期操作の結果
+	struct MultiplayerResult
+	{
+		/// @brief 操作の状態
+		MultiplayerOperationStatus status = MultiplayerOperationStatus::Pending;
+
+		/// @brief サーバから返されたエラーコード。サーバからの応答が無い場合は 0
+		int32 errorCode = 0;
+
+		/// @brief エラー文字列
+		String errorString;
+
+		/// @brief 操作が成功したかを返します。
+		/// @return 操作が成功した場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool succeeded() const noexcept
+		{
+			return (status == MultiplayerOperationStatus::Succeeded);
+		}
+
+		[[nodiscard]]
+		explicit operator bool() const noexcept
+		{
+			return succeeded();
+		}
+	};
+
+	/// @brief ルームへの参加・作成の非同期操作の結果
+	struct JoinRoomResult : MultiplayerResult
+	{
+		/// @brief ルーム内の自身のローカルプレイヤー ID
+		LocalPlayerID playerID = 0;
+	};
+
+	namespace detail
+	{
+		/// @brief 結果を待っている非同期操作
+		struct PendingOperation
+		{
+			/// @brief 操作の通し番号
+			uint64 id = 0;
+
+			/// @brief 操作の完了を通知するコールバックのコード
+			uint8 callbackCode = 0;
+
+			/// @brief タイムアウトする時刻（Time::GetMillisec() 基準）
+			uint64 deadlineMillisec = 0;
+
+			JoinRoomResult result;
+
+			/// @brief 結果を待っているコルーチン
+			std::coroutine_handle<> continuation;
+		};
+	}
+
+	/// @brief co_await で結果を待つことのできる Multiplayer_Photon の非同期操作
+	/// @tparam Result 結果の型
+	/// @remark 結果は Multiplayer_Photon::update() の中で通知され、結果を待っているコルーチンもそこで再開されます。
+	/// @remark 操作の結果を待っている間に別の操作を開始すると、その操作は失敗します。ただし connectAsync() と disconnectAsync() は開始でき、結果を待っていた操作は切断により失敗します。
+	/// @remark サーバからの応答は操作ごとの ID で対応付けられるため、タイムアウトした操作の応答が遅れて届いても後の操作の結果にはなりません。
+	template <class Result>
+	class MultiplayerOperation
+	{
+	public:
+
+		static_assert(std::is_base_of_v<MultiplayerResult, Result> and std::is_base_of_v<Result, JoinRoomResult>);
+
+		SIV3D_NODISCARD_CXX20
+		MultiplayerOperation() = default;
+
+		SIV3D_NODISCARD_CXX20
+		explicit MultiplayerOperation(std::shared_ptr<detail::PendingOperation> state) noexcept
+			: m_state{ std::move(state) } {}
+
+		SIV3D_NODISCARD_CXX20
+		MultiplayerOperation(MultiplayerOperation&& other) noexcept
+			: m_state{ std::move(other.m_state) }
+			, m_awaiting{ std::exchange(other.m_awaiting, false) } {}
+
+		MultiplayerOperation& operator =(MultiplayerOperation&&) = delete;
+
+		~MultiplayerOperation()
+		{
+			// 結果を待っているコルーチンが先に破棄された場合、再開されないようにする
+			if (m_awaiting and m_state)
+			{
+				m_state->continuation = nullptr;
+			}
+		}
+
+		/// @brief 結果が確定しているかを返します。
+		/// @return 結果が確定している場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isReady() const noexcept
+		{
+			return ((not m_state) or (m_state->result.status != MultiplayerOperationStatus::Pending));
+		}
+
+		/// @brief 操作の結果を返します。
+		/// @return 操作の結果。結果が確定していない場合は status が MultiplayerOperationStatus::Pending
+		[[nodiscard]]
+		Result result() const
+		{
+			if (not m_state)
+			{
+				Result failed;
+				failed.status = MultiplayerOperationStatus::Failed;
+				return failed;
+			}
+
+			return static_cast<const Result&>(m_state->result);
+		}
+
+		[[nodiscard]]
+		bool await_ready() const noexcept
+		{
+			return isReady();
+		}
+
+		void await_suspend(std::coroutine_handle<> continuation) noexcept
+		{
+			m_state->continuation = continuation;
+			m_awaiting = true;
+		}
+
+		[[nodiscard]]
+		Result await_resume()
+		{
+			m_awaiting = false;
+			return result();
+		}
+
+	private:
+
+		std::shared_ptr<detail::PendingOperation> m_state;
+
+		bool m_awaiting = false;
+	};
+
+	/// @brief Multiplayer_Photon の非同期操作を co_await するコルーチンの戻り値の型
+	/// @remark コルーチンは呼び出されるとすぐに実行を開始します。MultiplayerTask を破棄すると、中断中のコルーチンも破棄されます。
+	/// @remark コルーチン内で送出された例外は、コルーチンを再開した Multiplayer_Photon::update() から送出されます。
+	class MultiplayerTask
+	{
+	public:
+
+		struct promise_type
+		{
+			[[nodiscard]]
+			MultiplayerTask get_return_object() noexcept
+			{
+				return MultiplayerTask{ std::coroutine_handle<promise_type>::from_promise(*this) };
+			}
+
+			std::suspend_never initial_suspend() const noexcept { return{}; }
+
+			std::suspend_always final_suspend() const noexcept { return{}; }
+
+			void return_void() const noexcept {}
+
+			void unhandled_exception() const
+			{
+				throw;
+			}
+		};
+
+		SIV3D_NODISCARD_CXX20
+		MultiplayerTask() = default;
+
+		SIV3D_NODISCARD_CXX20
+		MultiplayerTask(MultiplayerTask&& other) noexcept
+			: m_handle{ std::exchange(other.m_handle, nullptr) } {}
+
+		MultiplayerTask& operator =(MultiplayerTask&& other) noexcept
+		{
+			if (this != &other)
+			{
+				reset();
+				m_handle = std::exchange(other.m_handle, nullptr);
+			}
+
+			return *this;
+		}
+
+		~MultiplayerTask()
+		{
+			reset();
+		}
+
+		/// @brief コルーチンが終了しているかを返します。
+		/// @return コルーチンが終了している、または空の場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isDone() const noexcept
+		{
+			return ((not m_handle) or m_handle.done());
+		}
+
+		/// @brief コルーチンを破棄します。
+		void reset() noexcept
+		{
+			if (m_handle)
+			{
+				m_handle.destroy();
+				m_handle = nullptr;
+			}
+		}
+
+	private:
+
+		explicit MultiplayerTask(std::coroutine_handle<promise_type> handle) noexcept
+			: m_handle{ handle } {}
+
+		std::coroutine_handle<promise_type> m_handle;
+	};
+
 	class Multiplayer_Photon;
 
 	namespace detail
 	{
 		using TypeErasedCallback = void(Multiplayer_Photon::*)();
-		using CallbackWrapper = void(*)(Multiplayer_Photon&, TypeErasedCallback, LocalPlayerID, Deserializer<MemoryViewReader>&);
+		using CallbackWrapper = void(*)(Multiplayer_Photon&, TypeErasedCallback, LocalPlayerID, const Byte*, size_t);
+
+		struct CustomEventReceiver
+		{
+			TypeErasedCallback callback = nullptr;
+
+			CallbackWrapper wrapper = nullptr;
+
+			/// @brief 固定レイアウトでエンコードされたイベントを受信するためのラッパー（引数が固定レイアウトにできない場合は nullptr）
+			CallbackWrapper fixedLayoutWrapper = nullptr;
+
+			/// @brief BitPackedSerializer でエンコードされたイベントを受信するためのラッパー（引数が IsBitPackedEventArg でない場合は nullptr）
+			CallbackWrapper bitPackedWrapper = nullptr;
+
+			/// @brief 固定レイアウトイベントのレイアウトハッシュ（引数が固定レイアウトにできない場合は 0）
+			uint32 layoutHash = 0;
+
+			/// @brief 固定レイアウトイベントのデータ部分のサイズ（バイト）
+			size_t layoutSize = 0;
+		};
+
+		/// @brief cereal を経由せずにメモリコピーで送受信できる引数の型
+		template <class Type>
+		concept FixedLayoutEventArg = (std::is_trivially_copyable_v<Type>
+			and (not std::is_pointer_v<Type>)
+			and (not std::is_member_pointer_v<Type>));
+
+		/// @brief 引数がすべて FixedLayoutEventArg である場合 true
+		template <class... Args>
+		inline constexpr bool IsFixedLayoutEvent = ((0 < sizeof...(Args)) and (FixedLayoutEventArg<std::remove_cvref_t<Args>> and ...));
+
+		/// @brief 引数がすべて IsBitPackedEventArg である場合 true
+		template <class... Args>
+		inline constexpr bool IsBitPackedEvent = (IsBitPackedEventArg<std::remove_cvref_t<Args>>::value and ...);
+
+		/// @brief 固定レイアウトイベントのデータ部分のサイズ（バイト）
+		template <class... Args>
+		inline constexpr size_t FixedLayoutSize = (sizeof(std::remove_cvref_t<Args>) + ... + 0);
+
+		template <class... Args>
+		[[nodiscard]]
+		constexpr std::array<size_t, sizeof...(Args)> FixedLayoutOffsets() noexcept
+		{
+			std::array<size_t, sizeof...(Args)> offsets{};
+			size_t offset = 0, index = 0;
+			((offsets[index++] = offset, offset += sizeof(std::remove_cvref_t<Args>)), ...);
+			return offsets;
+		}
+
+		/// @brief 固定レイアウトイベントの引数に使う構造体のフィールドの型
+		/// @remark `using type = std::tuple<フィールドの型...>;` を持つように特殊化すると、構造体のフィールド構成がレイアウトハッシュに反映されます。
+		/// @remark 特殊化されていない構造体は、サイズとアラインメントのみがレイアウトハッシュに反映されます。
+		template <class Type>
+		struct FixedLayoutFields {};
+
+		template <class Type>
+		struct FixedLayoutFields<Vector2D<Type>> { using type = std::tuple<Type, Type>; };
+
+		template <class Type>
+		struct FixedLayoutFields<Vector3D<Type>> { using type = std::tuple<Type, Type, Type>; };
+
+		template <class Type>
+		struct FixedLayoutFields<Vector4D<Type>> { using type = std::tuple<Type, Type, Type, Type>; };
+
+		template <>
+		struct FixedLayoutFields<Point> { using type = std::tuple<Point::value_type, Point::value_type>; };
+
+		template <>
+		struct FixedLayoutFields<Color> { using type = std::tuple<uint8, uint8, uint8, uint8>; };
+
+		template <>
+		struct FixedLayoutFields<ColorF> { using type = std::tuple<double, double, double, double>; };
+
+		template <class Type>
+		concept HasFixedLayoutFields = requires { typename FixedLayoutFields<Type>::type; };
+
+		template <class Type>
+		inline constexpr bool IsStdArray = false;
+
+		template <class Type, size_t N>
+		inline constexpr bool IsStdArray<std::array<Type, N>> = true;
 
-		using CustomEventReceiver = std::pair<TypeErasedCallback, CallbackWrapper>;
+		template <class Type>
+		inline constexpr bool IsCharType = (std::is_same_v<Type, char> or std::is_same_v<Type, char8_t>
+			or std::is_same_v<Type, char16_t> or std::is_same_v<Type, char32_t> or std::is_same_v<Type, wchar_t>);
+
+		[[nodiscard]]
+		constexpr uint32 FixedLayoutHashCombine(uint32 hash, const char kind) noexcept
+		{
+			hash ^= static_cast<uint8>(kind);
+			hash *= 16777619u;
+			return hash;
+		}
+
+		[[nodiscard]]
+		constexpr uint32 FixedLayoutHashCombine(uint32 hash, const size_t value) noexcept
+		{
+			for (size_t i = 0; i < sizeof(uint32); ++i)
+			{
+				hash ^= static_cast<uint8>(value >> (i * 8));
+				hash *= 16777619u;
+			}
+			return hash;
+		}
+
+		template <class Type>
+		[[nodiscard]]
+		constexpr uint32 FixedLayoutKindHash(uint32 hash) noexcept;
+
+		template <class Tuple, size_t... I>
+		[[nodiscard]]
+		constexpr uint32 FixedLayoutFieldsHash(uint32 hash, std::index_sequence<I...>) noexcept
+		{
+			((hash = FixedLayoutKindHash<std::remove_cv_t<std::tuple_element_t<I, Tuple>>>(hash)), ...);
+			return hash;
+		}
+
+		/// @brief 型の種類（整数・浮動小数点数・列挙型・配列・構造体のフィールド）とサイズ、アラインメントをハッシュに加えます。
+		/// @remark 型名を使わないため、コンパイラやビルド環境が異なっても同じレイアウトの型は同じ値になります。
+		template <class Type>
+		constexpr uint32 FixedLayoutKindHash(uint32 hash) noexcept
+		{
+			if constexpr (std::is_same_v<Type, bool>)
+			{
+				hash = FixedLayoutHashCombine(hash, 'b');
+			}
+			else if constexpr (IsCharType<Type>)
+			{
+				hash = FixedLayoutHashCombine(hash, 'c');
+			}
+			else if constexpr (std::is_enum_v<Type>)
+			{
+				hash = FixedLayoutHashCombine(hash, 'e');
+				hash = FixedLayoutKindHash<std::underlying_type_t<Type>>(hash);
+			}
+			else if constexpr (std::is_integral_v<Type>)
+			{
+				hash = FixedLayoutHashCombine(hash, (std::is_signed_v<Type> ? 'i' : 'u'));
+			}
+			else if constexpr (std::is_floating_point_v<Type>)
+			{
+				hash = FixedLayoutHashCombine(hash, 'f');
+			}
+			else if constexpr (std::is_array_v<Type>)
+			{
+				hash = FixedLayoutHashCombine(hash, 'a');
+				hash = FixedLayoutHashCombine(hash, std::extent_v<Type>);
+				hash = FixedLayoutKindHash<std::remove_cv_t<std::remove_extent_t<Type>>>(hash);
+			}
+			else if constexpr (IsStdArray<Type>)
+			{
+				hash = FixedLayoutHashCombine(hash, 'a');
+				hash = FixedLayoutHashCombine(hash, std::tuple_size_v<Type>);
+				hash = FixedLayoutKindHash<typename Type::value_type>(hash);
+			}
+			else if constexpr (HasFixedLayoutFields<Type>)
+			{
+				using Fields = typename FixedLayoutFields<Type>::type;
+				hash = FixedLayoutHashCombine(hash, '{');
+				hash = FixedLayoutFieldsHash<Fields>(hash, std::make_index_sequence<std::tuple_size_v<Fields>>());
+				hash = FixedLayoutHashCombine(hash, '}');
+			}
+			else
+			{
+				hash = FixedLayoutHashCombine(hash, 'o');
+			}
+
+			hash = FixedLayoutHashCombine(hash, sizeof(Type));
+			hash = FixedLayoutHashCombine(hash, alignof(Type));
+			return hash;
+		}
+
+		/// @brief 固定レイアウトイベントのレイアウトハッシュを計算します。
+		/// @remark 引数の型の種類・フィールド構成・サイズ・アラインメントから計算されます。
+		template <class... Args>
+		[[nodiscard]]
+		constexpr uint32 FixedLayoutHash() noexcept
+		{
+			uint32 hash = 2166136261u;
+			((hash = FixedLayoutKindHash<std::remove_cvref_t<Args>>(hash)), ...);
+			return (hash == 0) ? 1 : hash;
+		}
+
+		template <class Type>
+		[[nodiscard]]
+		inline Type LoadFixedLayout(const Byte* data) noexcept
+		{
+			std::array<Byte, sizeof(Type)> bytes;
+			std::memcpy(bytes.data(), data, sizeof(Type));
+			return std::bit_cast<Type>(bytes);
+		}
 	}
 
 	/// @brief マルチプレイヤー用クラス (Photon バックエンド)
@@ -409,8 +889,19 @@ namespace s3d
 
 		/// @brief サーバーと同期します。
 		/// @remark 6 秒間以上この関数を呼ばないと自動的に切断されます。
+		/// @remark 受信処理と onSendTick() は、フレームレートによらず setTickRate() で設定した頻度で行われます。
 		void update();
 
+		/// @brief update() の通信頻度を設定します。
+		/// @param tickRate 通信頻度の設定
+		/// @remark init() より前に呼んだ場合は、init() で適用されます。
+		void setTickRate(const NetworkTickRate& tickRate);
+
+		/// @brief update() の通信頻度の設定を返します。
+		/// @return 通信頻度の設定
+		[[nodiscard]]
+		NetworkTickRate getTickRate() const;
+
 		/// @brief update() を呼ぶ必要がある状態であるかを返します。
 		/// @return  update() を呼ぶ必要がある状態である場合 true, それ以外の場合は false
 		[[nodiscard]]
@@ -597,6 +1088,89 @@ namespace s3d
 		/// @return リクエストに成功してコールバックが呼ばれる場合 true、それ以外の場合は false
 		bool reconnectAndRejoin();
 
+		/// @brief 非同期操作のデフォルトのタイムアウト時間
+		static constexpr Duration DefaultOperationTimeout{ 10.0 };
+
+		/// @brief Photon サーバへの接続を試み、ロビーに入るまでを非同期に待ちます。
+		/// @param userName ユーザ名
+		/// @param region 接続するサーバのリージョン
+		/// @param timeout タイムアウト時間
+		/// @return 結果を co_await で受け取ることのできる非同期操作
+		/// @remark connectReturn() などの仮想関数も従来どおり呼ばれます。
+		[[nodiscard]]
+		MultiplayerOperation<MultiplayerResult> connectAsync(StringView userName, const Optional<String>& region = unspecified, const Duration& timeout = DefaultOperationTimeout);
+
+		/// @brief Photon サーバからの切断を試み、切断されるまでを非同期に待ちます。
+		/// @param timeout タイムアウト時間
+		/// @return 結果を co_await で受け取ることのできる非同期操作
+		/// @remark 切断時に結果を待っている他の非同期操作はすべて失敗します。
+		[[nodiscard]]
+		MultiplayerOperation<MultiplayerResult> disconnectAsync(const Duration& timeout = DefaultOperationTimeout);
+
+		/// @brief 既存のランダムなルームへの参加を試み、結果を非同期に待ちます。
+		/// @param expectedMaxPlayers 最大人数が指定されたものと一致するルームにのみ参加を試みます。（0の場合は指定なし）
+		/// @param matchmakingMode マッチメイキングモード
+		/// @param timeout タイムアウト時間
+		/// @return 結果を co_await で受け取ることのできる非同期操作
+		[[nodiscard]]
+		MultiplayerOperation<JoinRoomResult> joinRandomRoomAsync(int32 expectedMaxPlayers = 0, MatchmakingMode matchmakingMode = MatchmakingMode::FillOldestRoom, const Duration& timeout = DefaultOperationTimeout);
+
+		/// @brief 既存のランダムなルームへの参加を試み、結果を非同期に待ちます。
+		/// @param propertyFilter ルームプロパティのフィルタ
+		/// @param expectedMaxPlayers 最大人数が指定されたものと一致するルームにのみ参加を試みます。（0の場合は指定なし）
+		/// @param matchmakingMode マッチメイキングモード
+		/// @param timeout タイムアウト時間
+		/// @return 結果を co_await で受け取ることのできる非同期操作
+		[[nodiscard]]
+		MultiplayerOperation<JoinRoomResult> joinRandomRoomAsync(const RoomPropertyTable& propertyFilter, int32 expectedMaxPlayers = 0, MatchmakingMode matchmakingMode = MatchmakingMode::FillOldestRoom, const Duration& timeout = DefaultOperationTimeout);
+
+		/// @brief ランダムなルームへの参加を試み、参加できるルームが無かった場合にルームの作成を試み、結果を非同期に待ちます。
+		/// @param roomName 新しいルーム名。空の場合はランダムな名前が割り当てられます。
+		/// @param roomCreateOption ルーム作成オプション
+		/// @param propertyFilter プロパティがその通り設定されたルームにのみ参加を試みます。 （空の場合は指定なし）
+		/// @param expectedMaxPlayers 最大人数が指定されたものと一致するルームにのみ参加を試みます。（0の場合は指定なし）
+		/// @param matchmakingMode マッチメイキングモード
+		/// @param timeout タイムアウト時間
+		/// @return 結果を co_await で受け取ることのできる非同期操作
+		[[nodiscard]]
+		MultiplayerOperation<JoinRoomResult> joinRandomOrCreateRoomAsync(RoomNameView roomName, const RoomCreateOption& roomCreateOption = {}, const RoomPropertyTable& propertyFilter = {}, int32 expectedMaxPlayers = 0, MatchmakingMode matchmakingMode = MatchmakingMode::FillOldestRoom, const Duration& timeout = DefaultOperationTimeout);
+
+		/// @brief 既存の指定した名前のルームへの参加を試み、結果を非同期に待ちます。
+		/// @param roomName ルーム名
+		/// @param timeout タイムアウト時間
+		/// @return 結果を co_await で受け取ることのできる非同期操作
+		[[nodiscard]]
+		MultiplayerOperation<JoinRoomResult> joinRoomAsync(RoomNameView roomName, const Duration& timeout = DefaultOperationTimeout);
+
+		/// @brief 指定した名前のルームへの参加を試み、ルームが無かった場合には作成を試み、結果を非同期に待ちます。
+		/// @param roomName ルーム名
+		/// @param option ルーム作成オプション
+		/// @param timeout タイムアウト時間
+		/// @return 結果を co_await で受け取ることのできる非同期操作
+		[[nodiscard]]
+		MultiplayerOperation<JoinRoomResult> joinOrCreateRoomAsync(RoomNameView roomName, const RoomCreateOption& option = {}, const Duration& timeout = DefaultOperationTimeout);
+
+		/// @brief 新しいルームの作成を試み、結果を非同期に待ちます。
+		/// @param roomName ルーム名。空の場合はランダムな名前が割り当てられます。
+		/// @param option ルーム作成オプション
+		/// @param timeout タイムアウト時間
+		/// @return 結果を co_await で受け取ることのできる非同期操作
+		[[nodiscard]]
+		MultiplayerOperation<JoinRoomResult> createRoomAsync(RoomNameView roomName, const RoomCreateOption& option = {}, const Duration& timeout = DefaultOperationTimeout);
+
+		/// @brief ルームからの退出を試み、結果を非同期に待ちます。
+		/// @param willComeBack 退出後に reconnectAndRejoin() で再参加する場合 true
+		/// @param timeout タイムアウト時間
+		/// @return 結果を co_await で受け取ることのできる非同期操作
+		[[nodiscard]]
+		MultiplayerOperation<MultiplayerResult> leaveRoomAsync(bool willComeBack = false, const Duration& timeout = DefaultOperationTimeout);
+
+		/// @brief 切断状態から、以前に参加していたルームへの再参加を試み、結果を非同期に待ちます。
+		/// @param timeout タイムアウト時間
+		/// @return 結果を co_await で受け取ることのできる非同期操作
+		[[nodiscard]]
+		MultiplayerOperation<JoinRoomResult> reconnectAndRejoinAsync(const Duration& timeout = DefaultOperationTimeout);
+
 		/// @brief 指定したイベントターゲットグループに参加します。
 		/// @param targetGroup ターゲットグループ　(1以上255以下の整数)
 		/// @return リクエストに成功してコールバックが呼ばれる場合 true、それ以外の場合は false
@@ -624,6 +1198,8 @@ namespace s3d
 		/// @param event イベントの送信オプション
 		/// @param args 送信するデータ
 		/// @remark Argsにはシリアライズ可能かつデフォルト構築可能な型のみが指定できます。
+		/// @remark setEventEncoding() で EventEncoding::FixedLayout が指定されたイベントコードは、cereal を経由せずにメモリコピーで送信されます。このとき Args はすべてトリビアルコピー可能な型（Vec2, Point, int32 など）である必要があります。
+		/// @remark setEventEncoding() で EventEncoding::BitPacked が指定されたイベントコードは BitPackedSerializer で送信されます。このとき Args はすべて IsBitPackedEventArg である必要があります。
 		template<class... Args>
 		void sendEvent(const MultiplayerEvent& event, Args... args);
 
@@ -632,6 +1208,26 @@ namespace s3d
 		/// @param writer 送信するデータを書き込んだシリアライザ
 		void sendEvent(const MultiplayerEvent& event, const Serializer<MemoryWriter>& writer);
 
+		/// @brief ルームにイベントを送信します。
+		/// @param event イベントの送信オプション
+		/// @param writer 送信するデータを書き込んだ BitPackedSerializer
+		/// @remark 受信側では RegisterEventCallback() で登録したメンバ関数、または bitPackedEventAction() が呼ばれます。
+		void sendEvent(const MultiplayerEvent& event, const BitPackedSerializer& writer);
+
+		/// @brief イベントコードごとの送信エンコーディングを設定します。
+		/// @param eventCode イベントコード （1～199）
+		/// @param encoding 送信エンコーディング
+		/// @remark 受信側は送信されたデータの形式を自動で判別するため、送信側だけで設定すれば十分です。
+		/// @remark EventEncoding::FixedLayout を指定する場合、このイベントコードに登録されたコールバックの引数はすべてトリビアルコピー可能な型である必要があります。そうでない場合は Error 例外を投げます。
+		/// @remark EventEncoding::BitPacked を指定する場合、このイベントコードに登録されたコールバックの引数はすべて IsBitPackedEventArg である必要があります。そうでない場合は Error 例外を投げます。
+		void setEventEncoding(uint8 eventCode, EventEncoding encoding);
+
+		/// @brief イベントコードの送信エンコーディングを返します。
+		/// @param eventCode イベントコード
+		/// @return 送信エンコーディング
+		[[nodiscard]]
+		EventEncoding getEventEncoding(uint8 eventCode) const noexcept;
+
 		/// @brief キャッシュされたイベントを削除します。
 		/// @param eventCode 削除するイベントコード, 0 の場合は全てのイベントを削除
 		void removeEventCache(uint8 eventCode = 0);
@@ -642,6 +1238,33 @@ namespace s3d
 		/// @remark プレイヤーに紐づくイベントとは、ReceiverOption::○○○_CacheUntilLeaveRoomによってキャッシュされたイベントのことです。
 		void removeEventCache(uint8 eventCode, const Array<LocalPlayerID>& targets);
 
+		/// @brief イベントキャッシュを自動で圧縮する条件を設定します。
+		/// @param eventCode イベントコード （1～199）
+		/// @param compaction 圧縮する条件。none の場合は自動で圧縮しません。
+		/// @remark 条件は update() の中で判定され、超えた場合は compactEventCache() が呼ばれます。
+		void setEventCacheCompaction(uint8 eventCode, const Optional<EventCacheCompaction>& compaction);
+
+		/// @brief 自身が送信したイベントキャッシュを、最後に送信したイベント 1 つに置き換えます。
+		/// @param eventCode イベントコード （1～199）
+		/// @remark 送信オプションごとに、最後に送信したイベントを同じ送信オプションでキャッシュに追加し直します。ルーム内のプレイヤーは受信済みのため再度受信せず、後から入室したプレイヤーだけが受信します。
+		/// @remark ReceiverOption::○○○_CacheForever のイベントはプレイヤーに紐づかず、イベントコード単位でキャッシュ全体が削除されて置き換わります。他のプレイヤーのイベントを消さないよう、現在のルームで自分以外からそのイベントコードを受信している場合（入室時に受信したキャッシュを含む）は圧縮しません。送信者が 1 人（ホストなど）のイベントコードに使用してください。
+		/// @remark 他のプレイヤーが同じイベントコードを送信した直後で、まだ受信していない場合は、そのイベントも削除されます。複数のプレイヤーが送信するイベントコードには ReceiverOption::○○○_CacheUntilLeaveRoom を使用してください。
+		void compactEventCache(uint8 eventCode);
+
+		/// @brief イベントコードのキャッシュ全体を削除し、指定したスナップショットイベントに置き換えます。
+		/// @param event スナップショットイベントの送信オプション。キャッシュする ReceiverOption を指定してください。
+		/// @param args 送信するデータ
+		/// @remark 他のプレイヤーが送信したキャッシュも削除されるため、ホストが発行することを想定しています。
+		template<class... Args>
+		void replaceEventCache(const MultiplayerEvent& event, Args... args);
+
+		/// @brief 自身が送信してキャッシュされているイベントの大きさを返します。
+		/// @param eventCode イベントコード
+		/// @return キャッシュされているイベントの大きさ
+		/// @remark サーバのキャッシュを問い合わせるのではなく、このクライアントが現在のルームで送信した記録から計算します。同じイベントコードを異なる送信オプションで送信した場合は、それらの合計を返します。
+		[[nodiscard]]
+		EventCacheSize getEventCacheSize(uint8 eventCode) const;
+
 		/// @brief 自身のプレイヤー情報を返します。
 		LocalPlayer getLocalPlayer() const;
 
@@ -824,6 +1447,10 @@ namespace s3d
 		/// @brief ロビー内のルームが更新されたときに呼ばれます。
 		virtual void onRoomListUpdate() {}
 
+		/// @brief setTickRate() で設定した送信頻度で update() の中から呼ばれます。
+		/// @remark 定期的に送信する状態のイベントはこの関数の中で送信することで、フレームレートによらず一定の頻度で送信できます。
+		virtual void onSendTick() {}
+
 		/// @brief ルームのプロパティが変更されたときに呼ばれます。
 		/// @param changes 変更されたプロパティのキーと値（Web 版ではこのパラメータは利用できません）
 		/// @remark Web 版では、この関数はルームのプロパティが変更された時の他にも呼ばれることがあります。
@@ -841,6 +1468,13 @@ namespace s3d
 		/// @remark ユーザ定義型を受信する際に利用します。
 		virtual void customEventAction(LocalPlayerID playerID, uint8 eventCode, Deserializer<MemoryViewReader>& reader) {}
 
+		/// @brief BitPackedSerializer でエンコードされたルームのイベントを受信した際に呼ばれます。
+		/// @param playerID 送信者のローカルプレイヤー ID
+		/// @param eventCode イベントコード
+		/// @param reader 受信したデータ
+		/// @remark RegisterEventCallback() でメンバ関数が登録されていないイベントコードの場合に呼ばれます。
+		virtual void bitPackedEventAction(LocalPlayerID playerID, uint8 eventCode, BitPackedDeserializer& reader) {}
+
 		/// @brief クライアントのシステムのタイムスタンプ（ミリ秒）を返します。
 		/// @return クライアントのシステムのタイムスタンプ（ミリ秒）
 		/// @remark この値に getServerTimeOffsetMillisec() の戻り値と足した値がサーバのタイムスタンプと一致します。
@@ -852,6 +1486,12 @@ namespace s3d
 		template<class T, class... Args>
 		using EventCallbackType = void (T::*)(LocalPlayerID, Args...);
 
+		/// @brief イベントを受信した際に呼ばれるメンバ関数を登録します。
+		/// @param eventCode イベントコード （1～199）
+		/// @param callback 呼ばれるメンバ関数
+		/// @remark Args がすべてトリビアルコピー可能な型の場合は固定レイアウトのイベントも受信できます。送信側とレイアウトハッシュが一致しないイベントは破棄されます。
+		/// @remark setEventEncoding() で EventEncoding::FixedLayout が指定されたイベントコードに、トリビアルコピー可能でない Args のコールバックを登録しようとすると Error 例外を投げます。
+		/// @remark Args がすべて IsBitPackedEventArg の場合のみ、BitPackedSerializer でエンコードされたイベントを受信できます。
 		template<class T, class... Args>
 		void RegisterEventCallback(uint8 eventCode, EventCallbackType<T, Args...> callback);
 
@@ -874,6 +1514,13 @@ namespace s3d
 
 	private:
 
+		void sendFixedLayoutEvent(const MultiplayerEvent& event, const Byte* data, size_t size);
+
+		/// @brief 固定レイアウトで送信する引数が、このイベントコードに登録されたコールバックの引数と一致するかを確認します。
+		/// @param layoutHash 送信する引数のレイアウトハッシュ（固定レイアウトにできない場合は 0）
+		/// @throw Error 一致しない場合
+		void checkFixedLayoutEvent(uint8 eventCode, uint32 layoutHash) const;
+
 # if not SIV3D_PLATFORM(WEB)
 		std::unique_ptr<ExitGames::LoadBalancing::Listener> m_listener;
 
@@ -884,6 +1531,9 @@ namespace s3d
 		String m_lastJoinedRoomName;
 # else
 		std::unique_ptr<PhotonDetail> m_detail;
+
+		/// @brief setTickRate() で設定した通信頻度（init() より前に設定された場合は init() で適用する）
+		NetworkTickRate m_tickRate;
 # endif
 
 		String m_secretPhotonAppID;
@@ -894,6 +1544,8 @@ namespace s3d
 
 		HashTable<uint8, detail::CustomEventReceiver> m_table;
 
+		std::array<EventEncoding, 256> m_eventEncodings{};
+
 		std::function<void(StringView)> m_logger;
 	};
 
@@ -901,38 +1553,106 @@ namespace s3d
 
 	namespace detail
 	{
-		template<class T, class... Args>
+		template<class Reader, class T, class... Args>
 		struct EventWrapperImpl
 		{
-			static void wrapper(Multiplayer_Photon& client, TypeErasedCallback callback, LocalPlayerID player, Deserializer<MemoryViewReader>& reader)
+			static void wrapper(Multiplayer_Photon& client, TypeErasedCallback callback, LocalPlayerID player, const Byte* data, size_t size)
 			{
+				Reader reader{ data, size };
 				std::tuple<std::remove_cvref_t<Args>...> args{};
 				impl(static_cast<T&>(client), callback, player, reader, args, std::make_index_sequence<std::tuple_size_v<std::tuple<Args...>>>());
 			}
 
-			static void impl(T& client, TypeErasedCallback callback, LocalPlayerID player, Deserializer<MemoryViewReader>& reader, std::tuple<> args, std::integer_sequence<size_t>)
+			static void impl(T& client, TypeErasedCallback callback, LocalPlayerID player, Reader& reader, std::tuple<> args, std::integer_sequence<size_t>)
 			{
 				(client.*reinterpret_cast<Multiplayer_Photon::EventCallbackType<T, Args...>>(callback))(player);
 			}
 
 			template<std::size_t... I>
-			static void impl(T& client, TypeErasedCallback callback, LocalPlayerID player, Deserializer<MemoryViewReader>& reader, std::tuple<std::remove_cvref_t<Args>...> args, std::integer_sequence<size_t, I...>)
+			static void impl(T& client, TypeErasedCallback callback, LocalPlayerID player, Reader& reader, std::tuple<std::remove_cvref_t<Args>...> args, std::integer_sequence<size_t, I...>)
 			{
 				reader(std::get<I>(args)...);
 				(client.*reinterpret_cast<Multiplayer_Photon::EventCallbackType<T, Args...>>(callback))(player, static_cast<std::tuple_element_t<I, std::tuple<Args...>>>(std::get<I>(args))...);
 			}
 		};
+
+		template<class T, class... Args>
+		struct FixedLayoutEventWrapperImpl
+		{
+			static void wrapper(Multiplayer_Photon& client, TypeErasedCallback callback, LocalPlayerID player, const Byte* data, size_t size)
+			{
+				// サイズは呼び出し側で CustomEventReceiver::layoutSize と照合済み
+				if (size != FixedLayoutSize<Args...>)
+				{
+					return;
+				}
+
+				impl(static_cast<T&>(client), callback, player, data, std::make_index_sequence<sizeof...(Args)>());
+			}
+
+			template<std::size_t... I>
+			static void impl(T& client, TypeErasedCallback callback, LocalPlayerID player, const Byte* data, std::integer_sequence<size_t, I...>)
+			{
+				constexpr auto offsets = FixedLayoutOffsets<Args...>();
+				std::tuple<std::remove_cvref_t<Args>...> args{ LoadFixedLayout<std::remove_cvref_t<Args>>(data + offsets[I])... };
+				(client.*reinterpret_cast<Multiplayer_Photon::EventCallbackType<T, Args...>>(callback))(player, static_cast<std::tuple_element_t<I, std::tuple<Args...>>>(std::get<I>(args))...);
+			}
+		};
 	}
 
 	template<class... Args>
 	void Multiplayer_Photon::sendEvent(const MultiplayerEvent& event, Args... args)
 	{
-		sendEvent(event, Serializer<MemoryWriter> {}(args...));
+		const EventEncoding encoding = getEventEncoding(event.eventCode());
+
+		if (encoding == EventEncoding::BitPacked)
+		{
+			if constexpr (detail::IsBitPackedEvent<Args...>)
+			{
+				sendEvent(event, BitPackedSerializer{}(args...));
+			}
+			else
+			{
+				throw Error{ U"[Multiplayer_Photon] EventCode {} uses EventEncoding::BitPacked, but the event arguments are not IsBitPackedEventArg"_fmt(event.eventCode()) };
+			}
+		}
+		else if (encoding == EventEncoding::FixedLayout)
+		{
+			if constexpr (detail::IsFixedLayoutEvent<Args...>)
+			{
+				constexpr uint32 layoutHash = detail::FixedLayoutHash<Args...>();
+				checkFixedLayoutEvent(event.eventCode(), layoutHash);
+
+				std::array<Byte, (sizeof(layoutHash) + detail::FixedLayoutSize<Args...>)> buffer;
+				std::memcpy(buffer.data(), &layoutHash, sizeof(layoutHash));
+
+				size_t offset = sizeof(layoutHash);
+				((std::memcpy(buffer.data() + offset, std::addressof(args), sizeof(Args)), offset += sizeof(Args)), ...);
+
+				sendFixedLayoutEvent(event, buffer.data(), buffer.size());
+			}
+			else
+			{
+				checkFixedLayoutEvent(event.eventCode(), 0);
+			}
+		}
+		else
+		{
+			sendEvent(event, Serializer<MemoryWriter> {}(args...));
+		}
 	}
 
 	template<>
 	void Multiplayer_Photon::sendEvent<>(const MultiplayerEvent& event);
 
+	template<class... Args>
+	void Multiplayer_Photon::replaceEventCache(const MultiplayerEvent& event, Args... args)
+	{
+		removeEventCache(event.eventCode());
+
+		sendEvent(event, args...);
+	}
+
 	template<class T, class ...Args>
 	void Multiplayer_Photon::RegisterEventCallback(uint8 eventCode, Multiplayer_Photon::EventCallbackType<T, Args...> callback)
 	{
@@ -941,7 +1661,29 @@ namespace s3d
 			throw Error{ U"[Multiplayer_Photon] EventCode must be in a range of 1 to 199" };
 		}
 
-		m_table[static_cast<uint8>(eventCode)] = detail::CustomEventReceiver(reinterpret_cast<detail::TypeErasedCallback>(callback), &detail::EventWrapperImpl<T, Args...>::wrapper);
+		detail::CustomEventReceiver receiver{ reinterpret_cast<detail::TypeErasedCallback>(callback), &detail::EventWrapperImpl<Deserializer<MemoryViewReader>, T, Args...>::wrapper };
+
+		if constexpr (detail::IsBitPackedEvent<Args...>)
+		{
+			receiver.bitPackedWrapper = &detail::EventWrapperImpl<BitPackedDeserializer, T, Args...>::wrapper;
+		}
+		else if (getEventEncoding(eventCode) == EventEncoding::BitPacked)
+		{
+			throw Error{ U"[Multiplayer_Photon] EventCode {} uses EventEncoding::BitPacked, but the callback arguments are not IsBitPackedEventArg"_fmt(eventCode) };
+		}
+
+		if constexpr (detail::IsFixedLayoutEvent<Args...>)
+		{
+			receiver.fixedLayoutWrapper = &detail::FixedLayoutEventWrapperImpl<T, Args...>::wrapper;
+			receiver.layoutHash = detail::FixedLayoutHash<Args...>();
+			receiver.layoutSize = detail::FixedLayoutSize<Args...>;
+		}
+		else if (getEventEncoding(eventCode) == EventEncoding::FixedLayout)
+		{
+			throw Error{ U"[Multiplayer_Photon] EventCode {} uses EventEncoding::FixedLayout, but the callback arguments are not trivially copyable"_fmt(eventCode) };
+		}
+
+		m_table[static_cast<uint8>(eventCode)] = receiver;
 	}
 }
 
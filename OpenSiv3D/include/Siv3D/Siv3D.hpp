@@ -156,9 +156,15 @@
 // 動的配列（一次元）| Array
 # include <Siv3D/Array.hpp>
 
+// 二次元配列のアドレスモード | 2D array address mode
+# include <Siv3D/GridAddressMode.hpp>
+
 // 動的配列（二次元）| 2D array
 # include <Siv3D/Grid.hpp>
 
+// タイル状にモートン順序で格納する二次元配列 | Morton-ordered tiled 2D array
+# include <Siv3D/TiledGrid.hpp>
+
 // 文字列ルックアップヘルパー | Heterogeneous lookup helper
 # include <Siv3D/HeterogeneousLookupHelper.hpp>
 
@@ -171,9 +177,18 @@
 // ハッシュセット | Hash set
 # include <Siv3D/HashSet.hpp>
 
+// 並行ハッシュテーブル | Concurrent hash table
+# include <Siv3D/ConcurrentHashTable.hpp>
+
+// 並行ハッシュセット | Concurrent hash set
+# include <Siv3D/ConcurrentHashSet.hpp>
+
 // kd 木 | kd-tree
 # include <Siv3D/KDTree.hpp>
 
+// 動的 kd 木 | Dynamic kd-tree
+# include <Siv3D/DynamicKDTree.hpp>
+
 // Disjoint-set (Union-find) | Disjoint-set (Union–find)
 # include <Siv3D/DisjointSet.hpp>
 
@@ -192,6 +207,9 @@
 // 非同期タスク | Asynchronous task
 # include <Siv3D/AsyncTask.hpp>
 
+// タスクグループと並列 for | Task group and parallel for
+# include <Siv3D/TaskGroup.hpp>
+
 // 子プロセス | Child process
 # include <Siv3D/ChildProcess.hpp>
 
@@ -453,6 +471,9 @@
 // ZIP 圧縮ファイルの読み込み | ZIP reader
 # include <Siv3D/ZIPReader.hpp>
 
+// メモリマップトファイルによる ZIP 圧縮ファイルの読み込み | Memory-mapped ZIP archive reader
+# include <Siv3D/ZIPArchiveView.hpp>
+
 // ZIP 圧縮ファイルの書き出し | ZIP writer
 //# include <Siv3D/ZIPWriter.hpp> // [Siv3D ToDo]
 
@@ -474,12 +495,18 @@
 // CSV データの読み書き | CSV reader/writer
 # include <Siv3D/CSV.hpp>
 
+// 列指向の CSV リーダー | Columnar CSV reader
+# include <Siv3D/ColumnarCSV.hpp>
+
 // INI データの読み書き | INI reader/writer
 # include <Siv3D/INI.hpp>
 
 // JSON データの読み書き | JSON reader/writer
 # include <Siv3D/JSON.hpp>
 
+// JSON のストリーミング読み込み | Streaming JSON reader
+# include <Siv3D/JSONReader.hpp>
+
 // JSON データの検証 | JSON validation
 # include <Siv3D/JSONValidator.hpp>
 
@@ -567,6 +594,9 @@
 // 数式パーサ | Math parser
 # include <Siv3D/MathParser.hpp>
 
+// コンパイルされた数式 | Compiled math expression
+# include <Siv3D/CompiledMathExpression.hpp>
+
 // 統計 | Statistics
 # include <Siv3D/Statistics.hpp>
 
@@ -732,6 +762,9 @@
 // 2D 幾何 | 2D geometry processing
 # include <Siv3D/Geometry2D.hpp>
 
+// 2D 空間ハッシュ | 2D spatial hash
+# include <Siv3D/SpatialHash2D.hpp>
+
 // 長方形詰込み | Rectangle packing
 # include <Siv3D/RectanglePacking.hpp>
 
@@ -1131,6 +1164,15 @@
 // 追加の画像処理 | Extra image processing
 # include <Siv3D/ImageProcessing.hpp>
 
+// 画像処理のパイプライン | Image processing pipeline
+# include <Siv3D/ImagePipeline.hpp>
+
+// ミップマップの縮小フィルタ | Mipmap filter
+# include <Siv3D/MipmapFilter.hpp>
+
+// ミップマップチェーン | Mip chain
+# include <Siv3D/MipChain.hpp>
+
 // カスケード分類器 | Cascade classifier
 # include <Siv3D/CascadeClassifier.hpp>
 
@@ -1244,6 +1286,9 @@
 // 音声波形 | Audio wave
 # include <Siv3D/Wave.hpp>
 
+// 音声波形の一括処理 | Bulk DSP kernels for Wave
+# include <Siv3D/WaveDSP.hpp>
+
 //////////////////////////////////////////////////
 //
 //	FFT | FFT
@@ -1434,6 +1479,8 @@
 
 # include <Siv3D/PixelShaderAsset.hpp>
 
+# include <Siv3D/AssetStreamer.hpp>
+
 //////////////////////////////////////////////////
 //
 //	ナビメッシュ | Navigation Mesh
@@ -1445,6 +1492,9 @@
 // ナビメッシュ | Navigation mesh
 # include <Siv3D/NavMesh.hpp>
 
+// 経路のキャッシュを備えたナビメッシュの経路探索 | NavMesh path queries with a path cache
+# include <Siv3D/NavMeshPathfinder.hpp>
+
 //////////////////////////////////////////////////
 //
 //	シーン | Scene
@@ -1714,6 +1764,9 @@
 // エフェクト | Effect
 # include <Siv3D/Effect.hpp>
 
+// 同じ型のエフェクトを連続したメモリで管理するエフェクトグループ | Pooled effect group
+# include <Siv3D/EffectPool.hpp>
+
 // 軌跡 | Trail
 # include <Siv3D/Trail.hpp>
 
@@ -1755,6 +1808,12 @@
 // 2D パーティクルシステム | 2D Particle system (System)
 # include <Siv3D/ParticleSystem2D.hpp>
 
+// SoA で保持するパーティクルの配列 | Structure-of-arrays particle storage
+# include <Siv3D/ParticleArray2D.hpp>
+
+// SoA による 2D パーティクルシステム | 2D Particle system with structure-of-arrays storage
+# include <Siv3D/BulkParticleSystem2D.hpp>
+
 //////////////////////////////////////////////////
 //
 //	2D 物理演算 | 2D Physics
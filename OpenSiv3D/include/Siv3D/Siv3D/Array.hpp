@@ -16,6 +16,7 @@
 # endif
 # include <vector>
 # ifndef SIV3D_NO_CONCURRENT_API
+	# include <atomic>
 	# include <future>
 	# if SIV3D_PLATFORM(WINDOWS)
 	#	include <execution>
@@ -25,6 +26,7 @@
 # include "String.hpp"
 # include "Meta.hpp"
 # include "Threading.hpp"
+# include "TaskGroup.hpp"
 # include "FormatData.hpp"
 # include "Format.hpp"
 # include "FormatLiteral.hpp"
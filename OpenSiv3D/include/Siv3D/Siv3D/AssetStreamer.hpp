@@ -0,0 +1,387 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include <memory>
+# include "Common.hpp"
+# include "String.hpp"
+# include "Array.hpp"
+# include "HashTable.hpp"
+# include "Optional.hpp"
+# include "Duration.hpp"
+# include "AsyncTask.hpp"
+# include "AssetInfo.hpp"
+# include "Image.hpp"
+# include "Wave.hpp"
+# include "TextureDesc.hpp"
+# include "AudioLoopTiming.hpp"
+
+namespace s3d
+{
+	/// @brief ストリーミングするアセットの種類
+	enum class AssetStreamKind : uint8
+	{
+		/// @brief TextureAsset
+		Texture,
+
+		/// @brief AudioAsset
+		Audio,
+
+		/// @brief FontAsset
+		Font,
+	};
+
+	/// @brief ストリーミング中のアセットの状態
+	enum class AssetStreamState : uint8
+	{
+		/// @brief 要求されていない（解放された場合を含む）
+		Unrequested,
+
+		/// @brief デコードの順番を待っている
+		Queued,
+
+		/// @brief ワーカースレッドでデコード中（ワーカースレッドを使わないビルドでは、この状態にはなりません）
+		Decoding,
+
+		/// @brief メインスレッドでの GPU へのアップロード（またはロード）の順番を待っている
+		PendingUpload,
+
+		/// @brief ロード済み
+		Resident,
+
+		/// @brief ロードに失敗
+		Failed,
+	};
+
+	/// @brief アセットのロードの要求
+	struct AssetStreamRequest
+	{
+		/// @brief アセットの種類
+		AssetStreamKind kind = AssetStreamKind::Texture;
+
+		/// @brief アセット名
+		AssetName name;
+
+		/// @brief 優先度。大きいほど先にロードされます
+		int32 priority = 0;
+	};
+
+	/// @brief アセットごとのロードの計測結果
+	struct AssetStreamMetrics
+	{
+		/// @brief 最後のロードで、ワーカースレッドでのデコードにかかった時間（ナノ秒）
+		int64 decodeNanosec = 0;
+
+		/// @brief 最後のロードで、メインスレッドでのアップロード（またはロード）にかかった時間（ナノ秒）
+		int64 uploadNanosec = 0;
+
+		/// @brief 最後のロードで、要求されてからロードが完了するまでの時間（ナノ秒）
+		int64 latencyNanosec = 0;
+
+		/// @brief ロード済みの場合、メモリ上のサイズの見積もり（バイト）
+		size_t residentBytes = 0;
+
+		/// @brief ロードした回数
+		uint32 numLoads = 0;
+
+		/// @brief メモリの上限を超えたために解放された回数
+		uint32 numEvictions = 0;
+	};
+
+	/// @brief `AssetStreamer` 全体の状態
+	struct AssetStreamStats
+	{
+		/// @brief デコードの順番を待っているアセットの数
+		size_t numQueued = 0;
+
+		/// @brief デコード中のアセットの数
+		size_t numDecoding = 0;
+
+		/// @brief アップロードの順番を待っているアセットの数
+		size_t numPendingUpload = 0;
+
+		/// @brief ロード済みのアセットの数
+		size_t numResident = 0;
+
+		/// @brief ロード済みのアセットのメモリ上のサイズの見積もりの合計（バイト）
+		size_t residentBytes = 0;
+
+		/// @brief メモリの上限を超えたために解放されたアセットの数の合計
+		uint64 numEvictions = 0;
+	};
+
+	/// @brief 優先度とメモリの上限に基づいて、アセットをバックグラウンドでロードするスケジューラ | Prioritized, budgeted background asset streaming
+	/// @remark `registerTexture()` / `registerAudio()` で登録したアセットは、ファイルのデコードをワーカースレッドで行い、GPU へのアップロードだけをメインスレッドで行います。
+	/// @remark `track()` で追加した既存のアセットは、メインスレッドでロードされます。
+	/// @remark メインスレッドでの処理は `update()` の中で、1 フレームあたりの個数と時間の上限の範囲で行われます。
+	/// @remark pthread を使わない Web 向けのビルド（`__EMSCRIPTEN_PTHREADS__` が未定義）ではワーカースレッドを使えないため、デコードも `update()` の中でメインスレッドで行われ、アップロードと同じ個数と時間の上限の範囲で数えられます。
+	/// @remark ロード済みのアセットのサイズの合計がメモリの上限を超えると、最近使われていないアセットから `Release()` で解放されます。
+	class AssetStreamer
+	{
+	public:
+
+		/// @brief メモリの上限のデフォルト値（バイト）
+		static constexpr size_t DefaultMemoryBudget = (size_t{ 512 } << 20);
+
+		/// @brief 1 フレームあたりにアップロードするアセットの最大数のデフォルト値
+		static constexpr size_t DefaultMaxUploadsPerFrame = 8;
+
+		/// @brief 1 フレームあたりのアップロードの時間の上限のデフォルト値
+		static constexpr Duration DefaultUploadTimeBudget{ 0.002 };
+
+		/// @brief スケジューラを作成します。
+		/// @param memoryBudget ロード済みのアセットのメモリの上限（バイト）
+		/// @param maxConcurrentDecodes 同時にデコードするアセットの最大数。0 の場合は CPU のスレッド数から決めます
+		SIV3D_NODISCARD_CXX20
+		explicit AssetStreamer(size_t memoryBudget = DefaultMemoryBudget, size_t maxConcurrentDecodes = 0);
+
+		AssetStreamer(const AssetStreamer&) = delete;
+
+		AssetStreamer& operator =(const AssetStreamer&) = delete;
+
+		/// @brief デコード中のアセットがある場合、完了するまで待機します。
+		~AssetStreamer();
+
+		/// @brief 画像ファイルから作成するテクスチャアセットを登録し、ストリーミングの対象にします。
+		/// @param name アセット名
+		/// @param path 画像ファイルのパス
+		/// @param desc テクスチャの設定
+		/// @param tags タグ
+		/// @return 登録に成功した場合 true, それ以外の場合は false
+		/// @remark `TextureAsset::Register()` の代わりに使います。ストリーミングを待たずに `TextureAsset` を使った場合は、通常どおりその場でロードされます。
+		bool registerTexture(AssetNameView name, FilePathView path, TextureDesc desc = TextureDesc::Unmipped, const Array<AssetTag>& tags = {});
+
+		/// @brief 音声ファイルから作成するオーディオアセットを登録し、ストリーミングの対象にします。
+		/// @param name アセット名
+		/// @param path 音声ファイルのパス
+		/// @param loopTiming ループの設定
+		/// @param tags タグ
+		/// @return 登録に成功した場合 true, それ以外の場合は false
+		/// @remark `AudioAsset::Register()` の代わりに使います。ストリーミングを待たずに `AudioAsset` を使った場合は、通常どおりその場でロードされます。
+		bool registerAudio(AssetNameView name, FilePathView path, const Optional<AudioLoopTiming>& loopTiming = none, const Array<AssetTag>& tags = {});
+
+		/// @brief 登録済みのアセットを、ストリーミングの対象に追加します。
+		/// @param kind アセットの種類
+		/// @param name アセット名
+		/// @param residentBytes ロード後のメモリ上のサイズ（バイト）。0 の場合はロード後のアセットから見積もります
+		/// @remark 追加したアセットのロードは、メインスレッドで `update()` の中で行われます。
+		void track(AssetStreamKind kind, AssetNameView name, size_t residentBytes = 0);
+
+		/// @brief アセットがストリーミングの対象であるかを返します。
+		/// @param kind アセットの種類
+		/// @param name アセット名
+		/// @return ストリーミングの対象である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool contains(AssetStreamKind kind, AssetNameView name) const;
+
+		/// @brief アセットのロードを要求します。
+		/// @param kind アセットの種類
+		/// @param name アセット名
+		/// @param priority 優先度。大きいほど先にロードされます
+		/// @remark すでに要求されている場合は、優先度が高いほうに更新されます。ストリーミングの対象でないアセットは無視されます。
+		void request(AssetStreamKind kind, AssetNameView name, int32 priority = 0);
+
+		/// @brief アセットのロードを要求します。
+		/// @param request ロードの要求
+		void request(const AssetStreamRequest& request);
+
+		/// @brief シーンのマニフェストに含まれるアセットのロードをまとめて要求します。
+		/// @param manifest ロードの要求の一覧
+		void prefetch(const Array<AssetStreamRequest>& manifest);
+
+		/// @brief アセットが使われたことを記録します。
+		/// @param kind アセットの種類
+		/// @param name アセット名
+		/// @remark 現在のフレームと前のフレームで使われたアセットは、メモリの上限を超えても解放されません。
+		void touch(AssetStreamKind kind, AssetNameView name);
+
+		/// @brief ストリーミングを進めます。
+		/// @remark メインスレッドで毎フレーム 1 回呼ぶ必要があります。
+		/// @remark 完了したデコードの回収、新しいデコードの開始、上限の範囲でのアップロード、メモリの上限を超えた分の解放を行います。
+		void update();
+
+		/// @brief アセットがロード済みであるかを返します。
+		/// @param kind アセットの種類
+		/// @param name アセット名
+		/// @return ロード済みである場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isReady(AssetStreamKind kind, AssetNameView name) const;
+
+		/// @brief アセットのロードが完了するまで待機します。
+		/// @param kind アセットの種類
+		/// @param name アセット名
+		/// @return ロードに成功した場合 true, それ以外の場合は false
+		/// @remark 待機中のアセットは、順番を待たずにこのスレッドでデコード・アップロードされます。メインスレッドから呼ぶ必要があります。
+		bool wait(AssetStreamKind kind, AssetNameView name);
+
+		/// @brief アセットの状態を返します。
+		/// @param kind アセットの種類
+		/// @param name アセット名
+		/// @return アセットの状態
+		[[nodiscard]]
+		AssetStreamState getState(AssetStreamKind kind, AssetNameView name) const;
+
+		/// @brief マニフェストに含まれるアセットのうち、ロード済みのものの割合を返します。
+		/// @param manifest ロードの要求の一覧
+		/// @return ロード済みのアセットの割合 [0.0, 1.0]。ロードに失敗したアセットは完了として数えます
+		[[nodiscard]]
+		double progress(const Array<AssetStreamRequest>& manifest) const;
+
+		/// @brief アセットのロードの計測結果を返します。
+		/// @param kind アセットの種類
+		/// @param name アセット名
+		/// @return 計測結果。ストリーミングの対象でない場合は none
+		[[nodiscard]]
+		Optional<AssetStreamMetrics> getMetrics(AssetStreamKind kind, AssetNameView name) const;
+
+		/// @brief 全体の状態を返します。
+		/// @return 全体の状態
+		[[nodiscard]]
+		AssetStreamStats getStats() const noexcept;
+
+		/// @brief ロード済みのアセットのメモリの上限を設定します。
+		/// @param memoryBudget メモリの上限（バイト）
+		void setMemoryBudget(size_t memoryBudget) noexcept;
+
+		/// @brief ロード済みのアセットのメモリの上限を返します。
+		/// @return メモリの上限（バイト）
+		[[nodiscard]]
+		size_t getMemoryBudget() const noexcept;
+
+		/// @brief 同時にデコードするアセットの最大数を設定します。
+		/// @param maxConcurrentDecodes 同時にデコードするアセットの最大数。0 の場合は CPU のスレッド数から決めます
+		/// @remark ワーカースレッドを使わないビルドでは無視されます。
+		void setMaxConcurrentDecodes(size_t maxConcurrentDecodes) noexcept;
+
+		/// @brief 1 フレームあたりのメインスレッドでの処理の上限を設定します。
+		/// @param maxUploadsPerFrame 1 フレームあたりにアップロードするアセットの最大数。ワーカースレッドを使わないビルドでは、デコードも 1 つとして数えます
+		/// @param timeBudget 1 フレームあたりのアップロードの時間の上限。超えた時点で次のフレームに持ち越します
+		/// @remark 少なくとも 1 フレームに 1 つのアセットはアップロードされます。
+		void setUploadBudget(size_t maxUploadsPerFrame, const Duration& timeBudget = DefaultUploadTimeBudget) noexcept;
+
+	private:
+
+		/// @brief デコードの結果を、アセットの `onLoad` に受け渡すための領域
+		struct Staging
+		{
+			Image image;
+
+			Wave wave;
+
+			// ワーカースレッドが書き込み、タスクの完了後にメインスレッドが読む
+			int64 decodeNanosec = 0;
+		};
+
+		struct Entry
+		{
+			AssetStreamKind kind = AssetStreamKind::Texture;
+
+			AssetStreamState state = AssetStreamState::Unrequested;
+
+			AssetName name;
+
+			// 空の場合はワーカースレッドでデコードせず、メインスレッドでロードする
+			FilePath path;
+
+			std::shared_ptr<Staging> staging;
+
+			int32 priority = 0;
+
+			// キューに入れるたびに更新され、古い要素の判別と同じ優先度の中での順序に使う
+			uint64 ticket = 0;
+
+			uint64 lastUsedFrame = 0;
+
+			size_t residentBytesHint = 0;
+
+			int64 requestTime = 0;
+
+			AsyncTask<Image> imageTask;
+
+			AsyncTask<Wave> waveTask;
+
+			AssetStreamMetrics metrics;
+		};
+
+		struct QueueItem
+		{
+			int32 priority;
+
+			uint64 ticket;
+
+			uint32 index;
+
+			/// @brief 優先度が高く、チケットが古いものを先頭にするヒープの比較
+			[[nodiscard]]
+			bool operator <(const QueueItem& other) const noexcept
+			{
+				return ((priority != other.priority) ? (priority < other.priority) : (other.ticket < ticket));
+			}
+		};
+
+		Array<Entry> m_entries;
+
+		std::array<HashTable<AssetName, uint32>, 3> m_indices;
+
+		// デコード待ちと、アップロード待ちのヒープ
+		Array<QueueItem> m_decodeQueue;
+
+		Array<QueueItem> m_uploadQueue;
+
+		Array<uint32> m_decoding;
+
+		size_t m_memoryBudget = DefaultMemoryBudget;
+
+		size_t m_maxConcurrentDecodes = 0;
+
+		size_t m_maxUploadsPerFrame = DefaultMaxUploadsPerFrame;
+
+		int64 m_uploadTimeBudgetNanosec = 2'000'000;
+
+		size_t m_residentBytes = 0;
+
+		uint64 m_numEvictions = 0;
+
+		uint64 m_ticket = 0;
+
+		uint64 m_frame = 1;
+
+		[[nodiscard]]
+		Optional<uint32> findEntry(AssetStreamKind kind, AssetNameView name) const;
+
+		uint32 addEntry(AssetStreamKind kind, AssetNameView name);
+
+		void enqueue(uint32 index);
+
+		[[nodiscard]]
+		size_t maxConcurrentDecodes() const noexcept;
+
+		/// @brief ヒープから、状態とチケットが一致する最初の要素を取り出します。古い要素は読み飛ばします。
+		[[nodiscard]]
+		Optional<uint32> popQueue(Array<QueueItem>& queue, AssetStreamState state);
+
+		void startDecode(uint32 index);
+
+		void finishDecode(uint32 index);
+
+		/// @brief メインスレッドでデコードします。
+		void decodeNow(uint32 index);
+
+		void onDecoded(uint32 index, bool decoded);
+
+		void upload(uint32 index);
+
+		void evict();
+	};
+}
+
+# include "detail/AssetStreamer.ipp"
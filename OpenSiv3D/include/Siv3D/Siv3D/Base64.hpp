@@ -13,7 +13,9 @@
 # include "Common.hpp"
 # include "String.hpp"
 # include "Blob.hpp"
+# include "Error.hpp"
 # include "PredefinedYesNo.hpp"
+# include "SIMD.hpp"
 
 namespace s3d
 {
@@ -38,6 +40,20 @@ namespace s3d
 		/// @param dst Base64 エンコードされた入力データの格納先
 		void Encode(const void* data, size_t size, std::string& dst);
 
+		/// @brief データを Base64 エンコードし、dst に書き込みます。
+		/// @param data 入力データ
+		/// @param size 入力データのサイズ（バイト）
+		/// @param dst 書き込み先。`EncodedLength(size)` 文字以上の領域が必要です
+		/// @return 書き込んだ文字数
+		/// @remark 12 バイトずつ SIMD で変換します。
+		size_t Encode(const void* data, size_t size, char* dst) noexcept;
+
+		/// @brief データを Base64 エンコードした結果の文字数を返します。
+		/// @param size 入力データのサイズ（バイト）
+		/// @return Base64 エンコードした結果の文字数（パディングを含む）
+		[[nodiscard]]
+		constexpr size_t EncodedLength(size_t size) noexcept;
+
 		/// @brief Base64 データをデコードします。
 		/// @param base64 入力 Base64
 		/// @param skipValidation 妥当性をチェックするかどうか
@@ -53,5 +69,22 @@ namespace s3d
 		/// @return デコードされたデータ
 		[[nodiscard]]
 		Blob Decode(std::string_view base64, SkipValidation skipValidation = SkipValidation::No);
+
+		/// @brief Base64 データをデコードし、dst に格納します。
+		/// @param base64 入力 Base64
+		/// @param dst デコードされたデータの格納先。既存の容量は再利用されます
+		/// @param skipValidation 妥当性をチェックするかどうか
+		/// @throw Error 妥当性チェックが有効で、不正な入力が見つかった場合
+		/// @remark 16 文字ずつ SIMD で変換します。末尾以外のパディングや空白文字は不正な入力として扱います。
+		void Decode(std::string_view base64, Blob& dst, SkipValidation skipValidation = SkipValidation::No);
+
+		/// @brief Base64 データをデコードし、dst に格納します。
+		/// @param base64 入力 Base64
+		/// @param dst デコードされたデータの格納先。既存の容量は再利用されます
+		/// @param skipValidation 妥当性をチェックするかどうか
+		/// @throw Error 妥当性チェックが有効で、不正な入力が見つかった場合
+		void Decode(StringView base64, Blob& dst, SkipValidation skipValidation = SkipValidation::No);
 	}
 }
+
+# include "detail/Base64.ipp"
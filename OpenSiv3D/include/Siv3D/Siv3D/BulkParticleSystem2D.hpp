@@ -0,0 +1,117 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "PointVector.hpp"
+# include "IEmitter2D.hpp"
+# include "ParticleArray2D.hpp"
+# include "ParticleSystem2DParameters.hpp"
+# include "Scene.hpp"
+# include "Texture.hpp"
+
+namespace s3d
+{
+	/// @brief パーティクルを SoA で保持する 2D パーティクルシステム | 2D particle system with structure-of-arrays storage
+	/// @remark `ParticleSystem2D` と同じパラメータとエミッタを使い、同じ式でパーティクルを更新します。
+	/// @remark パーティクルは `ParticleArray2D` に格納され、更新は SIMD でまとめて行われます。寿命が尽きたパーティクルは末尾との入れ替えで削除されるため、描画順は保たれません。
+	/// @remark メモリは `ParticleSystem2DParameters::maxParticles` を変更したときにだけ確保されます。
+	class BulkParticleSystem2D
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		BulkParticleSystem2D() = default;
+
+		SIV3D_NODISCARD_CXX20
+		explicit BulkParticleSystem2D(const Vec2& position, const Vec2& force = Vec2{ 0, 0 });
+
+		SIV3D_NODISCARD_CXX20
+		BulkParticleSystem2D(const Vec2& position, const Vec2& force, std::unique_ptr<IEmitter2D>&& emitter,
+			const ParticleSystem2DParameters& parameters, const Texture& texture);
+
+		template <class Emitter, std::enable_if_t<std::is_base_of_v<IEmitter2D, Emitter>>* = nullptr>
+		SIV3D_NODISCARD_CXX20
+		BulkParticleSystem2D(const Vec2& position, const Vec2& force, const Emitter& emitter,
+			const ParticleSystem2DParameters& parameters, const Texture& texture);
+
+		void setPosition(const Vec2& position) noexcept;
+
+		void setForce(const Vec2& force) noexcept;
+
+		/// @brief エミッタを設定します。
+		/// @param emitter エミッタ
+		/// @remark `IBulkEmitter2D` を継承したエミッタの場合、パーティクルは `emitBulk()` でまとめて放出されます。
+		void setEmitter(std::unique_ptr<IEmitter2D>&& emitter);
+
+		template <class Emitter, std::enable_if_t<std::is_base_of_v<IEmitter2D, Emitter>>* = nullptr>
+		void setEmitter(const Emitter& emitter);
+
+		void setParameters(const ParticleSystem2DParameters& parameters);
+
+		void setTexture(const Texture& texture) noexcept;
+
+		[[nodiscard]]
+		size_t num_particles() const noexcept;
+
+		/// @brief パーティクルの配列を返します。
+		/// @return パーティクルの配列
+		[[nodiscard]]
+		const ParticleArray2D& particles() const noexcept;
+
+		void prewarm();
+
+		/// @brief パーティクルを更新し、新しいパーティクルを放出します。
+		/// @param deltaTime 経過時間（秒）
+		/// @remark パーティクル数が `ParticleArray2D::ParallelThreshold` 以上の場合は、チャンクに分けて並列に更新します。
+		void update(double deltaTime = Scene::DeltaTime());
+
+		void draw() const;
+
+		void drawDebug() const;
+
+		/// @brief 複数のパーティクルシステムを並列に更新します。
+		/// @param systems パーティクルシステムの一覧
+		/// @param deltaTime 経過時間（秒）
+		/// @remark パーティクルシステムごとにタスクを分けます。エミッタの `emit()` は複数のスレッドから呼ばれるため、スレッド間で状態を共有してはいけません。
+		static void UpdateAll(const Array<BulkParticleSystem2D*>& systems, double deltaTime = Scene::DeltaTime());
+
+	private:
+
+		Vec2 m_position{ 0, 0 };
+
+		Vec2 m_force{ 0, 0 };
+
+		std::unique_ptr<IEmitter2D> m_emitter;
+
+		// m_emitter が IBulkEmitter2D の場合はそのポインタ
+		IBulkEmitter2D* m_bulkEmitter = nullptr;
+
+		ParticleSystem2DParameters m_parameters;
+
+		Texture m_texture;
+
+		ParticleArray2D m_particles{ 1000 };
+
+		// 放出の結果を受け取る一時バッファ（フレームをまたいで再利用する）
+		Array<Emission2D> m_emissions;
+
+		double m_accumulatedTime = 0.0;
+
+		void update(double deltaTime, bool allowParallel);
+
+		void emit(double deltaTime);
+	};
+}
+
+# include "detail/BulkParticleSystem2D.ipp"
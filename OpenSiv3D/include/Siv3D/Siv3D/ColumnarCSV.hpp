@@ -0,0 +1,396 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <string>
+# include <string_view>
+# include <iterator>
+# include <stdexcept>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "String.hpp"
+# include "Optional.hpp"
+# include "Parse.hpp"
+# include "Format.hpp"
+# include "FormatFloat.hpp"
+# include "Unicode.hpp"
+# include "MemoryMappedFileView.hpp"
+# include "PredefinedYesNo.hpp"
+# include "TaskGroup.hpp"
+
+namespace s3d
+{
+	/// @brief CSV の列の型
+	enum class CSVColumnType : uint8
+	{
+		/// @brief 先頭の行から推定する
+		Auto,
+
+		/// @brief 64-bit 整数
+		Int64,
+
+		/// @brief 倍精度浮動小数点数
+		Double,
+
+		/// @brief 文字列
+		String,
+	};
+
+	/// @brief メモリマップトファイルから列ごとに読み込む CSV リーダー | Columnar, memory-mapped CSV reader
+	/// @remark 数値の列は読み込み時に 1 回だけ変換され、型付きの配列として保持されます。
+	/// @remark 文字列の列はファイル内の位置だけを保持し、要求されたときに UTF-8 のビューまたは `String` として取り出されます。そのため、ファイルは開いたまま保持されます。
+	/// @remark 行の区切りの検出と各列の変換は、ファイルを分割して並列に行われます。
+	/// @remark クオーテーション記号の中のクオーテーション記号は、2 つ重ねてエスケープする（RFC 4180）必要があります。
+	class ColumnarCSV
+	{
+	public:
+
+		class RowView;
+
+		class Iterator;
+
+		/// @brief 列の型を推定するために調べる行数
+		static constexpr size_t SchemaInferenceRows = 1024;
+
+		SIV3D_NODISCARD_CXX20
+		ColumnarCSV() = default;
+
+		/// @brief CSV ファイルを開いて読み込みます。
+		/// @param path ファイルパス
+		/// @param hasHeader 1 行目が列名である場合 `HasHeader::Yes`
+		/// @param schema 各列の型。指定されていない列や `CSVColumnType::Auto` の列は、先頭の `SchemaInferenceRows` 行から推定されます
+		/// @param separator 要素のセパレータ
+		/// @param quote クオーテーション記号
+		/// @remark 推定した型に変換できない要素がそれ以降の行にある場合、その列は `CSVColumnType::Double`, `CSVColumnType::String` の順に型が変わります。
+		SIV3D_NODISCARD_CXX20
+		explicit ColumnarCSV(FilePathView path, HasHeader hasHeader = HasHeader::Yes, const Array<CSVColumnType>& schema = {}, char separator = ',', char quote = '\"');
+
+		/// @brief CSV ファイルを開いて読み込みます。
+		/// @param path ファイルパス
+		/// @param hasHeader 1 行目が列名である場合 `HasHeader::Yes`
+		/// @param schema 各列の型。指定されていない列や `CSVColumnType::Auto` の列は、先頭の `SchemaInferenceRows` 行から推定されます
+		/// @param separator 要素のセパレータ
+		/// @param quote クオーテーション記号
+		/// @remark 推定した型に変換できない要素がそれ以降の行にある場合、その列は `CSVColumnType::Double`, `CSVColumnType::String` の順に型が変わります。
+		/// @return 読み込みに成功した場合 true, それ以外の場合は false
+		bool load(FilePathView path, HasHeader hasHeader = HasHeader::Yes, const Array<CSVColumnType>& schema = {}, char separator = ',', char quote = '\"');
+
+		/// @brief データを消去し、ファイルを閉じます。
+		void clear();
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief 行数を返します。
+		/// @return 行数（ヘッダ行と空行は含みません）
+		[[nodiscard]]
+		size_t rows() const noexcept;
+
+		/// @brief 列数を返します。
+		/// @return 列数
+		[[nodiscard]]
+		size_t columns() const noexcept;
+
+		/// @brief 列名の一覧を返します。
+		/// @return 列名の一覧。ヘッダ行が無い場合は空の配列
+		[[nodiscard]]
+		const Array<String>& columnNames() const noexcept;
+
+		/// @brief 列名から列のインデックスを返します。
+		/// @param name 列名
+		/// @return 列のインデックス。見つからない場合は none
+		[[nodiscard]]
+		Optional<size_t> columnIndex(StringView name) const;
+
+		/// @brief 列の型を返します。
+		/// @param column 列
+		/// @return 列の型
+		[[nodiscard]]
+		CSVColumnType columnType(size_t column) const;
+
+		/// @brief `CSVColumnType::Int64` の列の値の配列を返します。
+		/// @param column 列
+		/// @return 列の値の配列。空の要素や変換できない要素は 0 です（`hasValue()` で区別できます）
+		/// @throw std::invalid_argument 列の型が `CSVColumnType::Int64` でない場合
+		[[nodiscard]]
+		const Array<int64>& int64Column(size_t column) const;
+
+		/// @brief `CSVColumnType::Double` の列の値の配列を返します。
+		/// @param column 列
+		/// @return 列の値の配列。空の要素や変換できない要素は NaN です（`hasValue()` で区別できます）
+		/// @throw std::invalid_argument 列の型が `CSVColumnType::Double` でない場合
+		[[nodiscard]]
+		const Array<double>& doubleColumn(size_t column) const;
+
+		/// @brief 要素に値があるかを返します。
+		/// @param row 行
+		/// @param column 列
+		/// @return 数値の列では、要素が空でなく列の型に変換できた場合 true。文字列の列では、要素が空でない場合 true
+		[[nodiscard]]
+		bool hasValue(size_t row, size_t column) const noexcept;
+
+		/// @brief `CSVColumnType::String` の列の要素を、ファイル内の UTF-8 文字列のビューとして返します。
+		/// @param row 行
+		/// @param column 列
+		/// @return 要素のビュー。クオーテーション記号の中の重なったクオーテーション記号はそのまま含まれます。文字列以外の列や範囲外の場合は空のビュー
+		/// @remark ビューは `clear()` や `load()` を呼ぶまで有効です。
+		[[nodiscard]]
+		std::string_view getUTF8View(size_t row, size_t column) const;
+
+		/// @brief 要素を UTF-8 文字列として返します。
+		/// @param row 行
+		/// @param column 列
+		/// @return 要素の文字列。数値の列では数値を文字列に変換したもの
+		[[nodiscard]]
+		std::string getUTF8(size_t row, size_t column) const;
+
+		/// @brief 要素を文字列として返します。
+		/// @param row 行
+		/// @param column 列
+		/// @return 要素の文字列。数値の列では数値を文字列に変換したもの
+		[[nodiscard]]
+		String getString(size_t row, size_t column) const;
+
+		/// @brief 指定した位置の値を読み取ります。
+		/// @tparam Type 読み取る値の型
+		/// @param row 行
+		/// @param column 列
+		/// @return 読み取った値。失敗した場合は `Type{}`
+		template <class Type = String>
+		[[nodiscard]]
+		Type get(size_t row, size_t column) const;
+
+		/// @brief 指定した位置の値を読み取ります。失敗した場合は defaultValue を返します。
+		/// @tparam Type 読み取る値の型
+		/// @tparam U デフォルトの値の型
+		/// @param row 行
+		/// @param column 列
+		/// @param defaultValue デフォルトの値
+		/// @return 読み取った値。失敗した場合はデフォルトの値
+		template <class Type, class U>
+		[[nodiscard]]
+		Type getOr(size_t row, size_t column, U&& defaultValue) const;
+
+		/// @brief 指定した位置の値を読み取ります。失敗した場合は none を返します。
+		/// @tparam Type 読み取る値の型
+		/// @param row 行
+		/// @param column 列
+		/// @return 読み取った値。失敗した場合や、数値の列で要素が空の場合は none
+		/// @remark 数値型は、列の型が一致する場合は変換済みの値をそのまま返し、文字列の列の場合はファイル内の UTF-8 文字列から直接変換します。
+		template <class Type>
+		[[nodiscard]]
+		Optional<Type> getOpt(size_t row, size_t column) const;
+
+		/// @brief 行を返します。
+		/// @param row 行
+		/// @return 行のビュー
+		[[nodiscard]]
+		RowView operator [](size_t row) const noexcept;
+
+		[[nodiscard]]
+		Iterator begin() const noexcept;
+
+		[[nodiscard]]
+		Iterator end() const noexcept;
+
+	private:
+
+		struct FieldRef
+		{
+			uint64 offset = 0;
+
+			uint32 length = 0;
+
+			/// @brief 重なったクオーテーション記号を含む場合 1
+			uint32 escaped = 0;
+		};
+
+		struct Column
+		{
+			CSVColumnType type = CSVColumnType::String;
+
+			Array<int64> int64s;
+
+			Array<double> doubles;
+
+			/// @brief 数値の列で、要素が空でなく変換できた場合 1
+			Array<uint8> valid;
+
+			Array<FieldRef> fields;
+		};
+
+		MemoryMappedFileView m_file;
+
+		const char* m_data = nullptr;
+
+		Array<String> m_columnNames;
+
+		Array<Column> m_columns;
+
+		size_t m_rows = 0;
+
+		char m_quote = '\"';
+
+		void setColumnType(Column& column, CSVColumnType type);
+
+		[[nodiscard]]
+		bool inBounds(size_t row, size_t column) const noexcept;
+
+		[[nodiscard]]
+		std::string_view fieldView(const FieldRef& field) const noexcept;
+
+		[[nodiscard]]
+		std::string unescape(const FieldRef& field) const;
+	};
+
+	/// @brief `ColumnarCSV` の 1 行を参照するビュー
+	class ColumnarCSV::RowView
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		RowView() = default;
+
+		SIV3D_NODISCARD_CXX20
+		constexpr RowView(const ColumnarCSV* csv, size_t row) noexcept;
+
+		/// @brief 行のインデックスを返します。
+		/// @return 行のインデックス
+		[[nodiscard]]
+		constexpr size_t index() const noexcept;
+
+		/// @brief 列数を返します。
+		/// @return 列数
+		[[nodiscard]]
+		size_t columns() const noexcept;
+
+		/// @brief 指定した列の値を読み取ります。
+		/// @tparam Type 読み取る値の型
+		/// @param column 列
+		/// @return 読み取った値。失敗した場合は `Type{}`
+		template <class Type = String>
+		[[nodiscard]]
+		Type get(size_t column) const;
+
+		/// @brief 指定した列の値を読み取ります。失敗した場合は none を返します。
+		/// @tparam Type 読み取る値の型
+		/// @param column 列
+		/// @return 読み取った値。失敗した場合は none
+		template <class Type>
+		[[nodiscard]]
+		Optional<Type> getOpt(size_t column) const;
+
+		/// @brief `CSVColumnType::String` の列の要素を、ファイル内の UTF-8 文字列のビューとして返します。
+		/// @param column 列
+		/// @return 要素のビュー
+		[[nodiscard]]
+		std::string_view getUTF8View(size_t column) const;
+
+		/// @brief 指定した列の要素を文字列として返します。
+		/// @param column 列
+		/// @return 要素の文字列
+		[[nodiscard]]
+		String getString(size_t column) const;
+
+	private:
+
+		const ColumnarCSV* m_csv = nullptr;
+
+		size_t m_row = 0;
+	};
+
+	/// @brief `ColumnarCSV` の行を先頭から順に走査するイテレータ
+	/// @remark `operator *` は `RowView` を値で返すため、C++17 のイテレータの分類では入力イテレータです。C++20 のイテレータの概念ではランダムアクセスイテレータです。
+	class ColumnarCSV::Iterator
+	{
+	public:
+
+		using iterator_category	= std::input_iterator_tag;
+
+		using iterator_concept	= std::random_access_iterator_tag;
+
+		using value_type		= RowView;
+
+		using difference_type	= std::ptrdiff_t;
+
+		using pointer			= const RowView*;
+
+		using reference			= RowView;
+
+		SIV3D_NODISCARD_CXX20
+		Iterator() = default;
+
+		SIV3D_NODISCARD_CXX20
+		constexpr Iterator(const ColumnarCSV* csv, size_t row) noexcept;
+
+		[[nodiscard]]
+		constexpr RowView operator *() const noexcept;
+
+		[[nodiscard]]
+		constexpr RowView operator [](difference_type n) const noexcept;
+
+		constexpr Iterator& operator ++() noexcept;
+
+		constexpr Iterator operator ++(int) noexcept;
+
+		constexpr Iterator& operator --() noexcept;
+
+		constexpr Iterator operator --(int) noexcept;
+
+		constexpr Iterator& operator +=(difference_type n) noexcept;
+
+		constexpr Iterator& operator -=(difference_type n) noexcept;
+
+		[[nodiscard]]
+		constexpr Iterator operator +(difference_type n) const noexcept;
+
+		[[nodiscard]]
+		constexpr Iterator operator -(difference_type n) const noexcept;
+
+		[[nodiscard]]
+		constexpr difference_type operator -(const Iterator& other) const noexcept;
+
+		[[nodiscard]]
+		constexpr bool operator ==(const Iterator& other) const noexcept;
+
+		[[nodiscard]]
+		constexpr bool operator !=(const Iterator& other) const noexcept;
+
+		[[nodiscard]]
+		constexpr bool operator <(const Iterator& other) const noexcept;
+
+		[[nodiscard]]
+		constexpr bool operator >(const Iterator& other) const noexcept;
+
+		[[nodiscard]]
+		constexpr bool operator <=(const Iterator& other) const noexcept;
+
+		[[nodiscard]]
+		constexpr bool operator >=(const Iterator& other) const noexcept;
+
+		[[nodiscard]]
+		friend constexpr Iterator operator +(const difference_type n, const Iterator& it) noexcept
+		{
+			return (it + n);
+		}
+
+	private:
+
+		const ColumnarCSV* m_csv = nullptr;
+
+		size_t m_row = 0;
+	};
+}
+
+# include "detail/ColumnarCSV.ipp"
@@ -0,0 +1,209 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <initializer_list>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "String.hpp"
+# include "Optional.hpp"
+# include "MathParser.hpp"
+# include "Error.hpp"
+
+namespace s3d
+{
+	/// @brief バイトコードにコンパイルされた数式 | Math expression compiled to flat bytecode
+	/// @remark `MathParser::compile()` で作成します。変数の値を列（配列）で与えて、多数の点をまとめて評価できます。
+	/// @remark 四則演算・比較・論理演算・条件演算子と、組み込みの関数（sin, cos, tan, asin, acos, atan, sinh, cosh, tanh, asinh, acosh, atanh, log2, log10, log, ln, exp, sqrt, sign, rint, abs, min, max, sum, avg）に対応します。
+	/// @remark 定数の畳み込みや `a * x + b` の融合など、`MathParser` と同じ書き換えを行うため、評価結果は `MathParser::eval()` とビット単位で一致します。
+	/// @remark `MathParser::setFunction()` などで登録した関数や演算子は `MathParser` から取得できないため、それらを含む数式はコンパイルに失敗します。
+	class CompiledMathExpression
+	{
+	public:
+
+		/// @brief 一度にまとめて評価する行数
+		static constexpr size_t BatchSize = 256;
+
+		/// @brief 並列に評価する場合に、1 つのタスクが受け持つ行数
+		static constexpr size_t ParallelChunkSize = (BatchSize * 64);
+
+		/// @brief デフォルトコンストラクタ
+		SIV3D_NODISCARD_CXX20
+		CompiledMathExpression() = default;
+
+		/// @brief 数式パーサに設定されている数式をコンパイルします。
+		/// @param parser 数式パーサ
+		/// @remark 定数の値はコンパイル時に埋め込まれます。変数はコンパイル時に登録されているポインタが `eval()` で参照されます。
+		SIV3D_NODISCARD_CXX20
+		explicit CompiledMathExpression(const MathParser& parser);
+
+		/// @brief コンパイルに成功しているかを返します。
+		/// @return コンパイルに成功している場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isValid() const noexcept;
+
+		/// @brief コンパイルに成功しているかを返します。
+		/// @return コンパイルに成功している場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief コンパイル時に発生したエラーメッセージを返します。
+		/// @return コンパイル時に発生したエラーメッセージ。成功した場合は空の文字列
+		[[nodiscard]]
+		const String& getErrorMessage() const noexcept;
+
+		/// @brief コンパイルした数式を返します。
+		/// @return コンパイルした数式
+		[[nodiscard]]
+		const String& getExpression() const noexcept;
+
+		/// @brief 数式で使用されている変数の名前を、列の順番で返します。
+		/// @return 数式で使用されている変数の名前の一覧（名前の昇順）
+		[[nodiscard]]
+		const Array<String>& getVariableNames() const noexcept;
+
+		/// @brief 変数が何番目の列に対応するかを返します。
+		/// @param name 変数名
+		/// @return 列の番号。数式で使用されていない変数の場合は none
+		[[nodiscard]]
+		Optional<size_t> getVariableIndex(StringView name) const;
+
+		/// @brief バイトコードの命令数を返します。
+		/// @return バイトコードの命令数
+		[[nodiscard]]
+		size_t num_instructions() const noexcept;
+
+		/// @brief コンパイル時に登録されていた変数のポインタが指す値を使って、数式を評価します。
+		/// @return 数式を評価した結果。コンパイルに失敗している場合は `Math::NaN`
+		[[nodiscard]]
+		double eval() const;
+
+		/// @brief 変数の値を指定して数式を評価します。
+		/// @param values 変数の値の配列。`getVariableNames()` の順に並べます
+		/// @return 数式を評価した結果。コンパイルに失敗している場合は `Math::NaN`
+		[[nodiscard]]
+		double eval(const double* values) const;
+
+		/// @brief 変数の値の列を指定して、数式をまとめて評価します。
+		/// @param columns 変数ごとの値の列の先頭へのポインタ。`getVariableNames()` の順に並べます
+		/// @param results 結果を格納する配列の先頭へのポインタ
+		/// @param count 評価する行数
+		/// @throw Error 列の数が変数の数と一致しない場合
+		/// @remark 行数が `ParallelChunkSize` を超える場合は、スレッドプール上で並列に評価します。
+		/// @remark コンパイルに失敗している場合は、結果はすべて `Math::NaN` になります。
+		void evalBatch(std::initializer_list<const double*> columns, double* results, size_t count) const;
+
+		/// @brief 変数の値の列を指定して、数式をまとめて評価します。
+		/// @param columns 変数ごとの値の列の先頭へのポインタ。`getVariableNames()` の順に並べます
+		/// @param results 結果を格納する配列の先頭へのポインタ
+		/// @param count 評価する行数
+		/// @throw Error 列の数が変数の数と一致しない場合
+		/// @remark 行数が `ParallelChunkSize` を超える場合は、スレッドプール上で並列に評価します。
+		/// @remark コンパイルに失敗している場合は、結果はすべて `Math::NaN` になります。
+		void evalBatch(const Array<const double*>& columns, double* results, size_t count) const;
+
+		/// @brief 変数の値の列を指定して、数式をまとめて評価します。
+		/// @param columns 変数ごとの値の列。`getVariableNames()` の順に並べ、すべて同じ長さである必要があります
+		/// @param results 結果を格納する配列。列の長さにリサイズされます
+		/// @throw Error 列の数が変数の数と一致しない場合、または列の長さが揃っていない場合
+		void evalBatch(const Array<Array<double>>& columns, Array<double>& results) const;
+
+	private:
+
+		enum class OpCode : uint8
+		{
+			Value,
+
+			Variable,
+
+			// x * a + b
+			VariableMul,
+
+			VariablePow2,
+
+			VariablePow3,
+
+			VariablePow4,
+
+			Add,
+
+			Sub,
+
+			Mul,
+
+			Div,
+
+			Pow,
+
+			Less,
+
+			Greater,
+
+			LessEqual,
+
+			GreaterEqual,
+
+			Equal,
+
+			NotEqual,
+
+			And,
+
+			Or,
+
+			Negate,
+
+			Plus,
+
+			Select,
+
+			Function1,
+
+			FunctionN,
+		};
+
+		struct Instruction
+		{
+			OpCode op = OpCode::Value;
+
+			// 変数の番号、または可変長引数の関数の引数の数
+			uint32 index = 0;
+
+			// VariableMul の係数（Value では 0, Variable では 1）
+			double a = 0.0;
+
+			// VariableMul の定数項、Value の値
+			double b = 0.0;
+
+			MathParser::Fty1 f1 = nullptr;
+
+			double(*fn)(const double*, size_t) = nullptr;
+		};
+
+		class Compiler;
+
+		String m_expression;
+
+		String m_errorMessage;
+
+		Array<Instruction> m_code;
+
+		Array<String> m_variableNames;
+
+		Array<double*> m_variablePointers;
+
+		size_t m_stackSize = 0;
+
+		void evalRows(const double* const* columns, double* results, size_t first, size_t last) const;
+	};
+}
+
+# include "detail/CompiledMathExpression.ipp"
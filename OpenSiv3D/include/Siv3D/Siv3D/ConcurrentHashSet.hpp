@@ -0,0 +1,55 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <shared_mutex>
+# include "Common.hpp"
+# if SIV3D_INTRINSIC(SSE)
+#	define PHMAP_HAVE_SSE2 1
+#	define PHMAP_HAVE_SSSE3 1
+# endif
+# include <ThirdParty/parallel_hashmap/phmap.h>
+# include "HeterogeneousLookupHelper.hpp"
+# include "FormatData.hpp"
+
+namespace s3d
+{
+	/// @brief 複数のスレッドから同時に操作できるハッシュセット
+	/// @tparam Type 要素の型
+	/// @tparam Hash ハッシュ関数の型
+	/// @tparam Eq 要素の比較関数の型
+	/// @tparam Alloc アロケータの型
+	/// @tparam N 内部のセットの個数の log2。内部のセットごとにロックされるため、大きいほど競合が減ります
+	/// @tparam Mutex 内部のセットをロックするミューテックスの型
+	/// @remark `lazy_emplace_l()`, `if_contains()`, `erase_if()` に渡した関数は、要素のロックを保持したまま呼ばれます。
+	/// @remark イテレータはロックを保持しないため、他のスレッドが同時に変更する場合は使用できません。
+	template <class Type,
+		class Hash	= std::conditional_t<std::is_same_v<Type, String>, StringHash, phmap::priv::hash_default_hash<Type>>,
+		class Eq	= std::conditional_t<std::is_same_v<Type, String>, StringCompare, phmap::priv::hash_default_eq<Type>>,
+		class Alloc	= phmap::priv::Allocator<Type>,
+		size_t N	= 4,
+		class Mutex	= std::shared_mutex>
+	using ConcurrentHashSet = phmap::parallel_flat_hash_set<Type, Hash, Eq, Alloc, N, Mutex>;
+
+	template <class Type>
+	inline void swap(ConcurrentHashSet<Type>& a, ConcurrentHashSet<Type>& b) noexcept;
+
+	/// @remark 内部のセットを 1 つずつ共有ロックしながら出力します。
+	template <class Type>
+	inline void Formatter(FormatData& formatData, const ConcurrentHashSet<Type>& set);
+}
+
+# include "detail/ConcurrentHashSet.ipp"
+
+# if SIV3D_INTRINSIC(SSE)
+#	undef PHMAP_HAVE_SSE2
+#	undef PHMAP_HAVE_SSSE3
+# endif
@@ -0,0 +1,59 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <shared_mutex>
+# include "Common.hpp"
+# if SIV3D_INTRINSIC(SSE)
+#	define PHMAP_HAVE_SSE2 1
+#	define PHMAP_HAVE_SSSE3 1
+# endif
+SIV3D_DISABLE_MSVC_WARNINGS_PUSH(26495)
+# include <ThirdParty/parallel_hashmap/phmap.h>
+SIV3D_DISABLE_MSVC_WARNINGS_POP()
+# include "HeterogeneousLookupHelper.hpp"
+# include "FormatData.hpp"
+
+namespace s3d
+{
+	/// @brief 複数のスレッドから同時に操作できるハッシュテーブル
+	/// @tparam Key キーの型
+	/// @tparam Value 値の型
+	/// @tparam Hash ハッシュ関数の型
+	/// @tparam Eq キーの比較関数の型
+	/// @tparam Alloc アロケータの型
+	/// @tparam N 内部のテーブルの個数の log2。内部のテーブルごとにロックされるため、大きいほど競合が減ります
+	/// @tparam Mutex 内部のテーブルをロックするミューテックスの型
+	/// @remark 要素はハッシュ値によって 2^N 個の内部のテーブルに振り分けられ、操作はその内部のテーブルだけをロックして行われます。
+	/// @remark `try_emplace_l()`, `lazy_emplace_l()`, `if_contains()`, `modify_if()`, `erase_if()` に渡した関数は、要素のロックを保持したまま呼ばれます。
+	/// @remark イテレータや `operator[]`, `find()` が返す参照はロックを保持しないため、他のスレッドが同時に変更する場合は使用できません。
+	template <class Key, class Value,
+		class Hash	= std::conditional_t<std::is_same_v<Key, String>, StringHash, phmap::priv::hash_default_hash<Key>>,
+		class Eq	= std::conditional_t<std::is_same_v<Key, String>, StringCompare, phmap::priv::hash_default_eq<Key>>,
+		class Alloc = phmap::priv::Allocator<phmap::priv::Pair<const Key, Value>>,
+		size_t N	= 4,
+		class Mutex	= std::shared_mutex>
+	using ConcurrentHashTable = phmap::parallel_flat_hash_map<Key, Value, Hash, Eq, Alloc, N, Mutex>;
+
+	template <class Key, class Value>
+	inline void swap(ConcurrentHashTable<Key, Value>& a, ConcurrentHashTable<Key, Value>& b) noexcept;
+
+	/// @remark 内部のテーブルを 1 つずつ共有ロックしながら出力します。
+	template <class Key, class Value>
+	inline void Formatter(FormatData& formatData, const ConcurrentHashTable<Key, Value>& table);
+}
+
+# include "detail/ConcurrentHashTable.ipp"
+
+# if SIV3D_INTRINSIC(SSE)
+#	undef PHMAP_HAVE_SSE2
+#	undef PHMAP_HAVE_SSSE3
+# endif
@@ -0,0 +1,193 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "KDTree.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		template <class DatasetAdapter>
+		class KDSubsetAdapter;
+	}
+
+	/// @brief 要素の追加・削除に対応した kd-tree
+	/// @tparam DatasetAdapter kd-tree 用のアダプタ型
+	/// @remark 大きさが 2 倍ずつ異なる静的な kd-tree の集まり（対数フォレスト）で管理し、追加は償却 O(log² N) で行われます。
+	/// @remark 削除された要素は検索結果から除外されるだけで、ツリー内の半数以上が削除されたときに、そのツリーだけが再構築されます。
+	/// @remark データセット内の要素の座標を変更した場合は `update()` を呼ぶ必要があります。ほぼすべての要素が毎フレーム移動する場合は `rebuildIndex()` のほうが高速です。
+	/// @remark nanoflann の `KDTreeSingleIndexDynamicAdaptor` は、要素を 1 つ追加するたびにツリーを構築し、削除した要素の再追加や、削除が多いツリーの再構築に対応していないため、静的な `KDTreeSingleIndexAdaptor` を組み合わせて実装しています。
+	template <class DatasetAdapter>
+	class DynamicKDTree
+	{
+	public:
+
+		using adapter_type	= detail::KDAdapter<DatasetAdapter>;
+
+		using point_type	= typename adapter_type::point_type;
+
+		using element_type	= typename adapter_type::element_type;
+
+		using dataset_type	= typename adapter_type::dataset_type;
+
+		static constexpr int32 Dimensions = adapter_type::Dimensions;
+
+		/// @brief デフォルトコンストラクタ
+		/// @remark データセットが無いため、要素を追加しても無視されます。データセットを指定して構築したものをムーブ代入してください。
+		DynamicKDTree() = default;
+
+		/// @brief kd-tree を構築します。
+		/// @param dataset データセット
+		/// @remark データセットの現在のすべての要素が追加されます。
+		explicit DynamicKDTree(const dataset_type& dataset);
+
+		DynamicKDTree(const DynamicKDTree&) = delete;
+
+		DynamicKDTree(DynamicKDTree&&) = default;
+
+		~DynamicKDTree();
+
+		DynamicKDTree& operator =(const DynamicKDTree&) = delete;
+
+		DynamicKDTree& operator =(DynamicKDTree&&) = default;
+
+		/// @brief データセットの要素を kd-tree に追加します。
+		/// @param index データセット内のインデックス
+		/// @remark すでに追加されている場合は `update()` と同じです。データセットの範囲外のインデックスは無視されます。
+		void insert(size_t index);
+
+		/// @brief データセットの [first, last) の要素を kd-tree に追加します。
+		/// @param first 最初のインデックス
+		/// @param last 最後のインデックスの次
+		void insert(size_t first, size_t last);
+
+		/// @brief 要素を kd-tree から削除します。
+		/// @param index データセット内のインデックス
+		void remove(size_t index);
+
+		/// @brief 座標が変更された要素を kd-tree に反映します。
+		/// @param index データセット内のインデックス
+		void update(size_t index);
+
+		/// @brief 要素が kd-tree に含まれているかを返します。
+		/// @param index データセット内のインデックス
+		/// @return 含まれている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool contains(size_t index) const noexcept;
+
+		/// @brief kd-tree に含まれている要素の個数を返します。
+		/// @return kd-tree に含まれている要素の個数
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		/// @brief kd-tree に含まれているすべての要素から、1 つのツリーを再構築します。
+		void rebuildIndex();
+
+		/// @brief kd-tree を消去し、メモリから解放します。
+		void release();
+
+		/// @brief kd-tree が消費しているメモリのサイズ（バイト）を返します。
+		/// @return kd-tree が消費しているメモリのサイズ（バイト）
+		[[nodiscard]]
+		size_t usedMemory() const;
+
+		/// @brief 指定した座標から最も近い k 個の要素を検索して返します。
+		/// @param k 検索する個数
+		/// @param point 座標
+		/// @return 見つかった要素一覧
+		[[nodiscard]]
+		Array<size_t> knnSearch(size_t k, const point_type& point) const;
+
+		/// @brief 指定した座標から最も近い k 個の要素を検索して取得します。
+		/// @param results 結果を格納する配列
+		/// @param k 検索する個数
+		/// @param point 中心座標
+		void knnSearch(Array<size_t>& results, size_t k, const point_type& point) const;
+
+		/// @brief 指定した座標から最も近い k 個の要素を検索して取得します。
+		/// @param results 結果を格納する配列
+		/// @param distanceSqResults それぞれの要素について、中心からの距離の二乗を格納する配列
+		/// @param k 検索する個数
+		/// @param point 中心座標
+		void knnSearch(Array<size_t>& results, Array<element_type>& distanceSqResults, size_t k, const point_type& point) const;
+
+		/// @brief 指定した座標から指定した半径以内にある要素一覧を検索して返します。
+		/// @param point 中心座標
+		/// @param radius 半径
+		/// @param sortByDistance 結果を中心座標から近い順にソートする場合 `SortByDistance::Yes`, それ以外の場合は `SortByDistance::No`
+		/// @return 指定した位置から指定した半径以内にある要素一覧
+		[[nodiscard]]
+		Array<size_t> radiusSearch(const point_type& point, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
+		/// @brief 指定した座標から指定した半径以内にある要素一覧を検索して取得します。
+		/// @param results 結果を格納する配列
+		/// @param point 中心座標
+		/// @param radius 半径
+		/// @param sortByDistance 結果を中心座標から近い順にソートする場合 `SortByDistance::Yes`, それ以外の場合は `SortByDistance::No`
+		void radiusSearch(Array<size_t>& results, const point_type& point, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
+		/// @brief 複数の座標について、それぞれ最も近い k 個の要素を並列に検索して取得します。
+		/// @param results 結果を格納する配列。`results[i]` に `points[i]` の結果が格納されます
+		/// @param k 検索する個数
+		/// @param points 中心座標の一覧
+		void knnSearchBatch(Array<Array<size_t>>& results, size_t k, const Array<point_type>& points) const;
+
+		/// @brief 複数の座標について、それぞれ指定した半径以内にある要素一覧を並列に検索して取得します。
+		/// @param results 結果を格納する配列。`results[i]` に `points[i]` の結果が格納されます
+		/// @param points 中心座標の一覧
+		/// @param radius 半径
+		/// @param sortByDistance 結果を中心座標から近い順にソートする場合 `SortByDistance::Yes`, それ以外の場合は `SortByDistance::No`
+		void radiusSearchBatch(Array<Array<size_t>>& results, const Array<point_type>& points, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
+	private:
+
+		using subset_adapter_type = detail::KDSubsetAdapter<DatasetAdapter>;
+
+		using index_type = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<element_type, subset_adapter_type, double>, subset_adapter_type, Dimensions, size_t>;
+
+		struct Tree;
+
+		/// @brief ツリーに入る前の要素を保持するバッファの大きさ。最小のツリーの大きさでもあります
+		static constexpr size_t PendingCapacity = 32;
+
+		static constexpr size_t NotIndexed = SIZE_MAX;
+
+		static constexpr size_t PendingSlot = (SIZE_MAX - 1);
+
+		const dataset_type* m_dataset = nullptr;
+
+		// スロット k には最大 (PendingCapacity << k) 個の要素を持つツリーが入る
+		Array<std::unique_ptr<Tree>> m_trees;
+
+		// まだツリーに入っていない要素（総当たりで検索される）
+		Array<size_t> m_pending;
+
+		// データセットの各要素が入っているスロット
+		Array<size_t> m_slots;
+
+		size_t m_size = 0;
+
+		void flushPending();
+
+		void buildTree(size_t slot, Array<size_t>&& indices);
+
+		void collectLiveIndices(size_t slot, Array<size_t>& indices) const;
+
+		template <class ResultSet>
+		void findNeighbors(ResultSet& resultSet, const point_type& point) const;
+	};
+}
+
+# include "detail/DynamicKDTree.ipp"
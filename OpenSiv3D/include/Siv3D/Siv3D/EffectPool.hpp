@@ -0,0 +1,168 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <type_traits>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "Optional.hpp"
+# include "Duration.hpp"
+# include "VariableSpeedStopwatch.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		template <class Type, class = void>
+		struct HasEffectUpdate : std::false_type {};
+
+		template <class Type>
+		struct HasEffectUpdate<Type, std::void_t<decltype(std::declval<Type&>().update(0.0))>>
+			: std::is_convertible<decltype(std::declval<Type&>().update(0.0)), bool> {};
+	}
+
+	/// @brief 同じ型のエフェクトを連続したメモリで管理するエフェクトグループ | Pooled effect group that stores effects of a single type contiguously
+	/// @tparam Type エフェクトの型。`bool update(double timeSec)` メンバ関数を持つか、`double` を受け取り `bool` を返す関数オブジェクトである必要があります
+	/// @remark エフェクトは仮想関数を介さずに 1 つのループで更新され、終了したエフェクトのスロットはメモリを解放せずに再利用されます。
+	/// @remark 最大継続時間、時間経過の速さ、一時停止の扱いは `Effect` と同じです。エフェクトの更新順は追加した順に保たれます。
+	/// @remark `update()` の中でエフェクトを追加した場合、そのエフェクトは次の `update()` から更新されます。
+	template <class Type>
+	class EffectPool
+	{
+	public:
+
+		static_assert(std::disjunction_v<std::is_invocable_r<bool, Type&, double>, detail::HasEffectUpdate<Type>>,
+			"EffectPool<Type>: Type must have `bool update(double)` or be invocable as `bool(double)`");
+
+		using value_type = Type;
+
+		/// @brief エフェクトグループを作成します。
+		/// @param maxLifeTimeSec このエフェクトグループでのエフェクトの最大継続時間（秒）
+		SIV3D_NODISCARD_CXX20
+		explicit EffectPool(double maxLifeTimeSec = 10.0);
+
+		/// @brief エフェクトグループを作成します。
+		/// @param maxLifeTimeSec このエフェクトグループでのエフェクトの最大継続時間（秒）
+		SIV3D_NODISCARD_CXX20
+		explicit EffectPool(const Duration& maxLifeTimeSec);
+
+		/// @brief エフェクトグループに新しいエフェクトを追加します。
+		/// @tparam ...Args コンストラクタ引数の型
+		/// @param ...args コンストラクタ引数
+		/// @remark 空いているスロットがある場合、メモリを確保せずにその場で構築します。
+		template <class... Args>
+		EffectPool& add(Args&&... args);
+
+		/// @brief エフェクトグループがアクティブなエフェクトを持っているかを返します。
+		/// @remark `EffectPool::hasEffects()` と同じ結果を返します。
+		/// @return アクティブなエフェクトがある場合 true, それ以外の場合は false
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief エフェクトグループがアクティブなエフェクトを持っていないかを返します。
+		/// @return アクティブなエフェクトがない場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		/// @brief エフェクトグループがアクティブなエフェクトを持っているかを返します。
+		/// @return アクティブなエフェクトがある場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool hasEffects() const noexcept;
+
+		/// @brief エフェクトグループでアクティブなエフェクトの個数を返します。
+		/// @return アクティブなエフェクトの個数
+		[[nodiscard]]
+		size_t num_effects() const noexcept;
+
+		/// @brief メモリを再確保せずに保持できるエフェクトの個数を返します。
+		/// @return スロットの個数
+		[[nodiscard]]
+		size_t capacity() const noexcept;
+
+		/// @brief スロットをあらかじめ確保します。
+		/// @param n 確保するスロットの個数
+		void reserve(size_t n);
+
+		/// @brief このエフェクトグループの時間経過を一時停止します。
+		/// @remark 一時停止中も `update()` はエフェクトを同じ時刻で更新（描画）します。
+		void pause();
+
+		/// @brief このエフェクトグループの時間経過が一時停止されているかを返します。
+		/// @return 一時停止されている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isPaused() const noexcept;
+
+		/// @brief このエフェクトグループの時間経過が一時停止されている場合、再開します。
+		void resume();
+
+		/// @brief このエフェクトグループの時間経過の速さを、実時間に対する倍率 (2.0 で 2 倍早く経過）で設定します。
+		/// @param speed 時間経過の速さ
+		EffectPool& setSpeed(double speed);
+
+		/// @brief このエフェクトグループの時間経過の速さを返します。
+		/// @return 時間経過の速さ
+		[[nodiscard]]
+		double getSpeed() const noexcept;
+
+		/// @brief このエフェクトグループでのエフェクトの最大継続時間（秒）を設定します。
+		/// @param maxLifeTimeSec このエフェクトグループでのエフェクトの最大継続時間（秒）
+		EffectPool& setMaxLifeTime(double maxLifeTimeSec);
+
+		/// @brief このエフェクトグループでのエフェクトの最大継続時間（秒）を設定します。
+		/// @param maxLifeTimeSec このエフェクトグループでのエフェクトの最大継続時間（秒）
+		void setMaxLifeTime(const Duration& maxLifeTimeSec);
+
+		/// @brief このエフェクトグループでのエフェクトの最大継続時間（秒）を返します。
+		/// @return このエフェクトグループでのエフェクトの最大継続時間（秒）
+		[[nodiscard]]
+		double getMaxLifeTime() const noexcept;
+
+		/// @brief このエフェクトグループ内のエフェクトを更新します。
+		/// @remark 最大継続時間を超えたエフェクトと、更新で false を返したエフェクトは破棄され、そのスロットは再利用されます。
+		void update();
+
+		/// @brief このエフェクトグループ内の全てのエフェクトを、経過時間に関わらず消去します。
+		/// @remark スロットのメモリは保持されます。
+		void clear();
+
+		/// @brief スロットのメモリを、アクティブなエフェクトの個数に合わせて解放します。
+		void shrink_to_fit();
+
+	private:
+
+		// [0, m_size) のスロットに、追加した順にエフェクトが入っている
+		Array<Optional<Type>> m_slots;
+
+		// エフェクトを追加したときの、このエフェクトグループの時刻（秒）
+		Array<double> m_startTimes;
+
+		size_t m_size = 0;
+
+		// update() の中で追加されたエフェクト
+		Array<Type> m_pending;
+
+		Array<double> m_pendingStartTimes;
+
+		VariableSpeedStopwatch m_stopwatch{ StartImmediately::Yes };
+
+		double m_maxLifeTimeSec = 10.0;
+
+		bool m_updating = false;
+
+		template <class... Args>
+		void emplaceSlot(double startTime, Args&&... args);
+
+		[[nodiscard]]
+		static bool UpdateEffect(Type& effect, double timeSec);
+	};
+}
+
+# include "detail/EffectPool.ipp"
@@ -13,12 +13,65 @@
 # include "Common.hpp"
 # include "Array.hpp"
 # include "PointVector.hpp"
+# include "Optional.hpp"
+# include "GridAddressMode.hpp"
 
 namespace s3d
 {
 	template <class Type, class Allocator>
 	class Grid;
 
+	/// @brief `Grid::stencil_update()` に渡される、注目要素とその近傍への読み取りアクセス
+	/// @tparam Type 要素の型
+	template <class Type>
+	class GridStencil
+	{
+	public:
+
+		using value_type = Type;
+
+		SIV3D_NODISCARD_CXX20
+		GridStencil(const Type* data, Size size, Point pos, bool interior, GridAddressMode addressMode, const Type& borderValue) noexcept;
+
+		/// @brief 注目要素から (dx, dy) だけ離れた要素を返します。
+		/// @param dx X 方向のオフセット
+		/// @param dy Y 方向のオフセット
+		/// @remark 範囲外の場合は `GridAddressMode` に従って解決されます。オフセットは `stencil_update()` に渡した半径以内である必要があります。
+		/// @return 要素
+		[[nodiscard]]
+		const Type& operator ()(int32 dx, int32 dy) const noexcept;
+
+		/// @brief 注目要素から offset だけ離れた要素を返します。
+		/// @param offset オフセット
+		/// @return 要素
+		[[nodiscard]]
+		const Type& operator ()(Point offset) const noexcept;
+
+		/// @brief 注目要素を返します。
+		/// @return 注目要素
+		[[nodiscard]]
+		const Type& center() const noexcept;
+
+		/// @brief 注目要素の位置を返します。
+		/// @return 注目要素の位置
+		[[nodiscard]]
+		Point pos() const noexcept;
+
+	private:
+
+		const Type* m_data;
+
+		Size m_size;
+
+		Point m_pos;
+
+		bool m_interior;
+
+		GridAddressMode m_addressMode;
+
+		const Type* m_borderValue;
+	};
+
 	template <class Type, class Allocator>
 	inline void Formatter(FormatData& formatData, const Grid<Type, Allocator>& value);
 
@@ -524,6 +577,28 @@ namespace s3d
 		[[nodiscard]]
 		Grid stable_sorted_by(Fty f)&&;
 
+		/// @brief 各要素について、近傍の要素から新しい値を計算して更新します。
+		/// @tparam Fty 更新関数の型
+		/// @param buffer 書き込み先として使うバッファ。呼び出し後は更新前の内容が入ります
+		/// @param radius 近傍の半径（この範囲が端からはみ出さない要素では範囲外の解決を省略します）
+		/// @param addressMode 範囲外アクセスの扱い。`GridAddressMode::Border` の場合、範囲外は `value_type{}` になります
+		/// @param f 更新関数。`f(const GridStencil<Type>&)` の戻り値が新しい値になります
+		/// @remark すべての要素は更新前の値から計算されます（ダブルバッファ）。フレームをまたいで buffer を使い回すとメモリの再確保を避けられます。
+		/// @remark 十分に大きな二次元配列は、キャッシュに収まる 2D タイルに分割して並列に処理されます。
+		/// @return *this
+		template <class Fty, std::enable_if_t<std::is_invocable_r_v<Type, Fty, const GridStencil<Type>&>>* = nullptr>
+		Grid& stencil_update(Grid& buffer, int32 radius, GridAddressMode addressMode, Fty f);
+
+		/// @brief 各要素について、近傍の要素から新しい値を計算して更新します。範囲外は borderValue として扱います。
+		/// @tparam Fty 更新関数の型
+		/// @param buffer 書き込み先として使うバッファ。呼び出し後は更新前の内容が入ります
+		/// @param radius 近傍の半径
+		/// @param borderValue 範囲外の要素の値
+		/// @param f 更新関数。`f(const GridStencil<Type>&)` の戻り値が新しい値になります
+		/// @return *this
+		template <class Fty, std::enable_if_t<std::is_invocable_r_v<Type, Fty, const GridStencil<Type>&>>* = nullptr>
+		Grid& stencil_update(Grid& buffer, int32 radius, const value_type& borderValue, Fty f);
+
 		template <class T = Type, std::enable_if_t<Meta::HasPlus_v<T>>* = nullptr>
 		[[nodiscard]]
 		auto sum() const;
@@ -546,6 +621,46 @@ namespace s3d
 		[[nodiscard]]
 		Array<Type> values_at(std::initializer_list<Point> indices) const;
 
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		/// @brief 各要素とその位置を引数に関数を並列に呼びます。
+		/// @tparam Fty 関数の型
+		/// @param f 関数
+		/// @remark キャッシュに収まる大きさの、行の境界で区切った帯に分割して処理します。f は複数のスレッドから同時に呼ばれます。
+		/// @return *this
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Point, Type&>>* = nullptr>
+		Grid& parallel_each_index(Fty f);
+
+		/// @brief 各要素とその位置を引数に関数を並列に呼びます。
+		/// @tparam Fty 関数の型
+		/// @param f 関数
+		/// @return *this
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Point, Type>>* = nullptr>
+		const Grid& parallel_each_index(Fty f) const;
+
+		/// @brief 各要素に関数を並列に適用した結果からなる新しい二次元配列を返します。
+		/// @tparam Fty 関数の型
+		/// @param f 関数
+		/// @return 新しい二次元配列
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>* = nullptr>
+		[[nodiscard]]
+		auto parallel_map(Fty f) const;
+
+		/// @brief 要素を並列に畳み込みます。
+		/// @tparam R 結果の型
+		/// @tparam Fty 畳み込み関数の型
+		/// @tparam CombineFty 部分結果を結合する関数の型
+		/// @param identity 単位元。各帯の部分結果の初期値と、部分結果を結合するときの初期値に使います
+		/// @param f 畳み込み関数。`f(R, Type)` の戻り値が新しい部分結果になります
+		/// @param combine 部分結果を結合する関数。結合則を満たし、`combine(identity, r) == r` である必要があります
+		/// @remark 行の帯ごとに部分結果を求め、帯の順に combine で結合します。例えば二乗和は `parallel_reduce(0.0, [](double s, double x) { return (s + x * x); }, std::plus<>{})` です。
+		/// @return 畳み込んだ結果
+		template <class R, class Fty, class CombineFty>
+		[[nodiscard]]
+		R parallel_reduce(R identity, Fty f, CombineFty combine) const;
+
+	# endif
+
 		[[nodiscard]]
 		friend bool operator ==(const Grid& lhs, const Grid& rhs)
 		{
@@ -620,6 +735,9 @@ namespace s3d
 		size_type m_width = 0;
 
 		size_type m_height = 0;
+
+		template <class Fty>
+		Grid& stencilUpdate(Grid& buffer, int32 radius, GridAddressMode addressMode, const value_type& borderValue, Fty& f);
 	};
 
 	// deduction guide
@@ -0,0 +1,32 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief 二次元配列の範囲外アクセスの扱い | Addressing mode for out-of-range Grid access
+	enum class GridAddressMode : uint8
+	{
+		/// @brief 繰り返し
+		Repeat,
+
+		/// @brief ミラーで繰り返し
+		Mirror,
+
+		/// @brief 繰り返しなし（端の要素を使う）
+		Clamp,
+
+		/// @brief 繰り返しなしで範囲外は指定した値
+		Border,
+	};
+}
@@ -24,4 +24,20 @@ namespace s3d
 
 		virtual void drawDebug(const Vec2& emitterPosition) const = 0;
 	};
+
+	/// @brief 一度に複数のパーティクルを放出できるエミッタ | Emitter that can emit particles in bulk
+	/// @remark `BulkParticleSystem2D` は、このインタフェースを持つエミッタに対しては `emitBulk()` を 1 フレームに 1 回だけ呼びます。
+	/// @remark `CircleEmitter2D`, `ArcEmitter2D`, `RectEmitter2D`, `PolygonEmitter2D` などの組み込みのエミッタは `IEmitter2D` を継承しており、このインタフェースを持ちません。`BulkParticleSystem2D` で使った場合も、パーティクルは 1 つずつ `emit()` で放出されます。
+	struct IBulkEmitter2D : IEmitter2D
+	{
+		/// @brief パーティクルをまとめて放出します。
+		/// @param emitterPosition エミッタの位置
+		/// @param startSpeed 初速
+		/// @param dst 放出したパーティクルの書き込み先
+		/// @param count 放出するパーティクルの個数
+		/// @remark デフォルトの実装は `emit()` を count 回呼びます。
+		virtual void emitBulk(const Vec2& emitterPosition, double startSpeed, Emission2D* dst, size_t count);
+	};
 }
+
+# include "detail/IEmitter2D.ipp"
@@ -0,0 +1,126 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Array.hpp"
+# include "Image.hpp"
+# include "ImageProcessing.hpp"
+
+namespace s3d
+{
+	/// @brief 複数の画像処理を 1 回の走査にまとめて行うパイプライン | Fused multi-step image processing pipeline
+	/// @remark 画像は行の帯に分けられ、それぞれの帯がすべての処理を通ってから出力されます。途中の結果はキャッシュに収まる大きさの一時バッファにしか書き込まれないため、処理ごとに画像全体を読み書きするよりもメモリ帯域を節約できます。
+	/// @remark ぼかしの処理がある場合、帯の上下にはカーネルの半径の分だけ余分な行が計算されます。結果は、それぞれの処理を `ImageProcessing` の関数で順に行った場合と一致します。
+	/// @remark 帯は共有のスレッドプールで並列に処理されます。
+	class ImagePipeline
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		ImagePipeline() = default;
+
+		/// @brief 色を反転する処理を追加します。
+		/// @return *this
+		ImagePipeline& negate();
+
+		/// @brief グレイスケールに変換する処理を追加します。
+		/// @return *this
+		ImagePipeline& grayscale();
+
+		/// @brief 二値化する処理を追加します。
+		/// @param threshold 閾値。グレイスケール値がこれより大きいピクセルが白になります
+		/// @param invertColor 白と黒を反転する場合 `InvertColor::Yes`
+		/// @return *this
+		ImagePipeline& threshold(uint8 threshold, InvertColor invertColor = InvertColor::No);
+
+		/// @brief ボックスブラーをかける処理を追加します。
+		/// @param size カーネルの半径（ピクセル）
+		/// @param borderType 画像の外側の扱い
+		/// @return *this
+		ImagePipeline& blur(int32 size, BorderType borderType = BorderType::Reflect_101);
+
+		/// @brief ボックスブラーをかける処理を追加します。
+		/// @param horizontal 水平方向のカーネルの半径（ピクセル）
+		/// @param vertical 垂直方向のカーネルの半径（ピクセル）
+		/// @param borderType 画像の外側の扱い
+		/// @return *this
+		ImagePipeline& blur(int32 horizontal, int32 vertical, BorderType borderType = BorderType::Reflect_101);
+
+		/// @brief ガウスぼかしをかける処理を追加します。
+		/// @param size カーネルの半径（ピクセル）
+		/// @param borderType 画像の外側の扱い
+		/// @remark 結果は `ImageProcessing::GaussianBlur()` と一致します。`Image::gaussianBlurred()` とは丸めの方法が異なるため、一致しません。
+		/// @return *this
+		ImagePipeline& gaussianBlur(int32 size, BorderType borderType = BorderType::Reflect_101);
+
+		/// @brief ガウスぼかしをかける処理を追加します。
+		/// @param horizontal 水平方向のカーネルの半径（ピクセル）
+		/// @param vertical 垂直方向のカーネルの半径（ピクセル）
+		/// @param borderType 画像の外側の扱い
+		/// @remark 結果は `ImageProcessing::GaussianBlur()` と一致します。`Image::gaussianBlurred()` とは丸めの方法が異なるため、一致しません。
+		/// @return *this
+		ImagePipeline& gaussianBlur(int32 horizontal, int32 vertical, BorderType borderType = BorderType::Reflect_101);
+
+		/// @brief 追加されている処理の個数を返します。
+		/// @return 追加されている処理の個数
+		[[nodiscard]]
+		size_t num_steps() const noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		/// @brief すべての処理を削除します。
+		void clear();
+
+		/// @brief パイプラインを画像に適用し、結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @remark 処理が 1 つもない場合は src がコピーされます。
+		void apply(const Image& src, Image& dst) const;
+
+		/// @brief パイプラインを画像に適用した新しい画像を返します。
+		/// @param src 画像
+		/// @return パイプラインを適用した新しい画像
+		[[nodiscard]]
+		Image apply(const Image& src) const;
+
+	private:
+
+		enum class StepType : uint8
+		{
+			Negate,
+
+			Grayscale,
+
+			Threshold,
+
+			Filter,
+		};
+
+		struct Step
+		{
+			StepType type = StepType::Negate;
+
+			uint8 threshold = 0;
+
+			InvertColor invertColor = InvertColor::No;
+
+			detail::ImageFilterKernel kernel{};
+		};
+
+		Array<Step> m_steps;
+
+		static void ApplyPixels(const Step& step, const Color* src, Color* dst, size_t count) noexcept;
+	};
+}
+
+# include "detail/ImagePipeline.ipp"
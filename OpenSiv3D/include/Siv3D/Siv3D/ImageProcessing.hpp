@@ -60,6 +60,98 @@ namespace s3d
 		void Inpaint(const Image& image, const Image& maskImage, const Color& maskColor, Image& result, int32 radius = 2);
 
 		void Inpaint(const Image& image, const Grid<uint8>& maskImage, Image& result, int32 radius = 2);
+
+		/// @brief 画像の色を反転した結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @remark 行の帯ごとに並列に処理されます。src と dst は同じ画像でもかまいません。
+		void Negate(const Image& src, Image& dst);
+
+		/// @brief 画像をグレイスケールに変換した結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @remark 行の帯ごとに並列に処理されます。src と dst は同じ画像でもかまいません。
+		void Grayscale(const Image& src, Image& dst);
+
+		/// @brief 画像を二値化した結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @param threshold 閾値。グレイスケール値がこれより大きいピクセルが白になります
+		/// @param invertColor 白と黒を反転する場合 `InvertColor::Yes`
+		/// @remark 行の帯ごとに並列に処理されます。src と dst は同じ画像でもかまいません。アルファ値は保たれます。
+		void Threshold(const Image& src, Image& dst, uint8 threshold, InvertColor invertColor = InvertColor::No);
+
+		/// @brief 画像にモザイクをかけた結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @param size モザイクのブロックの一辺の大きさ（ピクセル）
+		void Mosaic(const Image& src, Image& dst, int32 size);
+
+		/// @brief 画像にモザイクをかけた結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @param horizontal モザイクのブロックの幅（ピクセル）
+		/// @param vertical モザイクのブロックの高さ（ピクセル）
+		/// @remark ブロックの行ごとに並列に処理されます。
+		void Mosaic(const Image& src, Image& dst, int32 horizontal, int32 vertical);
+
+		/// @brief 画像を時計回りに 90°* n 回転した結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @param n 時計回りに 90° 回転させる回数（負の場合は反時計回り）
+		/// @remark キャッシュに収まる大きさのタイルごとに並列に処理されます。
+		void Rotate90(const Image& src, Image& dst, int32 n = 1);
+
+		/// @brief 画像にボックスブラーをかけた結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @param size カーネルの半径（ピクセル）。カーネルの一辺の大きさは (size * 2 + 1) です
+		/// @param borderType 画像の外側の扱い
+		void Blur(const Image& src, Image& dst, int32 size, BorderType borderType = BorderType::Reflect_101);
+
+		/// @brief 画像にボックスブラーをかけた結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @param horizontal 水平方向のカーネルの半径（ピクセル）
+		/// @param vertical 垂直方向のカーネルの半径（ピクセル）
+		/// @param borderType 画像の外側の扱い
+		/// @remark 分離可能なフィルタとして、行の帯ごとに並列に処理されます。計算量はカーネルの大きさによりません。
+		void Blur(const Image& src, Image& dst, int32 horizontal, int32 vertical, BorderType borderType = BorderType::Reflect_101);
+
+		/// @brief 画像にガウスぼかしをかけた結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @param size カーネルの半径（ピクセル）。カーネルの一辺の大きさは (size * 2 + 1) です
+		/// @param borderType 画像の外側の扱い
+		/// @remark `Image::gaussianBlurred()` とは丸めの方法が異なるため、結果が一致しません。
+		void GaussianBlur(const Image& src, Image& dst, int32 size, BorderType borderType = BorderType::Reflect_101);
+
+		/// @brief 画像にガウスぼかしをかけた結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @param horizontal 水平方向のカーネルの半径（ピクセル）
+		/// @param vertical 垂直方向のカーネルの半径（ピクセル）
+		/// @param borderType 画像の外側の扱い
+		/// @remark 分離可能なフィルタとして、行の帯ごとに並列に処理されます。カーネルの重みは OpenCV と同じ方法で決まりますが、計算は浮動小数点数で行います。
+		/// @remark `Image::gaussianBlurred()`（OpenCV の固定小数点による実装）とは丸めの方法が異なり、結果が一致しないため、`Image::gaussianBlurred()` の代わりにはなりません。同じ結果が必要な場合は `Image::gaussianBlurred()` を使ってください。
+		void GaussianBlur(const Image& src, Image& dst, int32 horizontal, int32 vertical, BorderType borderType = BorderType::Reflect_101);
+
+		/// @brief 画像を拡大縮小した結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @param width 新しい幅（ピクセル）
+		/// @param height 新しい高さ（ピクセル）
+		/// @param interpolation 補間アルゴリズム
+		void Scale(const Image& src, Image& dst, int32 width, int32 height, InterpolationAlgorithm interpolation = InterpolationAlgorithm::Auto);
+
+		/// @brief 画像を拡大縮小した結果を dst に書き込みます。
+		/// @param src 画像
+		/// @param dst 結果を格納する画像。十分な容量がある場合、メモリの再確保は起こりません
+		/// @param size 新しい幅と高さ（ピクセル）
+		/// @param interpolation 補間アルゴリズム
+		/// @remark `Nearest`, `Linear`, `Area` は行の帯ごとに並列に処理されます。`Area` で拡大する場合は `Linear` になります。
+		/// @remark `Cubic`, `Lanczos` および、縮小でない場合の `Auto` は `Image::scaled()` で処理されるため、dst の容量は再利用されません。
+		void Scale(const Image& src, Image& dst, const Size& size, InterpolationAlgorithm interpolation = InterpolationAlgorithm::Auto);
 	}
 }
 
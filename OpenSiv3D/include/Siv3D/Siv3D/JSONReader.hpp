@@ -0,0 +1,271 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <string>
+# include <string_view>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "String.hpp"
+# include "Optional.hpp"
+# include "Blob.hpp"
+# include "MemoryMappedFileView.hpp"
+# include "Parse.hpp"
+# include "Format.hpp"
+# include "Unicode.hpp"
+# include "MemoryViewReader.hpp"
+# include "JSON.hpp"
+
+namespace s3d
+{
+	/// @brief `JSONReader` が読み取ったトークンの種類
+	enum class JSONTokenType : uint8
+	{
+		/// @brief まだ読み取りを開始していない
+		None,
+
+		/// @brief オブジェクトの開始 `{`
+		BeginObject,
+
+		/// @brief オブジェクトの終了 `}`
+		EndObject,
+
+		/// @brief 配列の開始 `[`
+		BeginArray,
+
+		/// @brief 配列の終了 `]`
+		EndArray,
+
+		/// @brief オブジェクトのキー
+		Key,
+
+		/// @brief 文字列
+		String,
+
+		/// @brief 数値
+		Number,
+
+		/// @brief `true` または `false`
+		Bool,
+
+		/// @brief `null`
+		Null,
+
+		/// @brief データの終端
+		End,
+
+		/// @brief 文法エラー
+		Error,
+	};
+
+	/// @brief DOM を構築せずに JSON を先頭から順に読み取るプル型のリーダー | Pull-style (SAX-like) JSON reader
+	/// @remark ファイルはメモリマップトファイルとして開かれ、キーや文字列はデータ内の UTF-8 のビューとして参照されます。`String` への変換は要求されたときにだけ行われます。
+	/// @remark `extract()` はパスが一致しない部分木をトークンに分解せずに読み飛ばします。
+	class JSONReader
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		JSONReader() = default;
+
+		/// @brief JSON ファイルを開きます。
+		/// @param path ファイルパス
+		SIV3D_NODISCARD_CXX20
+		explicit JSONReader(FilePathView path);
+
+		/// @brief Blob に格納された JSON データを読み取ります。
+		/// @param blob JSON データ。リーダーが所有します
+		SIV3D_NODISCARD_CXX20
+		explicit JSONReader(Blob&& blob);
+
+		/// @brief メモリ上の UTF-8 の JSON データを読み取ります。
+		/// @param utf8 JSON データ。リーダーよりも長く存在する必要があります
+		SIV3D_NODISCARD_CXX20
+		explicit JSONReader(std::string_view utf8);
+
+		JSONReader(const JSONReader&) = delete;
+
+		JSONReader(JSONReader&&) = default;
+
+		JSONReader& operator =(const JSONReader&) = delete;
+
+		JSONReader& operator =(JSONReader&&) = default;
+
+		/// @brief JSON ファイルを開きます。
+		/// @param path ファイルパス
+		/// @return ファイルを開けた場合 true, それ以外の場合は false
+		bool open(FilePathView path);
+
+		/// @brief Blob に格納された JSON データを読み取ります。
+		/// @param blob JSON データ。リーダーが所有します
+		void open(Blob&& blob);
+
+		/// @brief メモリ上の UTF-8 の JSON データを読み取ります。
+		/// @param utf8 JSON データ。リーダーよりも長く存在する必要があります
+		void open(std::string_view utf8);
+
+		/// @brief データを閉じます。
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const noexcept;
+
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief 先頭から読み直します。
+		void reset();
+
+		/// @brief 次のトークンを読み取ります。
+		/// @return 読み取ったトークンの種類
+		JSONTokenType nextToken();
+
+		/// @brief 現在のトークンの種類を返します。
+		/// @return 現在のトークンの種類
+		[[nodiscard]]
+		JSONTokenType tokenType() const noexcept;
+
+		/// @brief 現在の値を読み飛ばします。
+		/// @remark 現在のトークンが `BeginObject` または `BeginArray` の場合は、対応する `EndObject` または `EndArray` まで進みます。`Key` の場合は、そのキーの値を読み飛ばします。それ以外の場合は何もしません。
+		/// @remark 読み飛ばした部分は、括弧と文字列の対応以外は検査されません。
+		/// @return 成功した場合 true, 文法エラーの場合は false
+		bool skipValue();
+
+		/// @brief 現在のトークンが入っているオブジェクトや配列の深さを返します。
+		/// @return 深さ。最上位の値は 0
+		[[nodiscard]]
+		size_t depth() const noexcept;
+
+		/// @brief 現在の値の位置を JSON Pointer 形式で返します。
+		/// @return 現在の値の位置（例: `/features/3/geometry`）。`Key` の場合はそのキーの値の位置
+		[[nodiscard]]
+		String path() const;
+
+		/// @brief 現在のトークンのデータ内の UTF-8 のビューを返します。
+		/// @return トークンのビュー。`Key` と `String` はクオーテーションを除いた、エスケープを処理していない文字列
+		[[nodiscard]]
+		std::string_view raw() const noexcept;
+
+		/// @brief 現在のトークン（`Key` または `String`）がエスケープシーケンスを含むかを返します。
+		/// @return エスケープシーケンスを含む場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool hasEscape() const noexcept;
+
+		/// @brief 現在のトークン（`Key` または `String`）を、エスケープを処理した UTF-8 文字列として返します。
+		/// @return UTF-8 文字列
+		[[nodiscard]]
+		std::string getUTF8() const;
+
+		/// @brief 現在のトークン（`Key` または `String`）を文字列として返します。
+		/// @return 文字列
+		[[nodiscard]]
+		String getString() const;
+
+		/// @brief 現在のトークン（`Number`）を整数として返します。
+		/// @return 整数。整数として表現できない場合は none
+		[[nodiscard]]
+		Optional<int64> getInt64() const;
+
+		/// @brief 現在のトークン（`Number`）を浮動小数点数として返します。
+		/// @return 浮動小数点数。数値でない場合は none
+		[[nodiscard]]
+		Optional<double> getDouble() const;
+
+		/// @brief 現在のトークン（`Bool`）を bool として返します。
+		/// @return bool 値。`Bool` でない場合は none
+		[[nodiscard]]
+		Optional<bool> getBool() const;
+
+		/// @brief 現在のトークンを指定した型の値として返します。
+		/// @tparam Type 値の型
+		/// @return 値。変換できない場合は none
+		template <class Type>
+		[[nodiscard]]
+		Optional<Type> getOpt() const;
+
+		/// @brief 現在の値を読み取って JSON オブジェクトを作成します。
+		/// @return 現在の値の JSON オブジェクト。`BeginObject` や `BeginArray` の場合は、対応する終了トークンまで進みます
+		[[nodiscard]]
+		JSON readJSON();
+
+		/// @brief 指定したパスに一致する値を列挙します。
+		/// @tparam Fty 関数の型
+		/// @param pathPattern JSON Pointer 形式のパス。`*` は任意のキーまたはインデックスに一致します（例: `/features/*/properties/name`）
+		/// @param f 値の先頭のトークンに位置する `JSONReader&` を引数にとる関数
+		/// @remark f の呼び出し後、値の読み残しは読み飛ばされます。f は値の範囲を超えて読み進めてはいけません。
+		/// @remark 現在の位置からデータの終端まで読み進めます。
+		/// @return 一致した値の個数
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, JSONReader&>>* = nullptr>
+		size_t extract(StringView pathPattern, Fty f);
+
+	private:
+
+		struct Frame
+		{
+			std::string_view key;
+
+			size_t count = 0;
+
+			bool isObject = false;
+
+			bool keyEscaped = false;
+
+			bool afterKey = false;
+		};
+
+		MemoryMappedFileView m_file;
+
+		Blob m_blob;
+
+		const char* m_data = nullptr;
+
+		size_t m_size = 0;
+
+		size_t m_begin = 0;
+
+		size_t m_pos = 0;
+
+		size_t m_tokenBegin = 0;
+
+		std::string_view m_raw;
+
+		Array<Frame> m_stack;
+
+		JSONTokenType m_type = JSONTokenType::None;
+
+		bool m_escaped = false;
+
+		bool m_started = false;
+
+		void setData(const char* data, size_t size);
+
+		void skipWhitespace() noexcept;
+
+		JSONTokenType setError() noexcept;
+
+		JSONTokenType readValue();
+
+		bool readString() noexcept;
+
+		[[nodiscard]]
+		bool isValueToken() const noexcept;
+
+		[[nodiscard]]
+		size_t pathLength() const noexcept;
+
+		[[nodiscard]]
+		bool matchPrefix(const Array<std::string>& pattern, size_t length) const;
+
+		bool skipToDepth(size_t depth);
+	};
+}
+
+# include "detail/JSONReader.ipp"
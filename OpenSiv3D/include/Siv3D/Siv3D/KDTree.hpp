@@ -125,6 +125,20 @@ namespace s3d
 		/// @param sortByDistance 結果を中心座標から近い順にソートする場合 `SortByDistance::Yes`, それ以外の場合は `SortByDistance::No`
 		void radiusSearch(Array<size_t>& results, const point_type& point, element_type radius, const SortByDistance sortByDistance = SortByDistance::No) const;
 
+		/// @brief 複数の座標について、それぞれ最も近い k 個の要素を並列に検索して取得します。
+		/// @param results 結果を格納する配列。`results[i]` に `points[i]` の結果が格納されます
+		/// @param k 検索する個数
+		/// @param points 中心座標の一覧
+		/// @remark results の各要素の容量は再利用されるため、フレームをまたいで使い回すとメモリの再確保を避けられます。
+		void knnSearchBatch(Array<Array<size_t>>& results, size_t k, const Array<point_type>& points) const;
+
+		/// @brief 複数の座標について、それぞれ指定した半径以内にある要素一覧を並列に検索して取得します。
+		/// @param results 結果を格納する配列。`results[i]` に `points[i]` の結果が格納されます
+		/// @param points 中心座標の一覧
+		/// @param radius 半径
+		/// @param sortByDistance 結果を中心座標から近い順にソートする場合 `SortByDistance::Yes`, それ以外の場合は `SortByDistance::No`
+		void radiusSearchBatch(Array<Array<size_t>>& results, const Array<point_type>& points, element_type radius, SortByDistance sortByDistance = SortByDistance::No) const;
+
 	private:
 
 		adapter_type m_adapter;
@@ -20,6 +20,8 @@
 
 namespace s3d
 {
+	class CompiledMathExpression;
+
 	/// @brief 数式パーサ
 	class MathParser
 	{
@@ -235,6 +237,12 @@ namespace s3d
 		[[nodiscard]]
 		HSV evalHSV() const;
 
+		/// @brief 数式をバイトコードにコンパイルします。
+		/// @return コンパイルされた数式。多数の点をまとめて評価する場合は `CompiledMathExpression::evalBatch()` を使います
+		/// @remark コンパイルに失敗した場合は、`CompiledMathExpression::getErrorMessage()` でエラーメッセージを取得できます。
+		[[nodiscard]]
+		CompiledMathExpression compile() const;
+
 	private:
 
 		class MathParserDetail;
@@ -254,3 +262,5 @@ namespace s3d
 	[[nodiscard]]
 	Optional<double> EvalOpt(StringView expression);
 }
+
+# include "CompiledMathExpression.hpp"
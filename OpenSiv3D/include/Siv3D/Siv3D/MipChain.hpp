@@ -0,0 +1,149 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "MathConstants.hpp"
+# include "Image.hpp"
+# include "ImageProcessing.hpp"
+# include "MipmapFilter.hpp"
+# include "PredefinedYesNo.hpp"
+# include "SIMD.hpp"
+
+namespace s3d
+{
+	/// @brief 1 つの連続したバッファに格納されたミップマップチェーン | Mip chain stored in a single contiguous buffer
+	/// @remark レベル 0 は元の画像で、レベル n はレベル n - 1 を縮小したものです。各レベルは直前のレベルを 1 回だけ読んで作成されます。
+	/// @remark 各レベルは行の帯ごとに共有のスレッドプールで並列に作成されます。
+	/// @remark 再び `build()` を呼んだとき、バッファに十分な容量がある場合はメモリの再確保が起こりません。
+	class MipChain
+	{
+	public:
+
+		/// @brief ミップマップの 1 つのレベルの情報
+		struct Level
+		{
+			/// @brief 幅と高さ（ピクセル）
+			Size size;
+
+			/// @brief バッファの先頭からのオフセット（バイト）
+			size_t offset;
+
+			/// @brief 1 行のバイト数
+			size_t stride;
+		};
+
+		SIV3D_NODISCARD_CXX20
+		MipChain() = default;
+
+		/// @brief 画像からミップマップチェーンを作成します。
+		/// @param src 画像
+		/// @param filter 縮小フィルタ
+		/// @param gammaCorrect sRGB の色を線形の色空間で平均する場合 `GammaCorrect::Yes`
+		SIV3D_NODISCARD_CXX20
+		explicit MipChain(const Image& src, MipmapFilter filter = MipmapFilter::Box, GammaCorrect gammaCorrect = GammaCorrect::No);
+
+		/// @brief 画像からミップマップチェーンを作成します。
+		/// @param src 画像
+		/// @param maxLevel 元の画像を除く、ミップマップの最大個数
+		/// @param filter 縮小フィルタ
+		/// @param gammaCorrect sRGB の色を線形の色空間で平均する場合 `GammaCorrect::Yes`
+		SIV3D_NODISCARD_CXX20
+		MipChain(const Image& src, size_t maxLevel, MipmapFilter filter = MipmapFilter::Box, GammaCorrect gammaCorrect = GammaCorrect::No);
+
+		/// @brief 画像からミップマップチェーンを作り直します。
+		/// @param src 画像
+		/// @param filter 縮小フィルタ
+		/// @param gammaCorrect sRGB の色を線形の色空間で平均する場合 `GammaCorrect::Yes`
+		void build(const Image& src, MipmapFilter filter = MipmapFilter::Box, GammaCorrect gammaCorrect = GammaCorrect::No);
+
+		/// @brief 画像からミップマップチェーンを作り直します。
+		/// @param src 画像
+		/// @param maxLevel 元の画像を除く、ミップマップの最大個数
+		/// @param filter 縮小フィルタ
+		/// @param gammaCorrect sRGB の色を線形の色空間で平均する場合 `GammaCorrect::Yes`
+		void build(const Image& src, size_t maxLevel, MipmapFilter filter = MipmapFilter::Box, GammaCorrect gammaCorrect = GammaCorrect::No);
+
+		/// @brief レベルの個数を返します。
+		/// @return 元の画像を含むレベルの個数
+		[[nodiscard]]
+		size_t num_levels() const noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		/// @brief すべてのレベルを消去します。
+		/// @remark バッファの容量は保たれます。
+		void clear() noexcept;
+
+		/// @brief すべてのレベルを消去し、メモリを解放します。
+		void release();
+
+		/// @brief レベルの情報を返します。
+		/// @param level レベル
+		/// @return レベルの情報
+		[[nodiscard]]
+		const Level& level(size_t level) const;
+
+		/// @brief すべてのレベルの情報を返します。
+		/// @return すべてのレベルの情報
+		[[nodiscard]]
+		const Array<Level>& levels() const noexcept;
+
+		/// @brief レベルの幅と高さを返します。
+		/// @param level レベル
+		/// @return 幅と高さ（ピクセル）
+		[[nodiscard]]
+		Size size(size_t level) const;
+
+		/// @brief レベルの先頭のピクセルへのポインタを返します。
+		/// @param level レベル
+		/// @return レベルの先頭のピクセルへのポインタ
+		[[nodiscard]]
+		const Color* data(size_t level) const;
+
+		/// @brief バッファの先頭へのポインタを返します。
+		/// @return バッファの先頭へのポインタ
+		[[nodiscard]]
+		const Color* data() const noexcept;
+
+		/// @brief バッファのサイズ（バイト）を返します。
+		/// @return バッファのサイズ（バイト）
+		[[nodiscard]]
+		size_t size_bytes() const noexcept;
+
+		/// @brief レベルをコピーした画像を返します。
+		/// @param level レベル
+		/// @return レベルをコピーした画像
+		[[nodiscard]]
+		Image toImage(size_t level) const;
+
+		/// @brief 元の画像を除くすべてのレベルをコピーした画像の配列を返します。
+		/// @return `ImageProcessing::GenerateMips()` と同じ形式の画像の配列
+		[[nodiscard]]
+		Array<Image> toMips() const;
+
+	private:
+
+		Array<Color> m_data;
+
+		Array<Level> m_levels;
+
+		void downsample(const Level& srcLevel, const Level& dstLevel, MipmapFilter filter, GammaCorrect gammaCorrect);
+	};
+}
+
+# include "detail/MipChain.ipp"
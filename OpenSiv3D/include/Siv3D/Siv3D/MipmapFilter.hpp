@@ -0,0 +1,26 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+
+namespace s3d
+{
+	/// @brief ミップマップの縮小フィルタ
+	enum class MipmapFilter : uint8
+	{
+		/// @brief ボックスフィルタ（2x2 の平均）
+		Box,
+
+		/// @brief Kaiser 窓関数を用いたフィルタ（高品質）
+		Kaiser,
+	};
+}
@@ -0,0 +1,318 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <utility>
+# include <type_traits>
+# include <cstring>
+# include <atomic>
+# include <functional>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "HashTable.hpp"
+# include "PointVector.hpp"
+# include "NavMesh.hpp"
+# include "Hash.hpp"
+# include "Time.hpp"
+# include "Threading.hpp"
+# include "TaskGroup.hpp"
+
+namespace s3d
+{
+	/// @brief `NavMeshPathfinder` の統計情報
+	struct NavMeshPathStats
+	{
+		/// @brief 経路の要求の数
+		uint64 numRequests = 0;
+
+		/// @brief キャッシュ（同じバッチ内の同じ要求を含む）から経路を返した数
+		uint64 numCacheHits = 0;
+
+		/// @brief `NavMesh::query()` で経路を計算した数
+		uint64 numQueries = 0;
+
+		/// @brief キャッシュから追い出された経路の数
+		uint64 numEvictions = 0;
+
+		/// @brief `NavMesh::query()` にかかった時間の合計（ナノ秒）
+		uint64 queryTimeNanosec = 0;
+
+		/// @brief キャッシュの検索を含む、すべての要求の処理にかかった時間の合計（ナノ秒）
+		uint64 totalTimeNanosec = 0;
+
+		/// @brief キャッシュのヒット率を返します。
+		/// @return キャッシュのヒット率。要求が無い場合は 0.0
+		[[nodiscard]]
+		double hitRate() const noexcept;
+
+		/// @brief `NavMesh::query()` 1 回あたりの平均時間（ミリ秒）を返します。
+		/// @return `NavMesh::query()` 1 回あたりの平均時間（ミリ秒）。計算していない場合は 0.0
+		[[nodiscard]]
+		double averageQueryMillisec() const noexcept;
+	};
+
+	/// @brief 経路のキャッシュとバッチ検索を備えたナビメッシュの経路探索 | NavMesh path queries with an LRU path cache and batching
+	/// @remark 出発地点と目的地の座標を `quantization` の大きさのセルに量子化したものと、エリアのコストの組をキーとして、計算した経路を LRU キャッシュに保持します。
+	/// @remark キャッシュにヒットした場合は、同じセルの組について最初に計算された経路を、始点と終点を要求された出発地点と目的地に置き換えて返します。経路の端点が要求と別のセルにある（目的地に到達できない経路など）場合は、その端点は置き換えません。
+	/// @remark 端点を置き換えた線分は、実際に計算した線分から水平方向に最大でセルの対角線の長さ（セルの大きさの √2 倍）だけずれます。ナビメッシュは壁から `NavMeshConfig::agentRadius` だけ離れた領域に作られるため、セルの大きさが `agentRadius / √2` 以下であれば、ナビメッシュ上の出発地点と目的地について、置き換えた線分が壁を通り抜けることはありません。
+	/// @remark `build()` で構築した場合、セルの大きさは `setQuantization()` で設定していなければ、引数の `NavMeshConfig` から `agentRadius / √2` に設定されます。コンストラクタで既存のナビメッシュを渡した場合は `agentRadius` がわからないため、デフォルトでは座標が完全に一致する場合のみキャッシュにヒットします。
+	/// @remark `setQuantization()` でこれより大きいセルを指定すると、キャッシュのヒット率は上がりますが、セルが壁をまたぐ場合に、返される経路の最初と最後の線分がナビメッシュの外（壁の中や壁の向こう側）を通ることがあります。開けた場所でのみ使う場合や、経路をそのまま移動に使わない場合にのみ指定してください。
+	/// @remark `build()` で構築した場合、バッチ検索でキャッシュにヒットしなかった経路は、スレッドプールのスレッドごとに同じ引数から構築したナビメッシュを使って並列に計算されます。
+	/// @remark `build()` でナビメッシュを再構築するとキャッシュは破棄されます。同じナビメッシュを別の `NavMesh` オブジェクトから再構築した場合は `clearCache()` を呼んでください。
+	/// @remark このクラスはスレッドセーフではありません。
+	class NavMeshPathfinder
+	{
+	public:
+
+		using AreaCosts = Array<std::pair<int32, double>>;
+
+		/// @brief キャッシュに保持する経路の数のデフォルト値
+		static constexpr size_t DefaultCacheCapacity = 1024;
+
+		/// @brief 座標を量子化するセルの大きさのデフォルト値
+		/// @remark 0 で、座標が完全に一致する場合のみキャッシュにヒットします。`build()` で構築した場合は `NavMeshConfig::agentRadius / √2` に置き換えられます。
+		static constexpr double DefaultQuantization = 0.0;
+
+		/// @brief デフォルトコンストラクタ
+		SIV3D_NODISCARD_CXX20
+		NavMeshPathfinder() = default;
+
+		/// @brief 経路探索を作成します。
+		/// @param navMesh ナビメッシュ
+		/// @param cacheCapacity キャッシュに保持する経路の数。0 の場合はキャッシュしません
+		/// @param quantization 座標を量子化するセルの大きさ。0 以下の場合は座標が完全に一致する場合のみキャッシュにヒットします
+		SIV3D_NODISCARD_CXX20
+		explicit NavMeshPathfinder(const NavMesh& navMesh, size_t cacheCapacity = DefaultCacheCapacity, double quantization = DefaultQuantization);
+
+		/// @brief ナビメッシュを構築し、キャッシュを破棄します。
+		/// @tparam ...Args `NavMesh::build()` の引数の型
+		/// @param ...args `NavMesh::build()` の引数
+		/// @return ナビメッシュの構築に成功した場合 true, それ以外の場合は false
+		/// @remark `setQuantization()` やコンストラクタでセルの大きさを指定していない場合は、引数の `NavMeshConfig` （指定されていない場合はそのデフォルト値）の `agentRadius / √2` をセルの大きさにします。
+		/// @remark バッチ検索で並列に経路を計算するスレッドのナビメッシュを構築するため、引数のコピーを保持します。スレッドごとのナビメッシュは、最初に並列計算が必要になったときに、スレッドプールのワーカースレッドの数（`Threading::GetConcurrency() - 1` 個）だけ構築され、呼び出し元のスレッドは `navMesh()` を使います。それぞれが `navMesh()` と同じだけのメモリを使います。スレッドプールの無い環境（pthread を使わない Web 版など）では構築されず、経路は呼び出し元のスレッドで順に計算されます。
+		template <class... Args>
+		bool build(Args&&... args);
+
+		/// @brief 使用するナビメッシュを設定し、キャッシュを破棄します。
+		/// @param navMesh ナビメッシュ
+		/// @remark この関数で設定したナビメッシュでは、バッチ検索の経路は呼び出し元のスレッドで順に計算されます。
+		void setNavMesh(const NavMesh& navMesh);
+
+		/// @brief 使用しているナビメッシュを返します。
+		/// @return 使用しているナビメッシュ
+		[[nodiscard]]
+		const NavMesh& navMesh() const noexcept;
+
+		/// @brief 目的地もしくは目的地の近くまで到達できるナビメッシュ上の経路を計算します。
+		/// @param start 出発地点の座標
+		/// @param end 目的地の座標
+		/// @param areaCosts エリアのコスト
+		/// @return ナビメッシュ上の経路
+		[[nodiscard]]
+		Array<Vec2> query(const Vec2& start, const Vec2& end, const AreaCosts& areaCosts = {});
+
+		/// @brief 目的地もしくは目的地の近くまで到達できるナビメッシュ上の経路を計算します。
+		/// @param start 出発地点の座標
+		/// @param end 目的地の座標
+		/// @param dst 経路の格納先
+		/// @param areaCosts エリアのコスト
+		void query(const Vec2& start, const Vec2& end, Array<Vec2>& dst, const AreaCosts& areaCosts = {});
+
+		/// @brief 目的地もしくは目的地の近くまで到達できるナビメッシュ上の経路を計算します。
+		/// @param start 出発地点の座標
+		/// @param end 目的地の座標
+		/// @param areaCosts エリアのコスト
+		/// @return ナビメッシュ上の経路
+		[[nodiscard]]
+		Array<Vec3> query(const Vec3& start, const Vec3& end, const AreaCosts& areaCosts = {});
+
+		/// @brief 目的地もしくは目的地の近くまで到達できるナビメッシュ上の経路を計算します。
+		/// @param start 出発地点の座標
+		/// @param end 目的地の座標
+		/// @param dst 経路の格納先
+		/// @param areaCosts エリアのコスト
+		void query(const Vec3& start, const Vec3& end, Array<Vec3>& dst, const AreaCosts& areaCosts = {});
+
+		/// @brief 複数の出発地点と目的地の組について、経路をまとめて計算します。
+		/// @param requests 出発地点と目的地の組の一覧
+		/// @param results 経路の格納先。`results[i]` に `requests[i]` の経路が格納されます
+		/// @param areaCosts エリアのコスト
+		/// @remark キャッシュにヒットしない要求のうち、同じキーを持つものは 1 回だけ計算されます。
+		/// @remark `build()` で構築した場合、キャッシュにヒットしない要求はスレッドごとのナビメッシュで並列に計算されます。`setNavMesh()` やコンストラクタで設定したナビメッシュでは、呼び出し元のスレッドで順に計算されます。
+		void queryBatch(const Array<std::pair<Vec2, Vec2>>& requests, Array<Array<Vec2>>& results, const AreaCosts& areaCosts = {});
+
+		/// @brief 複数の出発地点と目的地の組について、経路をまとめて計算します。
+		/// @param requests 出発地点と目的地の組の一覧
+		/// @param areaCosts エリアのコスト
+		/// @return 経路の一覧。`requests[i]` の経路が i 番目に格納されます
+		[[nodiscard]]
+		Array<Array<Vec2>> queryBatch(const Array<std::pair<Vec2, Vec2>>& requests, const AreaCosts& areaCosts = {});
+
+		/// @brief 複数の出発地点と目的地の組について、経路をまとめて計算します。
+		/// @param requests 出発地点と目的地の組の一覧
+		/// @param results 経路の格納先。`results[i]` に `requests[i]` の経路が格納されます
+		/// @param areaCosts エリアのコスト
+		/// @remark キャッシュにヒットしない要求のうち、同じキーを持つものは 1 回だけ計算されます。
+		/// @remark `build()` で構築した場合、キャッシュにヒットしない要求はスレッドごとのナビメッシュで並列に計算されます。`setNavMesh()` やコンストラクタで設定したナビメッシュでは、呼び出し元のスレッドで順に計算されます。
+		void queryBatch(const Array<std::pair<Vec3, Vec3>>& requests, Array<Array<Vec3>>& results, const AreaCosts& areaCosts = {});
+
+		/// @brief 複数の出発地点と目的地の組について、経路をまとめて計算します。
+		/// @param requests 出発地点と目的地の組の一覧
+		/// @param areaCosts エリアのコスト
+		/// @return 経路の一覧。`requests[i]` の経路が i 番目に格納されます
+		[[nodiscard]]
+		Array<Array<Vec3>> queryBatch(const Array<std::pair<Vec3, Vec3>>& requests, const AreaCosts& areaCosts = {});
+
+		/// @brief キャッシュに保持されている経路の数を返します。
+		/// @return キャッシュに保持されている経路の数
+		[[nodiscard]]
+		size_t cacheSize() const noexcept;
+
+		/// @brief キャッシュに保持する経路の最大数を返します。
+		/// @return キャッシュに保持する経路の最大数
+		[[nodiscard]]
+		size_t cacheCapacity() const noexcept;
+
+		/// @brief キャッシュに保持する経路の最大数を設定します。
+		/// @param cacheCapacity キャッシュに保持する経路の最大数
+		/// @remark 現在の数より小さくした場合は、古いものから破棄されます。
+		void setCacheCapacity(size_t cacheCapacity);
+
+		/// @brief 座標を量子化するセルの大きさを返します。
+		/// @return 座標を量子化するセルの大きさ
+		[[nodiscard]]
+		double quantization() const noexcept;
+
+		/// @brief 座標を量子化するセルの大きさを設定し、キャッシュを破棄します。
+		/// @param quantization 座標を量子化するセルの大きさ。0 以下の場合は座標が完全に一致する場合のみキャッシュにヒットします
+		/// @remark 設定した後は、`build()` で `NavMeshConfig::agentRadius / √2` に置き換えられることはありません。`agentRadius / √2` より大きい値を指定した場合、経路の最初と最後の線分が壁を通り抜けることがあります。
+		void setQuantization(double quantization);
+
+		/// @brief キャッシュを破棄します。
+		void clearCache();
+
+		/// @brief 統計情報を返します。
+		/// @return 統計情報
+		[[nodiscard]]
+		const NavMeshPathStats& getStats() const noexcept;
+
+		/// @brief 統計情報をリセットします。
+		void resetStats() noexcept;
+
+	private:
+
+		struct Key
+		{
+			int64 start[3];
+
+			int64 end[3];
+
+			uint32 dimensions;
+
+			uint32 areaCostsIndex;
+
+			[[nodiscard]]
+			friend bool operator ==(const Key& a, const Key& b) noexcept
+			{
+				return (std::memcmp(&a, &b, sizeof(Key)) == 0);
+			}
+		};
+
+		struct KeyHash
+		{
+			[[nodiscard]]
+			size_t operator ()(const Key& key) const noexcept
+			{
+				return static_cast<size_t>(Hash::XXHash3(key));
+			}
+		};
+
+		struct Entry
+		{
+			Key key;
+
+			Array<Vec3> path;
+
+			uint32 prev;
+
+			uint32 next;
+		};
+
+		static constexpr uint32 NullIndex = UINT32_MAX;
+
+		/// @brief 区別して保持するエリアのコストの組の最大数。超えた場合はキャッシュを破棄します
+		static constexpr size_t MaxAreaCostsSets = 64;
+
+		NavMesh m_navMesh;
+
+		size_t m_cacheCapacity = DefaultCacheCapacity;
+
+		double m_quantization = DefaultQuantization;
+
+		// セルの大きさを `build()` に渡した `NavMeshConfig` の `agentRadius / √2` に合わせる場合 true
+		bool m_quantizationFromConfig = true;
+
+		// 双方向リストで LRU の順序を管理する（先頭が最も新しい）
+		Array<Entry> m_entries;
+
+		uint32 m_head = NullIndex;
+
+		uint32 m_tail = NullIndex;
+
+		HashTable<Key, uint32, KeyHash> m_index;
+
+		Array<AreaCosts> m_areaCostsSets;
+
+		NavMeshPathStats m_stats;
+
+		// スレッドごとのナビメッシュを構築する関数。`build()` で構築した場合のみ設定される
+		std::function<bool(NavMesh&)> m_builder;
+
+		// 並列に経路を計算するワーカースレッドごとのナビメッシュ。呼び出し元のスレッドは m_navMesh を使う
+		Array<NavMesh> m_workers;
+
+		[[nodiscard]]
+		int64 quantize(double value) const noexcept;
+
+		[[nodiscard]]
+		uint32 getAreaCostsIndex(const AreaCosts& areaCosts);
+
+		[[nodiscard]]
+		Key makeKey(const Vec3& start, const Vec3& end, uint32 dimensions, uint32 areaCostsIndex) const noexcept;
+
+		[[nodiscard]]
+		bool isInCell(const Vec3& point, const int64(&cell)[3]) const noexcept;
+
+		[[nodiscard]]
+		const Array<Vec3>* find(const Key& key);
+
+		template <class PointType>
+		void insert(const Key& key, const Array<PointType>& path);
+
+		template <class PointType>
+		void restoreEndpoints(const Key& key, const PointType& start, const PointType& end, Array<PointType>& path) const noexcept;
+
+		[[nodiscard]]
+		size_t prepareWorkers(size_t count);
+
+		void unlink(uint32 index) noexcept;
+
+		void pushFront(uint32 index) noexcept;
+
+		template <class PointType>
+		void queryImpl(const PointType& start, const PointType& end, Array<PointType>& dst, const AreaCosts& areaCosts);
+
+		template <class PointType>
+		void queryBatchImpl(const Array<std::pair<PointType, PointType>>& requests, Array<PointType>* results, const AreaCosts& areaCosts);
+	};
+}
+
+# include "detail/NavMeshPathfinder.ipp"
@@ -0,0 +1,167 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Array.hpp"
+# include "Allocator.hpp"
+# include "PointVector.hpp"
+# include "Particle2D.hpp"
+# include "SIMD.hpp"
+
+namespace s3d
+{
+	/// @brief `ParticleArray2D` の各成分の配列の先頭へのポインタ
+	/// @tparam Float `float` または `const float`
+	template <class Float>
+	struct ParticleStreams2D
+	{
+		Float* positionX;
+
+		Float* positionY;
+
+		Float* velocityX;
+
+		Float* velocityY;
+
+		Float* startColorR;
+
+		Float* startColorG;
+
+		Float* startColorB;
+
+		Float* startColorA;
+
+		Float* startSize;
+
+		Float* rotation;
+
+		Float* startAngularVelocity;
+
+		Float* startLifeTime;
+
+		Float* remainingLifeTime;
+	};
+
+	/// @brief パーティクルを成分ごとの配列（SoA）で保持する固定容量の配列 | Fixed-capacity structure-of-arrays particle storage
+	/// @remark メモリは容量を変更したときにだけ確保され、寿命が尽きたパーティクルは末尾の要素との入れ替えで削除されます。
+	/// @remark 位置・速度・回転・寿命の更新は、SSE で 4 つずつまとめて行われます。
+	class ParticleArray2D
+	{
+	public:
+
+		/// @brief 成分の数
+		static constexpr size_t NumStreams = 13;
+
+		/// @brief `update()` を並列に実行する最小のパーティクル数
+		static constexpr size_t ParallelThreshold = 32768;
+
+		/// @brief 並列に更新する際、1 つのタスクが受け持つパーティクル数
+		static constexpr size_t ParallelChunkSize = 8192;
+
+		SIV3D_NODISCARD_CXX20
+		ParticleArray2D() = default;
+
+		/// @brief 配列を作成します。
+		/// @param capacity 容量
+		SIV3D_NODISCARD_CXX20
+		explicit ParticleArray2D(size_t capacity);
+
+		/// @brief 容量を変更します。
+		/// @param capacity 新しい容量
+		/// @remark 容量が現在のパーティクル数より小さい場合、末尾のパーティクルは削除されます。
+		void setCapacity(size_t capacity);
+
+		/// @brief 容量を返します。
+		/// @return 容量
+		[[nodiscard]]
+		size_t capacity() const noexcept;
+
+		/// @brief パーティクル数を返します。
+		/// @return パーティクル数
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		[[nodiscard]]
+		bool isFull() const noexcept;
+
+		/// @brief パーティクルを末尾に追加します。
+		/// @param particle パーティクル
+		/// @return 追加した場合 true, 容量がいっぱいで追加できなかった場合は false
+		bool push_back(const Particle2D& particle) noexcept;
+
+		/// @brief パーティクル数を変更します。
+		/// @param size 新しいパーティクル数。容量を超える場合は容量になります
+		/// @remark 増えたパーティクルの値は不定です。`streams()` で直接書き込むために使います。
+		void resize(size_t size) noexcept;
+
+		/// @brief パーティクルを返します。
+		/// @param index インデックス
+		/// @return パーティクル
+		[[nodiscard]]
+		Particle2D get(size_t index) const noexcept;
+
+		/// @brief パーティクルを書き換えます。
+		/// @param index インデックス
+		/// @param particle パーティクル
+		void set(size_t index, const Particle2D& particle) noexcept;
+
+		/// @brief すべてのパーティクルを `Particle2D::update()` と同じ式で更新します。
+		/// @param deltaTime 経過時間（秒）
+		/// @param deltaVelocity 速度の変化量
+		/// @remark パーティクル数が `ParallelThreshold` 以上の場合は、チャンクに分けて並列に更新します。
+		void update(float deltaTime, const Float2& deltaVelocity) noexcept;
+
+		/// @brief [first, last) のパーティクルを `Particle2D::update()` と同じ式で更新します。
+		/// @param deltaTime 経過時間（秒）
+		/// @param deltaVelocity 速度の変化量
+		/// @param first 最初のインデックス
+		/// @param last 最後のインデックスの次
+		void update(float deltaTime, const Float2& deltaVelocity, size_t first, size_t last) noexcept;
+
+		/// @brief 寿命が尽きたパーティクルを、末尾の要素との入れ替えで削除します。
+		/// @return 削除したパーティクル数
+		/// @remark パーティクルの順序は保たれません。
+		size_t removeDead() noexcept;
+
+		/// @brief すべてのパーティクルを削除します。
+		/// @remark 容量は保たれます。
+		void clear() noexcept;
+
+		/// @brief 各成分の配列の先頭へのポインタを返します。
+		/// @return 各成分の配列の先頭へのポインタ。各配列は `size()` 個の有効な要素を持ちます
+		[[nodiscard]]
+		ParticleStreams2D<float> streams() noexcept;
+
+		/// @brief 各成分の配列の先頭へのポインタを返します。
+		/// @return 各成分の配列の先頭へのポインタ。各配列は `size()` 個の有効な要素を持ちます
+		[[nodiscard]]
+		ParticleStreams2D<const float> streams() const noexcept;
+
+	private:
+
+		// 成分ごとに m_stride 個ずつ並んだ 1 つの配列
+		Array<float, Allocator<float, 16>> m_data;
+
+		size_t m_stride = 0;
+
+		size_t m_capacity = 0;
+
+		size_t m_size = 0;
+
+		void moveParticle(size_t from, size_t to) noexcept;
+	};
+}
+
+# include "detail/ParticleArray2D.ipp"
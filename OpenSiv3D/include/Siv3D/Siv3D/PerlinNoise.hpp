@@ -16,6 +16,10 @@
 # include "PointVector.hpp"
 # include "Random.hpp"
 # include "Noise.hpp"
+# include "Grid.hpp"
+# include "Image.hpp"
+# include "SIMD.hpp"
+# include "TaskGroup.hpp"
 
 namespace s3d
 {
@@ -141,6 +145,44 @@ namespace s3d
 		value_type normalizedOctave3D0_1(Vector3D<value_type> xyz, int32 octaves, value_type persistence = value_type(0.5)) const noexcept;
 
 
+		/// @brief グリッドの各要素に 2D のオクターブノイズを書き込みます。
+		/// @param grid 書き込み先のグリッド
+		/// @param offset 左上の要素に対応するノイズの座標
+		/// @param scale 隣り合う要素の間のノイズの座標の差
+		/// @param octaves オクターブ数
+		/// @param persistence 持続度
+		/// @remark `grid[y][x]` には `octave2D((offset.x + x * scale), (offset.y + y * scale), octaves, persistence)` が書き込まれます。
+		/// @remark 複数の点を SIMD でまとめて計算し、行ごとに並列に処理します。スカラー版と同じ順序で演算するため、コンパイラが乗算と加算を FMA に縮約しない限り結果はビット単位で一致します（縮約された場合も差は 1e-5 未満です）。
+		void fill(Grid<value_type>& grid, Vector2D<value_type> offset, value_type scale, int32 octaves = 1, value_type persistence = value_type(0.5)) const;
+
+		/// @brief グリッドの各要素に 3D のオクターブノイズの断面を書き込みます。
+		/// @param grid 書き込み先のグリッド
+		/// @param offset 左上の要素に対応するノイズの座標。z を時間とともに変化させるとアニメーションするノイズになります
+		/// @param scale 隣り合う要素の間のノイズの座標の差
+		/// @param octaves オクターブ数
+		/// @param persistence 持続度
+		/// @remark `grid[y][x]` には `octave3D((offset.x + x * scale), (offset.y + y * scale), offset.z, octaves, persistence)` が書き込まれます。
+		void fill(Grid<value_type>& grid, Vector3D<value_type> offset, value_type scale, int32 octaves = 1, value_type persistence = value_type(0.5)) const;
+
+		/// @brief 画像の各ピクセルに 2D のオクターブノイズをグレースケールで書き込みます。
+		/// @param image 書き込み先の画像
+		/// @param offset 左上のピクセルに対応するノイズの座標
+		/// @param scale 隣り合うピクセルの間のノイズの座標の差
+		/// @param octaves オクターブ数
+		/// @param persistence 持続度
+		/// @remark 各ピクセルの明るさは `normalizedOctave2D0_1((offset.x + x * scale), (offset.y + y * scale), octaves, persistence)` です。
+		void fill(Image& image, Vector2D<value_type> offset, value_type scale, int32 octaves = 1, value_type persistence = value_type(0.5)) const;
+
+		/// @brief 画像の各ピクセルに 3D のオクターブノイズの断面をグレースケールで書き込みます。
+		/// @param image 書き込み先の画像
+		/// @param offset 左上のピクセルに対応するノイズの座標。z を時間とともに変化させるとアニメーションするノイズになります
+		/// @param scale 隣り合うピクセルの間のノイズの座標の差
+		/// @param octaves オクターブ数
+		/// @param persistence 持続度
+		/// @remark 各ピクセルの明るさは `normalizedOctave3D0_1((offset.x + x * scale), (offset.y + y * scale), offset.z, octaves, persistence)` です。
+		void fill(Image& image, Vector3D<value_type> offset, value_type scale, int32 octaves = 1, value_type persistence = value_type(0.5)) const;
+
+
 		[[nodiscard]]
 		constexpr const state_type& serialize() const noexcept;
 
@@ -155,6 +197,11 @@ namespace s3d
 		static constexpr Float Lerp(Float a, Float b, Float t) noexcept;
 
 		static constexpr Float Grad(uint8 hash, Float x, Float y, Float z) noexcept;
+
+		void fillRow(value_type* out, size_t width, value_type x0, value_type y, value_type z, bool is3D, value_type scale, int32 octaves, value_type persistence) const noexcept;
+
+		template <class Fty>
+		static void ForEachRows(size_t width, size_t height, Fty f);
 	};
 
 	using PerlinNoiseF	= BasicPerlinNoise<float>;
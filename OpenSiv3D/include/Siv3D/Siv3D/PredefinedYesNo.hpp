@@ -121,4 +121,7 @@ namespace s3d
 
 	/// @brief リガチャ（合字）を使う
 	using Ligature = YesNo<struct Ligature_tag>;
+
+	/// @brief 線形の色空間で計算する（ガンマ補正を行う）
+	using GammaCorrect = YesNo<struct GammaCorrect_tag>;
 }
@@ -0,0 +1,204 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <utility>
+# include "Common.hpp"
+# include "Array.hpp"
+# include "HashTable.hpp"
+# include "2DShapes.hpp"
+# include "Geometry2D.hpp"
+
+namespace s3d
+{
+	/// @brief 一様グリッドによる 2D の空間ハッシュ（ブロードフェーズ用） | Uniform spatial hash for 2D broad-phase collision detection
+	/// @tparam Id 要素を識別する型（ハッシュ可能である必要があります）
+	/// @remark 要素はバウンディングボックスで登録され、重なっているセルすべてに格納されます。
+	/// @remark 同じ要素の組は、2 つのバウンディングボックスの共通部分の左上を含むセルでのみ報告されるため、重複の除去に追加のメモリを使いません。
+	/// @remark 要素の移動や削除ではセルの配列の容量が保たれるため、十分に使った後はメモリの再確保が起こりません。
+	template <class Id>
+	class SpatialHash2D
+	{
+	public:
+
+		using id_type = Id;
+
+		/// @brief セルの一辺の長さのデフォルト値
+		static constexpr double DefaultCellSize = 64.0;
+
+		SIV3D_NODISCARD_CXX20
+		SpatialHash2D() = default;
+
+		/// @brief 空間ハッシュを作成します。
+		/// @param cellSize セルの一辺の長さ。登録する要素の典型的な大きさ程度が適切です
+		SIV3D_NODISCARD_CXX20
+		explicit SpatialHash2D(double cellSize);
+
+		/// @brief 要素を追加します。
+		/// @param id 要素の ID
+		/// @param bounds 要素のバウンディングボックス
+		/// @remark すでに追加されている場合は `update()` と同じです。
+		void insert(const Id& id, const RectF& bounds);
+
+		/// @brief 複数の要素をまとめて追加します。
+		/// @param items 要素の ID とバウンディングボックスの組の一覧
+		void insert(const Array<std::pair<Id, RectF>>& items);
+
+		/// @brief 要素のバウンディングボックスを更新します。
+		/// @param id 要素の ID
+		/// @param bounds 新しいバウンディングボックス
+		/// @remark 重なっているセルが変わらない場合は、バウンディングボックスを書き換えるだけです。
+		void update(const Id& id, const RectF& bounds);
+
+		/// @brief 要素を削除します。
+		/// @param id 要素の ID
+		void remove(const Id& id);
+
+		/// @brief 要素が含まれているかを返します。
+		/// @param id 要素の ID
+		/// @return 含まれている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool contains(const Id& id) const;
+
+		/// @brief 要素の個数を返します。
+		/// @return 要素の個数
+		[[nodiscard]]
+		size_t size() const noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		/// @brief セルの一辺の長さを返します。
+		/// @return セルの一辺の長さ
+		[[nodiscard]]
+		double cellSize() const noexcept;
+
+		/// @brief すべての要素を削除します。
+		/// @remark セルの配列の容量は保たれます。
+		void clear();
+
+		/// @brief 空のセルを削除し、メモリを解放します。
+		void shrink_to_fit();
+
+		/// @brief 指定した領域とバウンディングボックスが重なる要素を列挙します。
+		/// @tparam Fty 関数の型
+		/// @param area 領域
+		/// @param f 要素の ID を引数にとる関数
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, const Id&>>* = nullptr>
+		void query(const RectF& area, Fty f) const;
+
+		/// @brief 指定した領域とバウンディングボックスが重なる要素を取得します。
+		/// @param area 領域
+		/// @param results 結果を格納する配列（クリアされてから追加されます）
+		void query(const RectF& area, Array<Id>& results) const;
+
+		/// @brief バウンディングボックスが重なる要素の組を列挙します。
+		/// @tparam Fty 関数の型
+		/// @param f 2 つの要素の ID を引数にとる関数
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, const Id&, const Id&>>* = nullptr>
+		void queryPairs(Fty f) const;
+
+		/// @brief バウンディングボックスが重なる要素の組を取得します。
+		/// @param pairs 結果を格納する配列（クリアされてから追加されます）
+		void queryPairs(Array<std::pair<Id, Id>>& pairs) const;
+
+		/// @brief 別の空間ハッシュの要素と、バウンディングボックスが重なる組を列挙します。
+		/// @tparam OtherId 別の空間ハッシュの要素の ID の型
+		/// @tparam Fty 関数の型
+		/// @param other 別の空間ハッシュ
+		/// @param f この空間ハッシュの要素の ID と、別の空間ハッシュの要素の ID を引数にとる関数
+		template <class OtherId, class Fty, std::enable_if_t<std::is_invocable_v<Fty, const Id&, const OtherId&>>* = nullptr>
+		void queryPairs(const SpatialHash2D<OtherId>& other, Fty f) const;
+
+		/// @brief 別の空間ハッシュの要素と、バウンディングボックスが重なる組を取得します。
+		/// @tparam OtherId 別の空間ハッシュの要素の ID の型
+		/// @param other 別の空間ハッシュ
+		/// @param pairs 結果を格納する配列（クリアされてから追加されます）
+		template <class OtherId>
+		void queryPairs(const SpatialHash2D<OtherId>& other, Array<std::pair<Id, OtherId>>& pairs) const;
+
+	private:
+
+		template <class OtherId>
+		friend class SpatialHash2D;
+
+		struct CellRange
+		{
+			int32 x0, y0, x1, y1;
+
+			[[nodiscard]]
+			bool operator ==(const CellRange& other) const noexcept
+			{
+				return ((x0 == other.x0) && (y0 == other.y0) && (x1 == other.x1) && (y1 == other.y1));
+			}
+		};
+
+		struct Entry
+		{
+			Id id;
+
+			RectF bounds;
+
+			CellRange cells;
+		};
+
+		double m_cellSize = DefaultCellSize;
+
+		double m_inverseCellSize = (1.0 / DefaultCellSize);
+
+		Array<Entry> m_entries;
+
+		HashTable<Id, uint32> m_indices;
+
+		HashTable<uint64, Array<uint32>> m_cells;
+
+		[[nodiscard]]
+		static constexpr uint64 CellKey(int32 x, int32 y) noexcept;
+
+		[[nodiscard]]
+		CellRange toCellRange(const RectF& bounds) const noexcept;
+
+		void addToCells(uint32 index, const CellRange& cells);
+
+		void removeFromCells(uint32 index, const CellRange& cells);
+
+		void replaceInCells(uint32 oldIndex, uint32 newIndex, const CellRange& cells);
+	};
+
+	namespace Geometry2D
+	{
+		/// @brief 要素の組の一覧から、円同士が交差しない組を取り除きます。 | Removes pairs whose circles do not intersect.
+		/// @tparam IdA 1 つ目の要素の ID の型
+		/// @tparam IdB 2 つ目の要素の ID の型
+		/// @tparam CircleOfA 1 つ目の要素の ID から円を返す関数の型
+		/// @tparam CircleOfB 2 つ目の要素の ID から円を返す関数の型
+		/// @param pairs 要素の組の一覧
+		/// @param circleOfA 1 つ目の要素の ID から円を返す関数
+		/// @param circleOfB 2 つ目の要素の ID から円を返す関数
+		/// @remark 組ごとに `Geometry2D::Intersect(const Circle&, const Circle&)` で判定するため、結果は一致します。
+		template <class IdA, class IdB, class CircleOfA, class CircleOfB>
+		void FilterIntersectingCircles(Array<std::pair<IdA, IdB>>& pairs, CircleOfA circleOfA, CircleOfB circleOfB);
+
+		/// @brief 要素の組の一覧から、長方形同士が交差しない組を取り除きます。 | Removes pairs whose rectangles do not intersect.
+		/// @tparam IdA 1 つ目の要素の ID の型
+		/// @tparam IdB 2 つ目の要素の ID の型
+		/// @tparam RectOfA 1 つ目の要素の ID から長方形を返す関数の型
+		/// @tparam RectOfB 2 つ目の要素の ID から長方形を返す関数の型
+		/// @param pairs 要素の組の一覧
+		/// @param rectOfA 1 つ目の要素の ID から長方形を返す関数
+		/// @param rectOfB 2 つ目の要素の ID から長方形を返す関数
+		/// @remark 辺が接しているだけの長方形も交差しているとみなします。これは `SpatialHash2D` の検索と同じ判定で、`Geometry2D::Intersect(const RectF&, const RectF&)` とは異なります。
+		template <class IdA, class IdB, class RectOfA, class RectOfB>
+		void FilterIntersectingRects(Array<std::pair<IdA, IdB>>& pairs, RectOfA rectOfA, RectOfB rectOfB);
+	}
+}
+
+# include "detail/SpatialHash2D.ipp"
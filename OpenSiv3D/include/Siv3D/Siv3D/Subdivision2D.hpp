@@ -14,6 +14,7 @@
 # include "Array.hpp"
 # include "PointVector.hpp"
 # include "2DShapes.hpp"
+# include "Morton.hpp"
 
 namespace s3d
 {
@@ -89,6 +90,13 @@ namespace s3d
 
 		void addPoints(const Array<Vec2>& points);
 
+		/// @brief 点をモートン順序に並べ替えてから、まとめて追加します。
+		/// @param points 追加する点の一覧
+		/// @return 追加した点の頂点 ID の一覧。`points[i]` の頂点 ID が i 番目に格納されます
+		/// @remark 点の位置の探索は直前に追加した点の辺から始まるため、空間的に近い順に追加すると探索の距離が短くなります。
+		/// @remark 頂点と辺の配列はあらかじめ確保されます。頂点 ID は追加した順に振られるため、`addPoints()` とは異なる順になります。
+		Array<VertexID> addPointsSorted(const Array<Vec2>& points);
+
 		Optional<VertexID> findNearest(const Vec2& point, Vec2* nearestPt = nullptr);
 
 		[[nodiscard]]
@@ -0,0 +1,174 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# ifndef SIV3D_NO_CONCURRENT_API
+
+# include <atomic>
+# include <condition_variable>
+# include <deque>
+# include <exception>
+# include <functional>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <type_traits>
+# include <utility>
+# include <vector>
+# include "Common.hpp"
+# include "Threading.hpp"
+# include "Utility.hpp"
+
+namespace s3d
+{
+	namespace Threading
+	{
+		/// @brief 要素数がこの値以下の並列処理は、スレッドプールを使わずに呼び出し元のスレッドで逐次実行されます。 | Parallel algorithms on ranges no larger than this run serially on the calling thread.
+		inline constexpr size_t ParallelSerialCutoff = 1024;
+	}
+
+	namespace detail
+	{
+		/// @brief プロセス全体で共有されるワークスティーリング方式のスレッドプール
+		class WorkStealingPool
+		{
+		public:
+
+			using Job = std::function<void()>;
+
+			SIV3D_NODISCARD_CXX20
+			explicit WorkStealingPool(size_t numWorkers);
+
+			~WorkStealingPool();
+
+			WorkStealingPool(const WorkStealingPool&) = delete;
+
+			WorkStealingPool& operator =(const WorkStealingPool&) = delete;
+
+			/// @brief ワーカースレッドの数を返します。
+			[[nodiscard]]
+			size_t numWorkers() const noexcept;
+
+			/// @brief ジョブを追加します。
+			/// @remark ワーカースレッドから呼ばれた場合はそのスレッドのキューに、それ以外の場合は共有キューに積まれます。
+			void submit(Job job);
+
+			/// @brief キューからジョブを 1 つ取り出して、呼び出し元のスレッドで実行します。
+			/// @return ジョブを実行した場合 true, キューが空だった場合は false
+			bool tryRunOne();
+
+			/// @brief プロセス全体で共有されるスレッドプールを返します。
+			/// @remark 初回呼び出し時に `Threading::GetConcurrency() - 1` 個のワーカースレッドが起動されます。
+			[[nodiscard]]
+			static WorkStealingPool& Get();
+
+		private:
+
+			struct Queue
+			{
+				std::mutex mutex;
+
+				std::deque<Job> jobs;
+			};
+
+			std::vector<std::unique_ptr<Queue>> m_queues;
+
+			std::vector<std::thread> m_workers;
+
+			size_t m_numWorkers = 0;
+
+			std::atomic<size_t> m_queuedCount{ 0 };
+
+			std::mutex m_sleepMutex;
+
+			std::condition_variable m_sleepCondition;
+
+			bool m_stop = false;
+
+			[[nodiscard]]
+			static size_t& CurrentWorkerIndex() noexcept;
+
+			[[nodiscard]]
+			bool pop(size_t queueIndex, Job& job);
+
+			[[nodiscard]]
+			bool steal(size_t thiefIndex, Job& job);
+
+			void workerMain(size_t workerIndex);
+		};
+	}
+
+	/// @brief スレッドプール上で実行されるタスクのグループ | A group of tasks running on the shared thread pool
+	/// @remark `wait()` で待機している間、呼び出し元のスレッドもキューに残っているタスクを実行します。
+	class TaskGroup
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		TaskGroup() = default;
+
+		/// @brief 未完了のタスクがある場合、完了を待機します。
+		~TaskGroup();
+
+		TaskGroup(const TaskGroup&) = delete;
+
+		TaskGroup& operator =(const TaskGroup&) = delete;
+
+		/// @brief タスクを追加します。 | Adds a task to the group.
+		/// @tparam Fty タスクの関数の型
+		/// @param f タスクの関数
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty>>* = nullptr>
+		void run(Fty f);
+
+		/// @brief すべてのタスクの完了を待ちます。 | Waits until all tasks in the group finish.
+		/// @remark タスクが例外を送出した場合、最初の例外をここで再送出します。
+		void wait();
+
+		/// @brief すべてのタスクが完了しているかを返します。
+		/// @return すべてのタスクが完了している場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isDone() const noexcept;
+
+	private:
+
+		std::atomic<size_t> m_pendingCount{ 0 };
+
+		std::mutex m_exceptionMutex;
+
+		std::exception_ptr m_exception;
+
+		void waitPending() noexcept;
+	};
+
+	/// @brief 範囲 [first, last) を分割してスレッドプール上で並列に処理します。 | Processes the range [first, last) in parallel on the shared thread pool.
+	/// @tparam Fty 処理関数の型。`f(i)` または `f(chunkBegin, chunkEnd)` の形式
+	/// @param first 範囲の開始
+	/// @param last 範囲の終端
+	/// @param grain 1 つのタスクが処理する要素数の目安。0 の場合は `parallel_for(first, last, f)` と同じです
+	/// @param f 処理関数
+	/// @remark 範囲は grain に達するまで二分割されながらタスクとして積まれ、空いたワーカーが大きな塊から盗んで処理します。
+	/// @remark 要素数が grain 以下の場合は、呼び出し元のスレッドで逐次実行されます。
+	template <class Fty, std::enable_if_t<std::disjunction_v<std::is_invocable<Fty, size_t>, std::is_invocable<Fty, size_t, size_t>>>* = nullptr>
+	void parallel_for(size_t first, size_t last, size_t grain, Fty f);
+
+	/// @brief 範囲 [first, last) を分割してスレッドプール上で並列に処理します。 | Processes the range [first, last) in parallel on the shared thread pool.
+	/// @tparam Fty 処理関数の型。`f(i)` または `f(chunkBegin, chunkEnd)` の形式
+	/// @param first 範囲の開始
+	/// @param last 範囲の終端
+	/// @param f 処理関数
+	/// @remark grain はワーカー数から自動で決定されます。要素数が `Threading::ParallelSerialCutoff` 以下の場合は、呼び出し元のスレッドで逐次実行されます。
+	template <class Fty, std::enable_if_t<std::disjunction_v<std::is_invocable<Fty, size_t>, std::is_invocable<Fty, size_t, size_t>>>* = nullptr>
+	void parallel_for(size_t first, size_t last, Fty f);
+}
+
+# include "detail/TaskGroup.ipp"
+
+# endif // SIV3D_NO_CONCURRENT_API
@@ -0,0 +1,202 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Array.hpp"
+# include "Grid.hpp"
+# include "Image.hpp"
+# include "PointVector.hpp"
+# include "Morton.hpp"
+
+namespace s3d
+{
+	/// @brief タイル単位で要素をモートン順序（Z 曲線）に並べて格納する二次元配列クラス
+	/// @tparam Type 要素の型
+	/// @tparam TileSize タイルの一辺の要素数（2 の累乗、256 以下）
+	/// @tparam Allocator アロケータの型
+	/// @remark タイルは行優先で並び、各タイル内の要素は `Morton::Encode2D32()` と同じ Z 曲線の順に並びます。
+	/// @remark 近傍へのアクセスや列方向の走査が `Grid` よりキャッシュに乗りやすくなります。
+	template <class Type, size_t TileSize = 16, class Allocator = std::allocator<Type>>
+	class TiledGrid
+	{
+	public:
+
+		static_assert(((TileSize != 0) && ((TileSize & (TileSize - 1)) == 0) && (TileSize <= 256)), "TileSize must be a power of two no larger than 256");
+
+		using container_type	= Array<Type, Allocator>;
+		using value_type		= typename container_type::value_type;
+		using pointer			= typename container_type::pointer;
+		using const_pointer		= typename container_type::const_pointer;
+		using reference			= typename container_type::reference;
+		using const_reference	= typename container_type::const_reference;
+		using size_type			= typename container_type::size_type;
+		using allocator_type	= typename container_type::allocator_type;
+
+		/// @brief 1 つのタイルに含まれる要素数
+		static constexpr size_t TileCells = (TileSize * TileSize);
+
+		SIV3D_NODISCARD_CXX20
+		TiledGrid() = default;
+
+		/// @brief 二次元配列を作成します。
+		/// @param w 幅
+		/// @param h 高さ
+		SIV3D_NODISCARD_CXX20
+		TiledGrid(size_type w, size_type h);
+
+		/// @brief 二次元配列を作成します。
+		/// @param w 幅
+		/// @param h 高さ
+		/// @param value 要素の初期値
+		SIV3D_NODISCARD_CXX20
+		TiledGrid(size_type w, size_type h, const value_type& value);
+
+		/// @brief 二次元配列を作成します。
+		/// @param size 幅と高さ
+		SIV3D_NODISCARD_CXX20
+		explicit TiledGrid(Size size);
+
+		/// @brief 二次元配列を作成します。
+		/// @param size 幅と高さ
+		/// @param value 要素の初期値
+		SIV3D_NODISCARD_CXX20
+		TiledGrid(Size size, const value_type& value);
+
+		/// @brief 行優先の二次元配列から作成します。
+		/// @param grid 二次元配列
+		SIV3D_NODISCARD_CXX20
+		explicit TiledGrid(const Grid<Type, Allocator>& grid);
+
+		/// @brief 画像から作成します。
+		/// @param image 画像
+		template <class T = Type, std::enable_if_t<std::is_same_v<T, Color>>* = nullptr>
+		SIV3D_NODISCARD_CXX20
+		explicit TiledGrid(const Image& image);
+
+		[[nodiscard]]
+		bool inBounds(int64 y, int64 x) const noexcept;
+
+		[[nodiscard]]
+		bool inBounds(Point pos) const noexcept;
+
+		/// @brief 指定した位置の要素を返します。
+		/// @param pos 位置
+		/// @throw std::out_of_range 範囲外の場合
+		/// @return 要素
+		[[nodiscard]]
+		value_type& at(Point pos);
+
+		/// @brief 指定した位置の要素を返します。
+		/// @param pos 位置
+		/// @throw std::out_of_range 範囲外の場合
+		/// @return 要素
+		[[nodiscard]]
+		const value_type& at(Point pos) const;
+
+		[[nodiscard]]
+		value_type& operator [](Point pos) noexcept;
+
+		[[nodiscard]]
+		const value_type& operator [](Point pos) const noexcept;
+
+		/// @brief 指定した位置の要素を返します。範囲外の場合は defaultValue を返します。
+		/// @param pos 位置
+		/// @param defaultValue 範囲外の場合に返す値
+		/// @return 要素
+		template <class U>
+		[[nodiscard]]
+		value_type fetch(Point pos, U&& defaultValue) const;
+
+		[[nodiscard]]
+		bool empty() const noexcept;
+
+		[[nodiscard]]
+		bool isEmpty() const noexcept;
+
+		[[nodiscard]]
+		explicit operator bool() const noexcept;
+
+		[[nodiscard]]
+		size_type width() const noexcept;
+
+		[[nodiscard]]
+		size_type height() const noexcept;
+
+		[[nodiscard]]
+		Size size() const noexcept;
+
+		/// @brief 要素数を返します。
+		/// @return 要素数（幅 × 高さ）
+		[[nodiscard]]
+		size_type num_elements() const noexcept;
+
+		/// @brief 端数のタイルの余白を含む、内部の配列を返します。
+		/// @return 内部の配列
+		[[nodiscard]]
+		const container_type& storage() const noexcept;
+
+		TiledGrid& fill(const value_type& value);
+
+		/// @brief 各要素を引数に関数を呼びます。
+		/// @remark 要素は格納順（タイルごと、タイル内はモートン順序）に走査されます。
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type&>>* = nullptr>
+		TiledGrid& each(Fty f);
+
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>* = nullptr>
+		const TiledGrid& each(Fty f) const;
+
+		/// @brief 各要素とその位置を引数に関数を呼びます。
+		/// @remark 要素は格納順（タイルごと、タイル内はモートン順序）に走査されます。
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Point, Type&>>* = nullptr>
+		TiledGrid& each_index(Fty f);
+
+		template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Point, Type>>* = nullptr>
+		const TiledGrid& each_index(Fty f) const;
+
+		/// @brief 行優先の二次元配列に変換します。
+		/// @return 二次元配列
+		[[nodiscard]]
+		Grid<Type, Allocator> asGrid() const;
+
+		/// @brief 画像に変換します。
+		/// @return 画像
+		template <class T = Type, std::enable_if_t<std::is_same_v<T, Color>>* = nullptr>
+		[[nodiscard]]
+		Image toImage() const;
+
+		void swap(TiledGrid& other) noexcept;
+
+	private:
+
+		container_type m_data;
+
+		size_type m_width = 0;
+
+		size_type m_height = 0;
+
+		size_type m_tilesX = 0;
+
+		[[nodiscard]]
+		static constexpr size_type TilesFor(size_type n) noexcept;
+
+		[[nodiscard]]
+		size_type indexOf(size_type x, size_type y) const noexcept;
+
+		template <class Pointer, class Fty>
+		void eachIndexImpl(Pointer data, Fty& f) const;
+	};
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline void swap(TiledGrid<Type, TileSize, Allocator>& a, TiledGrid<Type, TileSize, Allocator>& b) noexcept;
+}
+
+# include "detail/TiledGrid.ipp"
@@ -0,0 +1,176 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include "Common.hpp"
+# include "Array.hpp"
+# include "MathConstants.hpp"
+# include "Wave.hpp"
+# include "WaveSample.hpp"
+# include "SIMD.hpp"
+# include "Error.hpp"
+
+namespace s3d
+{
+	/// @brief `Wave` のための一括処理のカーネル | Bulk DSP kernels for Wave
+	/// @remark 各関数は SSE2 でまとめて処理します。ポインタを受け取る関数は、メモリを確保しません。
+	namespace WaveDSP
+	{
+		/// @brief src にゲインを掛けたものを dst に加算します。
+		/// @param dst 加算先の波形
+		/// @param src 加算する波形
+		/// @param count サンプル数
+		/// @param gain ゲイン
+		void MixAdd(WaveSample* dst, const WaveSample* src, size_t count, float gain = 1.0f) noexcept;
+
+		/// @brief src にゲインを掛けたものを dst に加算します。ゲインは startGain から endGain まで線形に変化します。
+		/// @param dst 加算先の波形
+		/// @param src 加算する波形
+		/// @param count サンプル数
+		/// @param startGain 最初のサンプルのゲイン
+		/// @param endGain 最後のサンプルの次のゲイン
+		void MixAddRamp(WaveSample* dst, const WaveSample* src, size_t count, float startGain, float endGain) noexcept;
+
+		/// @brief src にゲインを掛けたものを dst に加算します。
+		/// @param dst 加算先の波形
+		/// @param src 加算する波形
+		/// @param gain ゲイン
+		/// @param dstOffset 加算を始める dst の位置（サンプル）
+		/// @remark dst が足りない場合は、無音のサンプルで延長されます。
+		void MixAdd(Wave& dst, const Wave& src, float gain = 1.0f, size_t dstOffset = 0);
+
+		/// @brief src にゲインを掛けたものを dst に加算します。ゲインは startGain から endGain まで線形に変化します。
+		/// @param dst 加算先の波形
+		/// @param src 加算する波形
+		/// @param startGain src の最初のサンプルのゲイン
+		/// @param endGain src の最後のサンプルの次のゲイン
+		/// @param dstOffset 加算を始める dst の位置（サンプル）
+		/// @remark dst が足りない場合は、無音のサンプルで延長されます。
+		void MixAddRamp(Wave& dst, const Wave& src, float startGain, float endGain, size_t dstOffset = 0);
+
+		/// @brief 波形にゲインを掛けます。
+		/// @param samples 波形
+		/// @param count サンプル数
+		/// @param gain ゲイン
+		void ApplyGain(WaveSample* samples, size_t count, float gain) noexcept;
+
+		/// @brief 波形にゲインを掛けます。ゲインは startGain から endGain まで線形に変化します。
+		/// @param samples 波形
+		/// @param count サンプル数
+		/// @param startGain 最初のサンプルのゲイン
+		/// @param endGain 最後のサンプルの次のゲイン
+		void ApplyGainRamp(WaveSample* samples, size_t count, float startGain, float endGain) noexcept;
+
+		/// @brief 波形にゲインを掛けます。
+		/// @param wave 波形
+		/// @param gain ゲイン
+		void ApplyGain(Wave& wave, float gain) noexcept;
+
+		/// @brief 波形にゲインを掛けます。ゲインは startGain から endGain まで線形に変化します。
+		/// @param wave 波形
+		/// @param startGain 最初のサンプルのゲイン
+		/// @param endGain 最後のサンプルの次のゲイン
+		void ApplyGainRamp(Wave& wave, float startGain, float endGain) noexcept;
+
+		/// @brief 波形のサンプリングレートを変換した結果を dst に書き込みます。
+		/// @param src 波形
+		/// @param dst 結果を格納する波形。src と同じでもかまいません
+		/// @param targetSampleRate 変換後のサンプリングレート
+		/// @remark Blackman 窓をかけた sinc 関数によるポリフェーズフィルタで変換します。縮小時は折り返し雑音を防ぐため、カットオフ周波数が変換後のナイキスト周波数に下がります。
+		/// @remark 出力はブロックごとに並列に計算されますが、結果はスレッド数によらず同じです。
+		/// @throw Error targetSampleRate が `Wave::MinSampleRate` 以上 `Wave::MaxSampleRate` 以下でない場合
+		void Resample(const Wave& src, Wave& dst, uint32 targetSampleRate);
+
+		/// @brief 波形のサンプリングレートを変換した新しい波形を返します。
+		/// @param src 波形
+		/// @param targetSampleRate 変換後のサンプリングレート
+		/// @return サンプリングレートを変換した新しい波形
+		/// @throw Error targetSampleRate が `Wave::MinSampleRate` 以上 `Wave::MaxSampleRate` 以下でない場合
+		[[nodiscard]]
+		Wave Resample(const Wave& src, uint32 targetSampleRate);
+
+		/// @brief 32-bit float の波形を 16-bit 整数の PCM に変換します。
+		/// @param src 波形
+		/// @param count サンプル数
+		/// @param dst 結果を格納する配列
+		/// @remark 結果は `WaveSample::asWaveSampleS16()` と一致します。
+		void ToInt16(const WaveSample* src, size_t count, WaveSampleS16* dst) noexcept;
+
+		/// @brief 32-bit float の波形を 16-bit 整数の PCM に変換します。
+		/// @param src 波形
+		/// @param dst 結果を格納する配列。十分な容量がある場合、メモリの再確保は起こりません
+		void ToInt16(const Wave& src, Array<WaveSampleS16>& dst);
+
+		/// @brief 16-bit 整数の PCM を 32-bit float の波形に変換します。
+		/// @param src PCM
+		/// @param count サンプル数
+		/// @param dst 結果を格納する配列
+		/// @remark 結果は `WaveSampleS16::asWaveSample()` と一致します。
+		void FromInt16(const WaveSampleS16* src, size_t count, WaveSample* dst) noexcept;
+
+		/// @brief 16-bit 整数の PCM を 32-bit float の波形に変換します。
+		/// @param src PCM
+		/// @param dst 結果を格納する波形。サンプリングレートは変更されません
+		void FromInt16(const Array<WaveSampleS16>& src, Wave& dst);
+
+		/// @brief チャンネルごとのピーク（絶対値の最大値）を返します。
+		/// @param samples 波形
+		/// @param count サンプル数
+		/// @return チャンネルごとのピーク
+		[[nodiscard]]
+		WaveSample Peak(const WaveSample* samples, size_t count) noexcept;
+
+		/// @brief チャンネルごとのピーク（絶対値の最大値）を返します。
+		/// @param wave 波形
+		/// @return チャンネルごとのピーク
+		[[nodiscard]]
+		WaveSample Peak(const Wave& wave) noexcept;
+
+		/// @brief チャンネルごとの RMS（二乗平均平方根）を返します。
+		/// @param samples 波形
+		/// @param count サンプル数
+		/// @return チャンネルごとの RMS
+		/// @remark 二乗和は倍精度で累積されます。
+		[[nodiscard]]
+		WaveSample RMS(const WaveSample* samples, size_t count) noexcept;
+
+		/// @brief チャンネルごとの RMS（二乗平均平方根）を返します。
+		/// @param wave 波形
+		/// @return チャンネルごとの RMS
+		[[nodiscard]]
+		WaveSample RMS(const Wave& wave) noexcept;
+
+		/// @brief ステレオの波形を、左右のチャンネルに分けます。
+		/// @param src 波形
+		/// @param count サンプル数
+		/// @param left 左チャンネルを格納する配列
+		/// @param right 右チャンネルを格納する配列
+		/// @remark left が src の先頭と同じ位置を指していてもかまいません。
+		void Deinterleave(const WaveSample* src, size_t count, float* left, float* right) noexcept;
+
+		/// @brief 左右のチャンネルを、ステレオの波形にまとめます。
+		/// @param left 左チャンネル
+		/// @param right 右チャンネル
+		/// @param count サンプル数
+		/// @param dst 結果を格納する配列
+		void Interleave(const float* left, const float* right, size_t count, WaveSample* dst) noexcept;
+
+		/// @brief 波形のデータを、前半が左チャンネル、後半が右チャンネルになるように並べ替えます。
+		/// @param wave 波形
+		void Deinterleave(Wave& wave);
+
+		/// @brief 前半が左チャンネル、後半が右チャンネルになっている波形のデータを、ステレオの波形に並べ替えます。
+		/// @param wave 波形
+		void Interleave(Wave& wave);
+	}
+}
+
+# include "detail/WaveDSP.ipp"
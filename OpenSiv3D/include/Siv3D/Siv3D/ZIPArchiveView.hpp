@@ -0,0 +1,305 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <memory>
+# include "Common.hpp"
+# include "String.hpp"
+# include "Array.hpp"
+# include "HashTable.hpp"
+# include "Optional.hpp"
+# include "Blob.hpp"
+# include "IReader.hpp"
+# include "MemoryViewReader.hpp"
+# include "MemoryMappedFileView.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		class ZIPInflater;
+	}
+
+	/// @brief ZIP アーカイブ内のファイルの情報
+	struct ZIPEntryInfo
+	{
+		/// @brief アーカイブ内のパス
+		FilePath path;
+
+		/// @brief 圧縮後のサイズ（バイト）
+		uint64 compressedSize = 0;
+
+		/// @brief 元のサイズ（バイト）
+		uint64 uncompressedSize = 0;
+
+		/// @brief データの先頭のファイル内での位置（バイト）
+		uint64 dataOffset = 0;
+
+		/// @brief 元のデータの CRC-32
+		uint32 crc32 = 0;
+
+		/// @brief 圧縮方式（0: 無圧縮, 8: Deflate）
+		uint16 method = 0;
+
+		/// @brief 暗号化されているか
+		bool encrypted = false;
+
+		/// @brief ディレクトリであるかを返します。
+		/// @return ディレクトリである場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isDirectory() const noexcept;
+
+		/// @brief 無圧縮で格納されているかを返します。
+		/// @return 無圧縮で格納されている場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isStored() const noexcept;
+
+		/// @brief `ZIPArchiveView` で読み込める圧縮方式であるかを返します。
+		/// @return 読み込める圧縮方式である場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isSupported() const noexcept;
+	};
+
+	/// @brief ZIP アーカイブ内のファイルを少しずつ展開しながら読み込む Reader
+	/// @remark Deflate で圧縮されたファイルは、zlib の `inflate()` で 32 KiB のスライディングウィンドウだけを使って、読み込んだ分だけ展開されます。アプリケーションは zlib (`-lz`) をリンクする必要があります。
+	/// @remark Deflate で圧縮されたファイルで読み込み位置を戻すと、先頭から展開し直します。
+	/// @remark 先頭から順にすべて読み込んだ場合は CRC-32 を検証し、一致しない場合は `hasError()` が true を返します。
+	class ZIPEntryReader : public IReader
+	{
+	public:
+
+		SIV3D_NODISCARD_CXX20
+		ZIPEntryReader();
+
+		SIV3D_NODISCARD_CXX20
+		ZIPEntryReader(const MemoryMappedFileView& file, const ZIPEntryInfo& entry);
+
+		ZIPEntryReader(const ZIPEntryReader& other);
+
+		ZIPEntryReader(ZIPEntryReader&&) noexcept;
+
+		~ZIPEntryReader() override;
+
+		ZIPEntryReader& operator =(const ZIPEntryReader& other);
+
+		ZIPEntryReader& operator =(ZIPEntryReader&&) noexcept;
+
+		/// @brief 読み込み位置を変更しないデータ読み込みをサポートしているかを返します。
+		/// @return 無圧縮のファイルの場合 true, それ以外の場合は false
+		/// @remark Deflate で圧縮されたファイルでも `lookahead()` は使えますが、展開の状態をコピーするため低速です。
+		[[nodiscard]]
+		bool supportsLookahead() const noexcept override;
+
+		/// @brief Reader が使用可能かを返します。
+		/// @return Reader が使用可能な場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool isOpen() const noexcept override;
+
+		/// @brief Reader のサイズを返します。
+		/// @return Reader のサイズ（バイト）
+		[[nodiscard]]
+		int64 size() const override;
+
+		/// @brief Reader の現在の読み込み位置を返します。
+		/// @return 現在の読み込み位置（バイト）
+		[[nodiscard]]
+		int64 getPos() const override;
+
+		/// @brief Reader の読み込み位置を変更します。
+		/// @param pos 新しい読み込み位置（バイト）
+		/// @return 読み込み位置の変更に成功した場合 true, それ以外の場合は false
+		bool setPos(int64 pos) override;
+
+		/// @brief Reader を読み飛ばし、読み込み位置を変更します。
+		/// @param offset 読み飛ばすサイズ（バイト）
+		/// @return 新しい読み込み位置（バイト）
+		int64 skip(int64 offset) override;
+
+		/// @brief Reader からデータを読み込みます。
+		/// @param dst 読み込み先
+		/// @param size 読み込むサイズ（バイト）
+		/// @return 実際に読み込んだサイズ（バイト）
+		int64 read(void* dst, int64 size) override;
+
+		/// @brief Reader からデータを読み込みます。
+		/// @param dst 読み込み先
+		/// @param pos 先頭から数えた読み込み開始位置（バイト）
+		/// @param size 読み込むサイズ（バイト）
+		/// @return 実際に読み込んだサイズ（バイト）
+		int64 read(void* dst, int64 pos, int64 size) override;
+
+		/// @brief Reader からデータを読み込みます。
+		/// @tparam Type 読み込む値の型
+		/// @param dst 読み込み先
+		/// @return 読み込みに成功した場合 true, それ以外の場合は false
+		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
+		bool read(TriviallyCopyable& dst);
+
+		/// @brief Reader から読み込み位置を変更しないでデータを読み込みます。
+		/// @param dst 読み込み先
+		/// @param size 読み込むサイズ（バイト）
+		/// @return 実際に読み込んだサイズ（バイト）
+		int64 lookahead(void* dst, int64 size) const override;
+
+		/// @brief Reader から読み込み位置を変更しないでデータを読み込みます。
+		/// @param dst 読み込み先
+		/// @param pos 先頭から数えた読み込み開始位置（バイト）
+		/// @param size 読み込むサイズ（バイト）
+		/// @return 実際に読み込んだサイズ（バイト）
+		int64 lookahead(void* dst, int64 pos, int64 size) const override;
+
+		/// @brief 読み込み位置を変更しないで Reader からデータを読み込みます。
+		/// @tparam Type 読み込む値の型
+		/// @param dst 読み込み先
+		/// @return 読み込みに成功したら true, それ以外の場合は false
+		SIV3D_CONCEPT_TRIVIALLY_COPYABLE
+		bool lookahead(TriviallyCopyable& dst) const;
+
+		/// @brief 展開中にエラーが発生したか、CRC-32 が一致しなかったかを返します。
+		/// @return エラーが発生した場合 true, それ以外の場合は false
+		[[nodiscard]]
+		bool hasError() const noexcept;
+
+	private:
+
+		MemoryMappedFileView m_file;
+
+		const uint8* m_data = nullptr;
+
+		int64 m_compressedSize = 0;
+
+		int64 m_size = 0;
+
+		int64 m_pos = 0;
+
+		uint32 m_expectedCRC = 0;
+
+		// 先頭から m_crcPos バイトまでの CRC-32
+		uint32 m_crc = 0;
+
+		int64 m_crcPos = 0;
+
+		bool m_error = false;
+
+		std::unique_ptr<detail::ZIPInflater> m_inflater;
+
+		void rewind();
+
+		int64 readForward(void* dst, int64 size);
+	};
+
+	/// @brief メモリマップトファイルによる ZIP アーカイブの読み込み | Memory-mapped ZIP archive reader with streaming and parallel extraction
+	/// @remark 無圧縮（Stored）と Deflate で格納されたファイル、ZIP64 に対応しています。暗号化されたファイルには対応していません。
+	class ZIPArchiveView
+	{
+	public:
+
+		/// @brief 並列に展開する際のメモリ使用量の上限のデフォルト値（バイト）
+		static constexpr size_t DefaultMemoryBudget = (64 << 20);
+
+		/// @brief ファイルの展開に使うバッファのサイズ（バイト）
+		static constexpr size_t ExtractBufferSize = (256 << 10);
+
+		SIV3D_NODISCARD_CXX20
+		ZIPArchiveView() = default;
+
+		/// @brief ZIP アーカイブを開きます。
+		/// @param path ZIP アーカイブのパス
+		SIV3D_NODISCARD_CXX20
+		explicit ZIPArchiveView(FilePathView path);
+
+		/// @brief ZIP アーカイブを開きます。
+		/// @param path ZIP アーカイブのパス
+		/// @return 開くことに成功した場合 true, それ以外の場合は false
+		bool open(FilePathView path);
+
+		/// @brief ZIP アーカイブを閉じます。
+		/// @remark すでに作成した `ZIPEntryReader` は、閉じた後も使用できます。
+		void close();
+
+		[[nodiscard]]
+		bool isOpen() const;
+
+		[[nodiscard]]
+		explicit operator bool() const;
+
+		/// @brief アーカイブ内のファイルのパスの一覧を返します。
+		/// @return アーカイブ内のファイルのパスの一覧
+		[[nodiscard]]
+		const Array<FilePath>& enumPaths() const noexcept;
+
+		/// @brief アーカイブ内のファイルの情報の一覧を返します。
+		/// @return アーカイブ内のファイルの情報の一覧
+		[[nodiscard]]
+		const Array<ZIPEntryInfo>& entries() const noexcept;
+
+		/// @brief アーカイブ内のファイルの情報を返します。
+		/// @param path アーカイブ内のパス
+		/// @return ファイルの情報。見つからない場合は none
+		[[nodiscard]]
+		Optional<ZIPEntryInfo> getEntry(FilePathView path) const;
+
+		/// @brief アーカイブ内のファイルを少しずつ展開しながら読み込む Reader を作成します。
+		/// @param path アーカイブ内のパス
+		/// @return Reader。ファイルが見つからない場合や対応していない圧縮方式の場合は空の Reader
+		[[nodiscard]]
+		ZIPEntryReader openEntry(FilePathView path) const;
+
+		/// @brief 無圧縮で格納されたファイルを、コピーせずにメモリマップトファイルから直接読み込む Reader を作成します。
+		/// @param path アーカイブ内のパス
+		/// @return Reader。ファイルが見つからない場合や無圧縮でない場合は空の Reader
+		/// @remark Reader はこの ZIPArchiveView を閉じるまで有効です。
+		[[nodiscard]]
+		MemoryViewReader viewStored(FilePathView path) const;
+
+		/// @brief アーカイブ内のファイルを展開して Blob に格納します。
+		/// @param path アーカイブ内のパス
+		/// @return 展開したデータ。失敗した場合は空の Blob
+		[[nodiscard]]
+		Blob extractToBlob(FilePathView path) const;
+
+		/// @brief アーカイブ内のすべてのファイルを展開して保存します。
+		/// @param targetDirectory 保存先のディレクトリ
+		/// @param memoryBudget 展開に使うメモリの上限（バイト）。同時に展開するファイルの数が制限されます
+		/// @return すべてのファイルの展開に成功した場合 true, それ以外の場合は false
+		/// @remark 独立したファイルを複数のスレッドで並列に展開します。`..` を含むパスや絶対パスのファイルは展開しません。
+		bool extractAll(FilePathView targetDirectory, size_t memoryBudget = DefaultMemoryBudget) const;
+
+		/// @brief パターンに一致するアーカイブ内のファイルを展開して保存します。
+		/// @param pattern パスのパターン。`*` は任意の文字列、`?` は任意の 1 文字に一致します
+		/// @param targetDirectory 保存先のディレクトリ
+		/// @param memoryBudget 展開に使うメモリの上限（バイト）。同時に展開するファイルの数が制限されます
+		/// @return 一致したすべてのファイルの展開に成功した場合 true, それ以外の場合は false
+		/// @remark 独立したファイルを複数のスレッドで並列に展開します。`..` を含むパスや絶対パスのファイルは展開しません。
+		bool extractFiles(StringView pattern, FilePathView targetDirectory, size_t memoryBudget = DefaultMemoryBudget) const;
+
+	private:
+
+		MemoryMappedFileView m_file;
+
+		Array<ZIPEntryInfo> m_entries;
+
+		Array<FilePath> m_paths;
+
+		HashTable<FilePath, size_t> m_index;
+
+		[[nodiscard]]
+		Optional<size_t> findEntry(FilePathView path) const;
+
+		[[nodiscard]]
+		bool extractEntry(const ZIPEntryInfo& entry, FilePathView targetDirectory, Array<uint8>& buffer) const;
+
+		[[nodiscard]]
+		bool extractEntries(const Array<size_t>& indices, FilePathView targetDirectory, size_t memoryBudget) const;
+	};
+}
+
+# include "detail/ZIPArchiveView.ipp"
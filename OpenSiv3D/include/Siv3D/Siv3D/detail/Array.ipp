@@ -1549,56 +1549,16 @@ namespace s3d
 
 	# else
 
-		if (isEmpty())
-		{
-			return 0;
-		}
-
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
-		{
-			return count_if(f);
-		}
+		std::atomic<size_t> result{ 0 };
 
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
+		const auto first = begin();
 
-		Array<std::future<std::ptrdiff_t>> futures;
-
-		auto it = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
+		parallel_for(0, size(), [&](const size_t chunkBegin, const size_t chunkEnd)
 		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
+			result.fetch_add(static_cast<size_t>(std::count_if((first + chunkBegin), (first + chunkEnd), f)), std::memory_order_relaxed);
+		});
 
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				return std::count_if(it, it + n, f);
-			}));
-
-			it += n;
-			countLeft -= n;
-		}
-
-		size_t result = 0;
-		
-		if (countLeft)
-		{
-			result = std::count_if(it, it + countLeft, f);
-		}
-
-		for (auto& future : futures)
-		{
-			result += future.get();
-		}
-
-		return result;
+		return result.load(std::memory_order_relaxed);
 
 	# endif
 	}
@@ -1613,52 +1573,12 @@ namespace s3d
 
 	# else
 
-		if (isEmpty())
-		{
-			return;
-		}
-
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
-		{
-			return each(f);
-		}
-
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<std::ptrdiff_t>> futures;
-
-		auto it = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
-		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				std::for_each(it, it + n, f);
-			}));
-
-			it += n;
-			countLeft -= n;
-		}
-
-		if (countLeft)
-		{
-			std::for_each(it, it + countLeft, f);
-		}
+		const auto first = begin();
 
-		for (auto& future : futures)
+		parallel_for(0, size(), [&](const size_t chunkBegin, const size_t chunkEnd)
 		{
-			future.get();
-		}
+			std::for_each((first + chunkBegin), (first + chunkEnd), f);
+		});
 
 	# endif
 	}
@@ -1673,52 +1593,12 @@ namespace s3d
 
 	# else
 
-		if (isEmpty())
-		{
-			return;
-		}
-
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
-		{
-			return each(f);
-		}
-
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<std::ptrdiff_t>> futures;
+		const auto first = begin();
 
-		auto it = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
+		parallel_for(0, size(), [&](const size_t chunkBegin, const size_t chunkEnd)
 		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]()
-			{
-				std::for_each(it, it + n, f);
-			}));
-
-			it += n;
-			countLeft -= n;
-		}
-
-		if (countLeft)
-		{
-			std::for_each(it, it + countLeft, f);
-		}
-
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+			std::for_each((first + chunkBegin), (first + chunkEnd), f);
+		});
 
 	# endif
 	}
@@ -1729,66 +1609,23 @@ namespace s3d
 	{
 		using Ret = std::remove_cvref_t<decltype(f((*this)[0]))>;
 
-		if (isEmpty())
-		{
-			return Array<Ret>{};
-		}
-
-		const size_t numThreads = Threading::GetConcurrency();
-
-		if (numThreads <= 1)
+		if (size() <= Threading::ParallelSerialCutoff)
 		{
 			return map(f);
 		}
 
 		Array<Ret> new_array(size());
 
-		const size_t countPerthread = Max<size_t>(1, (size() + (numThreads - 1)) / numThreads);
-
-		Array<std::future<void>> futures;
-
-		auto itDst = new_array.begin();
-		auto itSrc = begin();
-		size_t countLeft = size();
-
-		for (size_t i = 0; i < (numThreads - 1); ++i)
-		{
-			const size_t n = Min(countPerthread, countLeft);
-
-			if (n == 0)
-			{
-				break;
-			}
-
-			futures.emplace_back(std::async(std::launch::async, [=, &f]() mutable
-			{
-				const auto itSrcEnd = itSrc + n;
-
-				while (itSrc != itSrcEnd)
-				{
-					*itDst++ = f(*itSrc++);
-				}
-			}));
-
-			itDst += n;
-			itSrc += n;
-			countLeft -= n;
-		}
+		const auto itSrc = begin();
+		const auto itDst = new_array.begin();
 
-		if (countLeft)
+		parallel_for(0, size(), [&](const size_t chunkBegin, const size_t chunkEnd)
 		{
-			const auto itSrcEnd = end();
-
-			while (itSrc != itSrcEnd)
+			for (size_t i = chunkBegin; i < chunkEnd; ++i)
 			{
-				*itDst++ = f(*itSrc++);
+				itDst[i] = f(itSrc[i]);
 			}
-		}
-
-		for (auto& future : futures)
-		{
-			future.get();
-		}
+		});
 
 		return new_array;
 	}
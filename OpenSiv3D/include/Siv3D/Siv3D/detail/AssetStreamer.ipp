@@ -0,0 +1,694 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <algorithm>
+# include "../TextureAsset.hpp"
+# include "../AudioAsset.hpp"
+# include "../FontAsset.hpp"
+# include "../Time.hpp"
+# include "../Threading.hpp"
+
+namespace s3d
+{
+	namespace detail
+	{
+		// pthread を使わない Web 向けのビルドでは Async() のタスクが実行されないため、デコードをメインスレッドで行う
+	# if !SIV3D_PLATFORM(WEB) || defined(__EMSCRIPTEN_PTHREADS__)
+		inline constexpr bool AssetStreamerUsesWorkers = true;
+	# else
+		inline constexpr bool AssetStreamerUsesWorkers = false;
+	# endif
+
+		[[nodiscard]]
+		inline bool LoadStreamedAsset(const AssetStreamKind kind, const AssetNameView name)
+		{
+			switch (kind)
+			{
+			case AssetStreamKind::Texture:
+				return TextureAsset::Load(name);
+			case AssetStreamKind::Audio:
+				return AudioAsset::Load(name);
+			default:
+				return FontAsset::Load(name);
+			}
+		}
+
+		inline void ReleaseStreamedAsset(const AssetStreamKind kind, const AssetNameView name)
+		{
+			switch (kind)
+			{
+			case AssetStreamKind::Texture:
+				TextureAsset::Release(name);
+				break;
+			case AssetStreamKind::Audio:
+				AudioAsset::Release(name);
+				break;
+			default:
+				FontAsset::Release(name);
+				break;
+			}
+		}
+
+		/// @brief ロード済みのアセットのメモリ上のサイズを見積もります。
+		[[nodiscard]]
+		inline size_t EstimateStreamedAssetBytes(const AssetStreamKind kind, const AssetNameView name)
+		{
+			switch (kind)
+			{
+			case AssetStreamKind::Texture:
+				{
+					const TextureAsset texture{ name };
+					const size_t bytes = (static_cast<size_t>(texture.width()) * static_cast<size_t>(texture.height()) * 4);
+					return (texture.hasMipMap() ? (bytes + bytes / 3) : bytes);
+				}
+			case AssetStreamKind::Audio:
+				return (AudioAsset{ name }.samples() * sizeof(WaveSample));
+			default:
+				// フォントのグリフのキャッシュは描画に応じて増えるため、見積もらない
+				return 0;
+			}
+		}
+	}
+
+	inline AssetStreamer::AssetStreamer(const size_t memoryBudget, const size_t maxConcurrentDecodes)
+		: m_memoryBudget{ memoryBudget }
+		, m_maxConcurrentDecodes{ maxConcurrentDecodes } {}
+
+	inline AssetStreamer::~AssetStreamer()
+	{
+		for (const uint32 index : m_decoding)
+		{
+			Entry& entry = m_entries[index];
+
+			if (entry.imageTask.isValid())
+			{
+				entry.imageTask.wait();
+			}
+
+			if (entry.waveTask.isValid())
+			{
+				entry.waveTask.wait();
+			}
+		}
+	}
+
+	inline bool AssetStreamer::registerTexture(const AssetNameView name, const FilePathView path, const TextureDesc desc, const Array<AssetTag>& tags)
+	{
+		if (findEntry(AssetStreamKind::Texture, name))
+		{
+			return false;
+		}
+
+		auto staging = std::make_shared<Staging>();
+		auto data = std::make_unique<TextureAssetData>(path, desc, tags);
+
+		// デコード済みの画像があればアップロードだけを行い、無ければ通常どおりロードする
+		data->onLoad = [staging](TextureAssetData& asset, const String& hint)
+		{
+			if (not staging->image)
+			{
+				return TextureAssetData::DefaultLoad(asset, hint);
+			}
+
+			asset.texture = Texture{ staging->image, asset.desc };
+			staging->image = Image{};
+			return static_cast<bool>(asset.texture);
+		};
+
+		if (not TextureAsset::Register(name, std::move(data)))
+		{
+			return false;
+		}
+
+		Entry& entry = m_entries[addEntry(AssetStreamKind::Texture, name)];
+		entry.path = path;
+		entry.staging = std::move(staging);
+		return true;
+	}
+
+	inline bool AssetStreamer::registerAudio(const AssetNameView name, const FilePathView path, const Optional<AudioLoopTiming>& loopTiming, const Array<AssetTag>& tags)
+	{
+		if (findEntry(AssetStreamKind::Audio, name))
+		{
+			return false;
+		}
+
+		auto staging = std::make_shared<Staging>();
+		auto data = std::make_unique<AudioAssetData>(path, loopTiming, tags);
+
+		data->onLoad = [staging](AudioAssetData& asset, const String& hint)
+		{
+			if (not staging->wave)
+			{
+				return AudioAssetData::DefaultLoad(asset, hint);
+			}
+
+			asset.audio = Audio{ std::move(staging->wave), asset.loopTiming };
+			staging->wave = Wave{};
+			return static_cast<bool>(asset.audio);
+		};
+
+		if (not AudioAsset::Register(name, std::move(data)))
+		{
+			return false;
+		}
+
+		Entry& entry = m_entries[addEntry(AssetStreamKind::Audio, name)];
+		entry.path = path;
+		entry.staging = std::move(staging);
+		return true;
+	}
+
+	inline void AssetStreamer::track(const AssetStreamKind kind, const AssetNameView name, const size_t residentBytes)
+	{
+		if (findEntry(kind, name))
+		{
+			return;
+		}
+
+		m_entries[addEntry(kind, name)].residentBytesHint = residentBytes;
+	}
+
+	inline bool AssetStreamer::contains(const AssetStreamKind kind, const AssetNameView name) const
+	{
+		return findEntry(kind, name).has_value();
+	}
+
+	inline void AssetStreamer::request(const AssetStreamKind kind, const AssetNameView name, const int32 priority)
+	{
+		const auto index = findEntry(kind, name);
+
+		if (not index)
+		{
+			return;
+		}
+
+		Entry& entry = m_entries[*index];
+		entry.lastUsedFrame = m_frame;
+
+		switch (entry.state)
+		{
+		case AssetStreamState::Unrequested:
+			entry.priority = priority;
+			entry.requestTime = static_cast<int64>(Time::GetNanosec());
+			enqueue(*index);
+			break;
+		case AssetStreamState::Queued:
+		case AssetStreamState::PendingUpload:
+			if (entry.priority < priority)
+			{
+				// 古い要素はチケットが一致しなくなるので、取り出したときに読み飛ばされる
+				entry.priority = priority;
+				enqueue(*index);
+			}
+			break;
+		case AssetStreamState::Decoding:
+			entry.priority = Max(entry.priority, priority);
+			break;
+		default:
+			break;
+		}
+	}
+
+	inline void AssetStreamer::request(const AssetStreamRequest& request)
+	{
+		this->request(request.kind, request.name, request.priority);
+	}
+
+	inline void AssetStreamer::prefetch(const Array<AssetStreamRequest>& manifest)
+	{
+		for (const auto& request : manifest)
+		{
+			this->request(request);
+		}
+	}
+
+	inline void AssetStreamer::touch(const AssetStreamKind kind, const AssetNameView name)
+	{
+		if (const auto index = findEntry(kind, name))
+		{
+			m_entries[*index].lastUsedFrame = m_frame;
+		}
+	}
+
+	inline void AssetStreamer::update()
+	{
+		++m_frame;
+
+		if constexpr (detail::AssetStreamerUsesWorkers)
+		{
+			// 完了したデコードを回収する
+			for (size_t i = 0; i < m_decoding.size();)
+			{
+				const uint32 index = m_decoding[i];
+				const Entry& entry = m_entries[index];
+
+				if (entry.imageTask.isReady() || entry.waveTask.isReady())
+				{
+					m_decoding[i] = m_decoding.back();
+					m_decoding.pop_back();
+					finishDecode(index);
+				}
+				else
+				{
+					++i;
+				}
+			}
+
+			// アップロードの間もワーカースレッドが働くよう、先に新しいデコードを開始する
+			const size_t maxDecodes = maxConcurrentDecodes();
+
+			while (m_decoding.size() < maxDecodes)
+			{
+				const auto index = popQueue(m_decodeQueue, AssetStreamState::Queued);
+
+				if (not index)
+				{
+					break;
+				}
+
+				startDecode(*index);
+			}
+		}
+
+		// メインスレッドでの処理を、個数と時間の上限の範囲で行う
+		const int64 uploadStart = static_cast<int64>(Time::GetNanosec());
+		size_t numUploads = 0;
+
+		while (numUploads < m_maxUploadsPerFrame)
+		{
+			if (const auto index = popQueue(m_uploadQueue, AssetStreamState::PendingUpload))
+			{
+				upload(*index);
+			}
+			else if constexpr (not detail::AssetStreamerUsesWorkers)
+			{
+				// ワーカースレッドが無い場合は、デコードもアップロードと同じ上限の範囲でここで行う
+				const auto decodeIndex = popQueue(m_decodeQueue, AssetStreamState::Queued);
+
+				if (not decodeIndex)
+				{
+					break;
+				}
+
+				decodeNow(*decodeIndex);
+			}
+			else
+			{
+				break;
+			}
+
+			++numUploads;
+
+			if (m_uploadTimeBudgetNanosec <= (static_cast<int64>(Time::GetNanosec()) - uploadStart))
+			{
+				break;
+			}
+		}
+
+		evict();
+	}
+
+	inline bool AssetStreamer::isReady(const AssetStreamKind kind, const AssetNameView name) const
+	{
+		return (getState(kind, name) == AssetStreamState::Resident);
+	}
+
+	inline bool AssetStreamer::wait(const AssetStreamKind kind, const AssetNameView name)
+	{
+		const auto index = findEntry(kind, name);
+
+		if (not index)
+		{
+			return false;
+		}
+
+		request(kind, name, Largest<int32>);
+
+		Entry& entry = m_entries[*index];
+
+		if (entry.state == AssetStreamState::Queued)
+		{
+			if constexpr (detail::AssetStreamerUsesWorkers)
+			{
+				startDecode(*index);
+			}
+			else
+			{
+				decodeNow(*index);
+			}
+		}
+
+		if (entry.state == AssetStreamState::Decoding)
+		{
+			m_decoding.remove(*index);
+			finishDecode(*index);
+		}
+
+		if (entry.state == AssetStreamState::PendingUpload)
+		{
+			upload(*index);
+		}
+
+		return (entry.state == AssetStreamState::Resident);
+	}
+
+	inline AssetStreamState AssetStreamer::getState(const AssetStreamKind kind, const AssetNameView name) const
+	{
+		if (const auto index = findEntry(kind, name))
+		{
+			return m_entries[*index].state;
+		}
+
+		return AssetStreamState::Unrequested;
+	}
+
+	inline double AssetStreamer::progress(const Array<AssetStreamRequest>& manifest) const
+	{
+		if (not manifest)
+		{
+			return 1.0;
+		}
+
+		size_t numFinished = 0;
+
+		for (const auto& request : manifest)
+		{
+			const AssetStreamState state = getState(request.kind, request.name);
+
+			if ((state == AssetStreamState::Resident) || (state == AssetStreamState::Failed))
+			{
+				++numFinished;
+			}
+		}
+
+		return (static_cast<double>(numFinished) / manifest.size());
+	}
+
+	inline Optional<AssetStreamMetrics> AssetStreamer::getMetrics(const AssetStreamKind kind, const AssetNameView name) const
+	{
+		if (const auto index = findEntry(kind, name))
+		{
+			return m_entries[*index].metrics;
+		}
+
+		return none;
+	}
+
+	inline AssetStreamStats AssetStreamer::getStats() const noexcept
+	{
+		AssetStreamStats stats;
+		stats.residentBytes = m_residentBytes;
+		stats.numEvictions = m_numEvictions;
+
+		for (const auto& entry : m_entries)
+		{
+			switch (entry.state)
+			{
+			case AssetStreamState::Queued:
+				++stats.numQueued;
+				break;
+			case AssetStreamState::Decoding:
+				++stats.numDecoding;
+				break;
+			case AssetStreamState::PendingUpload:
+				++stats.numPendingUpload;
+				break;
+			case AssetStreamState::Resident:
+				++stats.numResident;
+				break;
+			default:
+				break;
+			}
+		}
+
+		return stats;
+	}
+
+	inline void AssetStreamer::setMemoryBudget(const size_t memoryBudget) noexcept
+	{
+		m_memoryBudget = memoryBudget;
+	}
+
+	inline size_t AssetStreamer::getMemoryBudget() const noexcept
+	{
+		return m_memoryBudget;
+	}
+
+	inline void AssetStreamer::setMaxConcurrentDecodes(const size_t maxConcurrentDecodes) noexcept
+	{
+		m_maxConcurrentDecodes = maxConcurrentDecodes;
+	}
+
+	inline void AssetStreamer::setUploadBudget(const size_t maxUploadsPerFrame, const Duration& timeBudget) noexcept
+	{
+		m_maxUploadsPerFrame = Max<size_t>(maxUploadsPerFrame, 1);
+		m_uploadTimeBudgetNanosec = static_cast<int64>(timeBudget.count() * 1'000'000'000.0);
+	}
+
+	inline Optional<uint32> AssetStreamer::findEntry(const AssetStreamKind kind, const AssetNameView name) const
+	{
+		const auto& indices = m_indices[FromEnum(kind)];
+
+		if (const auto it = indices.find(AssetName{ name }); it != indices.end())
+		{
+			return it->second;
+		}
+
+		return none;
+	}
+
+	inline uint32 AssetStreamer::addEntry(const AssetStreamKind kind, const AssetNameView name)
+	{
+		const uint32 index = static_cast<uint32>(m_entries.size());
+
+		Entry entry;
+		entry.kind = kind;
+		entry.name = name;
+		m_entries << std::move(entry);
+
+		m_indices[FromEnum(kind)].emplace(AssetName{ name }, index);
+		return index;
+	}
+
+	inline void AssetStreamer::enqueue(const uint32 index)
+	{
+		Entry& entry = m_entries[index];
+		entry.ticket = ++m_ticket;
+
+		// デコードの必要が無いアセットは、直接アップロードを待つ
+		if ((entry.state == AssetStreamState::PendingUpload) || entry.path.isEmpty())
+		{
+			entry.state = AssetStreamState::PendingUpload;
+			m_uploadQueue.push_back({ entry.priority, entry.ticket, index });
+			std::push_heap(m_uploadQueue.begin(), m_uploadQueue.end());
+		}
+		else
+		{
+			entry.state = AssetStreamState::Queued;
+			m_decodeQueue.push_back({ entry.priority, entry.ticket, index });
+			std::push_heap(m_decodeQueue.begin(), m_decodeQueue.end());
+		}
+	}
+
+	inline size_t AssetStreamer::maxConcurrentDecodes() const noexcept
+	{
+		if (m_maxConcurrentDecodes)
+		{
+			return m_maxConcurrentDecodes;
+		}
+
+		// メインスレッドの分を残す
+		return Max<size_t>((Threading::GetConcurrency() - 1), 1);
+	}
+
+	inline Optional<uint32> AssetStreamer::popQueue(Array<QueueItem>& queue, const AssetStreamState state)
+	{
+		while (queue)
+		{
+			std::pop_heap(queue.begin(), queue.end());
+			const QueueItem item = queue.back();
+			queue.pop_back();
+
+			const Entry& entry = m_entries[item.index];
+
+			if ((entry.state == state) && (entry.ticket == item.ticket))
+			{
+				return item.index;
+			}
+		}
+
+		return none;
+	}
+
+	inline void AssetStreamer::startDecode(const uint32 index)
+	{
+		Entry& entry = m_entries[index];
+		entry.state = AssetStreamState::Decoding;
+
+		if (entry.kind == AssetStreamKind::Texture)
+		{
+			entry.imageTask = Async([path = entry.path, staging = entry.staging]()
+				{
+					const int64 start = static_cast<int64>(Time::GetNanosec());
+					Image image{ path };
+					staging->decodeNanosec = (static_cast<int64>(Time::GetNanosec()) - start);
+					return image;
+				});
+		}
+		else
+		{
+			entry.waveTask = Async([path = entry.path, staging = entry.staging]()
+				{
+					const int64 start = static_cast<int64>(Time::GetNanosec());
+					Wave wave{ path };
+					staging->decodeNanosec = (static_cast<int64>(Time::GetNanosec()) - start);
+					return wave;
+				});
+		}
+
+		m_decoding << index;
+	}
+
+	inline void AssetStreamer::finishDecode(const uint32 index)
+	{
+		Entry& entry = m_entries[index];
+		bool decoded;
+
+		if (entry.kind == AssetStreamKind::Texture)
+		{
+			entry.staging->image = entry.imageTask.get();
+			decoded = static_cast<bool>(entry.staging->image);
+		}
+		else
+		{
+			entry.staging->wave = entry.waveTask.get();
+			decoded = static_cast<bool>(entry.staging->wave);
+		}
+
+		entry.metrics.decodeNanosec = entry.staging->decodeNanosec;
+		onDecoded(index, decoded);
+	}
+
+	inline void AssetStreamer::decodeNow(const uint32 index)
+	{
+		Entry& entry = m_entries[index];
+		bool decoded;
+
+		const int64 start = static_cast<int64>(Time::GetNanosec());
+
+		if (entry.kind == AssetStreamKind::Texture)
+		{
+			entry.staging->image = Image{ entry.path };
+			decoded = static_cast<bool>(entry.staging->image);
+		}
+		else
+		{
+			entry.staging->wave = Wave{ entry.path };
+			decoded = static_cast<bool>(entry.staging->wave);
+		}
+
+		entry.metrics.decodeNanosec = (static_cast<int64>(Time::GetNanosec()) - start);
+		onDecoded(index, decoded);
+	}
+
+	inline void AssetStreamer::onDecoded(const uint32 index, const bool decoded)
+	{
+		Entry& entry = m_entries[index];
+
+		if (not decoded)
+		{
+			entry.state = AssetStreamState::Failed;
+			return;
+		}
+
+		entry.state = AssetStreamState::PendingUpload;
+		enqueue(index);
+	}
+
+	inline void AssetStreamer::upload(const uint32 index)
+	{
+		Entry& entry = m_entries[index];
+
+		const int64 start = static_cast<int64>(Time::GetNanosec());
+		const bool loaded = detail::LoadStreamedAsset(entry.kind, entry.name);
+		const int64 end = static_cast<int64>(Time::GetNanosec());
+
+		if (entry.staging)
+		{
+			// ロードに失敗した場合も、デコード済みのデータを残さない
+			entry.staging->image = Image{};
+			entry.staging->wave = Wave{};
+		}
+
+		entry.metrics.uploadNanosec = (end - start);
+		entry.metrics.latencyNanosec = (end - entry.requestTime);
+
+		if (not loaded)
+		{
+			entry.state = AssetStreamState::Failed;
+			return;
+		}
+
+		const size_t bytes = (entry.residentBytesHint ? entry.residentBytesHint : detail::EstimateStreamedAssetBytes(entry.kind, entry.name));
+
+		// ロードした直後のアセットが、すぐに解放されないようにする
+		entry.state = AssetStreamState::Resident;
+		entry.lastUsedFrame = m_frame;
+		entry.metrics.residentBytes = bytes;
+		++entry.metrics.numLoads;
+		m_residentBytes += bytes;
+	}
+
+	inline void AssetStreamer::evict()
+	{
+		if (m_residentBytes <= m_memoryBudget)
+		{
+			return;
+		}
+
+		// 現在のフレームと前のフレームで使われたアセットは残す
+		Array<uint32> candidates;
+
+		for (uint32 i = 0; i < m_entries.size(); ++i)
+		{
+			const Entry& entry = m_entries[i];
+
+			if ((entry.state == AssetStreamState::Resident) && ((entry.lastUsedFrame + 1) < m_frame))
+			{
+				candidates << i;
+			}
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [this](const uint32 a, const uint32 b)
+			{
+				return (m_entries[a].lastUsedFrame < m_entries[b].lastUsedFrame);
+			});
+
+		for (const uint32 index : candidates)
+		{
+			if (m_residentBytes <= m_memoryBudget)
+			{
+				break;
+			}
+
+			Entry& entry = m_entries[index];
+			detail::ReleaseStreamedAsset(entry.kind, entry.name);
+
+			m_residentBytes -= entry.metrics.residentBytes;
+			entry.metrics.residentBytes = 0;
+			++entry.metrics.numEvictions;
+			++m_numEvictions;
+			entry.state = AssetStreamState::Unrequested;
+		}
+	}
+}
@@ -0,0 +1,306 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <array>
+
+namespace s3d
+{
+	namespace detail
+	{
+		inline constexpr char Base64EncodeTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+		/// @brief Base64 の文字から 6-bit の値への変換表。不正な文字は 0xFF
+		inline constexpr std::array<uint8, 256> Base64DecodeTable = []()
+		{
+			std::array<uint8, 256> table{};
+
+			for (auto& value : table)
+			{
+				value = 0xFF;
+			}
+
+			for (uint8 i = 0; i < 64; ++i)
+			{
+				table[static_cast<uint8>(Base64EncodeTable[i])] = i;
+			}
+
+			return table;
+		}();
+
+		/// @brief `StringView` をデコードするときに 1 回で変換する文字数（4 の倍数）
+		inline constexpr size_t Base64DecodeChunkLength = 4096;
+
+		// SIMD の変換は aklomp/base64 (BSD-2-Clause) の SSSE3 実装と同じ手法による
+		// SSE が使えない環境では simde が NEON や WebAssembly SIMD128 の命令に変換する（Web 版は `-msimd128` でビルドした場合。付けない場合はスカラーの処理になる）
+
+		/// @brief 12 バイトを 16 個の 6-bit の値に並べ替えます。
+		[[nodiscard]]
+		inline __m128i Base64EncodeReshuffle(const __m128i input) noexcept
+		{
+			const __m128i in = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+			const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+			const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+			const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+			const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+			return _mm_or_si128(t1, t3);
+		}
+
+		/// @brief 6-bit の値を Base64 の文字に変換します。
+		[[nodiscard]]
+		inline __m128i Base64EncodeTranslate(const __m128i in) noexcept
+		{
+			const __m128i lut = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+			__m128i indices = _mm_subs_epu8(in, _mm_set1_epi8(51));
+			const __m128i mask = _mm_cmpgt_epi8(in, _mm_set1_epi8(25));
+			indices = _mm_sub_epi8(indices, mask);
+			return _mm_add_epi8(in, _mm_shuffle_epi8(lut, indices));
+		}
+
+		inline size_t Base64EncodeCore(const uint8* src, size_t size, char* dst) noexcept
+		{
+			char* const first = dst;
+
+			// 16 バイト読み込んで先頭の 12 バイトを使う
+			while (16 <= size)
+			{
+				const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), Base64EncodeTranslate(Base64EncodeReshuffle(in)));
+				src += 12;
+				size -= 12;
+				dst += 16;
+			}
+
+			for (; 3 <= size; size -= 3)
+			{
+				const uint32 n = ((static_cast<uint32>(src[0]) << 16) | (static_cast<uint32>(src[1]) << 8) | src[2]);
+				dst[0] = Base64EncodeTable[(n >> 18) & 63];
+				dst[1] = Base64EncodeTable[(n >> 12) & 63];
+				dst[2] = Base64EncodeTable[(n >> 6) & 63];
+				dst[3] = Base64EncodeTable[n & 63];
+				src += 3;
+				dst += 4;
+			}
+
+			if (size == 1)
+			{
+				const uint32 n = (static_cast<uint32>(src[0]) << 16);
+				dst[0] = Base64EncodeTable[(n >> 18) & 63];
+				dst[1] = Base64EncodeTable[(n >> 12) & 63];
+				dst[2] = '=';
+				dst[3] = '=';
+				dst += 4;
+			}
+			else if (size == 2)
+			{
+				const uint32 n = ((static_cast<uint32>(src[0]) << 16) | (static_cast<uint32>(src[1]) << 8));
+				dst[0] = Base64EncodeTable[(n >> 18) & 63];
+				dst[1] = Base64EncodeTable[(n >> 12) & 63];
+				dst[2] = Base64EncodeTable[(n >> 6) & 63];
+				dst[3] = '=';
+				dst += 4;
+			}
+
+			return static_cast<size_t>(dst - first);
+		}
+
+		/// @brief パディングを除いた Base64 の文字数から、デコード後のサイズを返します。
+		[[nodiscard]]
+		inline constexpr size_t Base64DecodedSize(const size_t length) noexcept
+		{
+			return ((length / 4) * 3 + (((length % 4) == 0) ? 0 : ((length % 4) - 1)));
+		}
+
+		/// @brief パディングを除いた Base64 をデコードします。
+		/// @param length 文字数。4 で割った余りが 1 であってはいけません
+		/// @return 不正な文字が無かった場合 true, それ以外の場合は false
+		inline bool Base64DecodeCore(const char* src, const size_t length, uint8* dst) noexcept
+		{
+			const __m128i lutLo = _mm_setr_epi8(
+				0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+				0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+			const __m128i lutHi = _mm_setr_epi8(
+				0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+				0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+			const __m128i lutRoll = _mm_setr_epi8(
+				0, 16, 19, 4, -65, -65, -71, -71,
+				0, 0, 0, 0, 0, 0, 0, 0);
+			const __m128i mask2F = _mm_set1_epi8(0x2F);
+
+			size_t i = 0;
+
+			// 16 文字を 12 バイトに変換して 16 バイト書き込むため、後続の出力が 4 バイト以上ある間だけ行う
+			for (; (i + 24) <= length; i += 16)
+			{
+				__m128i str = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask2F);
+				const __m128i loNibbles = _mm_and_si128(str, mask2F);
+				const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+				const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+
+				if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0)
+				{
+					// 不正な文字を含むブロックはスカラーで処理する
+					break;
+				}
+
+				const __m128i eq2F = _mm_cmpeq_epi8(str, mask2F);
+				const __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+				str = _mm_add_epi8(str, roll);
+
+				const __m128i mergeAB = _mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140));
+				__m128i out = _mm_madd_epi16(mergeAB, _mm_set1_epi32(0x00011000));
+				out = _mm_shuffle_epi8(out, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), out);
+				dst += 12;
+			}
+
+			uint32 invalid = 0;
+
+			for (; (i + 4) <= length; i += 4)
+			{
+				const uint32 a = Base64DecodeTable[static_cast<uint8>(src[i])];
+				const uint32 b = Base64DecodeTable[static_cast<uint8>(src[i + 1])];
+				const uint32 c = Base64DecodeTable[static_cast<uint8>(src[i + 2])];
+				const uint32 d = Base64DecodeTable[static_cast<uint8>(src[i + 3])];
+				invalid |= (a | b | c | d);
+
+				const uint32 n = ((a << 18) | (b << 12) | (c << 6) | d);
+				dst[0] = static_cast<uint8>(n >> 16);
+				dst[1] = static_cast<uint8>(n >> 8);
+				dst[2] = static_cast<uint8>(n);
+				dst += 3;
+			}
+
+			if ((length - i) == 2)
+			{
+				const uint32 a = Base64DecodeTable[static_cast<uint8>(src[i])];
+				const uint32 b = Base64DecodeTable[static_cast<uint8>(src[i + 1])];
+				invalid |= (a | b);
+
+				dst[0] = static_cast<uint8>(((a << 18) | (b << 12)) >> 16);
+			}
+			else if ((length - i) == 3)
+			{
+				const uint32 a = Base64DecodeTable[static_cast<uint8>(src[i])];
+				const uint32 b = Base64DecodeTable[static_cast<uint8>(src[i + 1])];
+				const uint32 c = Base64DecodeTable[static_cast<uint8>(src[i + 2])];
+				invalid |= (a | b | c);
+
+				const uint32 n = ((a << 18) | (b << 12) | (c << 6));
+				dst[0] = static_cast<uint8>(n >> 16);
+				dst[1] = static_cast<uint8>(n >> 8);
+			}
+
+			return ((invalid & 0xC0) == 0);
+		}
+
+		/// @brief 末尾のパディングを除いた文字数を返します。
+		template <class View>
+		[[nodiscard]]
+		inline size_t Base64UnpaddedLength(const View& base64) noexcept
+		{
+			size_t length = base64.size();
+
+			if ((length % 4) == 0)
+			{
+				for (int32 i = 0; (i < 2) && (length != 0) && (base64[length - 1] == '='); ++i)
+				{
+					--length;
+				}
+			}
+
+			return length;
+		}
+	}
+
+	namespace Base64
+	{
+		inline size_t Encode(const void* data, const size_t size, char* dst) noexcept
+		{
+			return detail::Base64EncodeCore(static_cast<const uint8*>(data), size, dst);
+		}
+
+		inline constexpr size_t EncodedLength(const size_t size) noexcept
+		{
+			return (((size + 2) / 3) * 4);
+		}
+
+		inline void Decode(const std::string_view base64, Blob& dst, const SkipValidation skipValidation)
+		{
+			const size_t length = detail::Base64UnpaddedLength(base64);
+
+			if ((length % 4) == 1)
+			{
+				dst.clear();
+
+				if (not skipValidation)
+				{
+					throw Error{ U"Base64::Decode(): Invalid Base64 input" };
+				}
+
+				return;
+			}
+
+			dst.resize(detail::Base64DecodedSize(length));
+
+			if ((not detail::Base64DecodeCore(base64.data(), length, reinterpret_cast<uint8*>(dst.data())))
+				&& (not skipValidation))
+			{
+				dst.clear();
+				throw Error{ U"Base64::Decode(): Invalid Base64 input" };
+			}
+		}
+
+		inline void Decode(const StringView base64, Blob& dst, const SkipValidation skipValidation)
+		{
+			const size_t length = detail::Base64UnpaddedLength(base64);
+
+			if ((length % 4) == 1)
+			{
+				dst.clear();
+
+				if (not skipValidation)
+				{
+					throw Error{ U"Base64::Decode(): Invalid Base64 input" };
+				}
+
+				return;
+			}
+
+			dst.resize(detail::Base64DecodedSize(length));
+
+			uint8* pDst = reinterpret_cast<uint8*>(dst.data());
+			char buffer[detail::Base64DecodeChunkLength];
+			bool valid = true;
+
+			for (size_t i = 0; i < length; i += detail::Base64DecodeChunkLength)
+			{
+				const size_t chunkLength = Min(detail::Base64DecodeChunkLength, (length - i));
+
+				for (size_t k = 0; k < chunkLength; ++k)
+				{
+					const char32 ch = base64[i + k];
+					buffer[k] = ((ch < 0x80) ? static_cast<char>(ch) : '\x80');
+				}
+
+				valid &= detail::Base64DecodeCore(buffer, chunkLength, pDst);
+				pDst += ((detail::Base64DecodeChunkLength / 4) * 3);
+			}
+
+			if ((not valid) && (not skipValidation))
+			{
+				dst.clear();
+				throw Error{ U"Base64::Decode(): Invalid Base64 input" };
+			}
+		}
+	}
+}
@@ -0,0 +1,257 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <cmath>
+# include "../Math.hpp"
+# include "../Random.hpp"
+# include "../2DShapes.hpp"
+# include "../TextureRegion.hpp"
+# include "../TexturedQuad.hpp"
+# include "../ScopedRenderStates2D.hpp"
+
+namespace s3d
+{
+	inline BulkParticleSystem2D::BulkParticleSystem2D(const Vec2& position, const Vec2& force)
+		: m_position{ position }
+		, m_force{ force } {}
+
+	inline BulkParticleSystem2D::BulkParticleSystem2D(const Vec2& position, const Vec2& force, std::unique_ptr<IEmitter2D>&& emitter,
+		const ParticleSystem2DParameters& parameters, const Texture& texture)
+		: m_position{ position }
+		, m_force{ force }
+		, m_texture{ texture }
+	{
+		setEmitter(std::move(emitter));
+		setParameters(parameters);
+	}
+
+	template <class Emitter, std::enable_if_t<std::is_base_of_v<IEmitter2D, Emitter>>*>
+	inline BulkParticleSystem2D::BulkParticleSystem2D(const Vec2& position, const Vec2& force, const Emitter& emitter,
+		const ParticleSystem2DParameters& parameters, const Texture& texture)
+			: BulkParticleSystem2D{ position, force, std::make_unique<Emitter>(emitter), parameters, texture } {}
+
+	inline void BulkParticleSystem2D::setPosition(const Vec2& position) noexcept
+	{
+		m_position = position;
+	}
+
+	inline void BulkParticleSystem2D::setForce(const Vec2& force) noexcept
+	{
+		m_force = force;
+	}
+
+	inline void BulkParticleSystem2D::setEmitter(std::unique_ptr<IEmitter2D>&& emitter)
+	{
+		m_emitter = std::move(emitter);
+		m_bulkEmitter = dynamic_cast<IBulkEmitter2D*>(m_emitter.get());
+	}
+
+	template <class Emitter, std::enable_if_t<std::is_base_of_v<IEmitter2D, Emitter>>*>
+	inline void BulkParticleSystem2D::setEmitter(const Emitter& emitter)
+	{
+		setEmitter(std::make_unique<Emitter>(emitter));
+	}
+
+	inline void BulkParticleSystem2D::setParameters(const ParticleSystem2DParameters& parameters)
+	{
+		m_parameters = parameters;
+		m_particles.setCapacity(static_cast<size_t>(Max(parameters.maxParticles, 0.0)));
+	}
+
+	inline void BulkParticleSystem2D::setTexture(const Texture& texture) noexcept
+	{
+		m_texture = texture;
+	}
+
+	inline size_t BulkParticleSystem2D::num_particles() const noexcept
+	{
+		return m_particles.size();
+	}
+
+	inline const ParticleArray2D& BulkParticleSystem2D::particles() const noexcept
+	{
+		return m_particles;
+	}
+
+	inline void BulkParticleSystem2D::prewarm()
+	{
+		constexpr double Step = (1.0 / 60.0);
+
+		for (double t = 0.0; t < m_parameters.startLifeTime; t += Step)
+		{
+			update(Step);
+		}
+	}
+
+	inline void BulkParticleSystem2D::update(const double deltaTime)
+	{
+		update(deltaTime, true);
+	}
+
+	inline void BulkParticleSystem2D::draw() const
+	{
+		const ScopedRenderStates2D blend{ m_parameters.blendState };
+		const auto& sizeOverLifeTime = m_parameters.sizeOverLifeTimeFunc;
+		const auto& colorOverLifeTime = m_parameters.colorOverLifeTimeFunc;
+		const auto s = m_particles.streams();
+
+		for (size_t i = 0; i < m_particles.size(); ++i)
+		{
+			const Vec2 position{ s.positionX[i], s.positionY[i] };
+			const Float4 startColor{ s.startColorR[i], s.startColorG[i], s.startColorB[i], s.startColorA[i] };
+
+			const float size = (sizeOverLifeTime ? sizeOverLifeTime(s.startSize[i], s.startLifeTime[i], s.remainingLifeTime[i]) : s.startSize[i]);
+			const Float4 color = (colorOverLifeTime ? colorOverLifeTime(startColor, s.startLifeTime[i], s.remainingLifeTime[i]) : startColor);
+
+			if (m_texture)
+			{
+				m_texture.resized(size).rotated(s.rotation[i]).drawAt(position, ColorF{ color.x, color.y, color.z, color.w });
+			}
+			else
+			{
+				Circle{ position, (size * 0.5) }.draw(ColorF{ color.x, color.y, color.z, color.w });
+			}
+		}
+	}
+
+	inline void BulkParticleSystem2D::drawDebug() const
+	{
+		if (m_emitter)
+		{
+			m_emitter->drawDebug(m_position);
+		}
+	}
+
+	inline void BulkParticleSystem2D::UpdateAll(const Array<BulkParticleSystem2D*>& systems, const double deltaTime)
+	{
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if (1 < systems.size())
+		{
+			// システムの間で並列化するので、各システムの中では並列化しない
+			parallel_for(0, systems.size(), 1, [&](const size_t i)
+				{
+					systems[i]->update(deltaTime, false);
+				});
+			return;
+		}
+
+	# endif
+
+		for (auto* system : systems)
+		{
+			system->update(deltaTime, true);
+		}
+	}
+
+	inline void BulkParticleSystem2D::update(const double deltaTime, const bool allowParallel)
+	{
+		if (deltaTime <= 0.0)
+		{
+			return;
+		}
+
+		const float dt = static_cast<float>(deltaTime);
+		const Float2 deltaVelocity = (m_force * deltaTime);
+
+		if (allowParallel)
+		{
+			m_particles.update(dt, deltaVelocity);
+		}
+		else
+		{
+			m_particles.update(dt, deltaVelocity, 0, m_particles.size());
+		}
+
+		m_particles.removeDead();
+
+		emit(deltaTime);
+	}
+
+	inline void BulkParticleSystem2D::emit(const double deltaTime)
+	{
+		if ((not m_emitter) || (m_parameters.rate <= 0.0))
+		{
+			return;
+		}
+
+		const double interval = (1.0 / m_parameters.rate);
+		m_accumulatedTime += deltaTime;
+
+		const size_t count = static_cast<size_t>(std::floor(m_accumulatedTime / interval));
+
+		if (count == 0)
+		{
+			return;
+		}
+
+		m_accumulatedTime -= (count * interval);
+
+		// 空きが足りない場合は、先に放出されるはずだったパーティクルから順に放出する
+		const size_t numEmissions = Min(count, (m_particles.capacity() - m_particles.size()));
+
+		if (numEmissions == 0)
+		{
+			return;
+		}
+
+		m_emissions.resize(numEmissions);
+
+		if (m_bulkEmitter)
+		{
+			m_bulkEmitter->emitBulk(m_position, m_parameters.startSpeed, m_emissions.data(), numEmissions);
+		}
+		else
+		{
+			for (auto& emission : m_emissions)
+			{
+				emission = m_emitter->emit(m_position, m_parameters.startSpeed);
+			}
+		}
+
+		const Float4 startColor = m_parameters.startColor.toFloat4();
+		const float startSize = static_cast<float>(m_parameters.startSize);
+		const float startLifeTime = static_cast<float>(m_parameters.startLifeTime);
+		const double randomRotation = m_parameters.randomStartRotationDeg;
+		const double randomAngularVelocity = m_parameters.randomStartAngularVelocityDeg;
+
+		const size_t first = m_particles.size();
+		m_particles.resize(first + numEmissions);
+		const auto s = m_particles.streams();
+
+		for (size_t k = 0; k < numEmissions; ++k)
+		{
+			const Emission2D& emission = m_emissions[k];
+			const size_t i = (first + k);
+
+			// このフレームの中で、放出されてから経過した時間
+			const double age = (m_accumulatedTime + (count - 1 - k) * interval);
+
+			const double rotation = Math::ToRadians(m_parameters.startRotationDeg + ((randomRotation != 0.0) ? Random(-randomRotation, randomRotation) : 0.0));
+			const double angularVelocity = Math::ToRadians(m_parameters.startAngularVelocityDeg + ((randomAngularVelocity != 0.0) ? Random(-randomAngularVelocity, randomAngularVelocity) : 0.0));
+
+			s.positionX[i] = static_cast<float>(emission.position.x + emission.velocity.x * age);
+			s.positionY[i] = static_cast<float>(emission.position.y + emission.velocity.y * age);
+			s.velocityX[i] = static_cast<float>(emission.velocity.x + m_force.x * age);
+			s.velocityY[i] = static_cast<float>(emission.velocity.y + m_force.y * age);
+			s.startColorR[i] = startColor.x;
+			s.startColorG[i] = startColor.y;
+			s.startColorB[i] = startColor.z;
+			s.startColorA[i] = startColor.w;
+			s.startSize[i] = startSize;
+			s.rotation[i] = static_cast<float>(rotation + angularVelocity * age);
+			s.startAngularVelocity[i] = static_cast<float>(angularVelocity);
+			s.startLifeTime[i] = startLifeTime;
+			s.remainingLifeTime[i] = static_cast<float>(m_parameters.startLifeTime - age);
+		}
+	}
+}
@@ -0,0 +1,894 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <charconv>
+# include <cstdlib>
+# include <cstring>
+# include <cmath>
+# include <limits>
+# include <atomic>
+# include <memory>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 行の区切りを並列に探すときの 1 タスクあたりのバイト数
+		inline constexpr size_t ColumnarCSVChunkBytes = (1 << 20);
+
+		/// @brief 列を並列に変換するときの 1 タスクあたりの行数
+		inline constexpr size_t ColumnarCSVRowGrain = 4096;
+
+		template <class Fty>
+		inline void ForEachCSVRange(const size_t count, const size_t grain, Fty f)
+		{
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			if (grain < count)
+			{
+				parallel_for(0, count, grain, [&](const size_t first, const size_t last) { f(first, last); });
+				return;
+			}
+
+		# endif
+
+			f(0, count);
+		}
+
+		[[nodiscard]]
+		inline std::string_view TrimCSVSpaces(std::string_view s) noexcept
+		{
+			while ((not s.empty()) && ((s.front() == ' ') || (s.front() == '\t')))
+			{
+				s.remove_prefix(1);
+			}
+
+			while ((not s.empty()) && ((s.back() == ' ') || (s.back() == '\t')))
+			{
+				s.remove_suffix(1);
+			}
+
+			return s;
+		}
+
+		[[nodiscard]]
+		inline bool ParseCSVInt64(std::string_view s, int64& value) noexcept
+		{
+			s = TrimCSVSpaces(s);
+
+			if ((1 < s.size()) && (s.front() == '+'))
+			{
+				s.remove_prefix(1);
+			}
+
+			if (s.empty())
+			{
+				return false;
+			}
+
+			const char* last = (s.data() + s.size());
+			const auto [ptr, ec] = std::from_chars(s.data(), last, value);
+			return ((ec == std::errc{}) && (ptr == last));
+		}
+
+		[[nodiscard]]
+		inline bool ParseCSVDouble(std::string_view s, double& value) noexcept
+		{
+			s = TrimCSVSpaces(s);
+
+			if ((1 < s.size()) && (s.front() == '+'))
+			{
+				s.remove_prefix(1);
+			}
+
+			if (s.empty())
+			{
+				return false;
+			}
+
+		# if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+
+			const char* last = (s.data() + s.size());
+			const auto [ptr, ec] = std::from_chars(s.data(), last, value);
+			return ((ec == std::errc{}) && (ptr == last));
+
+		# else
+
+			char buffer[64];
+
+			if (sizeof(buffer) <= s.size())
+			{
+				return false;
+			}
+
+			std::memcpy(buffer, s.data(), s.size());
+			buffer[s.size()] = '\0';
+
+			char* end = nullptr;
+			value = std::strtod(buffer, &end);
+			return (end == (buffer + s.size()));
+
+		# endif
+		}
+
+		/// @brief 1 行の要素を先頭から順に列挙します。
+		/// @param f `f(column, offset, length, escaped)`
+		template <class Fty>
+		inline void ForEachCSVField(const char* data, size_t pos, const size_t end, const char separator, const char quote, Fty f)
+		{
+			for (size_t column = 0;; ++column)
+			{
+				if ((pos < end) && (data[pos] == quote))
+				{
+					const size_t first = ++pos;
+					bool escaped = false;
+
+					while (pos < end)
+					{
+						if (data[pos] == quote)
+						{
+							if (((pos + 1) < end) && (data[pos + 1] == quote))
+							{
+								escaped = true;
+								pos += 2;
+								continue;
+							}
+
+							break;
+						}
+
+						++pos;
+					}
+
+					f(column, first, (pos - first), escaped);
+
+					while ((pos < end) && (data[pos] != separator))
+					{
+						++pos;
+					}
+				}
+				else
+				{
+					const size_t first = pos;
+
+					while ((pos < end) && (data[pos] != separator))
+					{
+						++pos;
+					}
+
+					f(column, first, (pos - first), false);
+				}
+
+				if (end <= pos)
+				{
+					return;
+				}
+
+				++pos;
+			}
+		}
+
+		/// @brief クオーテーション記号の外にある改行で区切られた、空でない行の範囲 [first, last) を返します。
+		[[nodiscard]]
+		inline Array<std::pair<size_t, size_t>> FindCSVLines(const char* data, const size_t begin, const size_t size, const char quote)
+		{
+			const size_t numChunks = ((size - begin + ColumnarCSVChunkBytes - 1) / ColumnarCSVChunkBytes);
+
+			// 各チャンク内の改行の位置と、チャンク先頭からそこまでのクオーテーション記号の個数の偶奇 (pos * 2 + parity)
+			Array<Array<uint64>> newlines(numChunks);
+			Array<uint8> oddQuotes(numChunks);
+
+			ForEachCSVRange(numChunks, 1, [&](const size_t firstChunk, const size_t lastChunk)
+			{
+				for (size_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+				{
+					const size_t first = (begin + chunk * ColumnarCSVChunkBytes);
+					const size_t last = Min((first + ColumnarCSVChunkBytes), size);
+					Array<uint64>& positions = newlines[chunk];
+					uint64 parity = 0;
+
+					for (size_t i = first; i < last; ++i)
+					{
+						const char ch = data[i];
+
+						if (ch == quote)
+						{
+							parity ^= 1;
+						}
+						else if (ch == '\n')
+						{
+							positions.push_back((static_cast<uint64>(i) << 1) | parity);
+						}
+					}
+
+					oddQuotes[chunk] = static_cast<uint8>(parity);
+				}
+			});
+
+			Array<std::pair<size_t, size_t>> lines;
+
+			auto addLine = [&](const size_t first, size_t last)
+			{
+				if ((first < last) && (data[last - 1] == '\r'))
+				{
+					--last;
+				}
+
+				if (first < last)
+				{
+					lines.emplace_back(first, last);
+				}
+			};
+
+			size_t lineBegin = begin;
+			uint64 parity = 0;
+
+			for (size_t chunk = 0; chunk < numChunks; ++chunk)
+			{
+				for (const uint64 position : newlines[chunk])
+				{
+					if (((position & 1) ^ parity) == 0)
+					{
+						const size_t lineEnd = static_cast<size_t>(position >> 1);
+						addLine(lineBegin, lineEnd);
+						lineBegin = (lineEnd + 1);
+					}
+				}
+
+				newlines[chunk].clear();
+				newlines[chunk].shrink_to_fit();
+				parity ^= oddQuotes[chunk];
+			}
+
+			addLine(lineBegin, size);
+
+			return lines;
+		}
+	}
+
+	inline ColumnarCSV::ColumnarCSV(const FilePathView path, const HasHeader hasHeader, const Array<CSVColumnType>& schema, const char separator, const char quote)
+	{
+		load(path, hasHeader, schema, separator, quote);
+	}
+
+	inline bool ColumnarCSV::load(const FilePathView path, const HasHeader hasHeader, const Array<CSVColumnType>& schema, const char separator, const char quote)
+	{
+		clear();
+
+		if (not m_file.open(path, MapAll::Yes))
+		{
+			return false;
+		}
+
+		m_data = reinterpret_cast<const char*>(m_file.data());
+		m_quote = quote;
+
+		const size_t size = (m_data ? m_file.mappedSize() : 0);
+
+		// UTF-8 BOM
+		const size_t begin = (((3 <= size) && (std::memcmp(m_data, "\xEF\xBB\xBF", 3) == 0)) ? 3 : 0);
+
+		Array<std::pair<size_t, size_t>> lines = detail::FindCSVLines(m_data, begin, size, quote);
+
+		if (lines.isEmpty())
+		{
+			return true;
+		}
+
+		const size_t firstRow = (hasHeader ? 1 : 0);
+		size_t numColumns = 0;
+
+		detail::ForEachCSVField(m_data, lines.front().first, lines.front().second, separator, quote,
+			[&](const size_t column, const size_t offset, const size_t length, const bool escaped)
+			{
+				numColumns = (column + 1);
+
+				if (hasHeader)
+				{
+					const FieldRef field{ offset, static_cast<uint32>(length), escaped };
+					m_columnNames << Unicode::FromUTF8(escaped ? std::string_view{ unescape(field) } : fieldView(field));
+				}
+			});
+
+		m_rows = (lines.size() - firstRow);
+		m_columns.resize(numColumns);
+
+		// 先頭の行から型を推定した列（変換できない要素が見つかった場合は型を変更する）
+		Array<uint8> inferred(numColumns, 0);
+
+		// 列の型を決める
+		{
+			Array<uint8> maybeInt64(numColumns, 1), maybeDouble(numColumns, 1), hasValue(numColumns, 0);
+			const size_t lastSample = Min((firstRow + SchemaInferenceRows), lines.size());
+
+			for (size_t i = firstRow; i < lastSample; ++i)
+			{
+				detail::ForEachCSVField(m_data, lines[i].first, lines[i].second, separator, quote,
+					[&](const size_t column, const size_t offset, const size_t length, bool)
+					{
+						if (numColumns <= column)
+						{
+							return;
+						}
+
+						const std::string_view s = detail::TrimCSVSpaces(std::string_view{ (m_data + offset), length });
+
+						if (s.empty())
+						{
+							return;
+						}
+
+						hasValue[column] = 1;
+
+						if (int64 value; maybeInt64[column] && (not detail::ParseCSVInt64(s, value)))
+						{
+							maybeInt64[column] = 0;
+						}
+
+						if (double value; maybeDouble[column] && (not detail::ParseCSVDouble(s, value)))
+						{
+							maybeDouble[column] = 0;
+						}
+					});
+			}
+
+			for (size_t column = 0; column < numColumns; ++column)
+			{
+				CSVColumnType type = ((column < schema.size()) ? schema[column] : CSVColumnType::Auto);
+
+				if (type == CSVColumnType::Auto)
+				{
+					inferred[column] = 1;
+
+					if (hasValue[column] && maybeInt64[column])
+					{
+						type = CSVColumnType::Int64;
+					}
+					else if (hasValue[column] && maybeDouble[column])
+					{
+						type = CSVColumnType::Double;
+					}
+					else
+					{
+						type = CSVColumnType::String;
+					}
+				}
+
+				setColumnType(m_columns[column], type);
+			}
+		}
+
+		// 変換する列
+		Array<uint8> pending(numColumns, 1);
+
+		// 型を推定した列で、変換できない要素が見つかった列
+		const std::unique_ptr<std::atomic<uint8>[]> failed = std::make_unique<std::atomic<uint8>[]>(numColumns);
+
+		for (;;)
+		{
+			// 各行の要素を列ごとの配列に変換する
+			detail::ForEachCSVRange(m_rows, detail::ColumnarCSVRowGrain, [&](const size_t first, const size_t last)
+			{
+				for (size_t row = first; row < last; ++row)
+				{
+					const auto& line = lines[firstRow + row];
+
+					detail::ForEachCSVField(m_data, line.first, line.second, separator, quote,
+						[&](const size_t column, const size_t offset, const size_t length, const bool escaped)
+						{
+							if ((numColumns <= column) || (not pending[column]))
+							{
+								return;
+							}
+
+							Column& c = m_columns[column];
+							const std::string_view s{ (m_data + offset), length };
+							bool parsed = false;
+
+							switch (c.type)
+							{
+							case CSVColumnType::Int64:
+								if (int64 value; (parsed = detail::ParseCSVInt64(s, value)))
+								{
+									c.int64s[row] = value;
+								}
+								break;
+							case CSVColumnType::Double:
+								if (double value; (parsed = detail::ParseCSVDouble(s, value)))
+								{
+									c.doubles[row] = value;
+								}
+								break;
+							default:
+								c.fields[row] = FieldRef{ offset, static_cast<uint32>(length), escaped };
+								return;
+							}
+
+							if (parsed)
+							{
+								c.valid[row] = 1;
+							}
+							else if (inferred[column] && (not detail::TrimCSVSpaces(s).empty()))
+							{
+								failed[column].store(1, std::memory_order_relaxed);
+							}
+						});
+				}
+			});
+
+			// 変換できない要素があった列は Double, String の順に型を変えて変換し直す
+			bool retry = false;
+
+			for (size_t column = 0; column < numColumns; ++column)
+			{
+				pending[column] = failed[column].exchange(0, std::memory_order_relaxed);
+
+				if (pending[column])
+				{
+					Column& c = m_columns[column];
+					setColumnType(c, ((c.type == CSVColumnType::Int64) ? CSVColumnType::Double : CSVColumnType::String));
+					retry = true;
+				}
+			}
+
+			if (not retry)
+			{
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	inline void ColumnarCSV::setColumnType(Column& column, const CSVColumnType type)
+	{
+		column = Column{};
+		column.type = type;
+
+		if (type == CSVColumnType::Int64)
+		{
+			column.int64s.resize(m_rows, 0);
+			column.valid.resize(m_rows, 0);
+		}
+		else if (type == CSVColumnType::Double)
+		{
+			column.doubles.resize(m_rows, std::numeric_limits<double>::quiet_NaN());
+			column.valid.resize(m_rows, 0);
+		}
+		else
+		{
+			column.fields.resize(m_rows);
+		}
+	}
+
+	inline void ColumnarCSV::clear()
+	{
+		m_columnNames.clear();
+		m_columns.clear();
+		m_rows = 0;
+		m_data = nullptr;
+		m_file.close();
+	}
+
+	inline bool ColumnarCSV::isEmpty() const noexcept
+	{
+		return (m_rows == 0);
+	}
+
+	inline ColumnarCSV::operator bool() const noexcept
+	{
+		return (not isEmpty());
+	}
+
+	inline size_t ColumnarCSV::rows() const noexcept
+	{
+		return m_rows;
+	}
+
+	inline size_t ColumnarCSV::columns() const noexcept
+	{
+		return m_columns.size();
+	}
+
+	inline const Array<String>& ColumnarCSV::columnNames() const noexcept
+	{
+		return m_columnNames;
+	}
+
+	inline Optional<size_t> ColumnarCSV::columnIndex(const StringView name) const
+	{
+		for (size_t i = 0; i < m_columnNames.size(); ++i)
+		{
+			if (m_columnNames[i] == name)
+			{
+				return i;
+			}
+		}
+
+		return none;
+	}
+
+	inline CSVColumnType ColumnarCSV::columnType(const size_t column) const
+	{
+		return m_columns.at(column).type;
+	}
+
+	inline const Array<int64>& ColumnarCSV::int64Column(const size_t column) const
+	{
+		const Column& c = m_columns.at(column);
+
+		if (c.type != CSVColumnType::Int64)
+		{
+			throw std::invalid_argument{ "ColumnarCSV::int64Column(): column type is not Int64" };
+		}
+
+		return c.int64s;
+	}
+
+	inline const Array<double>& ColumnarCSV::doubleColumn(const size_t column) const
+	{
+		const Column& c = m_columns.at(column);
+
+		if (c.type != CSVColumnType::Double)
+		{
+			throw std::invalid_argument{ "ColumnarCSV::doubleColumn(): column type is not Double" };
+		}
+
+		return c.doubles;
+	}
+
+	inline bool ColumnarCSV::hasValue(const size_t row, const size_t column) const noexcept
+	{
+		if (not inBounds(row, column))
+		{
+			return false;
+		}
+
+		const Column& c = m_columns[column];
+
+		if (c.type == CSVColumnType::String)
+		{
+			return (c.fields[row].length != 0);
+		}
+
+		return (c.valid[row] != 0);
+	}
+
+	inline std::string_view ColumnarCSV::getUTF8View(const size_t row, const size_t column) const
+	{
+		if ((not inBounds(row, column))
+			|| (m_columns[column].type != CSVColumnType::String))
+		{
+			return{};
+		}
+
+		return fieldView(m_columns[column].fields[row]);
+	}
+
+	inline std::string ColumnarCSV::getUTF8(const size_t row, const size_t column) const
+	{
+		if (not inBounds(row, column))
+		{
+			return{};
+		}
+
+		const Column& c = m_columns[column];
+
+		if (c.type == CSVColumnType::String)
+		{
+			const FieldRef& field = c.fields[row];
+			return (field.escaped ? unescape(field) : std::string{ fieldView(field) });
+		}
+
+		return Unicode::ToUTF8(getString(row, column));
+	}
+
+	inline String ColumnarCSV::getString(const size_t row, const size_t column) const
+	{
+		if (not inBounds(row, column))
+		{
+			return{};
+		}
+
+		const Column& c = m_columns[column];
+
+		switch (c.type)
+		{
+		case CSVColumnType::Int64:
+			return (c.valid[row] ? Format(c.int64s[row]) : String{});
+		case CSVColumnType::Double:
+			return (c.valid[row] ? Format(c.doubles[row]) : String{});
+		default:
+			{
+				const FieldRef& field = c.fields[row];
+				return Unicode::FromUTF8(field.escaped ? std::string_view{ unescape(field) } : fieldView(field));
+			}
+		}
+	}
+
+	template <class Type>
+	inline Type ColumnarCSV::get(const size_t row, const size_t column) const
+	{
+		if (auto opt = getOpt<Type>(row, column))
+		{
+			return std::move(*opt);
+		}
+
+		return Type();
+	}
+
+	template <class Type, class U>
+	inline Type ColumnarCSV::getOr(const size_t row, const size_t column, U&& defaultValue) const
+	{
+		return getOpt<Type>(row, column).value_or(std::forward<U>(defaultValue));
+	}
+
+	template <class Type>
+	inline Optional<Type> ColumnarCSV::getOpt(const size_t row, const size_t column) const
+	{
+		if (not inBounds(row, column))
+		{
+			return none;
+		}
+
+		if constexpr (std::is_same_v<Type, String>)
+		{
+			return getString(row, column);
+		}
+		else if constexpr (std::is_arithmetic_v<Type> && (not std::is_same_v<Type, bool>))
+		{
+			const Column& c = m_columns[column];
+
+			if (c.type == CSVColumnType::Int64)
+			{
+				if (not c.valid[row])
+				{
+					return none;
+				}
+
+				return static_cast<Type>(c.int64s[row]);
+			}
+			else if (c.type == CSVColumnType::Double)
+			{
+				if (not c.valid[row])
+				{
+					return none;
+				}
+
+				return static_cast<Type>(c.doubles[row]);
+			}
+
+			const std::string_view s = fieldView(c.fields[row]);
+
+			if constexpr (std::is_integral_v<Type>)
+			{
+				if (int64 value; detail::ParseCSVInt64(s, value))
+				{
+					return static_cast<Type>(value);
+				}
+			}
+			else
+			{
+				if (double value; detail::ParseCSVDouble(s, value))
+				{
+					return static_cast<Type>(value);
+				}
+			}
+
+			return none;
+		}
+		else
+		{
+			return ParseOpt<Type>(getString(row, column));
+		}
+	}
+
+	inline ColumnarCSV::RowView ColumnarCSV::operator [](const size_t row) const noexcept
+	{
+		return{ this, row };
+	}
+
+	inline ColumnarCSV::Iterator ColumnarCSV::begin() const noexcept
+	{
+		return{ this, 0 };
+	}
+
+	inline ColumnarCSV::Iterator ColumnarCSV::end() const noexcept
+	{
+		return{ this, m_rows };
+	}
+
+	inline bool ColumnarCSV::inBounds(const size_t row, const size_t column) const noexcept
+	{
+		return ((row < m_rows) && (column < m_columns.size()));
+	}
+
+	inline std::string_view ColumnarCSV::fieldView(const FieldRef& field) const noexcept
+	{
+		if (field.length == 0)
+		{
+			return{};
+		}
+
+		return{ (m_data + field.offset), field.length };
+	}
+
+	inline std::string ColumnarCSV::unescape(const FieldRef& field) const
+	{
+		const std::string_view s = fieldView(field);
+		std::string result;
+		result.reserve(s.size());
+
+		for (size_t i = 0; i < s.size(); ++i)
+		{
+			result.push_back(s[i]);
+
+			if ((s[i] == m_quote) && ((i + 1) < s.size()) && (s[i + 1] == m_quote))
+			{
+				++i;
+			}
+		}
+
+		return result;
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	RowView
+	//
+	////////////////////////////////////////////////////////////////
+
+	inline constexpr ColumnarCSV::RowView::RowView(const ColumnarCSV* csv, const size_t row) noexcept
+		: m_csv{ csv }
+		, m_row{ row } {}
+
+	inline constexpr size_t ColumnarCSV::RowView::index() const noexcept
+	{
+		return m_row;
+	}
+
+	inline size_t ColumnarCSV::RowView::columns() const noexcept
+	{
+		return m_csv->columns();
+	}
+
+	template <class Type>
+	inline Type ColumnarCSV::RowView::get(const size_t column) const
+	{
+		return m_csv->get<Type>(m_row, column);
+	}
+
+	template <class Type>
+	inline Optional<Type> ColumnarCSV::RowView::getOpt(const size_t column) const
+	{
+		return m_csv->getOpt<Type>(m_row, column);
+	}
+
+	inline std::string_view ColumnarCSV::RowView::getUTF8View(const size_t column) const
+	{
+		return m_csv->getUTF8View(m_row, column);
+	}
+
+	inline String ColumnarCSV::RowView::getString(const size_t column) const
+	{
+		return m_csv->getString(m_row, column);
+	}
+
+	////////////////////////////////////////////////////////////////
+	//
+	//	Iterator
+	//
+	////////////////////////////////////////////////////////////////
+
+	inline constexpr ColumnarCSV::Iterator::Iterator(const ColumnarCSV* csv, const size_t row) noexcept
+		: m_csv{ csv }
+		, m_row{ row } {}
+
+	inline constexpr ColumnarCSV::RowView ColumnarCSV::Iterator::operator *() const noexcept
+	{
+		return{ m_csv, m_row };
+	}
+
+	inline constexpr ColumnarCSV::RowView ColumnarCSV::Iterator::operator [](const difference_type n) const noexcept
+	{
+		return{ m_csv, (m_row + n) };
+	}
+
+	inline constexpr ColumnarCSV::Iterator& ColumnarCSV::Iterator::operator ++() noexcept
+	{
+		++m_row;
+		return *this;
+	}
+
+	inline constexpr ColumnarCSV::Iterator ColumnarCSV::Iterator::operator ++(int) noexcept
+	{
+		Iterator tmp = *this;
+		++m_row;
+		return tmp;
+	}
+
+	inline constexpr ColumnarCSV::Iterator& ColumnarCSV::Iterator::operator --() noexcept
+	{
+		--m_row;
+		return *this;
+	}
+
+	inline constexpr ColumnarCSV::Iterator ColumnarCSV::Iterator::operator --(int) noexcept
+	{
+		Iterator tmp = *this;
+		--m_row;
+		return tmp;
+	}
+
+	inline constexpr ColumnarCSV::Iterator& ColumnarCSV::Iterator::operator +=(const difference_type n) noexcept
+	{
+		m_row += n;
+		return *this;
+	}
+
+	inline constexpr ColumnarCSV::Iterator& ColumnarCSV::Iterator::operator -=(const difference_type n) noexcept
+	{
+		m_row -= n;
+		return *this;
+	}
+
+	inline constexpr ColumnarCSV::Iterator ColumnarCSV::Iterator::operator +(const difference_type n) const noexcept
+	{
+		return{ m_csv, (m_row + n) };
+	}
+
+	inline constexpr ColumnarCSV::Iterator ColumnarCSV::Iterator::operator -(const difference_type n) const noexcept
+	{
+		return{ m_csv, (m_row - n) };
+	}
+
+	inline constexpr ColumnarCSV::Iterator::difference_type ColumnarCSV::Iterator::operator -(const Iterator& other) const noexcept
+	{
+		return (static_cast<difference_type>(m_row) - static_cast<difference_type>(other.m_row));
+	}
+
+	inline constexpr bool ColumnarCSV::Iterator::operator ==(const Iterator& other) const noexcept
+	{
+		return (m_row == other.m_row);
+	}
+
+	inline constexpr bool ColumnarCSV::Iterator::operator !=(const Iterator& other) const noexcept
+	{
+		return (m_row != other.m_row);
+	}
+
+	inline constexpr bool ColumnarCSV::Iterator::operator <(const Iterator& other) const noexcept
+	{
+		return (m_row < other.m_row);
+	}
+
+	inline constexpr bool ColumnarCSV::Iterator::operator >(const Iterator& other) const noexcept
+	{
+		return (m_row > other.m_row);
+	}
+
+	inline constexpr bool ColumnarCSV::Iterator::operator <=(const Iterator& other) const noexcept
+	{
+		return (m_row <= other.m_row);
+	}
+
+	inline constexpr bool ColumnarCSV::Iterator::operator >=(const Iterator& other) const noexcept
+	{
+		return (m_row >= other.m_row);
+	}
+
+# if __cpp_lib_concepts
+
+	static_assert(std::random_access_iterator<ColumnarCSV::Iterator>);
+
+# endif
+}
@@ -0,0 +1,1300 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <cmath>
+# include <charconv>
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief 数式の組み込み関数
+		struct MathBuiltinFunction
+		{
+			StringView name;
+
+			/// @brief 引数の数。可変長の場合は -1
+			int32 arity = 1;
+
+			MathParser::Fty1 f1 = nullptr;
+
+			double(*fn)(const double*, size_t) = nullptr;
+		};
+
+		[[nodiscard]]
+		inline double MathSum(const double* args, const size_t count) noexcept
+		{
+			double result = 0.0;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				result += args[i];
+			}
+
+			return result;
+		}
+
+		[[nodiscard]]
+		inline double MathAvg(const double* args, const size_t count) noexcept
+		{
+			return (MathSum(args, count) / static_cast<double>(count));
+		}
+
+		[[nodiscard]]
+		inline double MathMin(const double* args, const size_t count) noexcept
+		{
+			double result = args[0];
+
+			for (size_t i = 1; i < count; ++i)
+			{
+				result = ((args[i] < result) ? args[i] : result);
+			}
+
+			return result;
+		}
+
+		[[nodiscard]]
+		inline double MathMax(const double* args, const size_t count) noexcept
+		{
+			double result = args[0];
+
+			for (size_t i = 1; i < count; ++i)
+			{
+				result = ((result < args[i]) ? args[i] : result);
+			}
+
+			return result;
+		}
+
+		/// @brief 組み込み関数を名前で検索します。
+		/// @param name 関数名
+		/// @return 組み込み関数へのポインタ。見つからない場合は nullptr
+		[[nodiscard]]
+		inline const MathBuiltinFunction* FindMathBuiltinFunction(const StringView name) noexcept
+		{
+			// MathParser の組み込み関数と同じ計算をする
+			static const MathBuiltinFunction functions[] =
+			{
+				{ U"sin",	1, [](double x) { return std::sin(x); } },
+				{ U"cos",	1, [](double x) { return std::cos(x); } },
+				{ U"tan",	1, [](double x) { return std::tan(x); } },
+				{ U"asin",	1, [](double x) { return std::asin(x); } },
+				{ U"acos",	1, [](double x) { return std::acos(x); } },
+				{ U"atan",	1, [](double x) { return std::atan(x); } },
+				{ U"sinh",	1, [](double x) { return std::sinh(x); } },
+				{ U"cosh",	1, [](double x) { return std::cosh(x); } },
+				{ U"tanh",	1, [](double x) { return std::tanh(x); } },
+				{ U"asinh",	1, [](double x) { return std::asinh(x); } },
+				{ U"acosh",	1, [](double x) { return std::acosh(x); } },
+				{ U"atanh",	1, [](double x) { return std::atanh(x); } },
+				{ U"log2",	1, [](double x) { return std::log2(x); } },
+				{ U"log10",	1, [](double x) { return std::log10(x); } },
+				{ U"log",	1, [](double x) { return std::log(x); } },
+				{ U"ln",	1, [](double x) { return std::log(x); } },
+				{ U"exp",	1, [](double x) { return std::exp(x); } },
+				{ U"sqrt",	1, [](double x) { return std::sqrt(x); } },
+				{ U"sign",	1, [](double x) { return ((x < 0.0) ? -1.0 : ((0.0 < x) ? 1.0 : 0.0)); } },
+				{ U"rint",	1, [](double x) { return std::floor(x + 0.5); } },
+				{ U"abs",	1, [](double x) { return std::abs(x); } },
+				{ U"sum",	-1, nullptr, MathSum },
+				{ U"avg",	-1, nullptr, MathAvg },
+				{ U"min",	-1, nullptr, MathMin },
+				{ U"max",	-1, nullptr, MathMax },
+			};
+
+			for (const auto& function : functions)
+			{
+				if (function.name == name)
+				{
+					return &function;
+				}
+			}
+
+			return nullptr;
+		}
+
+		/// @brief 数式中の数値を読み取ります。
+		/// @param s 数値の先頭からの文字列
+		/// @param value 読み取った値
+		/// @return 読み取った文字数。数値でない場合は 0
+		[[nodiscard]]
+		inline size_t ParseMathNumber(const StringView s, double& value)
+		{
+			char buffer[128];
+			size_t length = 0;
+
+			const auto isDigit = [&](const size_t i) { return ((i < s.size()) && (U'0' <= s[i]) && (s[i] <= U'9')); };
+			const auto append = [&](const size_t i) { if (length < (sizeof(buffer) - 1)) { buffer[length] = static_cast<char>(s[i]); } ++length; };
+
+			size_t i = 0;
+			bool hasDigits = false;
+
+			for (; isDigit(i); ++i, hasDigits = true)
+			{
+				append(i);
+			}
+
+			if ((i < s.size()) && (s[i] == U'.'))
+			{
+				append(i++);
+
+				for (; isDigit(i); ++i, hasDigits = true)
+				{
+					append(i);
+				}
+			}
+
+			if (not hasDigits)
+			{
+				return 0;
+			}
+
+			if ((i < s.size()) && ((s[i] == U'e') || (s[i] == U'E')))
+			{
+				size_t k = (i + 1);
+
+				if ((k < s.size()) && ((s[k] == U'+') || (s[k] == U'-')))
+				{
+					++k;
+				}
+
+				if (isDigit(k))
+				{
+					for (; i < k; ++i)
+					{
+						append(i);
+					}
+
+					for (; isDigit(i); ++i)
+					{
+						append(i);
+					}
+				}
+			}
+
+			if ((sizeof(buffer) - 1) < length)
+			{
+				return 0;
+			}
+
+			buffer[length] = '\0';
+
+		# if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+
+			const auto [ptr, ec] = std::from_chars(buffer, (buffer + length), value);
+
+			if (ec == std::errc::result_out_of_range)
+			{
+				value = std::strtod(buffer, nullptr);
+			}
+
+		# else
+
+			value = std::strtod(buffer, nullptr);
+
+		# endif
+
+			return i;
+		}
+	}
+
+	/// @brief 数式をバイトコードに変換するクラス
+	/// @remark 命令を追加するたびに末尾の命令を見て、MathParser のバイトコードと同じ書き換え（定数の畳み込み、`a * x + b` への融合、低次のべき乗の展開）を行います。
+	class CompiledMathExpression::Compiler
+	{
+	public:
+
+		Compiler(const StringView expression, const HashTable<String, double>& constants, const HashTable<String, double*>& variables)
+			: m_expression{ expression }
+			, m_constants{ constants }
+			, m_variables{ variables } {}
+
+		void compile(CompiledMathExpression& result)
+		{
+			try
+			{
+				skipSpaces();
+
+				if (m_pos == m_expression.size())
+				{
+					throw Error{ U"Empty expression" };
+				}
+
+				parseTernary();
+
+				if (m_pos != m_expression.size())
+				{
+					if (m_expression[m_pos] == U',')
+					{
+						throw Error{ U"Multiple expressions are not supported (position {})"_fmt(m_pos) };
+					}
+
+					throwUnexpected();
+				}
+			}
+			catch (const Error& error)
+			{
+				result.m_errorMessage = error.what();
+				return;
+			}
+
+			// 単項の + は書き換えを妨げるためだけの命令なので、ここで取り除く
+			m_code.remove_if([](const Instruction& instruction) { return (instruction.op == OpCode::Plus); });
+
+			// 変数の番号を名前の昇順に振り直す
+			Array<uint32> order(m_names.size());
+
+			for (uint32 i = 0; i < order.size(); ++i)
+			{
+				order[i] = i;
+			}
+
+			std::sort(order.begin(), order.end(), [&](uint32 a, uint32 b) { return (m_names[a] < m_names[b]); });
+
+			Array<uint32> remap(order.size());
+
+			for (uint32 i = 0; i < order.size(); ++i)
+			{
+				remap[order[i]] = i;
+				result.m_variableNames << m_names[order[i]];
+				result.m_variablePointers << m_pointers[order[i]];
+			}
+
+			size_t depth = 0;
+
+			for (auto& instruction : m_code)
+			{
+				switch (instruction.op)
+				{
+				case OpCode::Value:
+					++depth;
+					break;
+				case OpCode::Variable:
+				case OpCode::VariableMul:
+				case OpCode::VariablePow2:
+				case OpCode::VariablePow3:
+				case OpCode::VariablePow4:
+					instruction.index = remap[instruction.index];
+					++depth;
+					break;
+				case OpCode::Negate:
+				case OpCode::Plus:
+				case OpCode::Function1:
+					break;
+				case OpCode::Select:
+					depth -= 2;
+					break;
+				case OpCode::FunctionN:
+					depth -= (instruction.index - 1);
+					break;
+				default:
+					--depth;
+					break;
+				}
+
+				result.m_stackSize = Max(result.m_stackSize, depth);
+			}
+
+			result.m_code = std::move(m_code);
+		}
+
+		/// @brief 二項演算を行います。
+		/// @param op 演算の種類
+		/// @param x 左辺の値
+		/// @param y 右辺の値
+		/// @return 演算の結果
+		[[nodiscard]]
+		static double Apply(const OpCode op, const double x, const double y)
+		{
+			switch (op)
+			{
+			case OpCode::Add:
+				return (x + y);
+			case OpCode::Sub:
+				return (x - y);
+			case OpCode::Mul:
+				return (x * y);
+			case OpCode::Div:
+				return (x / y);
+			case OpCode::Pow:
+				return std::pow(x, y);
+			case OpCode::Less:
+				return (x < y);
+			case OpCode::Greater:
+				return (x > y);
+			case OpCode::LessEqual:
+				return (x <= y);
+			case OpCode::GreaterEqual:
+				return (x >= y);
+			case OpCode::Equal:
+				return (x == y);
+			case OpCode::NotEqual:
+				return (x != y);
+			case OpCode::And:
+				return ((x != 0.0) && (y != 0.0));
+			case OpCode::Or:
+				return ((x != 0.0) || (y != 0.0));
+			default:
+				return 0.0;
+			}
+		}
+
+	private:
+
+		StringView m_expression;
+
+		const HashTable<String, double>& m_constants;
+
+		const HashTable<String, double*>& m_variables;
+
+		size_t m_pos = 0;
+
+		Array<Instruction> m_code;
+
+		Array<String> m_names;
+
+		Array<double*> m_pointers;
+
+		[[noreturn]]
+		void throwUnexpected() const
+		{
+			if (m_pos < m_expression.size())
+			{
+				throw Error{ U"Unexpected token \"{}\" at position {}"_fmt(m_expression[m_pos], m_pos) };
+			}
+			else
+			{
+				throw Error{ U"Unexpected end of expression" };
+			}
+		}
+
+		void skipSpaces() noexcept
+		{
+			while ((m_pos < m_expression.size())
+				&& ((m_expression[m_pos] == U' ') || (m_expression[m_pos] == U'\t') || (m_expression[m_pos] == U'\r') || (m_expression[m_pos] == U'\n')))
+			{
+				++m_pos;
+			}
+		}
+
+		[[nodiscard]]
+		bool accept(const StringView token) noexcept
+		{
+			if (m_expression.substr(m_pos).starts_with(token))
+			{
+				m_pos += token.size();
+				skipSpaces();
+				return true;
+			}
+
+			return false;
+		}
+
+		void expect(const char32 ch)
+		{
+			if ((m_expression.size() <= m_pos) || (m_expression[m_pos] != ch))
+			{
+				throwUnexpected();
+			}
+
+			++m_pos;
+			skipSpaces();
+		}
+
+		[[nodiscard]]
+		static bool IsNameCharacter(const char32 ch) noexcept
+		{
+			return (((U'0' <= ch) && (ch <= U'9')) || ((U'a' <= ch) && (ch <= U'z')) || ((U'A' <= ch) && (ch <= U'Z')) || (ch == U'_'));
+		}
+
+		// 演算子の優先順位は MathParser と同じ（低い順に ?:, ||, &&, 比較, + -, * / と単項の + -, ^）
+
+		void parseTernary()
+		{
+			parseOr();
+
+			if (accept(U"?"))
+			{
+				parseTernary();
+				expect(U':');
+				parseTernary();
+				m_code << Instruction{ OpCode::Select };
+			}
+		}
+
+		void parseOr()
+		{
+			parseAnd();
+
+			while (accept(U"||"))
+			{
+				parseAnd();
+				addBinary(OpCode::Or);
+			}
+		}
+
+		void parseAnd()
+		{
+			parseComparison();
+
+			while (accept(U"&&"))
+			{
+				parseComparison();
+				addBinary(OpCode::And);
+			}
+		}
+
+		void parseComparison()
+		{
+			parseAdditive();
+
+			for (;;)
+			{
+				OpCode op;
+
+				if (accept(U"<="))
+				{
+					op = OpCode::LessEqual;
+				}
+				else if (accept(U">="))
+				{
+					op = OpCode::GreaterEqual;
+				}
+				else if (accept(U"=="))
+				{
+					op = OpCode::Equal;
+				}
+				else if (accept(U"!="))
+				{
+					op = OpCode::NotEqual;
+				}
+				else if (accept(U"<"))
+				{
+					op = OpCode::Less;
+				}
+				else if (accept(U">"))
+				{
+					op = OpCode::Greater;
+				}
+				else
+				{
+					return;
+				}
+
+				parseAdditive();
+				addBinary(op);
+			}
+		}
+
+		void parseAdditive()
+		{
+			parseMultiplicative();
+
+			for (;;)
+			{
+				if (accept(U"+"))
+				{
+					parseMultiplicative();
+					addBinary(OpCode::Add);
+				}
+				else if (accept(U"-"))
+				{
+					parseMultiplicative();
+					addBinary(OpCode::Sub);
+				}
+				else
+				{
+					return;
+				}
+			}
+		}
+
+		void parseMultiplicative()
+		{
+			parseUnary();
+
+			for (;;)
+			{
+				if (accept(U"*"))
+				{
+					parseUnary();
+					addBinary(OpCode::Mul);
+				}
+				else if (accept(U"/"))
+				{
+					parseUnary();
+					addBinary(OpCode::Div);
+				}
+				else
+				{
+					return;
+				}
+			}
+		}
+
+		void parseUnary()
+		{
+			if (accept(U"-"))
+			{
+				parseUnary();
+				addUnary(OpCode::Negate);
+			}
+			else if (accept(U"+"))
+			{
+				parseUnary();
+				addUnary(OpCode::Plus);
+			}
+			else
+			{
+				parsePower();
+			}
+		}
+
+		void parsePower()
+		{
+			parsePrimary();
+
+			// ^ は右結合で、指数には単項の + - を付けられる
+			if (accept(U"^"))
+			{
+				parseUnary();
+				addBinary(OpCode::Pow);
+			}
+		}
+
+		void parsePrimary()
+		{
+			if (m_expression.size() <= m_pos)
+			{
+				throwUnexpected();
+			}
+
+			if (accept(U"("))
+			{
+				parseTernary();
+				expect(U')');
+				return;
+			}
+
+			double value;
+
+			if (const size_t length = detail::ParseMathNumber(m_expression.substr(m_pos), value))
+			{
+				m_pos += length;
+				skipSpaces();
+				addValue(value);
+				return;
+			}
+
+			const size_t first = m_pos;
+
+			while ((m_pos < m_expression.size()) && IsNameCharacter(m_expression[m_pos]))
+			{
+				++m_pos;
+			}
+
+			if (first == m_pos)
+			{
+				throwUnexpected();
+			}
+
+			const String name{ m_expression.substr(first, (m_pos - first)) };
+			skipSpaces();
+
+			if ((m_pos < m_expression.size()) && (m_expression[m_pos] == U'('))
+			{
+				parseFunction(name, first);
+				return;
+			}
+
+			if (const auto it = m_constants.find(name); it != m_constants.end())
+			{
+				addValue(it->second);
+				return;
+			}
+
+			if (const auto it = m_variables.find(name); it != m_variables.end())
+			{
+				addVariable(name, it->second);
+				return;
+			}
+
+			throw Error{ U"Unknown variable \"{}\" at position {}"_fmt(name, first) };
+		}
+
+		void parseFunction(const String& name, const size_t position)
+		{
+			const detail::MathBuiltinFunction* function = detail::FindMathBuiltinFunction(name);
+
+			if (not function)
+			{
+				throw Error{ U"Unknown function \"{}\" at position {}"_fmt(name, position) };
+			}
+
+			expect(U'(');
+
+			size_t argc = 0;
+
+			if (not accept(U")"))
+			{
+				do
+				{
+					parseTernary();
+					++argc;
+				} while (accept(U","));
+
+				expect(U')');
+			}
+
+			if (((function->arity < 0) && (argc == 0))
+				|| ((0 <= function->arity) && (argc != static_cast<size_t>(function->arity))))
+			{
+				throw Error{ U"Wrong number of arguments for function \"{}\" at position {}"_fmt(name, position) };
+			}
+
+			addFunction(*function, argc);
+		}
+
+		[[nodiscard]]
+		static bool IsVariable(const Instruction& instruction) noexcept
+		{
+			return ((instruction.op == OpCode::Variable) || (instruction.op == OpCode::VariableMul));
+		}
+
+		void addValue(const double value)
+		{
+			m_code << Instruction{ OpCode::Value, 0, 0.0, value };
+		}
+
+		void addVariable(const String& name, double* pointer)
+		{
+			uint32 index = 0;
+
+			for (; index < m_names.size(); ++index)
+			{
+				if (m_names[index] == name)
+				{
+					break;
+				}
+			}
+
+			if (index == m_names.size())
+			{
+				m_names << name;
+				m_pointers << pointer;
+			}
+
+			m_code << Instruction{ OpCode::Variable, index, 1.0, 0.0 };
+		}
+
+		void addUnary(const OpCode op)
+		{
+			Instruction& x = m_code.back();
+
+			if (x.op == OpCode::Value)
+			{
+				if (op == OpCode::Negate)
+				{
+					x.b = -x.b;
+				}
+
+				return;
+			}
+
+			m_code << Instruction{ op };
+		}
+
+		void addFunction(const detail::MathBuiltinFunction& function, const size_t argc)
+		{
+			if (function.arity < 0)
+			{
+				m_code << Instruction{ OpCode::FunctionN, static_cast<uint32>(argc), 0.0, 0.0, nullptr, function.fn };
+				return;
+			}
+
+			Instruction& x = m_code.back();
+
+			if (x.op == OpCode::Value)
+			{
+				x.b = function.f1(x.b);
+				return;
+			}
+
+			m_code << Instruction{ OpCode::Function1, 0, 0.0, 0.0, function.f1 };
+		}
+
+		void addBinary(const OpCode op)
+		{
+			const size_t size = m_code.size();
+			Instruction& x = m_code[size - 2];
+			const Instruction& y = m_code[size - 1];
+
+			if ((x.op == OpCode::Value) && (y.op == OpCode::Value))
+			{
+				// 論理演算の畳み込みでは、MathParser と同様に整数に切り捨ててから真偽を判定する
+				if ((op == OpCode::And) || (op == OpCode::Or))
+				{
+					x.b = Apply(op, std::trunc(x.b), std::trunc(y.b));
+				}
+				else
+				{
+					x.b = Apply(op, x.b, y.b);
+				}
+
+				m_code.pop_back();
+				return;
+			}
+
+			const bool isValueX = (x.op == OpCode::Value);
+			const bool isValueY = (y.op == OpCode::Value);
+			const bool isVariableX = IsVariable(x);
+			const bool isVariableY = IsVariable(y);
+			const bool sameVariable = (isVariableX && isVariableY && (x.index == y.index));
+
+			switch (op)
+			{
+			case OpCode::Add:
+			case OpCode::Sub:
+				// 定数と変数の一次式を a * x + b にまとめる
+				if ((isValueX && isVariableY) || (isVariableX && isValueY) || sameVariable)
+				{
+					const double sign = ((op == OpCode::Sub) ? -1.0 : 1.0);
+					x.index = (isVariableX ? x.index : y.index);
+					x.b += (sign * y.b);
+					x.a += (sign * y.a);
+					x.op = OpCode::VariableMul;
+					m_code.pop_back();
+					return;
+				}
+				break;
+			case OpCode::Mul:
+				if ((x.op == OpCode::Variable) && isValueY)
+				{
+					x.a = (x.b + y.b);
+					x.b = 0.0;
+					x.op = OpCode::VariableMul;
+					m_code.pop_back();
+					return;
+				}
+				else if (isValueX && (y.op == OpCode::Variable))
+				{
+					x.a = (x.b + y.b);
+					x.b = 0.0;
+					x.index = y.index;
+					x.op = OpCode::VariableMul;
+					m_code.pop_back();
+					return;
+				}
+				else if ((x.op == OpCode::VariableMul) && isValueY)
+				{
+					x.a *= y.b;
+					x.b *= y.b;
+					m_code.pop_back();
+					return;
+				}
+				else if (isValueX && (y.op == OpCode::VariableMul))
+				{
+					const double c = x.b;
+					x.a = (y.a * c);
+					x.b = (y.b * c);
+					x.index = y.index;
+					x.op = OpCode::VariableMul;
+					m_code.pop_back();
+					return;
+				}
+				else if ((x.op == OpCode::Variable) && (y.op == OpCode::Variable) && (x.index == y.index))
+				{
+					x.op = OpCode::VariablePow2;
+					m_code.pop_back();
+					return;
+				}
+				break;
+			case OpCode::Div:
+				if ((x.op == OpCode::VariableMul) && isValueY && (y.b != 0.0))
+				{
+					x.a /= y.b;
+					x.b /= y.b;
+					m_code.pop_back();
+					return;
+				}
+				break;
+			case OpCode::Pow:
+				if ((x.op == OpCode::Variable) && isValueY)
+				{
+					if (y.b == 0.0)
+					{
+						x = Instruction{ OpCode::Value, 0, 0.0, 1.0 };
+					}
+					else if (y.b == 1.0)
+					{
+						// x のまま
+					}
+					else if (y.b == 2.0)
+					{
+						x.op = OpCode::VariablePow2;
+					}
+					else if (y.b == 3.0)
+					{
+						x.op = OpCode::VariablePow3;
+					}
+					else if (y.b == 4.0)
+					{
+						x.op = OpCode::VariablePow4;
+					}
+					else
+					{
+						break;
+					}
+
+					m_code.pop_back();
+					return;
+				}
+				break;
+			default:
+				break;
+			}
+
+			m_code << Instruction{ op };
+		}
+	};
+
+	inline CompiledMathExpression::CompiledMathExpression(const MathParser& parser)
+		: m_expression{ parser.getExpression() }
+	{
+		const HashTable<String, double> constants = parser.getConstants();
+		const HashTable<String, double*> variables = parser.getVariables();
+		Compiler{ m_expression, constants, variables }.compile(*this);
+	}
+
+	inline bool CompiledMathExpression::isValid() const noexcept
+	{
+		return (not m_code.isEmpty());
+	}
+
+	inline CompiledMathExpression::operator bool() const noexcept
+	{
+		return isValid();
+	}
+
+	inline const String& CompiledMathExpression::getErrorMessage() const noexcept
+	{
+		return m_errorMessage;
+	}
+
+	inline const String& CompiledMathExpression::getExpression() const noexcept
+	{
+		return m_expression;
+	}
+
+	inline const Array<String>& CompiledMathExpression::getVariableNames() const noexcept
+	{
+		return m_variableNames;
+	}
+
+	inline Optional<size_t> CompiledMathExpression::getVariableIndex(const StringView name) const
+	{
+		for (size_t i = 0; i < m_variableNames.size(); ++i)
+		{
+			if (m_variableNames[i] == name)
+			{
+				return i;
+			}
+		}
+
+		return none;
+	}
+
+	inline size_t CompiledMathExpression::num_instructions() const noexcept
+	{
+		return m_code.size();
+	}
+
+	inline double CompiledMathExpression::eval() const
+	{
+		double values[16];
+		Array<double> heapValues;
+		double* pValues = values;
+
+		if (std::size(values) < m_variablePointers.size())
+		{
+			heapValues.resize(m_variablePointers.size());
+			pValues = heapValues.data();
+		}
+
+		for (size_t i = 0; i < m_variablePointers.size(); ++i)
+		{
+			pValues[i] = *m_variablePointers[i];
+		}
+
+		return eval(pValues);
+	}
+
+	inline double CompiledMathExpression::eval(const double* values) const
+	{
+		if (not isValid())
+		{
+			return Math::NaN;
+		}
+
+		double stack[64];
+		Array<double> heapStack;
+		double* pStack = stack;
+
+		if (std::size(stack) < m_stackSize)
+		{
+			heapStack.resize(m_stackSize);
+			pStack = heapStack.data();
+		}
+
+		size_t top = 0;
+
+		// evalRows() と同じ計算を 1 行分だけ行う
+		for (const auto& instruction : m_code)
+		{
+			switch (instruction.op)
+			{
+			case OpCode::Value:
+				pStack[top++] = instruction.b;
+				break;
+			case OpCode::Variable:
+				pStack[top++] = values[instruction.index];
+				break;
+			case OpCode::VariableMul:
+				{
+					const double t = (values[instruction.index] * instruction.a);
+					pStack[top++] = (t + instruction.b);
+					break;
+				}
+			case OpCode::VariablePow2:
+				{
+					const double x = values[instruction.index];
+					pStack[top++] = (x * x);
+					break;
+				}
+			case OpCode::VariablePow3:
+				{
+					const double x = values[instruction.index];
+					pStack[top++] = (x * x * x);
+					break;
+				}
+			case OpCode::VariablePow4:
+				{
+					const double x = values[instruction.index];
+					pStack[top++] = (x * x * x * x);
+					break;
+				}
+			case OpCode::Negate:
+				pStack[top - 1] = -pStack[top - 1];
+				break;
+			case OpCode::Plus:
+				break;
+			case OpCode::Function1:
+				pStack[top - 1] = instruction.f1(pStack[top - 1]);
+				break;
+			case OpCode::FunctionN:
+				top -= (instruction.index - 1);
+				pStack[top - 1] = instruction.fn((pStack + top - 1), instruction.index);
+				break;
+			case OpCode::Select:
+				top -= 2;
+				pStack[top - 1] = ((pStack[top - 1] == 0.0) ? pStack[top + 1] : pStack[top]);
+				break;
+			default:
+				--top;
+				pStack[top - 1] = Compiler::Apply(instruction.op, pStack[top - 1], pStack[top]);
+				break;
+			}
+		}
+
+		return pStack[0];
+	}
+
+	inline void CompiledMathExpression::evalBatch(const std::initializer_list<const double*> columns, double* results, const size_t count) const
+	{
+		evalBatch(Array<const double*>(columns), results, count);
+	}
+
+	inline void CompiledMathExpression::evalBatch(const Array<const double*>& columns, double* results, const size_t count) const
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		if (not isValid())
+		{
+			std::fill_n(results, count, Math::NaN);
+			return;
+		}
+
+		if (columns.size() != m_variableNames.size())
+		{
+			throw Error{ U"CompiledMathExpression::evalBatch(): {} columns are required, but {} were given"_fmt(m_variableNames.size(), columns.size()) };
+		}
+
+		const size_t numChunks = ((count + ParallelChunkSize - 1) / ParallelChunkSize);
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if (1 < numChunks)
+		{
+			parallel_for(0, numChunks, 1, [&](const size_t chunk)
+			{
+				const size_t first = (chunk * ParallelChunkSize);
+				evalRows(columns.data(), results, first, Min((first + ParallelChunkSize), count));
+			});
+			return;
+		}
+
+	# endif
+
+		evalRows(columns.data(), results, 0, count);
+	}
+
+	inline void CompiledMathExpression::evalBatch(const Array<Array<double>>& columns, Array<double>& results) const
+	{
+		const size_t count = (columns ? columns.front().size() : 0);
+
+		for (const auto& column : columns)
+		{
+			if (column.size() != count)
+			{
+				throw Error{ U"CompiledMathExpression::evalBatch(): all columns must have the same length" };
+			}
+		}
+
+		Array<const double*> pointers(columns.size());
+
+		for (size_t i = 0; i < columns.size(); ++i)
+		{
+			pointers[i] = columns[i].data();
+		}
+
+		results.resize(count);
+		evalBatch(pointers, results.data(), count);
+	}
+
+	inline void CompiledMathExpression::evalRows(const double* const* columns, double* results, const size_t first, const size_t last) const
+	{
+		// スタックの各段は BatchSize 行分の値の列で、変数の列はコピーせずに直接参照する
+		Array<double> buffer(m_stackSize * BatchSize);
+		Array<const double*> slots(m_stackSize);
+		Array<double> args;
+
+		const auto slotBuffer = [&](const size_t i) { return (buffer.data() + i * BatchSize); };
+
+		for (size_t offset = first; offset < last; offset += BatchSize)
+		{
+			const size_t n = Min(BatchSize, (last - offset));
+			size_t top = 0;
+
+			for (const auto& instruction : m_code)
+			{
+				switch (instruction.op)
+				{
+				case OpCode::Value:
+					{
+						double* dst = slotBuffer(top);
+						std::fill_n(dst, n, instruction.b);
+						slots[top++] = dst;
+						break;
+					}
+				case OpCode::Variable:
+					slots[top++] = (columns[instruction.index] + offset);
+					break;
+				case OpCode::VariableMul:
+					{
+						const double* x = (columns[instruction.index] + offset);
+						double* dst = slotBuffer(top);
+						const double a = instruction.a, b = instruction.b;
+
+						for (size_t k = 0; k < n; ++k)
+						{
+							const double t = (x[k] * a);
+							dst[k] = (t + b);
+						}
+
+						slots[top++] = dst;
+						break;
+					}
+				case OpCode::VariablePow2:
+					{
+						const double* x = (columns[instruction.index] + offset);
+						double* dst = slotBuffer(top);
+
+						for (size_t k = 0; k < n; ++k)
+						{
+							dst[k] = (x[k] * x[k]);
+						}
+
+						slots[top++] = dst;
+						break;
+					}
+				case OpCode::VariablePow3:
+					{
+						const double* x = (columns[instruction.index] + offset);
+						double* dst = slotBuffer(top);
+
+						for (size_t k = 0; k < n; ++k)
+						{
+							dst[k] = (x[k] * x[k] * x[k]);
+						}
+
+						slots[top++] = dst;
+						break;
+					}
+				case OpCode::VariablePow4:
+					{
+						const double* x = (columns[instruction.index] + offset);
+						double* dst = slotBuffer(top);
+
+						for (size_t k = 0; k < n; ++k)
+						{
+							dst[k] = (x[k] * x[k] * x[k] * x[k]);
+						}
+
+						slots[top++] = dst;
+						break;
+					}
+				case OpCode::Negate:
+					{
+						const double* x = slots[top - 1];
+						double* dst = slotBuffer(top - 1);
+
+						for (size_t k = 0; k < n; ++k)
+						{
+							dst[k] = -x[k];
+						}
+
+						slots[top - 1] = dst;
+						break;
+					}
+				case OpCode::Plus:
+					break;
+				case OpCode::Function1:
+					{
+						const double* x = slots[top - 1];
+						double* dst = slotBuffer(top - 1);
+						const auto f = instruction.f1;
+
+						for (size_t k = 0; k < n; ++k)
+						{
+							dst[k] = f(x[k]);
+						}
+
+						slots[top - 1] = dst;
+						break;
+					}
+				case OpCode::FunctionN:
+					{
+						const size_t argc = instruction.index;
+						top -= (argc - 1);
+						double* dst = slotBuffer(top - 1);
+						const auto f = instruction.fn;
+						args.resize(argc);
+
+						for (size_t k = 0; k < n; ++k)
+						{
+							for (size_t i = 0; i < argc; ++i)
+							{
+								args[i] = slots[top - 1 + i][k];
+							}
+
+							dst[k] = f(args.data(), argc);
+						}
+
+						slots[top - 1] = dst;
+						break;
+					}
+				case OpCode::Select:
+					{
+						top -= 2;
+						const double* c = slots[top - 1];
+						const double* x = slots[top];
+						const double* y = slots[top + 1];
+						double* dst = slotBuffer(top - 1);
+
+						for (size_t k = 0; k < n; ++k)
+						{
+							dst[k] = ((c[k] == 0.0) ? y[k] : x[k]);
+						}
+
+						slots[top - 1] = dst;
+						break;
+					}
+				default:
+					{
+						--top;
+						const double* x = slots[top - 1];
+						const double* y = slots[top];
+						double* dst = slotBuffer(top - 1);
+
+						switch (instruction.op)
+						{
+						case OpCode::Add:
+							for (size_t k = 0; k < n; ++k) { dst[k] = (x[k] + y[k]); }
+							break;
+						case OpCode::Sub:
+							for (size_t k = 0; k < n; ++k) { dst[k] = (x[k] - y[k]); }
+							break;
+						case OpCode::Mul:
+							for (size_t k = 0; k < n; ++k) { dst[k] = (x[k] * y[k]); }
+							break;
+						case OpCode::Div:
+							for (size_t k = 0; k < n; ++k) { dst[k] = (x[k] / y[k]); }
+							break;
+						case OpCode::Pow:
+							for (size_t k = 0; k < n; ++k) { dst[k] = std::pow(x[k], y[k]); }
+							break;
+						case OpCode::Less:
+							for (size_t k = 0; k < n; ++k) { dst[k] = (x[k] < y[k]); }
+							break;
+						case OpCode::Greater:
+							for (size_t k = 0; k < n; ++k) { dst[k] = (x[k] > y[k]); }
+							break;
+						case OpCode::LessEqual:
+							for (size_t k = 0; k < n; ++k) { dst[k] = (x[k] <= y[k]); }
+							break;
+						case OpCode::GreaterEqual:
+							for (size_t k = 0; k < n; ++k) { dst[k] = (x[k] >= y[k]); }
+							break;
+						case OpCode::Equal:
+							for (size_t k = 0; k < n; ++k) { dst[k] = (x[k] == y[k]); }
+							break;
+						case OpCode::NotEqual:
+							for (size_t k = 0; k < n; ++k) { dst[k] = (x[k] != y[k]); }
+							break;
+						case OpCode::And:
+							for (size_t k = 0; k < n; ++k) { dst[k] = ((x[k] != 0.0) && (y[k] != 0.0)); }
+							break;
+						case OpCode::Or:
+							for (size_t k = 0; k < n; ++k) { dst[k] = ((x[k] != 0.0) || (y[k] != 0.0)); }
+							break;
+						default:
+							break;
+						}
+
+						slots[top - 1] = dst;
+						break;
+					}
+				}
+			}
+
+			std::copy_n(slots[0], n, (results + offset));
+		}
+	}
+
+	inline CompiledMathExpression MathParser::compile() const
+	{
+		return CompiledMathExpression{ *this };
+	}
+}
@@ -0,0 +1,45 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Type>
+	inline void swap(ConcurrentHashSet<Type>& a, ConcurrentHashSet<Type>& b) noexcept
+	{
+		a.swap(b);
+	}
+
+	template <class Type>
+	inline void Formatter(FormatData& formatData, const ConcurrentHashSet<Type>& set)
+	{
+		formatData.string.push_back(U'{');
+
+		bool isFirst = true;
+
+		set.for_each([&](const Type& value)
+		{
+			if (isFirst)
+			{
+				isFirst = false;
+			}
+			else
+			{
+				formatData.string.append(U", "_sv);
+			}
+
+			Formatter(formatData, value);
+		});
+
+		formatData.string.push_back(U'}');
+	}
+}
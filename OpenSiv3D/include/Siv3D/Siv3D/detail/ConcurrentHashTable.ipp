@@ -0,0 +1,42 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Key, class Value>
+	inline void swap(ConcurrentHashTable<Key, Value>& a, ConcurrentHashTable<Key, Value>& b) noexcept
+	{
+		a.swap(b);
+	}
+
+	template <class Key, class Value>
+	inline void Formatter(FormatData& formatData, const ConcurrentHashTable<Key, Value>& table)
+	{
+		formatData.string.append(U"{\n"_sv);
+
+		table.for_each([&](const auto& p)
+		{
+			formatData.string.append(U"\t{"_sv);
+
+			Formatter(formatData, p.first);
+
+			formatData.string.append(U":\t"_sv);
+
+			Formatter(formatData, p.second);
+
+			formatData.string.append(U"},\n"_sv);
+		});
+
+		formatData.string.push_back(U'}');
+	}
+}
@@ -0,0 +1,505 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief データセットの一部の要素だけを nanoflann に見せるアダプタ
+		template <class DatasetAdapter>
+		class KDSubsetAdapter
+		{
+		public:
+
+			using element_type	= typename DatasetAdapter::element_type;
+
+			using dataset_type	= typename DatasetAdapter::dataset_type;
+
+			KDSubsetAdapter(const dataset_type& dataset, Array<size_t>&& indices)
+				: m_dataset{ dataset }
+				, m_indices{ std::move(indices) } {}
+
+			[[nodiscard]]
+			size_t kdtree_get_point_count() const
+			{
+				return m_indices.size();
+			}
+
+			[[nodiscard]]
+			element_type kdtree_get_pt(const size_t index, const size_t dim) const
+			{
+				return DatasetAdapter::GetElement(m_dataset, m_indices[index], dim);
+			}
+
+			template <class BBOX>
+			bool kdtree_get_bbox(BBOX&) const
+			{
+				return false;
+			}
+
+			[[nodiscard]]
+			const Array<size_t>& indices() const noexcept
+			{
+				return m_indices;
+			}
+
+		private:
+
+			const dataset_type& m_dataset;
+
+			Array<size_t> m_indices;
+		};
+
+		/// @brief フォレスト内の各ツリーの検索結果を、データセットのインデックスに変換して 1 つの結果にまとめるアダプタ
+		/// @remark 削除済み、または別のスロットへ移動済みの要素は除外します。
+		template <class ResultSet>
+		class KDForestResultSet
+		{
+		public:
+
+			using DistanceType	= typename ResultSet::DistanceType;
+
+			using IndexType		= size_t;
+
+			KDForestResultSet(ResultSet& resultSet, const Array<size_t>& slots)
+				: m_resultSet{ resultSet }
+				, m_slots{ slots } {}
+
+			void setSource(const size_t* localToGlobal, const size_t slot) noexcept
+			{
+				m_localToGlobal = localToGlobal;
+				m_slot = slot;
+			}
+
+			size_t size() const
+			{
+				return m_resultSet.size();
+			}
+
+			bool full() const
+			{
+				return m_resultSet.full();
+			}
+
+			DistanceType worstDist() const
+			{
+				return m_resultSet.worstDist();
+			}
+
+			bool addPoint(const DistanceType dist, const IndexType localIndex)
+			{
+				const size_t index = m_localToGlobal[localIndex];
+
+				if (m_slots[index] != m_slot)
+				{
+					return true;
+				}
+
+				return m_resultSet.addPoint(dist, index);
+			}
+
+		private:
+
+			ResultSet& m_resultSet;
+
+			const Array<size_t>& m_slots;
+
+			const size_t* m_localToGlobal = nullptr;
+
+			size_t m_slot = 0;
+		};
+	}
+
+	template <class DatasetAdapter>
+	struct DynamicKDTree<DatasetAdapter>::Tree
+	{
+		subset_adapter_type adapter;
+
+		index_type index;
+
+		size_t liveCount;
+
+		Tree(const dataset_type& dataset, Array<size_t>&& indices)
+			: adapter{ dataset, std::move(indices) }
+			, index{ Dimensions, adapter, nanoflann::KDTreeSingleIndexAdaptorParams(10) }
+			, liveCount{ adapter.indices().size() } {}
+	};
+
+	template <class DatasetAdapter>
+	inline DynamicKDTree<DatasetAdapter>::DynamicKDTree(const dataset_type& dataset)
+		: m_dataset{ &dataset }
+	{
+		insert(0, std::size(dataset));
+	}
+
+	template <class DatasetAdapter>
+	inline DynamicKDTree<DatasetAdapter>::~DynamicKDTree() = default;
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::insert(const size_t index)
+	{
+		insert(index, (index + 1));
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::insert(const size_t first, size_t last)
+	{
+		// デフォルトコンストラクタで作成した場合はデータセットが無い
+		if (not m_dataset)
+		{
+			return;
+		}
+
+		last = Min(last, static_cast<size_t>(std::size(*m_dataset)));
+
+		if (last <= first)
+		{
+			return;
+		}
+
+		if (m_slots.size() < last)
+		{
+			m_slots.resize(last, NotIndexed);
+		}
+
+		for (size_t index = first; index < last; ++index)
+		{
+			remove(index);
+
+			m_slots[index] = PendingSlot;
+			m_pending.push_back(index);
+			++m_size;
+		}
+
+		if (PendingCapacity <= m_pending.size())
+		{
+			flushPending();
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::remove(const size_t index)
+	{
+		if (not contains(index))
+		{
+			return;
+		}
+
+		const size_t slot = std::exchange(m_slots[index], NotIndexed);
+		--m_size;
+
+		if (slot == PendingSlot)
+		{
+			m_pending.remove(index);
+			return;
+		}
+
+		Tree& tree = *m_trees[slot];
+
+		if (--tree.liveCount == 0)
+		{
+			m_trees[slot].reset();
+		}
+		else if ((tree.liveCount * 2) < tree.adapter.indices().size())
+		{
+			// 半数以上が削除されたツリーだけを、残っている要素で作り直す
+			Array<size_t> indices;
+			collectLiveIndices(slot, indices);
+			buildTree(slot, std::move(indices));
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::update(const size_t index)
+	{
+		insert(index);
+	}
+
+	template <class DatasetAdapter>
+	inline bool DynamicKDTree<DatasetAdapter>::contains(const size_t index) const noexcept
+	{
+		return ((index < m_slots.size()) && (m_slots[index] != NotIndexed));
+	}
+
+	template <class DatasetAdapter>
+	inline size_t DynamicKDTree<DatasetAdapter>::size() const noexcept
+	{
+		return m_size;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::rebuildIndex()
+	{
+		Array<size_t> indices = std::move(m_pending);
+		m_pending.clear();
+
+		for (size_t slot = 0; slot < m_trees.size(); ++slot)
+		{
+			if (m_trees[slot])
+			{
+				collectLiveIndices(slot, indices);
+				m_trees[slot].reset();
+			}
+		}
+
+		if (indices.isEmpty())
+		{
+			return;
+		}
+
+		size_t slot = 0;
+
+		while ((PendingCapacity << slot) < indices.size())
+		{
+			++slot;
+		}
+
+		buildTree(slot, std::move(indices));
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::release()
+	{
+		m_trees.clear();
+		m_trees.shrink_to_fit();
+		m_pending.clear();
+		m_pending.shrink_to_fit();
+		m_slots.clear();
+		m_slots.shrink_to_fit();
+		m_size = 0;
+	}
+
+	template <class DatasetAdapter>
+	inline size_t DynamicKDTree<DatasetAdapter>::usedMemory() const
+	{
+		size_t memory = ((m_pending.capacity() + m_slots.capacity()) * sizeof(size_t));
+
+		for (const auto& tree : m_trees)
+		{
+			if (tree)
+			{
+				memory += (tree->index.pool.usedMemory + tree->index.pool.wastedMemory
+					+ (tree->adapter.indices().capacity() * sizeof(size_t) * 2));
+			}
+		}
+
+		return memory;
+	}
+
+	template <class DatasetAdapter>
+	inline Array<size_t> DynamicKDTree<DatasetAdapter>::knnSearch(const size_t k, const point_type& point) const
+	{
+		Array<size_t> results;
+
+		knnSearch(results, k, point);
+
+		return results;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::knnSearch(Array<size_t>& results, const size_t k, const point_type& point) const
+	{
+		results.resize(k);
+
+		Array<double> distanceSqs(k);
+
+		nanoflann::KNNResultSet<double, size_t> resultSet{ k };
+		resultSet.init(results.data(), distanceSqs.data());
+
+		findNeighbors(resultSet, point);
+
+		results.resize(resultSet.size());
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::knnSearch(Array<size_t>& results, Array<element_type>& distanceSqResults, const size_t k, const point_type& point) const
+	{
+		results.resize(k);
+
+		Array<double> distanceSqs(k);
+
+		nanoflann::KNNResultSet<double, size_t> resultSet{ k };
+		resultSet.init(results.data(), distanceSqs.data());
+
+		findNeighbors(resultSet, point);
+
+		const size_t count = resultSet.size();
+
+		results.resize(count);
+		distanceSqResults.resize(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			distanceSqResults[i] = static_cast<element_type>(distanceSqs[i]);
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline Array<size_t> DynamicKDTree<DatasetAdapter>::radiusSearch(const point_type& point, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		Array<size_t> results;
+
+		radiusSearch(results, point, radius, sortByDistance);
+
+		return results;
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::radiusSearch(Array<size_t>& results, const point_type& point, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		const double radiusSq = (static_cast<double>(radius) * radius);
+
+		if (sortByDistance)
+		{
+			std::vector<std::pair<size_t, double>> matches;
+
+			nanoflann::RadiusResultSet<double, size_t> resultSet{ radiusSq, matches };
+
+			findNeighbors(resultSet, point);
+
+			std::sort(matches.begin(), matches.end(), nanoflann::IndexDist_Sorter());
+
+			results.resize(matches.size());
+
+			for (size_t i = 0; i < matches.size(); ++i)
+			{
+				results[i] = matches[i].first;
+			}
+		}
+		else
+		{
+			detail::RadiusResultsAdapter<double> resultSet{ radiusSq, results };
+
+			findNeighbors(resultSet, point);
+		}
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::knnSearchBatch(Array<Array<size_t>>& results, const size_t k, const Array<point_type>& points) const
+	{
+		results.resize(points.size());
+
+		detail::ForEachKDTreeQuery(points.size(), [&](const size_t i)
+		{
+			knnSearch(results[i], k, points[i]);
+		});
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::radiusSearchBatch(Array<Array<size_t>>& results, const Array<point_type>& points, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		results.resize(points.size());
+
+		detail::ForEachKDTreeQuery(points.size(), [&](const size_t i)
+		{
+			radiusSearch(results[i], points[i], radius, sortByDistance);
+		});
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::flushPending()
+	{
+		Array<size_t> indices = std::move(m_pending);
+		m_pending.clear();
+
+		// 空いていて、全要素が収まるスロットが見つかるまで、小さいツリーから順に併合する
+		size_t slot = 0;
+
+		for (;; ++slot)
+		{
+			if (m_trees.size() <= slot)
+			{
+				m_trees.resize(slot + 1);
+			}
+
+			if ((not m_trees[slot]) && (indices.size() <= (PendingCapacity << slot)))
+			{
+				break;
+			}
+
+			if (m_trees[slot])
+			{
+				collectLiveIndices(slot, indices);
+				m_trees[slot].reset();
+			}
+		}
+
+		buildTree(slot, std::move(indices));
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::buildTree(const size_t slot, Array<size_t>&& indices)
+	{
+		if (m_trees.size() <= slot)
+		{
+			m_trees.resize(slot + 1);
+		}
+
+		for (const size_t index : indices)
+		{
+			m_slots[index] = slot;
+		}
+
+		m_trees[slot] = std::make_unique<Tree>(*m_dataset, std::move(indices));
+	}
+
+	template <class DatasetAdapter>
+	inline void DynamicKDTree<DatasetAdapter>::collectLiveIndices(const size_t slot, Array<size_t>& indices) const
+	{
+		for (const size_t index : m_trees[slot]->adapter.indices())
+		{
+			if (m_slots[index] == slot)
+			{
+				indices.push_back(index);
+			}
+		}
+	}
+
+	template <class DatasetAdapter>
+	template <class ResultSet>
+	inline void DynamicKDTree<DatasetAdapter>::findNeighbors(ResultSet& resultSet, const point_type& point) const
+	{
+		const element_type* query = adapter_type::GetPointer(point);
+
+		detail::KDForestResultSet<ResultSet> forestResultSet{ resultSet, m_slots };
+
+		const nanoflann::SearchParams searchParams{ 32, 0.0f, false };
+
+		// 大きいツリーから検索すると、早い段階で候補の距離が縮まる
+		for (size_t slot = m_trees.size(); slot-- > 0;)
+		{
+			if (const auto& tree = m_trees[slot])
+			{
+				forestResultSet.setSource(tree->adapter.indices().data(), slot);
+				tree->index.findNeighbors(forestResultSet, query, searchParams);
+			}
+		}
+
+		// ツリーに入る前の要素は総当たりで調べる
+		for (const size_t index : m_pending)
+		{
+			double distanceSq = 0.0;
+
+			for (int32 dim = 0; dim < Dimensions; ++dim)
+			{
+				const double d = (static_cast<double>(DatasetAdapter::GetElement(*m_dataset, index, dim)) - query[dim]);
+				distanceSq += (d * d);
+			}
+
+			if (distanceSq < resultSet.worstDist())
+			{
+				resultSet.addPoint(distanceSq, index);
+			}
+		}
+	}
+}
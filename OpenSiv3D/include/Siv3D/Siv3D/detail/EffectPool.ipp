@@ -0,0 +1,230 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Type>
+	inline EffectPool<Type>::EffectPool(const double maxLifeTimeSec)
+		: m_maxLifeTimeSec{ maxLifeTimeSec } {}
+
+	template <class Type>
+	inline EffectPool<Type>::EffectPool(const Duration& maxLifeTimeSec)
+		: EffectPool{ maxLifeTimeSec.count() } {}
+
+	template <class Type>
+	template <class... Args>
+	inline EffectPool<Type>& EffectPool<Type>::add(Args&&... args)
+	{
+		const double startTime = m_stopwatch.sF();
+
+		if (m_updating)
+		{
+			// 更新中のエフェクトへの参照を無効にしないよう、スロットには update() の後で移す
+			m_pending.emplace_back(std::forward<Args>(args)...);
+			m_pendingStartTimes.push_back(startTime);
+		}
+		else
+		{
+			emplaceSlot(startTime, std::forward<Args>(args)...);
+		}
+
+		return *this;
+	}
+
+	template <class Type>
+	inline EffectPool<Type>::operator bool() const noexcept
+	{
+		return hasEffects();
+	}
+
+	template <class Type>
+	inline bool EffectPool<Type>::isEmpty() const noexcept
+	{
+		return (num_effects() == 0);
+	}
+
+	template <class Type>
+	inline bool EffectPool<Type>::hasEffects() const noexcept
+	{
+		return (num_effects() != 0);
+	}
+
+	template <class Type>
+	inline size_t EffectPool<Type>::num_effects() const noexcept
+	{
+		return (m_size + m_pending.size());
+	}
+
+	template <class Type>
+	inline size_t EffectPool<Type>::capacity() const noexcept
+	{
+		return m_slots.size();
+	}
+
+	template <class Type>
+	inline void EffectPool<Type>::reserve(const size_t n)
+	{
+		if (m_slots.size() < n)
+		{
+			m_slots.resize(n);
+			m_startTimes.resize(n);
+		}
+	}
+
+	template <class Type>
+	inline void EffectPool<Type>::pause()
+	{
+		m_stopwatch.pause();
+	}
+
+	template <class Type>
+	inline bool EffectPool<Type>::isPaused() const noexcept
+	{
+		return m_stopwatch.isPaused();
+	}
+
+	template <class Type>
+	inline void EffectPool<Type>::resume()
+	{
+		m_stopwatch.resume();
+	}
+
+	template <class Type>
+	inline EffectPool<Type>& EffectPool<Type>::setSpeed(const double speed)
+	{
+		m_stopwatch.setSpeed(speed);
+		return *this;
+	}
+
+	template <class Type>
+	inline double EffectPool<Type>::getSpeed() const noexcept
+	{
+		return m_stopwatch.getSpeed();
+	}
+
+	template <class Type>
+	inline EffectPool<Type>& EffectPool<Type>::setMaxLifeTime(const double maxLifeTimeSec)
+	{
+		m_maxLifeTimeSec = maxLifeTimeSec;
+		return *this;
+	}
+
+	template <class Type>
+	inline void EffectPool<Type>::setMaxLifeTime(const Duration& maxLifeTimeSec)
+	{
+		setMaxLifeTime(maxLifeTimeSec.count());
+	}
+
+	template <class Type>
+	inline double EffectPool<Type>::getMaxLifeTime() const noexcept
+	{
+		return m_maxLifeTimeSec;
+	}
+
+	template <class Type>
+	inline void EffectPool<Type>::update()
+	{
+		const double currentTime = m_stopwatch.sF();
+
+		m_updating = true;
+
+		// 終了したエフェクトを取り除きながら、残るエフェクトを追加した順のまま前に詰める
+		size_t writeIndex = 0;
+
+		for (size_t i = 0; i < m_size; ++i)
+		{
+			Optional<Type>& slot = m_slots[i];
+			const double timeSec = (currentTime - m_startTimes[i]);
+
+			if ((m_maxLifeTimeSec < timeSec)
+				|| (not UpdateEffect(*slot, timeSec)))
+			{
+				slot.reset();
+				continue;
+			}
+
+			if (writeIndex != i)
+			{
+				m_slots[writeIndex].emplace(std::move(*slot));
+				m_startTimes[writeIndex] = m_startTimes[i];
+				slot.reset();
+			}
+
+			++writeIndex;
+		}
+
+		m_size = writeIndex;
+
+		m_updating = false;
+
+		for (size_t i = 0; i < m_pending.size(); ++i)
+		{
+			emplaceSlot(m_pendingStartTimes[i], std::move(m_pending[i]));
+		}
+
+		m_pending.clear();
+		m_pendingStartTimes.clear();
+	}
+
+	template <class Type>
+	inline void EffectPool<Type>::clear()
+	{
+		for (size_t i = 0; i < m_size; ++i)
+		{
+			m_slots[i].reset();
+		}
+
+		m_size = 0;
+		m_pending.clear();
+		m_pendingStartTimes.clear();
+	}
+
+	template <class Type>
+	inline void EffectPool<Type>::shrink_to_fit()
+	{
+		m_slots.resize(m_size);
+		m_slots.shrink_to_fit();
+		m_startTimes.resize(m_size);
+		m_startTimes.shrink_to_fit();
+		m_pending.shrink_to_fit();
+		m_pendingStartTimes.shrink_to_fit();
+	}
+
+	template <class Type>
+	template <class... Args>
+	inline void EffectPool<Type>::emplaceSlot(const double startTime, Args&&... args)
+	{
+		if (m_size == m_slots.size())
+		{
+			m_slots.emplace_back();
+			m_startTimes.push_back(0.0);
+		}
+
+		m_slots[m_size].emplace(std::forward<Args>(args)...);
+		m_startTimes[m_size] = startTime;
+		++m_size;
+	}
+
+	template <class Type>
+	inline bool EffectPool<Type>::UpdateEffect(Type& effect, const double timeSec)
+	{
+		if constexpr (detail::HasEffectUpdate<Type>::value)
+		{
+			return static_cast<bool>(effect.update(timeSec));
+		}
+		else
+		{
+			return static_cast<bool>(effect(timeSec));
+		}
+	}
+}
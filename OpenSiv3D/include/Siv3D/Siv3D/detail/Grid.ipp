@@ -13,6 +13,153 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		/// @brief 並列処理で 1 つのタスクが受け持つ行の帯のバイト数の目安
+		inline constexpr size_t GridParallelBandBytes = (64 * 1024);
+
+		/// @brief `stencil_update()` で 1 つのタスクが受け持つ 2D タイルのバイト数の目安
+		inline constexpr size_t GridStencilTileBytes = (32 * 1024);
+
+		[[nodiscard]]
+		inline constexpr int32 ResolveGridAddress(const int32 i, const int32 n, const GridAddressMode addressMode) noexcept
+		{
+			switch (addressMode)
+			{
+			case GridAddressMode::Repeat:
+				return (((i % n) + n) % n);
+			case GridAddressMode::Mirror:
+				{
+					const int32 period = (n * 2);
+					const int32 m = (((i % period) + period) % period);
+					return ((m < n) ? m : (period - 1 - m));
+				}
+			case GridAddressMode::Clamp:
+				return Clamp(i, 0, (n - 1));
+			default:
+				return (((0 <= i) && (i < n)) ? i : -1);
+			}
+		}
+
+		template <class Fty>
+		inline void ForEachGridTile(const size_t width, const size_t height, const size_t tileWidth, const size_t tileHeight, Fty f)
+		{
+			const size_t tilesX = ((width + tileWidth - 1) / tileWidth);
+			const size_t tilesY = ((height + tileHeight - 1) / tileHeight);
+			const size_t numTiles = (tilesX * tilesY);
+
+			auto invoke = [&](const size_t i)
+			{
+				const size_t x0 = ((i % tilesX) * tileWidth);
+				const size_t y0 = ((i / tilesX) * tileHeight);
+				f(x0, y0, Min((x0 + tileWidth), width), Min((y0 + tileHeight), height));
+			};
+
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			if ((Threading::ParallelSerialCutoff < (width * height)) && (1 < numTiles))
+			{
+				parallel_for(0, numTiles, 1, invoke);
+				return;
+			}
+
+		# endif
+
+			for (size_t i = 0; i < numTiles; ++i)
+			{
+				invoke(i);
+			}
+		}
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		/// @brief 並列処理で 1 つのタスクが処理する要素数を返します。帯は行の境界で区切られます。
+		[[nodiscard]]
+		inline constexpr size_t GridBandSize(const size_t width, const size_t elementBytes) noexcept
+		{
+			const size_t rowBytes = Max<size_t>(1, (width * elementBytes));
+			return (Max<size_t>(1, (GridParallelBandBytes / rowBytes)) * Max<size_t>(1, width));
+		}
+
+		[[nodiscard]]
+		inline constexpr size_t GridBandCount(const size_t count, const size_t bandSize) noexcept
+		{
+			return ((count + bandSize - 1) / bandSize);
+		}
+
+		template <class Fty>
+		inline void ForEachGridBand(const size_t count, const size_t bandSize, Fty f)
+		{
+			const size_t numBands = GridBandCount(count, bandSize);
+
+			auto invoke = [&](const size_t i)
+			{
+				const size_t first = (i * bandSize);
+				f(i, first, Min((first + bandSize), count));
+			};
+
+			if ((count <= Threading::ParallelSerialCutoff) || (numBands <= 1))
+			{
+				for (size_t i = 0; i < numBands; ++i)
+				{
+					invoke(i);
+				}
+
+				return;
+			}
+
+			parallel_for(0, numBands, 1, invoke);
+		}
+
+	# endif
+	}
+
+	template <class Type>
+	inline GridStencil<Type>::GridStencil(const Type* data, const Size size, const Point pos, const bool interior, const GridAddressMode addressMode, const Type& borderValue) noexcept
+		: m_data{ data }
+		, m_size{ size }
+		, m_pos{ pos }
+		, m_interior{ interior }
+		, m_addressMode{ addressMode }
+		, m_borderValue{ &borderValue } {}
+
+	template <class Type>
+	inline const Type& GridStencil<Type>::operator ()(const int32 dx, const int32 dy) const noexcept
+	{
+		if (m_interior)
+		{
+			return m_data[(static_cast<size_t>(m_pos.y + dy) * m_size.x) + (m_pos.x + dx)];
+		}
+
+		const int32 x = detail::ResolveGridAddress((m_pos.x + dx), m_size.x, m_addressMode);
+		const int32 y = detail::ResolveGridAddress((m_pos.y + dy), m_size.y, m_addressMode);
+
+		if ((x < 0) || (y < 0))
+		{
+			return *m_borderValue;
+		}
+
+		return m_data[(static_cast<size_t>(y) * m_size.x) + x];
+	}
+
+	template <class Type>
+	inline const Type& GridStencil<Type>::operator ()(const Point offset) const noexcept
+	{
+		return operator ()(offset.x, offset.y);
+	}
+
+	template <class Type>
+	inline const Type& GridStencil<Type>::center() const noexcept
+	{
+		return m_data[(static_cast<size_t>(m_pos.y) * m_size.x) + m_pos.x];
+	}
+
+	template <class Type>
+	inline Point GridStencil<Type>::pos() const noexcept
+	{
+		return m_pos;
+	}
+
 	template <class Type, class Allocator>
 	inline Grid<Type, Allocator>::Grid(const size_type w, const size_type h)
 		: m_data(w * h)
@@ -1401,6 +1548,69 @@ namespace s3d
 		return std::move(*this);
 	}
 
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_r_v<Type, Fty, const GridStencil<Type>&>>*>
+	inline Grid<Type, Allocator>& Grid<Type, Allocator>::stencil_update(Grid& buffer, const int32 radius, const GridAddressMode addressMode, Fty f)
+	{
+		const value_type borderValue{};
+
+		return stencilUpdate(buffer, radius, addressMode, borderValue, f);
+	}
+
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_r_v<Type, Fty, const GridStencil<Type>&>>*>
+	inline Grid<Type, Allocator>& Grid<Type, Allocator>::stencil_update(Grid& buffer, const int32 radius, const value_type& borderValue, Fty f)
+	{
+		return stencilUpdate(buffer, radius, GridAddressMode::Border, borderValue, f);
+	}
+
+	template <class Type, class Allocator>
+	template <class Fty>
+	inline Grid<Type, Allocator>& Grid<Type, Allocator>::stencilUpdate(Grid& buffer, int32 radius, const GridAddressMode addressMode, const value_type& borderValue, Fty& f)
+	{
+		if (buffer.size() != size())
+		{
+			buffer.resize(size());
+		}
+
+		if (isEmpty())
+		{
+			return *this;
+		}
+
+		radius = Max(radius, 0);
+
+		const Size gridSize = size();
+		const_pointer src = m_data.data();
+		pointer dst = buffer.m_data.data();
+
+		// 半径分のはみ出しを含めてもタイルがキャッシュに収まるようにする
+		const size_t tileCells = Max<size_t>(64, (detail::GridStencilTileBytes / sizeof(value_type)));
+		const size_t tileWidth = Min<size_t>(m_width, Max<size_t>(16, (tileCells / 32)));
+		const size_t tileHeight = Max<size_t>(1, (tileCells / Max<size_t>(1, tileWidth)));
+
+		detail::ForEachGridTile(m_width, m_height, tileWidth, tileHeight,
+			[&](const size_t x0, const size_t y0, const size_t x1, const size_t y1)
+			{
+				for (size_t y = y0; y < y1; ++y)
+				{
+					const bool rowInterior = ((static_cast<int32>(y) - radius) >= 0) && ((static_cast<int32>(y) + radius) < gridSize.y);
+
+					for (size_t x = x0; x < x1; ++x)
+					{
+						const bool interior = rowInterior
+							&& ((static_cast<int32>(x) - radius) >= 0) && ((static_cast<int32>(x) + radius) < gridSize.x);
+
+						dst[(y * m_width) + x] = f(GridStencil<Type>{ src, gridSize, Point{ x, y }, interior, addressMode, borderValue });
+					}
+				}
+			});
+
+		m_data.swap(buffer.m_data);
+
+		return *this;
+	}
+
 	template <class Type, class Allocator>
 	template <class T, std::enable_if_t<Meta::HasPlus_v<T>>*>
 	inline auto Grid<Type, Allocator>::sum() const
@@ -1467,6 +1677,117 @@ namespace s3d
 		return new_array;
 	}
 
+# ifndef SIV3D_NO_CONCURRENT_API
+
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Point, Type&>>*>
+	inline Grid<Type, Allocator>& Grid<Type, Allocator>::parallel_each_index(Fty f)
+	{
+		pointer data = m_data.data();
+		const size_t width = m_width;
+
+		detail::ForEachGridBand(m_data.size(), detail::GridBandSize(m_width, sizeof(value_type)),
+			[&](size_t, const size_t first, const size_t last)
+			{
+				size_t x = (first % width);
+				size_t y = (first / width);
+
+				for (size_t i = first; i < last; ++i)
+				{
+					f(Point{ x, y }, data[i]);
+
+					if (++x == width)
+					{
+						x = 0;
+						++y;
+					}
+				}
+			});
+
+		return *this;
+	}
+
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Point, Type>>*>
+	inline const Grid<Type, Allocator>& Grid<Type, Allocator>::parallel_each_index(Fty f) const
+	{
+		const_pointer data = m_data.data();
+		const size_t width = m_width;
+
+		detail::ForEachGridBand(m_data.size(), detail::GridBandSize(m_width, sizeof(value_type)),
+			[&](size_t, const size_t first, const size_t last)
+			{
+				size_t x = (first % width);
+				size_t y = (first / width);
+
+				for (size_t i = first; i < last; ++i)
+				{
+					f(Point{ x, y }, data[i]);
+
+					if (++x == width)
+					{
+						x = 0;
+						++y;
+					}
+				}
+			});
+
+		return *this;
+	}
+
+	template <class Type, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>*>
+	inline auto Grid<Type, Allocator>::parallel_map(Fty f) const
+	{
+		using ResultType = std::remove_cvref_t<decltype(f(m_data[0]))>;
+
+		Array<ResultType> new_grid(m_data.size());
+
+		detail::ForEachGridBand(m_data.size(), detail::GridBandSize(m_width, Max(sizeof(value_type), sizeof(ResultType))),
+			[&](size_t, const size_t first, const size_t last)
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					new_grid[i] = f(m_data[i]);
+				}
+			});
+
+		return Grid<ResultType>(m_width, m_height, std::move(new_grid));
+	}
+
+	template <class Type, class Allocator>
+	template <class R, class Fty, class CombineFty>
+	inline R Grid<Type, Allocator>::parallel_reduce(R identity, Fty f, CombineFty combine) const
+	{
+		const size_t bandSize = detail::GridBandSize(m_width, sizeof(value_type));
+
+		Array<Optional<R>> partials(detail::GridBandCount(m_data.size(), bandSize));
+
+		detail::ForEachGridBand(m_data.size(), bandSize,
+			[&](const size_t band, const size_t first, const size_t last)
+			{
+				R value = identity;
+
+				for (size_t i = first; i < last; ++i)
+				{
+					value = f(std::move(value), m_data[i]);
+				}
+
+				partials[band].emplace(std::move(value));
+			});
+
+		R value = std::move(identity);
+
+		for (auto& partial : partials)
+		{
+			value = combine(std::move(value), std::move(*partial));
+		}
+
+		return value;
+	}
+
+# endif
+
 	template <class Type, class Allocator>
 	template <class Fty, std::enable_if_t<std::is_invocable_r_v<Type, Fty>>*>
 	inline Grid<Type, Allocator> Grid<Type, Allocator>::Generate(const size_type w, const size_type h, Fty generator)
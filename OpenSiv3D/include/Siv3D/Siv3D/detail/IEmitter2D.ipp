@@ -0,0 +1,23 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	inline void IBulkEmitter2D::emitBulk(const Vec2& emitterPosition, const double startSpeed, Emission2D* dst, const size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			dst[i] = emit(emitterPosition, startSpeed);
+		}
+	}
+}
@@ -0,0 +1,207 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	inline ImagePipeline& ImagePipeline::negate()
+	{
+		m_steps.push_back(Step{ StepType::Negate });
+
+		return *this;
+	}
+
+	inline ImagePipeline& ImagePipeline::grayscale()
+	{
+		m_steps.push_back(Step{ StepType::Grayscale });
+
+		return *this;
+	}
+
+	inline ImagePipeline& ImagePipeline::threshold(const uint8 threshold, const InvertColor invertColor)
+	{
+		m_steps.push_back(Step{ StepType::Threshold, threshold, invertColor });
+
+		return *this;
+	}
+
+	inline ImagePipeline& ImagePipeline::blur(const int32 size, const BorderType borderType)
+	{
+		return blur(size, size, borderType);
+	}
+
+	inline ImagePipeline& ImagePipeline::blur(const int32 horizontal, const int32 vertical, const BorderType borderType)
+	{
+		m_steps.push_back(Step{ StepType::Filter, 0, InvertColor::No, detail::ImageFilterKernel::Box(horizontal, vertical, borderType) });
+
+		return *this;
+	}
+
+	inline ImagePipeline& ImagePipeline::gaussianBlur(const int32 size, const BorderType borderType)
+	{
+		return gaussianBlur(size, size, borderType);
+	}
+
+	inline ImagePipeline& ImagePipeline::gaussianBlur(const int32 horizontal, const int32 vertical, const BorderType borderType)
+	{
+		m_steps.push_back(Step{ StepType::Filter, 0, InvertColor::No, detail::ImageFilterKernel::Gaussian(horizontal, vertical, borderType) });
+
+		return *this;
+	}
+
+	inline size_t ImagePipeline::num_steps() const noexcept
+	{
+		return m_steps.size();
+	}
+
+	inline bool ImagePipeline::isEmpty() const noexcept
+	{
+		return m_steps.isEmpty();
+	}
+
+	inline void ImagePipeline::clear()
+	{
+		m_steps.clear();
+	}
+
+	inline void ImagePipeline::apply(const Image& src, Image& dst) const
+	{
+		if (&src == &dst)
+		{
+			Image result;
+			apply(src, result);
+			dst.swap(result);
+			return;
+		}
+
+		const int32 width = src.width();
+		const int32 height = src.height();
+		dst.resize(width, height);
+
+		if (src.isEmpty())
+		{
+			return;
+		}
+
+		if (m_steps.isEmpty())
+		{
+			std::memcpy(dst.data(), src.data(), src.size_bytes());
+			return;
+		}
+
+		const size_t numSteps = m_steps.size();
+		Array<Array<int32>> xTables(numSteps), yTables(numSteps);
+		int32 totalRadiusY = 0;
+
+		for (size_t i = 0; i < numSteps; ++i)
+		{
+			if (m_steps[i].type == StepType::Filter)
+			{
+				const detail::ImageFilterKernel& kernel = m_steps[i].kernel;
+				xTables[i] = detail::MakeImageBorderTable(width, kernel.radiusX, kernel.borderType);
+				yTables[i] = detail::MakeImageBorderTable(height, kernel.radiusY, kernel.borderType);
+				totalRadiusY += kernel.radiusY;
+			}
+		}
+
+		detail::ForEachImageBand(width, height, detail::ImageBandRows(width, (totalRadiusY * 4)),
+			[&](const int32 first, const int32 last)
+			{
+				// 各処理が出力する行の範囲を、最後の処理から逆にたどって求める
+				Array<std::pair<int32, int32>> ranges(numSteps);
+				ranges.back() = { first, last };
+
+				for (size_t i = (numSteps - 1); 0 < i; --i)
+				{
+					const int32 radiusY = ((m_steps[i].type == StepType::Filter) ? m_steps[i].kernel.radiusY : 0);
+					ranges[i - 1] = { Max(0, (ranges[i].first - radiusY)), Min(height, (ranges[i].second + radiusY)) };
+				}
+
+				const size_t bufferLength = (static_cast<size_t>(Min(height, (last + totalRadiusY)) - Max(0, (first - totalRadiusY))) * width);
+				Array<Color> buffers[2] = { Array<Color>(bufferLength), Array<Color>(bufferLength) };
+
+				// 現在の結果（最初は入力の画像）
+				const Color* current = src.data();
+				int32 currentFirstRow = 0;
+				int32 currentBuffer = -1;
+
+				for (size_t i = 0; i < numSteps; ++i)
+				{
+					const Step& step = m_steps[i];
+					const auto [rowFirst, rowLast] = ranges[i];
+					const bool isLast = ((i + 1) == numSteps);
+					Color* target;
+					int32 targetBuffer;
+
+					if (isLast)
+					{
+						target = dst[rowFirst];
+						targetBuffer = -1;
+					}
+					else if ((step.type != StepType::Filter) && (currentBuffer != -1))
+					{
+						// ピクセルごとの処理は一時バッファ上でその場で行う
+						target = const_cast<Color*>(current + static_cast<size_t>(rowFirst - currentFirstRow) * width);
+						targetBuffer = currentBuffer;
+					}
+					else
+					{
+						targetBuffer = ((currentBuffer == 0) ? 1 : 0);
+						target = buffers[targetBuffer].data();
+					}
+
+					if (step.type == StepType::Filter)
+					{
+						detail::FilterImageRows(current, currentFirstRow, width, height, step.kernel, xTables[i], yTables[i], target, rowFirst, rowLast);
+					}
+					else
+					{
+						ApplyPixels(step, (current + static_cast<size_t>(rowFirst - currentFirstRow) * width), target, (static_cast<size_t>(rowLast - rowFirst) * width));
+					}
+
+					if (targetBuffer != currentBuffer)
+					{
+						current = target;
+						currentFirstRow = rowFirst;
+						currentBuffer = targetBuffer;
+					}
+				}
+			});
+	}
+
+	inline Image ImagePipeline::apply(const Image& src) const
+	{
+		Image result;
+
+		apply(src, result);
+
+		return result;
+	}
+
+	inline void ImagePipeline::ApplyPixels(const Step& step, const Color* src, Color* dst, const size_t count) noexcept
+	{
+		switch (step.type)
+		{
+		case StepType::Negate:
+			detail::NegateImagePixels(src, dst, count);
+			break;
+		case StepType::Grayscale:
+			detail::GrayscaleImagePixels(src, dst, count);
+			break;
+		case StepType::Threshold:
+			detail::ThresholdImagePixels(src, dst, count, step.threshold, step.invertColor);
+			break;
+		default:
+			break;
+		}
+	}
+}
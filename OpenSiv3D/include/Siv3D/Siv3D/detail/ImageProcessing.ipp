@@ -13,6 +13,449 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		/// @brief 並列処理で 1 つのタスクが受け持つ行の帯のバイト数の目安
+		inline constexpr size_t ImageParallelBandBytes = (64 * 1024);
+
+		/// @brief `ImageProcessing::Rotate90()` で 1 つのタスクが受け持つタイルの一辺の大きさ（ピクセル）
+		inline constexpr int32 ImageRotateTileSize = 64;
+
+		[[nodiscard]]
+		inline constexpr int32 ImageBandRows(const int32 width, const int32 minRows = 1) noexcept
+		{
+			const size_t rowBytes = (static_cast<size_t>(Max(width, 1)) * sizeof(Color));
+
+			return Max(static_cast<int32>(Max<size_t>(1, (ImageParallelBandBytes / rowBytes))), minRows);
+		}
+
+		/// @brief 画像を行の帯に分けて処理します。
+		/// @param width 画像の幅
+		/// @param height 画像の高さ
+		/// @param bandRows 1 つの帯の行数
+		/// @param f 帯の最初の行と、最後の行の次を引数にとる関数
+		template <class Fty>
+		inline void ForEachImageBand(const int32 width, const int32 height, const int32 bandRows, Fty f)
+		{
+			if ((width <= 0) || (height <= 0))
+			{
+				return;
+			}
+
+			ForEachGridTile(static_cast<size_t>(width), static_cast<size_t>(height), static_cast<size_t>(width), static_cast<size_t>(bandRows),
+				[&](size_t, const size_t y0, size_t, const size_t y1)
+				{
+					f(static_cast<int32>(y0), static_cast<int32>(y1));
+				});
+		}
+
+		[[nodiscard]]
+		inline constexpr int32 ResolveImageBorder(const int32 i, const int32 n, const BorderType borderType) noexcept
+		{
+			if ((0 <= i) && (i < n))
+			{
+				return i;
+			}
+
+			if (n == 1)
+			{
+				return 0;
+			}
+
+			switch (borderType)
+			{
+			case BorderType::Replicate:
+				return Clamp(i, 0, (n - 1));
+			case BorderType::Reflect:
+				{
+					const int32 period = (n * 2);
+					const int32 m = (((i % period) + period) % period);
+					return ((m < n) ? m : (period - 1 - m));
+				}
+			default:
+				{
+					const int32 period = ((n - 1) * 2);
+					const int32 m = (((i % period) + period) % period);
+					return ((m < n) ? m : (period - m));
+				}
+			}
+		}
+
+		/// @brief 半径 radius のカーネルのための、インデックスの変換表を作成します。
+		/// @return `table[i]` が座標 `(i - radius)` を画像の内側に移したものである配列
+		[[nodiscard]]
+		inline Array<int32> MakeImageBorderTable(const int32 n, const int32 radius, const BorderType borderType)
+		{
+			Array<int32> table(static_cast<size_t>(n) + (static_cast<size_t>(radius) * 2));
+
+			for (size_t i = 0; i < table.size(); ++i)
+			{
+				table[i] = ResolveImageBorder((static_cast<int32>(i) - radius), n, borderType);
+			}
+
+			return table;
+		}
+
+		/// @brief 分離可能なフィルタのカーネル
+		struct ImageFilterKernel
+		{
+			int32 radiusX = 0;
+
+			int32 radiusY = 0;
+
+			BorderType borderType = BorderType::Reflect_101;
+
+			/// @brief 水平方向の重み。空の場合はボックスフィルタです
+			Array<float> weightsX;
+
+			/// @brief 垂直方向の重み。空の場合はボックスフィルタです
+			Array<float> weightsY;
+
+			[[nodiscard]]
+			bool isBox() const noexcept
+			{
+				return weightsX.isEmpty();
+			}
+
+			[[nodiscard]]
+			static ImageFilterKernel Box(const int32 horizontal, const int32 vertical, const BorderType borderType)
+			{
+				return{ Max(horizontal, 0), Max(vertical, 0), borderType, {}, {} };
+			}
+
+			[[nodiscard]]
+			static ImageFilterKernel Gaussian(const int32 horizontal, const int32 vertical, const BorderType borderType)
+			{
+				return{ Max(horizontal, 0), Max(vertical, 0), borderType, GaussianWeights(horizontal), GaussianWeights(vertical) };
+			}
+
+			/// @brief ガウシアンカーネルの重みを、OpenCV の `getGaussianKernel(size * 2 + 1, 0)` と同じ方法で作成します。
+			[[nodiscard]]
+			static Array<float> GaussianWeights(int32 radius)
+			{
+				radius = Max(radius, 0);
+
+				if (radius == 1)
+				{
+					return{ 0.25f, 0.5f, 0.25f };
+				}
+				else if (radius == 2)
+				{
+					return{ 0.0625f, 0.25f, 0.375f, 0.25f, 0.0625f };
+				}
+				else if (radius == 3)
+				{
+					return{ 0.03125f, 0.109375f, 0.21875f, 0.28125f, 0.21875f, 0.109375f, 0.03125f };
+				}
+
+				const double sigma = ((0.3 * (radius - 1)) + 0.8);
+				const double scale = (-0.5 / (sigma * sigma));
+				Array<double> weights((static_cast<size_t>(radius) * 2) + 1);
+				double sum = 0.0;
+
+				for (int32 i = -radius; i <= radius; ++i)
+				{
+					sum += (weights[i + radius] = std::exp(scale * i * i));
+				}
+
+				return weights.map([=](const double w) { return static_cast<float>(w / sum); });
+			}
+		};
+
+		/// @brief 画像の行 [first, last) にフィルタをかけます。
+		/// @param src 入力の画像の srcFirstRow 行目を指すポインタ。行 [max(0, first - radiusY), min(height, last + radiusY)) を含む必要があります
+		/// @param srcFirstRow src が指している行
+		/// @param width 画像の幅
+		/// @param height 画像の高さ
+		/// @param kernel カーネル
+		/// @param xTable 水平方向のインデックスの変換表
+		/// @param yTable 垂直方向のインデックスの変換表
+		/// @param dst 結果の first 行目を書き込む位置
+		/// @param first 最初の行
+		/// @param last 最後の行の次
+		inline void FilterImageRows(const Color* src, const int32 srcFirstRow, const int32 width, const int32 height, const ImageFilterKernel& kernel,
+			const Array<int32>& xTable, const Array<int32>& yTable, Color* dst, const int32 first, const int32 last)
+		{
+			const int32 rx = kernel.radiusX;
+			const int32 ry = kernel.radiusY;
+			const int32 lo = Max(0, (first - ry));
+			const int32 hi = Min(height, (last + ry));
+			const size_t rowLength = (static_cast<size_t>(width) * 4);
+
+			if (kernel.isBox())
+			{
+				// 水平方向の和（スライディングウィンドウ）
+				Array<uint32> rows(static_cast<size_t>(hi - lo) * rowLength);
+
+				for (int32 y = lo; y < hi; ++y)
+				{
+					const Color* s = (src + static_cast<size_t>(y - srcFirstRow) * width);
+					uint32* out = (rows.data() + static_cast<size_t>(y - lo) * rowLength);
+					uint32 sum[4] = {};
+
+					for (int32 k = 0; k <= (rx * 2); ++k)
+					{
+						const Color c = s[xTable[k]];
+						sum[0] += c.r; sum[1] += c.g; sum[2] += c.b; sum[3] += c.a;
+					}
+
+					for (int32 x = 0; x < width; ++x)
+					{
+						std::memcpy((out + static_cast<size_t>(x) * 4), sum, sizeof(sum));
+
+						if ((x + 1) < width)
+						{
+							const Color add = s[xTable[x + (rx * 2) + 1]];
+							const Color sub = s[xTable[x]];
+							sum[0] += (add.r - sub.r); sum[1] += (add.g - sub.g); sum[2] += (add.b - sub.b); sum[3] += (add.a - sub.a);
+						}
+					}
+				}
+
+				// 垂直方向の和（スライディングウィンドウ）
+				Array<uint64> columns(rowLength, 0);
+
+				for (int32 k = 0; k <= (ry * 2); ++k)
+				{
+					const uint32* row = (rows.data() + static_cast<size_t>(yTable[first + k] - lo) * rowLength);
+
+					for (size_t i = 0; i < rowLength; ++i)
+					{
+						columns[i] += row[i];
+					}
+				}
+
+				const uint64 area = ((static_cast<uint64>(rx) * 2 + 1) * (static_cast<uint64>(ry) * 2 + 1));
+
+				for (int32 y = first; y < last; ++y)
+				{
+					uint8* out = reinterpret_cast<uint8*>(dst + static_cast<size_t>(y - first) * width);
+
+					for (size_t i = 0; i < rowLength; ++i)
+					{
+						out[i] = static_cast<uint8>(((columns[i] * 2) + area) / (area * 2));
+					}
+
+					if ((y + 1) < last)
+					{
+						const uint32* add = (rows.data() + static_cast<size_t>(yTable[y + (ry * 2) + 1] - lo) * rowLength);
+						const uint32* sub = (rows.data() + static_cast<size_t>(yTable[y] - lo) * rowLength);
+
+						for (size_t i = 0; i < rowLength; ++i)
+						{
+							columns[i] += add[i];
+							columns[i] -= sub[i];
+						}
+					}
+				}
+			}
+			else
+			{
+				const float* wx = kernel.weightsX.data();
+				const float* wy = kernel.weightsY.data();
+
+				// 水平方向の畳み込み
+				Array<float> rows(static_cast<size_t>(hi - lo) * rowLength);
+
+				for (int32 y = lo; y < hi; ++y)
+				{
+					const Color* s = (src + static_cast<size_t>(y - srcFirstRow) * width);
+					float* out = (rows.data() + static_cast<size_t>(y - lo) * rowLength);
+
+					for (int32 x = 0; x < width; ++x)
+					{
+						float sum[4] = {};
+
+						for (int32 k = 0; k <= (rx * 2); ++k)
+						{
+							const Color c = s[xTable[x + k]];
+							const float w = wx[k];
+							sum[0] += (w * c.r); sum[1] += (w * c.g); sum[2] += (w * c.b); sum[3] += (w * c.a);
+						}
+
+						std::memcpy((out + static_cast<size_t>(x) * 4), sum, sizeof(sum));
+					}
+				}
+
+				// 垂直方向の畳み込み
+				Array<float> sums(rowLength);
+
+				for (int32 y = first; y < last; ++y)
+				{
+					std::fill(sums.begin(), sums.end(), 0.0f);
+
+					for (int32 k = 0; k <= (ry * 2); ++k)
+					{
+						const float* row = (rows.data() + static_cast<size_t>(yTable[y + k] - lo) * rowLength);
+						const float w = wy[k];
+
+						for (size_t i = 0; i < rowLength; ++i)
+						{
+							sums[i] += (w * row[i]);
+						}
+					}
+
+					uint8* out = reinterpret_cast<uint8*>(dst + static_cast<size_t>(y - first) * width);
+
+					for (size_t i = 0; i < rowLength; ++i)
+					{
+						out[i] = static_cast<uint8>(Min((sums[i] + 0.5f), 255.0f));
+					}
+				}
+			}
+		}
+
+		inline void NegateImagePixels(const Color* src, Color* dst, const size_t count) noexcept
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				dst[i] = ~src[i];
+			}
+		}
+
+		inline void GrayscaleImagePixels(const Color* src, Color* dst, const size_t count) noexcept
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const uint8 gray = src[i].grayscale0_255();
+				dst[i] = Color{ gray, src[i].a };
+			}
+		}
+
+		inline void ThresholdImagePixels(const Color* src, Color* dst, const size_t count, const uint8 threshold, const InvertColor invertColor) noexcept
+		{
+			const uint8 above = (invertColor ? 0 : 255);
+			const uint8 below = static_cast<uint8>(255 - above);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const uint8 value = ((threshold < src[i].grayscale0_255()) ? above : below);
+				dst[i] = Color{ value, src[i].a };
+			}
+		}
+
+		/// @brief 画像の各ピクセルを変換した結果を dst に書き込みます。
+		template <class Fty>
+		inline void TransformImagePixels(const Image& src, Image& dst, Fty f)
+		{
+			const int32 width = src.width();
+			const int32 height = src.height();
+
+			if (&src != &dst)
+			{
+				dst.resize(width, height);
+			}
+
+			const Color* pSrc = src.data();
+			Color* pDst = dst.data();
+
+			ForEachImageBand(width, height, ImageBandRows(width),
+				[=](const int32 first, const int32 last)
+				{
+					const size_t offset = (static_cast<size_t>(first) * width);
+					f((pSrc + offset), (pDst + offset), (static_cast<size_t>(last - first) * width));
+				});
+		}
+
+		inline void FilterImage(const Image& src, Image& dst, const ImageFilterKernel& kernel)
+		{
+			if (&src == &dst)
+			{
+				Image result;
+				FilterImage(src, result, kernel);
+				dst.swap(result);
+				return;
+			}
+
+			const int32 width = src.width();
+			const int32 height = src.height();
+			dst.resize(width, height);
+
+			if (src.isEmpty())
+			{
+				return;
+			}
+
+			const Array<int32> xTable = MakeImageBorderTable(width, kernel.radiusX, kernel.borderType);
+			const Array<int32> yTable = MakeImageBorderTable(height, kernel.radiusY, kernel.borderType);
+
+			ForEachImageBand(width, height, ImageBandRows(width, (kernel.radiusY * 4)),
+				[&](const int32 first, const int32 last)
+				{
+					FilterImageRows(src.data(), 0, width, height, kernel, xTable, yTable, dst[first], first, last);
+				});
+		}
+
+		/// @brief 拡大縮小で、出力の 1 つの座標が参照する入力の範囲と重み
+		struct ImageScaleTaps
+		{
+			/// @brief `offsets[i]` から `offsets[i + 1]` までが、出力の座標 i の要素です
+			Array<uint32> offsets;
+
+			Array<int32> indices;
+
+			Array<float> weights;
+		};
+
+		[[nodiscard]]
+		inline ImageScaleTaps MakeImageScaleTaps(const int32 srcLength, const int32 dstLength, const InterpolationAlgorithm interpolation)
+		{
+			const double scale = (static_cast<double>(srcLength) / dstLength);
+			ImageScaleTaps taps;
+			taps.offsets.reserve(static_cast<size_t>(dstLength) + 1);
+			taps.offsets << 0;
+
+			for (int32 i = 0; i < dstLength; ++i)
+			{
+				if (interpolation == InterpolationAlgorithm::Nearest)
+				{
+					taps.indices << Min(static_cast<int32>(i * scale), (srcLength - 1));
+					taps.weights << 1.0f;
+				}
+				else if (interpolation == InterpolationAlgorithm::Linear)
+				{
+					const double x = (((i + 0.5) * scale) - 0.5);
+					int32 x0 = static_cast<int32>(std::floor(x));
+					double t = (x - x0);
+
+					if (x0 < 0)
+					{
+						x0 = 0;
+						t = 0.0;
+					}
+					else if ((srcLength - 1) <= x0)
+					{
+						x0 = (srcLength - 1);
+						t = 0.0;
+					}
+
+					taps.indices << x0 << Min((x0 + 1), (srcLength - 1));
+					taps.weights << static_cast<float>(1.0 - t) << static_cast<float>(t);
+				}
+				else // Area
+				{
+					const double begin = (i * scale);
+					const double end = Min(((i + 1) * scale), static_cast<double>(srcLength));
+
+					for (int32 k = static_cast<int32>(begin); k < end; ++k)
+					{
+						const double coverage = (Min(end, (k + 1.0)) - Max(begin, static_cast<double>(k)));
+
+						if (0.0 < coverage)
+						{
+							taps.indices << k;
+							taps.weights << static_cast<float>(coverage / scale);
+						}
+					}
+				}
+
+				taps.offsets << static_cast<uint32>(taps.indices.size());
+			}
+
+			return taps;
+		}
+	}
+
 	namespace ImageProcessing
 	{
 		inline constexpr size_t CalculateMipCount(size_t width, size_t height) noexcept
@@ -28,5 +471,238 @@ namespace s3d
 
 			return numLevels;
 		}
+
+		inline void Negate(const Image& src, Image& dst)
+		{
+			detail::TransformImagePixels(src, dst, detail::NegateImagePixels);
+		}
+
+		inline void Grayscale(const Image& src, Image& dst)
+		{
+			detail::TransformImagePixels(src, dst, detail::GrayscaleImagePixels);
+		}
+
+		inline void Threshold(const Image& src, Image& dst, const uint8 threshold, const InvertColor invertColor)
+		{
+			detail::TransformImagePixels(src, dst,
+				[=](const Color* pSrc, Color* pDst, const size_t count)
+				{
+					detail::ThresholdImagePixels(pSrc, pDst, count, threshold, invertColor);
+				});
+		}
+
+		inline void Mosaic(const Image& src, Image& dst, const int32 size)
+		{
+			Mosaic(src, dst, size, size);
+		}
+
+		inline void Mosaic(const Image& src, Image& dst, int32 horizontal, int32 vertical)
+		{
+			const int32 width = src.width();
+			const int32 height = src.height();
+			horizontal = Max(horizontal, 1);
+			vertical = Max(vertical, 1);
+
+			if (&src != &dst)
+			{
+				dst.resize(width, height);
+			}
+
+			// 帯の境界をブロックの境界にそろえる
+			const int32 bandRows = (((detail::ImageBandRows(width) + vertical - 1) / vertical) * vertical);
+
+			detail::ForEachImageBand(width, height, bandRows,
+				[&](const int32 first, const int32 last)
+				{
+					for (int32 y0 = first; y0 < last; y0 += vertical)
+					{
+						const int32 y1 = Min((y0 + vertical), last);
+
+						for (int32 x0 = 0; x0 < width; x0 += horizontal)
+						{
+							const int32 x1 = Min((x0 + horizontal), width);
+							uint32 sum[4] = {};
+
+							for (int32 y = y0; y < y1; ++y)
+							{
+								const Color* s = src[y];
+
+								for (int32 x = x0; x < x1; ++x)
+								{
+									sum[0] += s[x].r; sum[1] += s[x].g; sum[2] += s[x].b; sum[3] += s[x].a;
+								}
+							}
+
+							const uint32 count = static_cast<uint32>((x1 - x0) * (y1 - y0));
+							const Color average{ static_cast<uint8>(sum[0] / count), static_cast<uint8>(sum[1] / count),
+								static_cast<uint8>(sum[2] / count), static_cast<uint8>(sum[3] / count) };
+
+							for (int32 y = y0; y < y1; ++y)
+							{
+								std::fill((dst[y] + x0), (dst[y] + x1), average);
+							}
+						}
+					}
+				});
+		}
+
+		inline void Rotate90(const Image& src, Image& dst, const int32 n)
+		{
+			if (&src == &dst)
+			{
+				Image result;
+				Rotate90(src, result, n);
+				dst.swap(result);
+				return;
+			}
+
+			const int32 width = src.width();
+			const int32 height = src.height();
+			const int32 turns = (((n % 4) + 4) % 4);
+
+			if ((turns % 2) == 0)
+			{
+				dst.resize(width, height);
+			}
+			else
+			{
+				dst.resize(height, width);
+			}
+
+			if (turns == 0)
+			{
+				std::memcpy(dst.data(), src.data(), src.size_bytes());
+				return;
+			}
+
+			const int32 dstWidth = dst.width();
+			const int32 dstHeight = dst.height();
+
+			detail::ForEachGridTile(static_cast<size_t>(dstWidth), static_cast<size_t>(dstHeight), detail::ImageRotateTileSize, detail::ImageRotateTileSize,
+				[&](const size_t x0, const size_t y0, const size_t x1, const size_t y1)
+				{
+					for (size_t y = y0; y < y1; ++y)
+					{
+						Color* d = dst[y];
+
+						for (size_t x = x0; x < x1; ++x)
+						{
+							if (turns == 1)
+							{
+								d[x] = src[height - 1 - x][y];
+							}
+							else if (turns == 2)
+							{
+								d[x] = src[height - 1 - y][width - 1 - x];
+							}
+							else
+							{
+								d[x] = src[x][width - 1 - y];
+							}
+						}
+					}
+				});
+		}
+
+		inline void Blur(const Image& src, Image& dst, const int32 size, const BorderType borderType)
+		{
+			Blur(src, dst, size, size, borderType);
+		}
+
+		inline void Blur(const Image& src, Image& dst, const int32 horizontal, const int32 vertical, const BorderType borderType)
+		{
+			detail::FilterImage(src, dst, detail::ImageFilterKernel::Box(horizontal, vertical, borderType));
+		}
+
+		inline void GaussianBlur(const Image& src, Image& dst, const int32 size, const BorderType borderType)
+		{
+			GaussianBlur(src, dst, size, size, borderType);
+		}
+
+		inline void GaussianBlur(const Image& src, Image& dst, const int32 horizontal, const int32 vertical, const BorderType borderType)
+		{
+			detail::FilterImage(src, dst, detail::ImageFilterKernel::Gaussian(horizontal, vertical, borderType));
+		}
+
+		inline void Scale(const Image& src, Image& dst, const int32 width, const int32 height, const InterpolationAlgorithm interpolation)
+		{
+			Scale(src, dst, Size{ width, height }, interpolation);
+		}
+
+		inline void Scale(const Image& src, Image& dst, const Size& size, InterpolationAlgorithm interpolation)
+		{
+			if ((size.x <= 0) || (size.y <= 0) || src.isEmpty())
+			{
+				dst.clear();
+				return;
+			}
+
+			const bool shrink = ((size.x <= src.width()) && (size.y <= src.height()));
+
+			if (interpolation == InterpolationAlgorithm::Auto)
+			{
+				interpolation = (shrink ? InterpolationAlgorithm::Area : InterpolationAlgorithm::Cubic);
+			}
+			else if ((interpolation == InterpolationAlgorithm::Area) && (not shrink))
+			{
+				interpolation = InterpolationAlgorithm::Linear;
+			}
+
+			if ((interpolation == InterpolationAlgorithm::Cubic) || (interpolation == InterpolationAlgorithm::Lanczos))
+			{
+				dst = src.scaled(size, interpolation);
+				return;
+			}
+
+			if (&src == &dst)
+			{
+				Image result;
+				Scale(src, result, size, interpolation);
+				dst.swap(result);
+				return;
+			}
+
+			dst.resize(size);
+
+			const detail::ImageScaleTaps xTaps = detail::MakeImageScaleTaps(src.width(), size.x, interpolation);
+			const detail::ImageScaleTaps yTaps = detail::MakeImageScaleTaps(src.height(), size.y, interpolation);
+			const size_t rowLength = (static_cast<size_t>(size.x) * 4);
+
+			detail::ForEachImageBand(size.x, size.y, detail::ImageBandRows(size.x),
+				[&](const int32 first, const int32 last)
+				{
+					Array<float> sums(rowLength);
+
+					for (int32 y = first; y < last; ++y)
+					{
+						std::fill(sums.begin(), sums.end(), 0.0f);
+
+						for (uint32 ty = yTaps.offsets[y]; ty < yTaps.offsets[y + 1]; ++ty)
+						{
+							const Color* s = src[yTaps.indices[ty]];
+							const float wy = yTaps.weights[ty];
+
+							for (int32 x = 0; x < size.x; ++x)
+							{
+								float* sum = (sums.data() + static_cast<size_t>(x) * 4);
+
+								for (uint32 tx = xTaps.offsets[x]; tx < xTaps.offsets[x + 1]; ++tx)
+								{
+									const Color c = s[xTaps.indices[tx]];
+									const float w = (wy * xTaps.weights[tx]);
+									sum[0] += (w * c.r); sum[1] += (w * c.g); sum[2] += (w * c.b); sum[3] += (w * c.a);
+								}
+							}
+						}
+
+						uint8* out = reinterpret_cast<uint8*>(dst[y]);
+
+						for (size_t i = 0; i < rowLength; ++i)
+						{
+							out[i] = static_cast<uint8>(Min((sums[i] + 0.5f), 255.0f));
+						}
+					}
+				});
+		}
 	}
 }
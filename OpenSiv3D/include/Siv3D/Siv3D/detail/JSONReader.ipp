@@ -0,0 +1,874 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <charconv>
+# include <cstdlib>
+# include <cstring>
+
+namespace s3d
+{
+	namespace detail
+	{
+		inline void AppendUTF8(std::string& s, const char32 ch)
+		{
+			if (ch < 0x80)
+			{
+				s.push_back(static_cast<char>(ch));
+			}
+			else if (ch < 0x800)
+			{
+				s.push_back(static_cast<char>(0xC0 | (ch >> 6)));
+				s.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+			}
+			else if (ch < 0x10000)
+			{
+				s.push_back(static_cast<char>(0xE0 | (ch >> 12)));
+				s.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+				s.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+			}
+			else
+			{
+				s.push_back(static_cast<char>(0xF0 | (ch >> 18)));
+				s.push_back(static_cast<char>(0x80 | ((ch >> 12) & 0x3F)));
+				s.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+				s.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+			}
+		}
+
+		[[nodiscard]]
+		inline bool ParseJSONHex4(const std::string_view s, const size_t pos, char32& ch) noexcept
+		{
+			if (s.size() < (pos + 4))
+			{
+				return false;
+			}
+
+			uint32 value;
+			const auto [ptr, ec] = std::from_chars((s.data() + pos), (s.data() + pos + 4), value, 16);
+
+			if ((ec != std::errc{}) || (ptr != (s.data() + pos + 4)))
+			{
+				return false;
+			}
+
+			ch = static_cast<char32>(value);
+			return true;
+		}
+
+		/// @brief JSON の文字列のエスケープシーケンスを処理します。
+		[[nodiscard]]
+		inline std::string UnescapeJSONString(const std::string_view s)
+		{
+			std::string result;
+			result.reserve(s.size());
+
+			for (size_t i = 0; i < s.size(); ++i)
+			{
+				if ((s[i] != '\\') || ((i + 1) == s.size()))
+				{
+					result.push_back(s[i]);
+					continue;
+				}
+
+				switch (const char ch = s[++i])
+				{
+				case 'b':
+					result.push_back('\b');
+					break;
+				case 'f':
+					result.push_back('\f');
+					break;
+				case 'n':
+					result.push_back('\n');
+					break;
+				case 'r':
+					result.push_back('\r');
+					break;
+				case 't':
+					result.push_back('\t');
+					break;
+				case 'u':
+					{
+						char32 code;
+
+						if (not ParseJSONHex4(s, (i + 1), code))
+						{
+							result.push_back(ch);
+							break;
+						}
+
+						i += 4;
+
+						// サロゲートペア
+						if ((0xD800 <= code) && (code < 0xDC00)
+							&& ((i + 2) < s.size()) && (s[i + 1] == '\\') && (s[i + 2] == 'u'))
+						{
+							if (char32 low; ParseJSONHex4(s, (i + 3), low) && (0xDC00 <= low) && (low < 0xE000))
+							{
+								code = (0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00));
+								i += 6;
+							}
+						}
+
+						AppendUTF8(result, code);
+						break;
+					}
+				default:
+					result.push_back(ch);
+					break;
+				}
+			}
+
+			return result;
+		}
+	}
+
+	inline JSONReader::JSONReader(const FilePathView path)
+	{
+		open(path);
+	}
+
+	inline JSONReader::JSONReader(Blob&& blob)
+	{
+		open(std::move(blob));
+	}
+
+	inline JSONReader::JSONReader(const std::string_view utf8)
+	{
+		open(utf8);
+	}
+
+	inline bool JSONReader::open(const FilePathView path)
+	{
+		close();
+
+		if (not m_file.open(path, MapAll::Yes))
+		{
+			return false;
+		}
+
+		setData(reinterpret_cast<const char*>(m_file.data()), m_file.mappedSize());
+		return true;
+	}
+
+	inline void JSONReader::open(Blob&& blob)
+	{
+		close();
+
+		m_blob = std::move(blob);
+		setData(reinterpret_cast<const char*>(m_blob.data()), m_blob.size());
+	}
+
+	inline void JSONReader::open(const std::string_view utf8)
+	{
+		close();
+
+		setData(utf8.data(), utf8.size());
+	}
+
+	inline void JSONReader::close()
+	{
+		m_file.close();
+		m_blob.release();
+		m_data = nullptr;
+		m_size = 0;
+		m_begin = 0;
+		reset();
+	}
+
+	inline bool JSONReader::isOpen() const noexcept
+	{
+		return (m_data != nullptr);
+	}
+
+	inline JSONReader::operator bool() const noexcept
+	{
+		return isOpen();
+	}
+
+	inline void JSONReader::reset()
+	{
+		m_pos = m_begin;
+		m_tokenBegin = m_begin;
+		m_raw = {};
+		m_stack.clear();
+		m_type = JSONTokenType::None;
+		m_escaped = false;
+		m_started = false;
+	}
+
+	inline JSONTokenType JSONReader::nextToken()
+	{
+		if (not m_data)
+		{
+			return (m_type = JSONTokenType::End);
+		}
+
+		if ((m_type == JSONTokenType::End) || (m_type == JSONTokenType::Error))
+		{
+			return m_type;
+		}
+
+		skipWhitespace();
+		m_tokenBegin = m_pos;
+		m_raw = {};
+		m_escaped = false;
+
+		if (m_stack.isEmpty())
+		{
+			if (m_started)
+			{
+				return ((m_pos == m_size) ? (m_type = JSONTokenType::End) : setError());
+			}
+
+			m_started = true;
+			return readValue();
+		}
+
+		if (m_size <= m_pos)
+		{
+			return setError();
+		}
+
+		Frame& frame = m_stack.back();
+
+		if (frame.isObject)
+		{
+			if (frame.afterKey)
+			{
+				frame.afterKey = false;
+				return readValue();
+			}
+
+			if (m_data[m_pos] == '}')
+			{
+				m_stack.pop_back();
+				m_raw = std::string_view{ (m_data + m_pos++), 1 };
+				return (m_type = JSONTokenType::EndObject);
+			}
+
+			if (frame.count != 0)
+			{
+				if (m_data[m_pos] != ',')
+				{
+					return setError();
+				}
+
+				++m_pos;
+				skipWhitespace();
+				m_tokenBegin = m_pos;
+			}
+
+			if ((m_size <= m_pos) || (m_data[m_pos] != '\"') || (not readString()))
+			{
+				return setError();
+			}
+
+			frame.key = m_raw;
+			frame.keyEscaped = m_escaped;
+			++frame.count;
+
+			skipWhitespace();
+
+			if ((m_size <= m_pos) || (m_data[m_pos] != ':'))
+			{
+				return setError();
+			}
+
+			++m_pos;
+			frame.afterKey = true;
+			return (m_type = JSONTokenType::Key);
+		}
+		else
+		{
+			if (m_data[m_pos] == ']')
+			{
+				m_stack.pop_back();
+				m_raw = std::string_view{ (m_data + m_pos++), 1 };
+				return (m_type = JSONTokenType::EndArray);
+			}
+
+			if (frame.count != 0)
+			{
+				if (m_data[m_pos] != ',')
+				{
+					return setError();
+				}
+
+				++m_pos;
+				skipWhitespace();
+				m_tokenBegin = m_pos;
+			}
+
+			++frame.count;
+			return readValue();
+		}
+	}
+
+	inline JSONTokenType JSONReader::tokenType() const noexcept
+	{
+		return m_type;
+	}
+
+	inline bool JSONReader::skipValue()
+	{
+		switch (m_type)
+		{
+		case JSONTokenType::BeginObject:
+		case JSONTokenType::BeginArray:
+			return skipToDepth(m_stack.size() - 1);
+		case JSONTokenType::Key:
+			{
+				const JSONTokenType type = nextToken();
+
+				if ((type == JSONTokenType::BeginObject) || (type == JSONTokenType::BeginArray))
+				{
+					return skipToDepth(m_stack.size() - 1);
+				}
+
+				return (type != JSONTokenType::Error);
+			}
+		default:
+			return (m_type != JSONTokenType::Error);
+		}
+	}
+
+	inline size_t JSONReader::depth() const noexcept
+	{
+		return pathLength();
+	}
+
+	inline String JSONReader::path() const
+	{
+		String result;
+
+		for (size_t i = 0; i < pathLength(); ++i)
+		{
+			const Frame& frame = m_stack[i];
+			result.push_back(U'/');
+
+			if (frame.isObject)
+			{
+				const String key = Unicode::FromUTF8(frame.keyEscaped ? std::string_view{ detail::UnescapeJSONString(frame.key) } : frame.key);
+				result.append(key.replaced(U"~", U"~0").replaced(U"/", U"~1"));
+			}
+			else
+			{
+				result.append(Format(frame.count - 1));
+			}
+		}
+
+		return result;
+	}
+
+	inline std::string_view JSONReader::raw() const noexcept
+	{
+		return m_raw;
+	}
+
+	inline bool JSONReader::hasEscape() const noexcept
+	{
+		return m_escaped;
+	}
+
+	inline std::string JSONReader::getUTF8() const
+	{
+		if (m_escaped)
+		{
+			return detail::UnescapeJSONString(m_raw);
+		}
+
+		return std::string{ m_raw };
+	}
+
+	inline String JSONReader::getString() const
+	{
+		if (m_escaped)
+		{
+			return Unicode::FromUTF8(detail::UnescapeJSONString(m_raw));
+		}
+
+		return Unicode::FromUTF8(m_raw);
+	}
+
+	inline Optional<int64> JSONReader::getInt64() const
+	{
+		if ((m_type != JSONTokenType::Number) || m_raw.empty())
+		{
+			return none;
+		}
+
+		int64 value;
+		const char* last = (m_raw.data() + m_raw.size());
+		const auto [ptr, ec] = std::from_chars(m_raw.data(), last, value);
+
+		if ((ec != std::errc{}) || (ptr != last))
+		{
+			return none;
+		}
+
+		return value;
+	}
+
+	inline Optional<double> JSONReader::getDouble() const
+	{
+		if ((m_type != JSONTokenType::Number) || m_raw.empty())
+		{
+			return none;
+		}
+
+		double value;
+
+	# if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+
+		const char* last = (m_raw.data() + m_raw.size());
+		const auto [ptr, ec] = std::from_chars(m_raw.data(), last, value);
+
+		if ((ec != std::errc{}) || (ptr != last))
+		{
+			return none;
+		}
+
+	# else
+
+		const std::string s{ m_raw };
+		char* end = nullptr;
+		value = std::strtod(s.c_str(), &end);
+
+		if (end != (s.c_str() + s.size()))
+		{
+			return none;
+		}
+
+	# endif
+
+		return value;
+	}
+
+	inline Optional<bool> JSONReader::getBool() const
+	{
+		if (m_type != JSONTokenType::Bool)
+		{
+			return none;
+		}
+
+		return (m_raw.front() == 't');
+	}
+
+	template <class Type>
+	inline Optional<Type> JSONReader::getOpt() const
+	{
+		if constexpr (std::is_same_v<Type, String>)
+		{
+			if ((m_type != JSONTokenType::String) && (m_type != JSONTokenType::Key))
+			{
+				return none;
+			}
+
+			return getString();
+		}
+		else if constexpr (std::is_same_v<Type, std::string>)
+		{
+			if ((m_type != JSONTokenType::String) && (m_type != JSONTokenType::Key))
+			{
+				return none;
+			}
+
+			return getUTF8();
+		}
+		else if constexpr (std::is_same_v<Type, bool>)
+		{
+			return getBool();
+		}
+		else if constexpr (std::is_integral_v<Type>)
+		{
+			if (const auto value = getInt64())
+			{
+				return static_cast<Type>(*value);
+			}
+
+			return none;
+		}
+		else if constexpr (std::is_floating_point_v<Type>)
+		{
+			if (const auto value = getDouble())
+			{
+				return static_cast<Type>(*value);
+			}
+
+			return none;
+		}
+		else
+		{
+			return ParseOpt<Type>(getString());
+		}
+	}
+
+	inline JSON JSONReader::readJSON()
+	{
+		if (not isValueToken())
+		{
+			return JSON::Invalid();
+		}
+
+		const size_t first = m_tokenBegin;
+
+		if ((m_type == JSONTokenType::BeginObject) || (m_type == JSONTokenType::BeginArray))
+		{
+			if (not skipValue())
+			{
+				return JSON::Invalid();
+			}
+		}
+
+		return JSON::Load(MemoryViewReader{ (m_data + first), (m_pos - first) });
+	}
+
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, JSONReader&>>*>
+	inline size_t JSONReader::extract(const StringView pathPattern, Fty f)
+	{
+		Array<std::string> pattern;
+
+		if (not pathPattern.isEmpty())
+		{
+			const std::string utf8 = Unicode::ToUTF8(pathPattern);
+			size_t pos = ((utf8.front() == '/') ? 1 : 0);
+
+			for (;;)
+			{
+				const size_t next = utf8.find('/', pos);
+				std::string segment = utf8.substr(pos, (next - pos));
+
+				for (size_t i = 0; (i = segment.find('~', i)) != std::string::npos; ++i)
+				{
+					if ((i + 1) < segment.size())
+					{
+						segment.replace(i, 2, ((segment[i + 1] == '1') ? "/" : "~"));
+					}
+				}
+
+				pattern.push_back(std::move(segment));
+
+				if (next == std::string::npos)
+				{
+					break;
+				}
+
+				pos = (next + 1);
+			}
+		}
+
+		size_t count = 0;
+
+		for (;;)
+		{
+			const JSONTokenType type = nextToken();
+
+			if ((type == JSONTokenType::End) || (type == JSONTokenType::Error))
+			{
+				break;
+			}
+
+			if (not isValueToken())
+			{
+				continue;
+			}
+
+			const size_t length = pathLength();
+			const bool isContainer = ((type == JSONTokenType::BeginObject) || (type == JSONTokenType::BeginArray));
+
+			if (not matchPrefix(pattern, Min(length, pattern.size())))
+			{
+				if (isContainer && (not skipValue()))
+				{
+					break;
+				}
+
+				continue;
+			}
+
+			if (length < pattern.size())
+			{
+				continue;
+			}
+
+			const size_t parentDepth = (isContainer ? (m_stack.size() - 1) : m_stack.size());
+
+			++count;
+			f(*this);
+
+			if (isContainer && (parentDepth < m_stack.size()) && (not skipToDepth(parentDepth)))
+			{
+				break;
+			}
+		}
+
+		return count;
+	}
+
+	inline void JSONReader::setData(const char* data, const size_t size)
+	{
+		m_data = data;
+		m_size = size;
+
+		// UTF-8 BOM
+		m_begin = (((3 <= size) && (std::memcmp(data, "\xEF\xBB\xBF", 3) == 0)) ? 3 : 0);
+
+		reset();
+	}
+
+	inline void JSONReader::skipWhitespace() noexcept
+	{
+		while (m_pos < m_size)
+		{
+			const char ch = m_data[m_pos];
+
+			if ((ch != ' ') && (ch != '\n') && (ch != '\r') && (ch != '\t'))
+			{
+				break;
+			}
+
+			++m_pos;
+		}
+	}
+
+	inline JSONTokenType JSONReader::setError() noexcept
+	{
+		m_raw = {};
+		return (m_type = JSONTokenType::Error);
+	}
+
+	inline JSONTokenType JSONReader::readValue()
+	{
+		if (m_size <= m_pos)
+		{
+			return setError();
+		}
+
+		const char* p = (m_data + m_pos);
+		const size_t rest = (m_size - m_pos);
+
+		switch (*p)
+		{
+		case '{':
+			{
+				Frame frame;
+				frame.isObject = true;
+				m_stack.push_back(frame);
+				m_raw = std::string_view{ p, 1 };
+				++m_pos;
+				return (m_type = JSONTokenType::BeginObject);
+			}
+		case '[':
+			{
+				m_stack.push_back(Frame{});
+				m_raw = std::string_view{ p, 1 };
+				++m_pos;
+				return (m_type = JSONTokenType::BeginArray);
+			}
+		case '\"':
+			return (readString() ? (m_type = JSONTokenType::String) : setError());
+		case 't':
+		case 'n':
+			{
+				if ((rest < 4) || ((std::memcmp(p, "true", 4) != 0) && (std::memcmp(p, "null", 4) != 0)))
+				{
+					return setError();
+				}
+
+				m_raw = std::string_view{ p, 4 };
+				m_pos += 4;
+				return (m_type = ((*p == 't') ? JSONTokenType::Bool : JSONTokenType::Null));
+			}
+		case 'f':
+			{
+				if ((rest < 5) || (std::memcmp(p, "false", 5) != 0))
+				{
+					return setError();
+				}
+
+				m_raw = std::string_view{ p, 5 };
+				m_pos += 5;
+				return (m_type = JSONTokenType::Bool);
+			}
+		default:
+			{
+				if ((*p != '-') && ((*p < '0') || ('9' < *p)))
+				{
+					return setError();
+				}
+
+				size_t length = 1;
+
+				while (length < rest)
+				{
+					const char ch = p[length];
+
+					if ((('0' <= ch) && (ch <= '9')) || (ch == '.') || (ch == 'e') || (ch == 'E') || (ch == '+') || (ch == '-'))
+					{
+						++length;
+						continue;
+					}
+
+					break;
+				}
+
+				m_raw = std::string_view{ p, length };
+				m_pos += length;
+				return (m_type = JSONTokenType::Number);
+			}
+		}
+	}
+
+	inline bool JSONReader::readString() noexcept
+	{
+		const size_t first = ++m_pos;
+
+		while (m_pos < m_size)
+		{
+			const char ch = m_data[m_pos];
+
+			if (ch == '\"')
+			{
+				m_raw = std::string_view{ (m_data + first), (m_pos - first) };
+				++m_pos;
+				return true;
+			}
+
+			if (ch == '\\')
+			{
+				m_escaped = true;
+				m_pos += 2;
+				continue;
+			}
+
+			++m_pos;
+		}
+
+		return false;
+	}
+
+	inline bool JSONReader::isValueToken() const noexcept
+	{
+		switch (m_type)
+		{
+		case JSONTokenType::BeginObject:
+		case JSONTokenType::BeginArray:
+		case JSONTokenType::String:
+		case JSONTokenType::Number:
+		case JSONTokenType::Bool:
+		case JSONTokenType::Null:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	inline size_t JSONReader::pathLength() const noexcept
+	{
+		if ((m_type == JSONTokenType::BeginObject) || (m_type == JSONTokenType::BeginArray))
+		{
+			return (m_stack.size() - 1);
+		}
+
+		return m_stack.size();
+	}
+
+	inline bool JSONReader::matchPrefix(const Array<std::string>& pattern, const size_t length) const
+	{
+		for (size_t i = 0; i < length; ++i)
+		{
+			const std::string& segment = pattern[i];
+
+			if (segment == "*")
+			{
+				continue;
+			}
+
+			const Frame& frame = m_stack[i];
+
+			if (frame.isObject)
+			{
+				if (frame.keyEscaped ? (detail::UnescapeJSONString(frame.key) != segment) : (frame.key != segment))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				char buffer[24];
+				const auto [ptr, ec] = std::to_chars(std::begin(buffer), std::end(buffer), (frame.count - 1));
+
+				if (std::string_view{ buffer, static_cast<size_t>(ptr - buffer) } != segment)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	inline bool JSONReader::skipToDepth(const size_t depth)
+	{
+		size_t level = (m_stack.size() - depth);
+
+		while (m_pos < m_size)
+		{
+			const char ch = m_data[m_pos++];
+
+			if (ch == '\"')
+			{
+				while (m_pos < m_size)
+				{
+					const char c = m_data[m_pos++];
+
+					if (c == '\\')
+					{
+						++m_pos;
+					}
+					else if (c == '\"')
+					{
+						break;
+					}
+				}
+			}
+			else if ((ch == '{') || (ch == '['))
+			{
+				++level;
+			}
+			else if ((ch == '}') || (ch == ']'))
+			{
+				if (--level == 0)
+				{
+					const bool isObject = (ch == '}');
+
+					if (m_stack[depth].isObject != isObject)
+					{
+						setError();
+						return false;
+					}
+
+					m_stack.resize(depth);
+					m_tokenBegin = (m_pos - 1);
+					m_raw = std::string_view{ (m_data + m_tokenBegin), 1 };
+					m_escaped = false;
+					m_type = (isObject ? JSONTokenType::EndObject : JSONTokenType::EndArray);
+					return true;
+				}
+			}
+		}
+
+		setError();
+		return false;
+	}
+}
@@ -96,6 +96,26 @@ namespace s3d
 				return m_radius;
 			}
 		};
+
+		/// @brief バッチ検索で 1 つのタスクが受け持つクエリ数の目安
+		inline constexpr size_t KDTreeBatchGrain = 32;
+
+		template <class Fty>
+		inline void ForEachKDTreeQuery(const size_t count, Fty f)
+		{
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			parallel_for(0, count, KDTreeBatchGrain, f);
+
+		# else
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				f(i);
+			}
+
+		# endif
+		}
 	}
 
 	template <class DatasetAdapter>
@@ -204,4 +224,26 @@ namespace s3d
 			m_index.radiusSearchCustomCallback(adapter_type::GetPointer(point), resultSet, searchParams);
 		}
 	}
+
+	template <class DatasetAdapter>
+	inline void KDTree<DatasetAdapter>::knnSearchBatch(Array<Array<size_t>>& results, const size_t k, const Array<point_type>& points) const
+	{
+		results.resize(points.size());
+
+		detail::ForEachKDTreeQuery(points.size(), [&](const size_t i)
+		{
+			knnSearch(results[i], k, points[i]);
+		});
+	}
+
+	template <class DatasetAdapter>
+	inline void KDTree<DatasetAdapter>::radiusSearchBatch(Array<Array<size_t>>& results, const Array<point_type>& points, const element_type radius, const SortByDistance sortByDistance) const
+	{
+		results.resize(points.size());
+
+		detail::ForEachKDTreeQuery(points.size(), [&](const size_t i)
+		{
+			radiusSearch(results[i], points[i], radius, sortByDistance);
+		});
+	}
 }
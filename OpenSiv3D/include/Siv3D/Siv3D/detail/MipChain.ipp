@@ -0,0 +1,429 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief Kaiser フィルタの半径（出力のピクセル単位）
+		inline constexpr double MipKaiserRadius = 2.0;
+
+		/// @brief Kaiser 窓関数の形状パラメータ
+		inline constexpr double MipKaiserBeta = 4.0;
+
+		/// @brief 第 1 種変形ベッセル関数 I0 を返します。
+		[[nodiscard]]
+		inline double BesselI0(const double x) noexcept
+		{
+			double sum = 1.0;
+			double term = 1.0;
+
+			for (int32 k = 1; k < 64; ++k)
+			{
+				const double t = (x / (2.0 * k));
+				term *= (t * t);
+				sum += term;
+
+				if (term < (sum * 1e-12))
+				{
+					break;
+				}
+			}
+
+			return sum;
+		}
+
+		[[nodiscard]]
+		inline ImageScaleTaps MakeMipKaiserTaps(const int32 srcLength, const int32 dstLength)
+		{
+			const double scale = (static_cast<double>(srcLength) / dstLength);
+			const double radius = (MipKaiserRadius * scale);
+			const double i0Beta = BesselI0(MipKaiserBeta);
+
+			ImageScaleTaps taps;
+			taps.offsets.reserve(static_cast<size_t>(dstLength) + 1);
+			taps.offsets << 0;
+
+			for (int32 i = 0; i < dstLength; ++i)
+			{
+				const double center = (((i + 0.5) * scale) - 0.5);
+				const size_t begin = taps.weights.size();
+				double sum = 0.0;
+
+				for (int32 k = static_cast<int32>(std::ceil(center - radius)); k <= static_cast<int32>(std::floor(center + radius)); ++k)
+				{
+					const double x = (k - center);
+					const double t = (x / radius);
+
+					if (1.0 <= (t * t))
+					{
+						continue;
+					}
+
+					const double s = (x / scale);
+					const double sinc = ((s == 0.0) ? 1.0 : (std::sin(Math::Pi * s) / (Math::Pi * s)));
+					const double w = (sinc * BesselI0(MipKaiserBeta * std::sqrt(1.0 - t * t)) / i0Beta);
+
+					taps.indices << Clamp(k, 0, (srcLength - 1));
+					taps.weights << static_cast<float>(w);
+					sum += w;
+				}
+
+				for (size_t k = begin; k < taps.weights.size(); ++k)
+				{
+					taps.weights[k] = static_cast<float>(taps.weights[k] / sum);
+				}
+
+				taps.offsets << static_cast<uint32>(taps.indices.size());
+			}
+
+			return taps;
+		}
+
+		struct SRGBTables
+		{
+			/// @brief sRGB の 8-bit 値から線形の値への変換表
+			std::array<float, 256> toLinear;
+
+			/// @brief `thresholds[i]` は sRGB の値 (i + 0.5) / 255 に対応する線形の値
+			std::array<float, 255> thresholds;
+		};
+
+		[[nodiscard]]
+		inline double SRGBToLinear(const double c) noexcept
+		{
+			return ((c <= 0.04045) ? (c / 12.92) : std::pow(((c + 0.055) / 1.055), 2.4));
+		}
+
+		[[nodiscard]]
+		inline const SRGBTables& GetSRGBTables()
+		{
+			static const SRGBTables tables = []()
+			{
+				SRGBTables result;
+
+				for (size_t i = 0; i < result.toLinear.size(); ++i)
+				{
+					result.toLinear[i] = static_cast<float>(SRGBToLinear(i / 255.0));
+				}
+
+				for (size_t i = 0; i < result.thresholds.size(); ++i)
+				{
+					result.thresholds[i] = static_cast<float>(SRGBToLinear((i + 0.5) / 255.0));
+				}
+
+				return result;
+			}();
+
+			return tables;
+		}
+
+		/// @brief 線形の値を、sRGB の 8-bit 値に変換します。sRGB の空間で最も近い値に丸められます。
+		[[nodiscard]]
+		inline uint8 LinearToSRGB8(const float value, const SRGBTables& tables) noexcept
+		{
+			return static_cast<uint8>(std::upper_bound(tables.thresholds.begin(), tables.thresholds.end(), value) - tables.thresholds.begin());
+		}
+
+		/// @brief 2 行の 2x2 ピクセルを平均して 1 行を作成します。
+		inline void DownsampleMipRow2x2(const Color* row0, const Color* row1, Color* dst, const int32 width) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i two = _mm_set1_epi16(2);
+			int32 x = 0;
+
+			for (; (x + 2) <= width; x += 2)
+			{
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + (x * 2)));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + (x * 2)));
+
+				// 縦の和 [p0, p1], [p2, p3]
+				const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+				const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+				// 横の和 [p0 + p1, p2 + p3]
+				__m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+				sum = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(sum, sum));
+			}
+
+			for (; x < width; ++x)
+			{
+				const Color p0 = row0[x * 2], p1 = row0[x * 2 + 1], p2 = row1[x * 2], p3 = row1[x * 2 + 1];
+				dst[x] = Color{ static_cast<uint8>((p0.r + p1.r + p2.r + p3.r + 2) >> 2),
+								static_cast<uint8>((p0.g + p1.g + p2.g + p3.g + 2) >> 2),
+								static_cast<uint8>((p0.b + p1.b + p2.b + p3.b + 2) >> 2),
+								static_cast<uint8>((p0.a + p1.a + p2.a + p3.a + 2) >> 2) };
+			}
+		}
+
+		[[nodiscard]]
+		inline __m128 LoadMipPixel(const Color color, const SRGBTables* tables) noexcept
+		{
+			if (tables)
+			{
+				return _mm_setr_ps(tables->toLinear[color.r], tables->toLinear[color.g], tables->toLinear[color.b], color.a);
+			}
+
+			uint32 packed;
+			std::memcpy(&packed, &color, sizeof(packed));
+
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int32>(packed)), zero), zero);
+
+			return _mm_cvtepi32_ps(v);
+		}
+
+		[[nodiscard]]
+		inline Color StoreMipPixel(const __m128 value, const SRGBTables* tables) noexcept
+		{
+			if (tables)
+			{
+				alignas(16) float v[4];
+				_mm_store_ps(v, value);
+
+				return{ LinearToSRGB8(v[0], *tables), LinearToSRGB8(v[1], *tables), LinearToSRGB8(v[2], *tables),
+					static_cast<uint8>(Clamp((v[3] + 0.5f), 0.0f, 255.0f)) };
+			}
+
+			const __m128 rounded = _mm_add_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(0.5f));
+			const __m128i v = _mm_cvttps_epi32(rounded);
+			const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(v, v), _mm_setzero_si128());
+			const uint32 bits = static_cast<uint32>(_mm_cvtsi128_si32(packed));
+
+			Color result;
+			std::memcpy(&result, &bits, sizeof(result));
+			return result;
+		}
+	}
+
+	inline MipChain::MipChain(const Image& src, const MipmapFilter filter, const GammaCorrect gammaCorrect)
+	{
+		build(src, filter, gammaCorrect);
+	}
+
+	inline MipChain::MipChain(const Image& src, const size_t maxLevel, const MipmapFilter filter, const GammaCorrect gammaCorrect)
+	{
+		build(src, maxLevel, filter, gammaCorrect);
+	}
+
+	inline void MipChain::build(const Image& src, const MipmapFilter filter, const GammaCorrect gammaCorrect)
+	{
+		build(src, SIZE_MAX, filter, gammaCorrect);
+	}
+
+	inline void MipChain::build(const Image& src, const size_t maxLevel, const MipmapFilter filter, const GammaCorrect gammaCorrect)
+	{
+		clear();
+
+		if (src.isEmpty())
+		{
+			return;
+		}
+
+		const size_t numLevels = (Min((ImageProcessing::CalculateMipCount(src.width(), src.height()) - 1), maxLevel) + 1);
+		Size size = src.size();
+		size_t numPixels = 0;
+
+		for (size_t i = 0; i < numLevels; ++i)
+		{
+			m_levels << Level{ size, (numPixels * sizeof(Color)), (size.x * sizeof(Color)) };
+			numPixels += size.area();
+			size = Size{ Max((size.x / 2), 1), Max((size.y / 2), 1) };
+		}
+
+		m_data.resize(numPixels);
+
+		std::memcpy(m_data.data(), src.data(), src.size_bytes());
+
+		for (size_t i = 1; i < numLevels; ++i)
+		{
+			downsample(m_levels[i - 1], m_levels[i], filter, gammaCorrect);
+		}
+	}
+
+	inline size_t MipChain::num_levels() const noexcept
+	{
+		return m_levels.size();
+	}
+
+	inline bool MipChain::isEmpty() const noexcept
+	{
+		return m_levels.isEmpty();
+	}
+
+	inline MipChain::operator bool() const noexcept
+	{
+		return (not m_levels.isEmpty());
+	}
+
+	inline void MipChain::clear() noexcept
+	{
+		m_data.clear();
+
+		m_levels.clear();
+	}
+
+	inline void MipChain::release()
+	{
+		clear();
+
+		m_data.shrink_to_fit();
+
+		m_levels.shrink_to_fit();
+	}
+
+	inline const MipChain::Level& MipChain::level(const size_t level) const
+	{
+		return m_levels.at(level);
+	}
+
+	inline const Array<MipChain::Level>& MipChain::levels() const noexcept
+	{
+		return m_levels;
+	}
+
+	inline Size MipChain::size(const size_t level) const
+	{
+		return m_levels.at(level).size;
+	}
+
+	inline const Color* MipChain::data(const size_t level) const
+	{
+		return (m_data.data() + (m_levels.at(level).offset / sizeof(Color)));
+	}
+
+	inline const Color* MipChain::data() const noexcept
+	{
+		return m_data.data();
+	}
+
+	inline size_t MipChain::size_bytes() const noexcept
+	{
+		return (m_data.size() * sizeof(Color));
+	}
+
+	inline Image MipChain::toImage(const size_t level) const
+	{
+		const Level& info = m_levels.at(level);
+		Image image{ info.size };
+
+		std::memcpy(image.data(), data(level), image.size_bytes());
+
+		return image;
+	}
+
+	inline Array<Image> MipChain::toMips() const
+	{
+		Array<Image> mips(Arg::reserve = (Max<size_t>(m_levels.size(), 1) - 1));
+
+		for (size_t i = 1; i < m_levels.size(); ++i)
+		{
+			mips << toImage(i);
+		}
+
+		return mips;
+	}
+
+	inline void MipChain::downsample(const Level& srcLevel, const Level& dstLevel, const MipmapFilter filter, const GammaCorrect gammaCorrect)
+	{
+		const Color* src = (m_data.data() + (srcLevel.offset / sizeof(Color)));
+		Color* dst = (m_data.data() + (dstLevel.offset / sizeof(Color)));
+		const Size srcSize = srcLevel.size;
+		const Size dstSize = dstLevel.size;
+
+		// 幅と高さがともに偶数のボックスフィルタは整数演算で処理する
+		if ((filter == MipmapFilter::Box) && (not gammaCorrect)
+			&& (srcSize.x == (dstSize.x * 2)) && (srcSize.y == (dstSize.y * 2)))
+		{
+			detail::ForEachImageBand(dstSize.x, dstSize.y, detail::ImageBandRows(srcSize.x),
+				[=](const int32 first, const int32 last)
+				{
+					for (int32 y = first; y < last; ++y)
+					{
+						const Color* row0 = (src + static_cast<size_t>(y * 2) * srcSize.x);
+						detail::DownsampleMipRow2x2(row0, (row0 + srcSize.x), (dst + static_cast<size_t>(y) * dstSize.x), dstSize.x);
+					}
+				});
+
+			return;
+		}
+
+		const detail::ImageScaleTaps xTaps = ((filter == MipmapFilter::Kaiser)
+			? detail::MakeMipKaiserTaps(srcSize.x, dstSize.x) : detail::MakeImageScaleTaps(srcSize.x, dstSize.x, InterpolationAlgorithm::Area));
+		const detail::ImageScaleTaps yTaps = ((filter == MipmapFilter::Kaiser)
+			? detail::MakeMipKaiserTaps(srcSize.y, dstSize.y) : detail::MakeImageScaleTaps(srcSize.y, dstSize.y, InterpolationAlgorithm::Area));
+		const detail::SRGBTables* tables = (gammaCorrect ? &detail::GetSRGBTables() : nullptr);
+
+		detail::ForEachImageBand(dstSize.x, dstSize.y, detail::ImageBandRows(srcSize.x),
+			[&](const int32 first, const int32 last)
+			{
+				// 帯が参照する入力の行の範囲
+				int32 lo = srcSize.y, hi = 0;
+
+				for (uint32 t = yTaps.offsets[first]; t < yTaps.offsets[last]; ++t)
+				{
+					lo = Min(lo, yTaps.indices[t]);
+					hi = Max(hi, (yTaps.indices[t] + 1));
+				}
+
+				// 水平方向の縮小（1 ピクセルあたり float 4 個）
+				Array<float> rows(static_cast<size_t>(hi - lo) * dstSize.x * 4);
+
+				for (int32 sy = lo; sy < hi; ++sy)
+				{
+					const Color* s = (src + static_cast<size_t>(sy) * srcSize.x);
+					float* out = (rows.data() + static_cast<size_t>(sy - lo) * dstSize.x * 4);
+
+					for (int32 x = 0; x < dstSize.x; ++x)
+					{
+						__m128 sum = _mm_setzero_ps();
+
+						for (uint32 t = xTaps.offsets[x]; t < xTaps.offsets[x + 1]; ++t)
+						{
+							sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(xTaps.weights[t]), detail::LoadMipPixel(s[xTaps.indices[t]], tables)));
+						}
+
+						_mm_storeu_ps((out + x * 4), sum);
+					}
+				}
+
+				// 垂直方向の縮小
+				Array<float> sums(static_cast<size_t>(dstSize.x) * 4);
+
+				for (int32 y = first; y < last; ++y)
+				{
+					std::fill(sums.begin(), sums.end(), 0.0f);
+
+					for (uint32 t = yTaps.offsets[y]; t < yTaps.offsets[y + 1]; ++t)
+					{
+						const float* row = (rows.data() + static_cast<size_t>(yTaps.indices[t] - lo) * dstSize.x * 4);
+						const __m128 w = _mm_set1_ps(yTaps.weights[t]);
+
+						for (int32 x = 0; x < dstSize.x; ++x)
+						{
+							_mm_storeu_ps((sums.data() + x * 4), _mm_add_ps(_mm_loadu_ps(sums.data() + x * 4), _mm_mul_ps(w, _mm_loadu_ps(row + x * 4))));
+						}
+					}
+
+					Color* out = (dst + static_cast<size_t>(y) * dstSize.x);
+
+					for (int32 x = 0; x < dstSize.x; ++x)
+					{
+						out[x] = detail::StoreMipPixel(_mm_loadu_ps(sums.data() + x * 4), tables);
+					}
+				}
+			});
+	}
+}
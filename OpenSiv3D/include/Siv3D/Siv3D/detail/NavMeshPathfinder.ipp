@@ -0,0 +1,601 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <cmath>
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		inline Vec3 ToNavMeshPathPoint(const Vec2& point) noexcept
+		{
+			return{ point.x, point.y, 0.0 };
+		}
+
+		[[nodiscard]]
+		inline Vec3 ToNavMeshPathPoint(const Vec3& point) noexcept
+		{
+			return point;
+		}
+
+		inline void FromNavMeshPath(const Array<Vec3>& path, Array<Vec2>& dst)
+		{
+			dst.resize(path.size());
+
+			for (size_t i = 0; i < path.size(); ++i)
+			{
+				dst[i].set(path[i].x, path[i].y);
+			}
+		}
+
+		inline void FromNavMeshPath(const Array<Vec3>& path, Array<Vec3>& dst)
+		{
+			dst.assign(path.begin(), path.end());
+		}
+
+		inline void ToNavMeshPath(const Array<Vec2>& path, Array<Vec3>& dst)
+		{
+			dst.resize(path.size());
+
+			for (size_t i = 0; i < path.size(); ++i)
+			{
+				dst[i].set(path[i].x, path[i].y, 0.0);
+			}
+		}
+
+		inline void ToNavMeshPath(const Array<Vec3>& path, Array<Vec3>& dst)
+		{
+			dst.assign(path.begin(), path.end());
+		}
+
+		/// @brief `NavMesh::build()` の引数に含まれる `NavMeshConfig` から、端点を置き換えても壁を通り抜けないセルの大きさ `agentRadius / √2` を返します。
+		template <class... Args>
+		[[nodiscard]]
+		inline double GetNavMeshSafeQuantization(const Args&... args) noexcept
+		{
+			double agentRadius = NavMeshConfig{}.agentRadius;
+
+			([&](const auto& arg)
+			{
+				if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, NavMeshConfig>)
+				{
+					agentRadius = arg.agentRadius;
+				}
+			}(args), ...);
+
+			return (agentRadius / Math::Sqrt2);
+		}
+	}
+
+	inline double NavMeshPathStats::hitRate() const noexcept
+	{
+		if (numRequests == 0)
+		{
+			return 0.0;
+		}
+
+		return (static_cast<double>(numCacheHits) / numRequests);
+	}
+
+	inline double NavMeshPathStats::averageQueryMillisec() const noexcept
+	{
+		if (numQueries == 0)
+		{
+			return 0.0;
+		}
+
+		return (queryTimeNanosec / 1'000'000.0 / numQueries);
+	}
+
+	inline NavMeshPathfinder::NavMeshPathfinder(const NavMesh& navMesh, const size_t cacheCapacity, const double quantization)
+		: m_navMesh{ navMesh }
+		, m_cacheCapacity{ cacheCapacity }
+		, m_quantization{ quantization }
+		, m_quantizationFromConfig{ false } {}
+
+	template <class... Args>
+	inline bool NavMeshPathfinder::build(Args&&... args)
+	{
+		clearCache();
+		m_builder = nullptr;
+		m_workers.clear();
+
+		if (not m_navMesh.build(args...))
+		{
+			return false;
+		}
+
+		if (m_quantizationFromConfig)
+		{
+			m_quantization = detail::GetNavMeshSafeQuantization(args...);
+		}
+
+		// スレッドごとのナビメッシュを同じ入力から構築できるよう、引数のコピーを保持する
+		m_builder = [args...](NavMesh& navMesh) { return navMesh.build(args...); };
+		return true;
+	}
+
+	inline void NavMeshPathfinder::setNavMesh(const NavMesh& navMesh)
+	{
+		m_navMesh = navMesh;
+		m_builder = nullptr;
+		m_workers.clear();
+		clearCache();
+	}
+
+	inline const NavMesh& NavMeshPathfinder::navMesh() const noexcept
+	{
+		return m_navMesh;
+	}
+
+	inline Array<Vec2> NavMeshPathfinder::query(const Vec2& start, const Vec2& end, const AreaCosts& areaCosts)
+	{
+		Array<Vec2> path;
+		query(start, end, path, areaCosts);
+		return path;
+	}
+
+	inline void NavMeshPathfinder::query(const Vec2& start, const Vec2& end, Array<Vec2>& dst, const AreaCosts& areaCosts)
+	{
+		queryImpl(start, end, dst, areaCosts);
+	}
+
+	inline Array<Vec3> NavMeshPathfinder::query(const Vec3& start, const Vec3& end, const AreaCosts& areaCosts)
+	{
+		Array<Vec3> path;
+		query(start, end, path, areaCosts);
+		return path;
+	}
+
+	inline void NavMeshPathfinder::query(const Vec3& start, const Vec3& end, Array<Vec3>& dst, const AreaCosts& areaCosts)
+	{
+		queryImpl(start, end, dst, areaCosts);
+	}
+
+	inline void NavMeshPathfinder::queryBatch(const Array<std::pair<Vec2, Vec2>>& requests, Array<Array<Vec2>>& results, const AreaCosts& areaCosts)
+	{
+		results.resize(requests.size());
+		queryBatchImpl(requests, results.data(), areaCosts);
+	}
+
+	inline Array<Array<Vec2>> NavMeshPathfinder::queryBatch(const Array<std::pair<Vec2, Vec2>>& requests, const AreaCosts& areaCosts)
+	{
+		Array<Array<Vec2>> results;
+		queryBatch(requests, results, areaCosts);
+		return results;
+	}
+
+	inline void NavMeshPathfinder::queryBatch(const Array<std::pair<Vec3, Vec3>>& requests, Array<Array<Vec3>>& results, const AreaCosts& areaCosts)
+	{
+		results.resize(requests.size());
+		queryBatchImpl(requests, results.data(), areaCosts);
+	}
+
+	inline Array<Array<Vec3>> NavMeshPathfinder::queryBatch(const Array<std::pair<Vec3, Vec3>>& requests, const AreaCosts& areaCosts)
+	{
+		Array<Array<Vec3>> results;
+		queryBatch(requests, results, areaCosts);
+		return results;
+	}
+
+	inline size_t NavMeshPathfinder::cacheSize() const noexcept
+	{
+		return m_entries.size();
+	}
+
+	inline size_t NavMeshPathfinder::cacheCapacity() const noexcept
+	{
+		return m_cacheCapacity;
+	}
+
+	inline void NavMeshPathfinder::setCacheCapacity(const size_t cacheCapacity)
+	{
+		m_cacheCapacity = cacheCapacity;
+
+		if (m_entries.size() <= cacheCapacity)
+		{
+			return;
+		}
+
+		// 新しいものから順に残し、配列を詰め直す
+		Array<Entry> entries;
+		entries.reserve(cacheCapacity);
+
+		for (uint32 i = m_head; (i != NullIndex) && (entries.size() < cacheCapacity); i = m_entries[i].next)
+		{
+			entries << std::move(m_entries[i]);
+		}
+
+		m_stats.numEvictions += (m_entries.size() - entries.size());
+		m_entries = std::move(entries);
+		m_index.clear();
+
+		for (uint32 i = 0; i < m_entries.size(); ++i)
+		{
+			m_entries[i].prev = ((i == 0) ? NullIndex : (i - 1));
+			m_entries[i].next = (((i + 1) == m_entries.size()) ? NullIndex : (i + 1));
+			m_index.emplace(m_entries[i].key, i);
+		}
+
+		m_head = (m_entries ? 0 : NullIndex);
+		m_tail = (m_entries ? static_cast<uint32>(m_entries.size() - 1) : NullIndex);
+	}
+
+	inline double NavMeshPathfinder::quantization() const noexcept
+	{
+		return m_quantization;
+	}
+
+	inline void NavMeshPathfinder::setQuantization(const double quantization)
+	{
+		m_quantization = quantization;
+		m_quantizationFromConfig = false;
+		clearCache();
+	}
+
+	inline void NavMeshPathfinder::clearCache()
+	{
+		m_entries.clear();
+		m_index.clear();
+		m_areaCostsSets.clear();
+		m_head = NullIndex;
+		m_tail = NullIndex;
+	}
+
+	inline const NavMeshPathStats& NavMeshPathfinder::getStats() const noexcept
+	{
+		return m_stats;
+	}
+
+	inline void NavMeshPathfinder::resetStats() noexcept
+	{
+		m_stats = {};
+	}
+
+	inline int64 NavMeshPathfinder::quantize(const double value) const noexcept
+	{
+		if (m_quantization <= 0.0)
+		{
+			int64 bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		return static_cast<int64>(std::floor(value / m_quantization));
+	}
+
+	inline uint32 NavMeshPathfinder::getAreaCostsIndex(const AreaCosts& areaCosts)
+	{
+		for (size_t i = 0; i < m_areaCostsSets.size(); ++i)
+		{
+			if (m_areaCostsSets[i] == areaCosts)
+			{
+				return static_cast<uint32>(i);
+			}
+		}
+
+		if (MaxAreaCostsSets <= m_areaCostsSets.size())
+		{
+			clearCache();
+		}
+
+		m_areaCostsSets << areaCosts;
+		return static_cast<uint32>(m_areaCostsSets.size() - 1);
+	}
+
+	inline NavMeshPathfinder::Key NavMeshPathfinder::makeKey(const Vec3& start, const Vec3& end, const uint32 dimensions, const uint32 areaCostsIndex) const noexcept
+	{
+		Key key;
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			key.start[i] = quantize(start.elem(i));
+			key.end[i] = quantize(end.elem(i));
+		}
+
+		key.dimensions = dimensions;
+		key.areaCostsIndex = areaCostsIndex;
+		return key;
+	}
+
+	inline bool NavMeshPathfinder::isInCell(const Vec3& point, const int64(&cell)[3]) const noexcept
+	{
+		for (size_t i = 0; i < 3; ++i)
+		{
+			if (quantize(point.elem(i)) != cell[i])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	inline const Array<Vec3>* NavMeshPathfinder::find(const Key& key)
+	{
+		const auto it = m_index.find(key);
+
+		if (it == m_index.end())
+		{
+			return nullptr;
+		}
+
+		const uint32 index = it->second;
+
+		if (index != m_head)
+		{
+			unlink(index);
+			pushFront(index);
+		}
+
+		return &m_entries[index].path;
+	}
+
+	template <class PointType>
+	inline void NavMeshPathfinder::insert(const Key& key, const Array<PointType>& path)
+	{
+		if (m_cacheCapacity == 0)
+		{
+			return;
+		}
+
+		uint32 index;
+
+		if (m_entries.size() < m_cacheCapacity)
+		{
+			index = static_cast<uint32>(m_entries.size());
+			m_entries.push_back(Entry{ key, {}, NullIndex, NullIndex });
+		}
+		else
+		{
+			// 最も古い経路の場所を再利用する
+			index = m_tail;
+			unlink(index);
+			m_index.erase(m_entries[index].key);
+			m_entries[index].key = key;
+			++m_stats.numEvictions;
+		}
+
+		// 追い出した経路の配列の容量を再利用する
+		detail::ToNavMeshPath(path, m_entries[index].path);
+
+		pushFront(index);
+		m_index.emplace(key, index);
+	}
+
+	template <class PointType>
+	inline void NavMeshPathfinder::restoreEndpoints(const Key& key, const PointType& start, const PointType& end, Array<PointType>& path) const noexcept
+	{
+		if (not path)
+		{
+			return;
+		}
+
+		// 端点が要求と同じセルにある場合のみ、要求された座標に置き換える
+		if (isInCell(detail::ToNavMeshPathPoint(path.front()), key.start))
+		{
+			path.front() = start;
+		}
+
+		if (isInCell(detail::ToNavMeshPathPoint(path.back()), key.end))
+		{
+			path.back() = end;
+		}
+	}
+
+	inline size_t NavMeshPathfinder::prepareWorkers(const size_t count)
+	{
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if ((count < 2) || (not m_builder))
+		{
+			return 0;
+		}
+
+		// 呼び出し元のスレッドは m_navMesh を使うので、ワーカースレッドの分だけ構築する
+		const size_t numThreads = Min(count, (detail::WorkStealingPool::Get().numWorkers() + 1));
+
+		while ((m_workers.size() + 1) < numThreads)
+		{
+			NavMesh navMesh;
+
+			if (not m_builder(navMesh))
+			{
+				m_builder = nullptr;
+				m_workers.clear();
+				return 0;
+			}
+
+			m_workers << navMesh;
+		}
+
+		return numThreads;
+
+	# else
+
+		return 0;
+
+	# endif
+	}
+
+	inline void NavMeshPathfinder::unlink(const uint32 index) noexcept
+	{
+		Entry& entry = m_entries[index];
+
+		if (entry.prev != NullIndex)
+		{
+			m_entries[entry.prev].next = entry.next;
+		}
+		else
+		{
+			m_head = entry.next;
+		}
+
+		if (entry.next != NullIndex)
+		{
+			m_entries[entry.next].prev = entry.prev;
+		}
+		else
+		{
+			m_tail = entry.prev;
+		}
+
+		entry.prev = entry.next = NullIndex;
+	}
+
+	inline void NavMeshPathfinder::pushFront(const uint32 index) noexcept
+	{
+		Entry& entry = m_entries[index];
+		entry.prev = NullIndex;
+		entry.next = m_head;
+
+		if (m_head != NullIndex)
+		{
+			m_entries[m_head].prev = index;
+		}
+
+		m_head = index;
+
+		if (m_tail == NullIndex)
+		{
+			m_tail = index;
+		}
+	}
+
+	template <class PointType>
+	inline void NavMeshPathfinder::queryImpl(const PointType& start, const PointType& end, Array<PointType>& dst, const AreaCosts& areaCosts)
+	{
+		constexpr uint32 Dimensions = static_cast<uint32>(sizeof(PointType) / sizeof(double));
+
+		const uint64 startTime = Time::GetNanosec();
+		const uint32 areaCostsIndex = getAreaCostsIndex(areaCosts);
+		const Key key = makeKey(detail::ToNavMeshPathPoint(start), detail::ToNavMeshPathPoint(end), Dimensions, areaCostsIndex);
+
+		if (const Array<Vec3>* cached = find(key))
+		{
+			detail::FromNavMeshPath(*cached, dst);
+			restoreEndpoints(key, start, end, dst);
+			++m_stats.numCacheHits;
+		}
+		else
+		{
+			const uint64 queryStartTime = Time::GetNanosec();
+			m_navMesh.query(start, end, dst, areaCosts);
+			m_stats.queryTimeNanosec += (Time::GetNanosec() - queryStartTime);
+			++m_stats.numQueries;
+
+			insert(key, dst);
+		}
+
+		++m_stats.numRequests;
+		m_stats.totalTimeNanosec += (Time::GetNanosec() - startTime);
+	}
+
+	template <class PointType>
+	inline void NavMeshPathfinder::queryBatchImpl(const Array<std::pair<PointType, PointType>>& requests, Array<PointType>* results, const AreaCosts& areaCosts)
+	{
+		constexpr uint32 Dimensions = static_cast<uint32>(sizeof(PointType) / sizeof(double));
+
+		const uint64 startTime = Time::GetNanosec();
+		const uint32 areaCostsIndex = getAreaCostsIndex(areaCosts);
+
+		// キャッシュにヒットしなかったキーから misses のインデックスへの対応
+		HashTable<Key, size_t, KeyHash> pending;
+
+		// 計算する要求のインデックスとキー
+		Array<std::pair<size_t, Key>> misses;
+
+		// 同じバッチ内の同じキーの要求のインデックスと、misses のインデックス
+		Array<std::pair<size_t, size_t>> duplicates;
+
+		for (size_t i = 0; i < requests.size(); ++i)
+		{
+			const auto& [start, end] = requests[i];
+			const Key key = makeKey(detail::ToNavMeshPathPoint(start), detail::ToNavMeshPathPoint(end), Dimensions, areaCostsIndex);
+
+			if (const Array<Vec3>* cached = find(key))
+			{
+				detail::FromNavMeshPath(*cached, results[i]);
+				restoreEndpoints(key, start, end, results[i]);
+				++m_stats.numCacheHits;
+				continue;
+			}
+
+			if (const auto it = pending.find(key); it != pending.end())
+			{
+				duplicates.emplace_back(i, it->second);
+				++m_stats.numCacheHits;
+				continue;
+			}
+
+			pending.emplace(key, misses.size());
+			misses.emplace_back(i, key);
+		}
+
+		const size_t numWorkers = prepareWorkers(misses.size());
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if (2 <= numWorkers)
+		{
+			// 各ワーカーは自分専用のナビメッシュを使い、残っている要求を 1 つずつ取り出して計算する
+			Array<uint64> queryTimes(numWorkers, 0);
+			std::atomic<size_t> next{ 0 };
+
+			parallel_for(0, numWorkers, 1, [&](const size_t worker)
+			{
+				const NavMesh& navMesh = ((worker == 0) ? m_navMesh : m_workers[worker - 1]);
+
+				for (size_t k = next++; k < misses.size(); k = next++)
+				{
+					const size_t i = misses[k].first;
+					const uint64 queryStartTime = Time::GetNanosec();
+					navMesh.query(requests[i].first, requests[i].second, results[i], areaCosts);
+					queryTimes[worker] += (Time::GetNanosec() - queryStartTime);
+				}
+			});
+
+			m_stats.queryTimeNanosec += queryTimes.sum();
+		}
+		else
+
+	# endif
+
+		{
+			for (const auto& miss : misses)
+			{
+				const size_t i = miss.first;
+				const uint64 queryStartTime = Time::GetNanosec();
+				m_navMesh.query(requests[i].first, requests[i].second, results[i], areaCosts);
+				m_stats.queryTimeNanosec += (Time::GetNanosec() - queryStartTime);
+			}
+		}
+
+		m_stats.numQueries += misses.size();
+
+		for (const auto& [i, key] : misses)
+		{
+			insert(key, results[i]);
+		}
+
+		for (const auto& [i, miss] : duplicates)
+		{
+			const auto& [source, key] = misses[miss];
+			results[i] = results[source];
+			restoreEndpoints(key, requests[i].first, requests[i].second, results[i]);
+		}
+
+		m_stats.numRequests += requests.size();
+		m_stats.totalTimeNanosec += (Time::GetNanosec() - startTime);
+	}
+}
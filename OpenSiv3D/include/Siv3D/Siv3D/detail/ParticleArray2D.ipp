@@ -0,0 +1,253 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	inline ParticleArray2D::ParticleArray2D(const size_t capacity)
+	{
+		setCapacity(capacity);
+	}
+
+	inline void ParticleArray2D::setCapacity(const size_t capacity)
+	{
+		if (capacity == m_capacity)
+		{
+			return;
+		}
+
+		// 各成分の先頭が 16 バイト境界になるよう、4 の倍数にそろえる
+		const size_t stride = ((capacity + 3) & ~size_t{ 3 });
+		const size_t size = Min(m_size, capacity);
+
+		Array<float, Allocator<float, 16>> data(stride * NumStreams);
+
+		for (size_t i = 0; i < NumStreams; ++i)
+		{
+			std::copy_n((m_data.data() + i * m_stride), size, (data.data() + i * stride));
+		}
+
+		m_data = std::move(data);
+		m_stride = stride;
+		m_capacity = capacity;
+		m_size = size;
+	}
+
+	inline size_t ParticleArray2D::capacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	inline size_t ParticleArray2D::size() const noexcept
+	{
+		return m_size;
+	}
+
+	inline bool ParticleArray2D::isEmpty() const noexcept
+	{
+		return (m_size == 0);
+	}
+
+	inline bool ParticleArray2D::isFull() const noexcept
+	{
+		return (m_size == m_capacity);
+	}
+
+	inline bool ParticleArray2D::push_back(const Particle2D& particle) noexcept
+	{
+		if (isFull())
+		{
+			return false;
+		}
+
+		set(m_size++, particle);
+		return true;
+	}
+
+	inline void ParticleArray2D::resize(const size_t size) noexcept
+	{
+		m_size = Min(size, m_capacity);
+	}
+
+	inline Particle2D ParticleArray2D::get(const size_t index) const noexcept
+	{
+		const auto s = streams();
+
+		Particle2D particle;
+		particle.position = { s.positionX[index], s.positionY[index] };
+		particle.velocity = { s.velocityX[index], s.velocityY[index] };
+		particle.startColor = { s.startColorR[index], s.startColorG[index], s.startColorB[index], s.startColorA[index] };
+		particle.startSize = s.startSize[index];
+		particle.rotation = s.rotation[index];
+		particle.startAngularVelocity = s.startAngularVelocity[index];
+		particle.startLifeTime = s.startLifeTime[index];
+		particle.remainingLifeTime = s.remainingLifeTime[index];
+		return particle;
+	}
+
+	inline void ParticleArray2D::set(const size_t index, const Particle2D& particle) noexcept
+	{
+		const auto s = streams();
+		s.positionX[index] = particle.position.x;
+		s.positionY[index] = particle.position.y;
+		s.velocityX[index] = particle.velocity.x;
+		s.velocityY[index] = particle.velocity.y;
+		s.startColorR[index] = particle.startColor.x;
+		s.startColorG[index] = particle.startColor.y;
+		s.startColorB[index] = particle.startColor.z;
+		s.startColorA[index] = particle.startColor.w;
+		s.startSize[index] = particle.startSize;
+		s.rotation[index] = particle.rotation;
+		s.startAngularVelocity[index] = particle.startAngularVelocity;
+		s.startLifeTime[index] = particle.startLifeTime;
+		s.remainingLifeTime[index] = particle.remainingLifeTime;
+	}
+
+	inline void ParticleArray2D::update(const float deltaTime, const Float2& deltaVelocity) noexcept
+	{
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if (ParallelThreshold <= m_size)
+		{
+			parallel_for(0, m_size, ParallelChunkSize, [&](const size_t first, const size_t last)
+				{
+					update(deltaTime, deltaVelocity, first, last);
+				});
+			return;
+		}
+
+	# endif
+
+		update(deltaTime, deltaVelocity, 0, m_size);
+	}
+
+	inline void ParticleArray2D::update(const float deltaTime, const Float2& deltaVelocity, size_t first, const size_t last) noexcept
+	{
+		const auto s = streams();
+		float* const px = s.positionX;
+		float* const py = s.positionY;
+		float* const vx = s.velocityX;
+		float* const vy = s.velocityY;
+		float* const rotation = s.rotation;
+		const float* const angularVelocity = s.startAngularVelocity;
+		float* const remaining = s.remainingLifeTime;
+
+		// 先頭を 4 の倍数にそろえるまでスカラーで処理する
+		for (; (first < last) && (first & 3); ++first)
+		{
+			px[first] += (vx[first] * deltaTime);
+			py[first] += (vy[first] * deltaTime);
+			vx[first] += deltaVelocity.x;
+			vy[first] += deltaVelocity.y;
+			rotation[first] += (angularVelocity[first] * deltaTime);
+			remaining[first] -= deltaTime;
+		}
+
+		const __m128 dt = _mm_set1_ps(deltaTime);
+		const __m128 dvx = _mm_set1_ps(deltaVelocity.x);
+		const __m128 dvy = _mm_set1_ps(deltaVelocity.y);
+
+		for (; (first + 4) <= last; first += 4)
+		{
+			const __m128 x = _mm_load_ps(px + first);
+			const __m128 y = _mm_load_ps(py + first);
+			const __m128 u = _mm_load_ps(vx + first);
+			const __m128 v = _mm_load_ps(vy + first);
+			_mm_store_ps((px + first), _mm_add_ps(x, _mm_mul_ps(u, dt)));
+			_mm_store_ps((py + first), _mm_add_ps(y, _mm_mul_ps(v, dt)));
+			_mm_store_ps((vx + first), _mm_add_ps(u, dvx));
+			_mm_store_ps((vy + first), _mm_add_ps(v, dvy));
+
+			const __m128 r = _mm_load_ps(rotation + first);
+			const __m128 w = _mm_load_ps(angularVelocity + first);
+			_mm_store_ps((rotation + first), _mm_add_ps(r, _mm_mul_ps(w, dt)));
+			_mm_store_ps((remaining + first), _mm_sub_ps(_mm_load_ps(remaining + first), dt));
+		}
+
+		for (; first < last; ++first)
+		{
+			px[first] += (vx[first] * deltaTime);
+			py[first] += (vy[first] * deltaTime);
+			vx[first] += deltaVelocity.x;
+			vy[first] += deltaVelocity.y;
+			rotation[first] += (angularVelocity[first] * deltaTime);
+			remaining[first] -= deltaTime;
+		}
+	}
+
+	inline size_t ParticleArray2D::removeDead() noexcept
+	{
+		const float* const remaining = streams().remainingLifeTime;
+		const size_t oldSize = m_size;
+		const __m128 zero = _mm_setzero_ps();
+		size_t i = 0;
+
+		while (i < m_size)
+		{
+			// 4 つとも生きている区間は飛ばす
+			if (((i & 3) == 0) && ((i + 4) <= m_size)
+				&& (_mm_movemask_ps(_mm_cmple_ps(_mm_load_ps(remaining + i), zero)) == 0))
+			{
+				i += 4;
+				continue;
+			}
+
+			if (remaining[i] <= 0.0f)
+			{
+				// 入れ替えた要素も寿命が尽きている可能性があるので、同じ位置をもう一度調べる
+				moveParticle(--m_size, i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		return (oldSize - m_size);
+	}
+
+	inline void ParticleArray2D::clear() noexcept
+	{
+		m_size = 0;
+	}
+
+	inline ParticleStreams2D<float> ParticleArray2D::streams() noexcept
+	{
+		float* p = m_data.data();
+		const size_t n = m_stride;
+		return{ p, (p + n), (p + n * 2), (p + n * 3), (p + n * 4), (p + n * 5), (p + n * 6),
+			(p + n * 7), (p + n * 8), (p + n * 9), (p + n * 10), (p + n * 11), (p + n * 12) };
+	}
+
+	inline ParticleStreams2D<const float> ParticleArray2D::streams() const noexcept
+	{
+		const float* p = m_data.data();
+		const size_t n = m_stride;
+		return{ p, (p + n), (p + n * 2), (p + n * 3), (p + n * 4), (p + n * 5), (p + n * 6),
+			(p + n * 7), (p + n * 8), (p + n * 9), (p + n * 10), (p + n * 11), (p + n * 12) };
+	}
+
+	inline void ParticleArray2D::moveParticle(const size_t from, const size_t to) noexcept
+	{
+		if (from == to)
+		{
+			return;
+		}
+
+		float* const p = m_data.data();
+
+		for (size_t i = 0; i < NumStreams; ++i)
+		{
+			p[i * m_stride + to] = p[i * m_stride + from];
+		}
+	}
+}
@@ -13,6 +13,133 @@
 
 namespace s3d
 {
+	namespace detail
+	{
+		/// @brief `BasicPerlinNoise::fill()` で 1 タスクが処理するピクセル数の目安
+		inline constexpr size_t PerlinNoiseTaskPixels = 16384;
+
+		struct PerlinNoiseLanesF
+		{
+			using value_type = float;
+
+			using vector_type = __m128;
+
+			static constexpr size_t Size = 4;
+
+			static vector_type Load(const float* p) noexcept { return _mm_loadu_ps(p); }
+
+			static void Store(float* p, const vector_type v) noexcept { _mm_storeu_ps(p, v); }
+
+			static vector_type Set1(const float v) noexcept { return _mm_set1_ps(v); }
+
+			static vector_type FromInt(const int32* p) noexcept { return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+
+			static vector_type Add(const vector_type a, const vector_type b) noexcept { return _mm_add_ps(a, b); }
+
+			static vector_type Sub(const vector_type a, const vector_type b) noexcept { return _mm_sub_ps(a, b); }
+
+			static vector_type Mul(const vector_type a, const vector_type b) noexcept { return _mm_mul_ps(a, b); }
+
+			static vector_type Floor(const vector_type a) noexcept { return _mm_floor_ps(a); }
+
+			static vector_type Less(const vector_type a, const vector_type b) noexcept { return _mm_cmplt_ps(a, b); }
+
+			static vector_type Equal(const vector_type a, const vector_type b) noexcept { return _mm_cmpeq_ps(a, b); }
+
+			static vector_type Or(const vector_type a, const vector_type b) noexcept { return _mm_or_ps(a, b); }
+
+			static vector_type And(const vector_type a, const vector_type b) noexcept { return _mm_and_ps(a, b); }
+
+			static vector_type Xor(const vector_type a, const vector_type b) noexcept { return _mm_xor_ps(a, b); }
+
+			/// @brief mask ? a : b
+			static vector_type Select(const vector_type mask, const vector_type a, const vector_type b) noexcept { return _mm_blendv_ps(b, a, mask); }
+		};
+
+		struct PerlinNoiseLanesD
+		{
+			using value_type = double;
+
+			using vector_type = __m128d;
+
+			static constexpr size_t Size = 2;
+
+			static vector_type Load(const double* p) noexcept { return _mm_loadu_pd(p); }
+
+			static void Store(double* p, const vector_type v) noexcept { _mm_storeu_pd(p, v); }
+
+			static vector_type Set1(const double v) noexcept { return _mm_set1_pd(v); }
+
+			static vector_type FromInt(const int32* p) noexcept { return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))); }
+
+			static vector_type Add(const vector_type a, const vector_type b) noexcept { return _mm_add_pd(a, b); }
+
+			static vector_type Sub(const vector_type a, const vector_type b) noexcept { return _mm_sub_pd(a, b); }
+
+			static vector_type Mul(const vector_type a, const vector_type b) noexcept { return _mm_mul_pd(a, b); }
+
+			static vector_type Floor(const vector_type a) noexcept { return _mm_floor_pd(a); }
+
+			static vector_type Less(const vector_type a, const vector_type b) noexcept { return _mm_cmplt_pd(a, b); }
+
+			static vector_type Equal(const vector_type a, const vector_type b) noexcept { return _mm_cmpeq_pd(a, b); }
+
+			static vector_type Or(const vector_type a, const vector_type b) noexcept { return _mm_or_pd(a, b); }
+
+			static vector_type And(const vector_type a, const vector_type b) noexcept { return _mm_and_pd(a, b); }
+
+			static vector_type Xor(const vector_type a, const vector_type b) noexcept { return _mm_xor_pd(a, b); }
+
+			/// @brief mask ? a : b
+			static vector_type Select(const vector_type mask, const vector_type a, const vector_type b) noexcept { return _mm_blendv_pd(b, a, mask); }
+		};
+
+		template <class Float>
+		using PerlinNoiseLanes = std::conditional_t<std::is_same_v<Float, float>, PerlinNoiseLanesF, PerlinNoiseLanesD>;
+
+		template <class Lanes>
+		[[nodiscard]]
+		inline typename Lanes::vector_type PerlinNoiseFade(const typename Lanes::vector_type t) noexcept
+		{
+			using L = Lanes;
+			// t * t * t * (t * (t * 6 - 15) + 10)
+			return L::Mul(L::Mul(L::Mul(t, t), t), L::Add(L::Mul(t, L::Sub(L::Mul(t, L::Set1(6)), L::Set1(15))), L::Set1(10)));
+		}
+
+		template <class Lanes>
+		[[nodiscard]]
+		inline typename Lanes::vector_type PerlinNoiseLerp(const typename Lanes::vector_type a, const typename Lanes::vector_type b, const typename Lanes::vector_type t) noexcept
+		{
+			using L = Lanes;
+			return L::Add(a, L::Mul(L::Sub(b, a), t));
+		}
+
+		/// @brief `BasicPerlinNoise::Grad()` を複数の点で同時に計算します。
+		/// @param hash 各点のハッシュ値（0-15）
+		template <class Lanes>
+		[[nodiscard]]
+		inline typename Lanes::vector_type PerlinNoiseGrad(const int32* hash, const typename Lanes::vector_type x, const typename Lanes::vector_type y, const typename Lanes::vector_type z) noexcept
+		{
+			using L = Lanes;
+			using V = typename L::vector_type;
+
+			const V h = L::FromInt(hash);
+			const V half = L::Floor(L::Mul(h, L::Set1(0.5)));
+			const V quarter = L::Floor(L::Mul(h, L::Set1(0.25)));
+			const V bit0 = L::Sub(h, L::Add(half, half));
+			const V bit1 = L::Sub(half, L::Add(quarter, quarter));
+			const V signBit = L::Set1(-0.0);
+
+			const V u = L::Select(L::Less(h, L::Set1(8)), x, y);
+			const V v = L::Select(L::Less(h, L::Set1(4)), y,
+				L::Select(L::Or(L::Equal(h, L::Set1(12)), L::Equal(h, L::Set1(14))), x, z));
+
+			const V su = L::Xor(u, L::And(L::Equal(bit0, L::Set1(1)), signBit));
+			const V sv = L::Xor(v, L::And(L::Equal(bit1, L::Set1(1)), signBit));
+			return L::Add(su, sv);
+		}
+	}
+
 	template <class Float>
 	inline constexpr BasicPerlinNoise<Float>::BasicPerlinNoise() noexcept
 		: m_perm{ 151,160,137,91,90,15,
@@ -289,6 +416,87 @@ namespace s3d
 	}
 
 
+	template <class Float>
+	inline void BasicPerlinNoise<Float>::fill(Grid<value_type>& grid, const Vector2D<value_type> offset, const value_type scale, const int32 octaves, const value_type persistence) const
+	{
+		const size_t width = grid.width();
+
+		ForEachRows(width, grid.height(), [&](const size_t first, const size_t last)
+		{
+			for (size_t y = first; y < last; ++y)
+			{
+				fillRow((grid.data() + y * width), width, offset.x, (offset.y + y * scale),
+					static_cast<value_type>(0.12345678901234567890), false, scale, octaves, persistence);
+			}
+		});
+	}
+
+	template <class Float>
+	inline void BasicPerlinNoise<Float>::fill(Grid<value_type>& grid, const Vector3D<value_type> offset, const value_type scale, const int32 octaves, const value_type persistence) const
+	{
+		const size_t width = grid.width();
+
+		ForEachRows(width, grid.height(), [&](const size_t first, const size_t last)
+		{
+			for (size_t y = first; y < last; ++y)
+			{
+				fillRow((grid.data() + y * width), width, offset.x, (offset.y + y * scale), offset.z, true, scale, octaves, persistence);
+			}
+		});
+	}
+
+	template <class Float>
+	inline void BasicPerlinNoise<Float>::fill(Image& image, const Vector2D<value_type> offset, const value_type scale, const int32 octaves, const value_type persistence) const
+	{
+		const size_t width = image.width();
+		const value_type maxAmplitude = Noise::MaxAmplitude(static_cast<size_t>(Max(octaves, 0)), persistence);
+
+		ForEachRows(width, image.height(), [&](const size_t first, const size_t last)
+		{
+			Array<value_type> buffer(width);
+
+			for (size_t y = first; y < last; ++y)
+			{
+				fillRow(buffer.data(), width, offset.x, (offset.y + y * scale),
+					static_cast<value_type>(0.12345678901234567890), false, scale, octaves, persistence);
+
+				Color* pDst = (image.data() + y * width);
+
+				for (size_t x = 0; x < width; ++x)
+				{
+					const uint8 gray = Color::ToUint8(Noise::To01(buffer[x] / maxAmplitude));
+					pDst[x] = Color{ gray, gray, gray, 255 };
+				}
+			}
+		});
+	}
+
+	template <class Float>
+	inline void BasicPerlinNoise<Float>::fill(Image& image, const Vector3D<value_type> offset, const value_type scale, const int32 octaves, const value_type persistence) const
+	{
+		const size_t width = image.width();
+		const value_type maxAmplitude = Noise::MaxAmplitude(static_cast<size_t>(Max(octaves, 0)), persistence);
+
+		ForEachRows(width, image.height(), [&](const size_t first, const size_t last)
+		{
+			Array<value_type> buffer(width);
+
+			for (size_t y = first; y < last; ++y)
+			{
+				fillRow(buffer.data(), width, offset.x, (offset.y + y * scale), offset.z, true, scale, octaves, persistence);
+
+				Color* pDst = (image.data() + y * width);
+
+				for (size_t x = 0; x < width; ++x)
+				{
+					const uint8 gray = Color::ToUint8(Noise::To01(buffer[x] / maxAmplitude));
+					pDst[x] = Color{ gray, gray, gray, 255 };
+				}
+			}
+		});
+	}
+
+
 	template <class Float>
 	inline constexpr const typename BasicPerlinNoise<Float>::state_type& BasicPerlinNoise<Float>::serialize() const noexcept
 	{
@@ -321,4 +529,128 @@ namespace s3d
 		const Float v = h < 4 ? y : h == 12 || h == 14 ? x : z;
 		return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
 	}
+
+	template <class Float>
+	inline void BasicPerlinNoise<Float>::fillRow(value_type* out, const size_t width, const value_type x0, value_type y, value_type z, const bool is3D,
+		const value_type scale, const int32 octaves, const value_type persistence) const noexcept
+	{
+		using L = detail::PerlinNoiseLanes<Float>;
+		using V = typename L::vector_type;
+		constexpr size_t N = L::Size;
+
+		std::fill(out, (out + width), value_type(0));
+
+		value_type amplitude = 1;
+		value_type frequency = 1;
+
+		for (int32 octave = 0; octave < octaves; ++octave)
+		{
+			// 行内で共通の y, z についての計算
+			const value_type _y = std::floor(y);
+			const value_type _z = std::floor(z);
+			const std::int32_t iy = static_cast<std::int32_t>(_y) & 255;
+			const std::int32_t iz = static_cast<std::int32_t>(_z) & 255;
+			const value_type fy = (y - _y);
+			const value_type fz = (z - _z);
+
+			const V Y0 = L::Set1(fy);
+			const V Y1 = L::Set1(fy - 1);
+			const V Z0 = L::Set1(fz);
+			const V Z1 = L::Set1(fz - 1);
+			const V v = L::Set1(Fade(fy));
+			const V w = L::Set1(Fade(fz));
+			const V amp = L::Set1(amplitude);
+
+			size_t i = 0;
+
+			for (; (i + N) <= width; i += N)
+			{
+				alignas(16) value_type fx[N];
+				alignas(16) int32 h[8][4];
+
+				for (size_t lane = 0; lane < N; ++lane)
+				{
+					const value_type x = ((x0 + (i + lane) * scale) * frequency);
+					const value_type _x = std::floor(x);
+					const std::int32_t ix = static_cast<std::int32_t>(_x) & 255;
+					fx[lane] = (x - _x);
+
+					const std::uint8_t A = (m_perm[ix & 255] + iy) & 255;
+					const std::uint8_t B = (m_perm[(ix + 1) & 255] + iy) & 255;
+
+					const std::uint8_t AA = (m_perm[A] + iz) & 255;
+					const std::uint8_t AB = (m_perm[(A + 1) & 255] + iz) & 255;
+
+					const std::uint8_t BA = (m_perm[B] + iz) & 255;
+					const std::uint8_t BB = (m_perm[(B + 1) & 255] + iz) & 255;
+
+					h[0][lane] = (m_perm[AA] & 15);
+					h[1][lane] = (m_perm[BA] & 15);
+					h[2][lane] = (m_perm[AB] & 15);
+					h[3][lane] = (m_perm[BB] & 15);
+					h[4][lane] = (m_perm[(AA + 1) & 255] & 15);
+					h[5][lane] = (m_perm[(BA + 1) & 255] & 15);
+					h[6][lane] = (m_perm[(AB + 1) & 255] & 15);
+					h[7][lane] = (m_perm[(BB + 1) & 255] & 15);
+				}
+
+				const V X0 = L::Load(fx);
+				const V X1 = L::Sub(X0, L::Set1(1));
+				const V u = detail::PerlinNoiseFade<L>(X0);
+
+				const V p0 = detail::PerlinNoiseGrad<L>(h[0], X0, Y0, Z0);
+				const V p1 = detail::PerlinNoiseGrad<L>(h[1], X1, Y0, Z0);
+				const V p2 = detail::PerlinNoiseGrad<L>(h[2], X0, Y1, Z0);
+				const V p3 = detail::PerlinNoiseGrad<L>(h[3], X1, Y1, Z0);
+				const V p4 = detail::PerlinNoiseGrad<L>(h[4], X0, Y0, Z1);
+				const V p5 = detail::PerlinNoiseGrad<L>(h[5], X1, Y0, Z1);
+				const V p6 = detail::PerlinNoiseGrad<L>(h[6], X0, Y1, Z1);
+				const V p7 = detail::PerlinNoiseGrad<L>(h[7], X1, Y1, Z1);
+
+				const V q0 = detail::PerlinNoiseLerp<L>(p0, p1, u);
+				const V q1 = detail::PerlinNoiseLerp<L>(p2, p3, u);
+				const V q2 = detail::PerlinNoiseLerp<L>(p4, p5, u);
+				const V q3 = detail::PerlinNoiseLerp<L>(p6, p7, u);
+
+				const V r0 = detail::PerlinNoiseLerp<L>(q0, q1, v);
+				const V r1 = detail::PerlinNoiseLerp<L>(q2, q3, v);
+
+				const V n = detail::PerlinNoiseLerp<L>(r0, r1, w);
+				L::Store((out + i), L::Add(L::Load(out + i), L::Mul(n, amp)));
+			}
+
+			for (; i < width; ++i)
+			{
+				out[i] += (noise3D(((x0 + i * scale) * frequency), y, z) * amplitude);
+			}
+
+			y *= 2;
+
+			if (is3D)
+			{
+				z *= 2;
+			}
+
+			frequency *= 2;
+			amplitude *= persistence;
+		}
+	}
+
+	template <class Float>
+	template <class Fty>
+	inline void BasicPerlinNoise<Float>::ForEachRows(const size_t width, const size_t height, Fty f)
+	{
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if ((Threading::ParallelSerialCutoff < (width * height)) && (1 < height))
+		{
+			const size_t grain = Max<size_t>(1, (detail::PerlinNoiseTaskPixels / Max<size_t>(width, 1)));
+			parallel_for(0, height, grain, [&](const size_t first, const size_t last) { f(first, last); });
+			return;
+		}
+
+	# endif
+
+		f(0, height);
+	}
 }
@@ -308,6 +308,90 @@ namespace s3d
 		}
 	}
 
+	//////////////////////////////////////////////////////
+	//
+	//	ConcurrentHashTable
+	//
+	template <class Archive, class Key, class Value>
+	inline void SIV3D_SERIALIZE_SAVE(Archive& archive, const ConcurrentHashTable<Key, Value>& table)
+	{
+		// 内部のテーブルは 1 つずつロックされ、その間にも他のスレッドが要素を追加・削除できるため、
+		// 先にコピーした要素の個数を書き込む（内容は各内部のテーブルをコピーした時点のもの）
+		Array<std::pair<Key, Value>> snapshot;
+		snapshot.reserve(table.size());
+
+		table.for_each([&](const auto& p)
+		{
+			snapshot.emplace_back(p.first, p.second);
+		});
+
+		archive(cereal::make_size_tag(static_cast<cereal::size_type>(snapshot.size())));
+
+		for (const auto& [key, value] : snapshot)
+		{
+			archive(cereal::make_map_item(key, value));
+		}
+	}
+
+	template <class Archive, class Key, class Value>
+	inline void SIV3D_SERIALIZE_LOAD(Archive& archive, ConcurrentHashTable<Key, Value>& table)
+	{
+		cereal::size_type size;
+		archive(cereal::make_size_tag(size));
+
+		table.clear();
+		table.reserve(static_cast<std::size_t>(size));
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			Key key;
+			Value value;
+			archive(cereal::make_map_item(key, value));
+			table.emplace(std::move(key), std::move(value));
+		}
+	}
+
+	//////////////////////////////////////////////////////
+	//
+	//	ConcurrentHashSet
+	//
+	template <class Archive, class Key>
+	inline void SIV3D_SERIALIZE_SAVE(Archive& archive, const ConcurrentHashSet<Key>& set)
+	{
+		// ConcurrentHashTable と同じく、先にコピーした要素の個数を書き込む
+		Array<Key> snapshot;
+		snapshot.reserve(set.size());
+
+		set.for_each([&](const Key& key)
+		{
+			snapshot.push_back(key);
+		});
+
+		archive(cereal::make_size_tag(static_cast<cereal::size_type>(snapshot.size())));
+
+		for (const auto& key : snapshot)
+		{
+			archive(key);
+		}
+	}
+
+	template <class Archive, class Key>
+	inline void SIV3D_SERIALIZE_LOAD(Archive& archive, ConcurrentHashSet<Key>& set)
+	{
+		cereal::size_type size;
+		archive(cereal::make_size_tag(size));
+
+		set.clear();
+		set.reserve(static_cast<std::size_t>(size));
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			Key key;
+			archive(key);
+			set.emplace(std::move(key));
+		}
+	}
+
 	//////////////////////////////////////////////////////
 	//
 	//	Optional
@@ -0,0 +1,378 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		inline bool SpatialHashBoundsOverlap(const RectF& a, const RectF& b) noexcept
+		{
+			return ((a.x <= (b.x + b.w)) && (b.x <= (a.x + a.w))
+				&& (a.y <= (b.y + b.h)) && (b.y <= (a.y + a.h)));
+		}
+	}
+
+	template <class Id>
+	inline SpatialHash2D<Id>::SpatialHash2D(const double cellSize)
+		: m_cellSize{ cellSize }
+		, m_inverseCellSize{ 1.0 / cellSize } {}
+
+	template <class Id>
+	inline void SpatialHash2D<Id>::insert(const Id& id, const RectF& bounds)
+	{
+		if (m_indices.contains(id))
+		{
+			update(id, bounds);
+			return;
+		}
+
+		const uint32 index = static_cast<uint32>(m_entries.size());
+		const CellRange cells = toCellRange(bounds);
+
+		m_entries.push_back(Entry{ id, bounds, cells });
+		m_indices.emplace(id, index);
+
+		addToCells(index, cells);
+	}
+
+	template <class Id>
+	inline void SpatialHash2D<Id>::insert(const Array<std::pair<Id, RectF>>& items)
+	{
+		m_entries.reserve(m_entries.size() + items.size());
+		m_indices.reserve(m_indices.size() + items.size());
+
+		for (const auto& [id, bounds] : items)
+		{
+			insert(id, bounds);
+		}
+	}
+
+	template <class Id>
+	inline void SpatialHash2D<Id>::update(const Id& id, const RectF& bounds)
+	{
+		const auto it = m_indices.find(id);
+
+		if (it == m_indices.end())
+		{
+			insert(id, bounds);
+			return;
+		}
+
+		const uint32 index = it->second;
+		Entry& entry = m_entries[index];
+		const CellRange cells = toCellRange(bounds);
+
+		entry.bounds = bounds;
+
+		if (cells == entry.cells)
+		{
+			return;
+		}
+
+		removeFromCells(index, entry.cells);
+		addToCells(index, cells);
+		entry.cells = cells;
+	}
+
+	template <class Id>
+	inline void SpatialHash2D<Id>::remove(const Id& id)
+	{
+		const auto it = m_indices.find(id);
+
+		if (it == m_indices.end())
+		{
+			return;
+		}
+
+		const uint32 index = it->second;
+		const uint32 lastIndex = static_cast<uint32>(m_entries.size() - 1);
+
+		removeFromCells(index, m_entries[index].cells);
+		m_indices.erase(it);
+
+		// 末尾の要素を空いた場所へ移す
+		if (index != lastIndex)
+		{
+			Entry& last = m_entries[lastIndex];
+			replaceInCells(lastIndex, index, last.cells);
+			m_indices[last.id] = index;
+			m_entries[index] = std::move(last);
+		}
+
+		m_entries.pop_back();
+	}
+
+	template <class Id>
+	inline bool SpatialHash2D<Id>::contains(const Id& id) const
+	{
+		return m_indices.contains(id);
+	}
+
+	template <class Id>
+	inline size_t SpatialHash2D<Id>::size() const noexcept
+	{
+		return m_entries.size();
+	}
+
+	template <class Id>
+	inline bool SpatialHash2D<Id>::isEmpty() const noexcept
+	{
+		return m_entries.isEmpty();
+	}
+
+	template <class Id>
+	inline double SpatialHash2D<Id>::cellSize() const noexcept
+	{
+		return m_cellSize;
+	}
+
+	template <class Id>
+	inline void SpatialHash2D<Id>::clear()
+	{
+		m_entries.clear();
+		m_indices.clear();
+
+		for (auto& [key, indices] : m_cells)
+		{
+			indices.clear();
+		}
+	}
+
+	template <class Id>
+	inline void SpatialHash2D<Id>::shrink_to_fit()
+	{
+		for (auto it = m_cells.begin(); it != m_cells.end();)
+		{
+			if (it->second.isEmpty())
+			{
+				m_cells.erase(it++);
+			}
+			else
+			{
+				it->second.shrink_to_fit();
+				++it;
+			}
+		}
+
+		m_entries.shrink_to_fit();
+	}
+
+	template <class Id>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, const Id&>>*>
+	inline void SpatialHash2D<Id>::query(const RectF& area, Fty f) const
+	{
+		const CellRange range = toCellRange(area);
+
+		for (int32 y = range.y0; y <= range.y1; ++y)
+		{
+			for (int32 x = range.x0; x <= range.x1; ++x)
+			{
+				const auto it = m_cells.find(CellKey(x, y));
+
+				if (it == m_cells.end())
+				{
+					continue;
+				}
+
+				for (const uint32 index : it->second)
+				{
+					const Entry& entry = m_entries[index];
+
+					// 要素と領域が共有する最初のセルでだけ報告する
+					if ((Max(entry.cells.x0, range.x0) != x)
+						|| (Max(entry.cells.y0, range.y0) != y))
+					{
+						continue;
+					}
+
+					if (detail::SpatialHashBoundsOverlap(entry.bounds, area))
+					{
+						f(entry.id);
+					}
+				}
+			}
+		}
+	}
+
+	template <class Id>
+	inline void SpatialHash2D<Id>::query(const RectF& area, Array<Id>& results) const
+	{
+		results.clear();
+
+		query(area, [&results](const Id& id) { results.push_back(id); });
+	}
+
+	template <class Id>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, const Id&, const Id&>>*>
+	inline void SpatialHash2D<Id>::queryPairs(Fty f) const
+	{
+		for (const auto& [key, indices] : m_cells)
+		{
+			const int32 x = static_cast<int32>(static_cast<uint32>(key >> 32));
+			const int32 y = static_cast<int32>(static_cast<uint32>(key));
+			const size_t count = indices.size();
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const Entry& a = m_entries[indices[i]];
+
+				for (size_t k = (i + 1); k < count; ++k)
+				{
+					const Entry& b = m_entries[indices[k]];
+
+					// 2 つの要素が共有する最初のセルでだけ報告する
+					if ((Max(a.cells.x0, b.cells.x0) != x)
+						|| (Max(a.cells.y0, b.cells.y0) != y))
+					{
+						continue;
+					}
+
+					if (detail::SpatialHashBoundsOverlap(a.bounds, b.bounds))
+					{
+						f(a.id, b.id);
+					}
+				}
+			}
+		}
+	}
+
+	template <class Id>
+	inline void SpatialHash2D<Id>::queryPairs(Array<std::pair<Id, Id>>& pairs) const
+	{
+		pairs.clear();
+
+		queryPairs([&pairs](const Id& a, const Id& b) { pairs.emplace_back(a, b); });
+	}
+
+	template <class Id>
+	template <class OtherId, class Fty, std::enable_if_t<std::is_invocable_v<Fty, const Id&, const OtherId&>>*>
+	inline void SpatialHash2D<Id>::queryPairs(const SpatialHash2D<OtherId>& other, Fty f) const
+	{
+		// 要素の少ない側から、多い側の空間ハッシュを検索する
+		if (other.size() < size())
+		{
+			for (const auto& b : other.m_entries)
+			{
+				query(b.bounds, [&](const Id& a) { f(a, b.id); });
+			}
+		}
+		else
+		{
+			for (const auto& a : m_entries)
+			{
+				other.query(a.bounds, [&](const OtherId& b) { f(a.id, b); });
+			}
+		}
+	}
+
+	template <class Id>
+	template <class OtherId>
+	inline void SpatialHash2D<Id>::queryPairs(const SpatialHash2D<OtherId>& other, Array<std::pair<Id, OtherId>>& pairs) const
+	{
+		pairs.clear();
+
+		queryPairs(other, [&pairs](const Id& a, const OtherId& b) { pairs.emplace_back(a, b); });
+	}
+
+	template <class Id>
+	inline constexpr uint64 SpatialHash2D<Id>::CellKey(const int32 x, const int32 y) noexcept
+	{
+		return ((static_cast<uint64>(static_cast<uint32>(x)) << 32) | static_cast<uint32>(y));
+	}
+
+	template <class Id>
+	inline typename SpatialHash2D<Id>::CellRange SpatialHash2D<Id>::toCellRange(const RectF& bounds) const noexcept
+	{
+		return{
+			static_cast<int32>(std::floor(bounds.x * m_inverseCellSize)),
+			static_cast<int32>(std::floor(bounds.y * m_inverseCellSize)),
+			static_cast<int32>(std::floor((bounds.x + bounds.w) * m_inverseCellSize)),
+			static_cast<int32>(std::floor((bounds.y + bounds.h) * m_inverseCellSize)) };
+	}
+
+	template <class Id>
+	inline void SpatialHash2D<Id>::addToCells(const uint32 index, const CellRange& cells)
+	{
+		for (int32 y = cells.y0; y <= cells.y1; ++y)
+		{
+			for (int32 x = cells.x0; x <= cells.x1; ++x)
+			{
+				m_cells[CellKey(x, y)].push_back(index);
+			}
+		}
+	}
+
+	template <class Id>
+	inline void SpatialHash2D<Id>::removeFromCells(const uint32 index, const CellRange& cells)
+	{
+		for (int32 y = cells.y0; y <= cells.y1; ++y)
+		{
+			for (int32 x = cells.x0; x <= cells.x1; ++x)
+			{
+				Array<uint32>& indices = m_cells[CellKey(x, y)];
+
+				// セル内の順序は問わないので、末尾と入れ替えて取り除く
+				for (auto& i : indices)
+				{
+					if (i == index)
+					{
+						i = indices.back();
+						indices.pop_back();
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	template <class Id>
+	inline void SpatialHash2D<Id>::replaceInCells(const uint32 oldIndex, const uint32 newIndex, const CellRange& cells)
+	{
+		for (int32 y = cells.y0; y <= cells.y1; ++y)
+		{
+			for (int32 x = cells.x0; x <= cells.x1; ++x)
+			{
+				for (auto& i : m_cells[CellKey(x, y)])
+				{
+					if (i == oldIndex)
+					{
+						i = newIndex;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	namespace Geometry2D
+	{
+		template <class IdA, class IdB, class CircleOfA, class CircleOfB>
+		inline void FilterIntersectingCircles(Array<std::pair<IdA, IdB>>& pairs, CircleOfA circleOfA, CircleOfB circleOfB)
+		{
+			pairs.remove_if([&](const std::pair<IdA, IdB>& pair)
+				{
+					return (not Geometry2D::Intersect(circleOfA(pair.first), circleOfB(pair.second)));
+				});
+		}
+
+		template <class IdA, class IdB, class RectOfA, class RectOfB>
+		inline void FilterIntersectingRects(Array<std::pair<IdA, IdB>>& pairs, RectOfA rectOfA, RectOfB rectOfB)
+		{
+			pairs.remove_if([&](const std::pair<IdA, IdB>& pair)
+				{
+					return (not detail::SpatialHashBoundsOverlap(rectOfA(pair.first), rectOfB(pair.second)));
+				});
+		}
+	}
+}
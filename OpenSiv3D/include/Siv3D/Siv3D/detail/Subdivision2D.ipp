@@ -23,6 +23,61 @@ namespace s3d
 		return (not m_internal.isEmpty());
 	}
 
+	inline Array<Subdivision2D::VertexID> Subdivision2D::addPointsSorted(const Array<Vec2>& points)
+	{
+		Array<VertexID> vertexIDs(points.size());
+
+		if (not points)
+		{
+			return vertexIDs;
+		}
+
+		double minX = Math::Inf, minY = Math::Inf;
+		double maxX = -Math::Inf, maxY = -Math::Inf;
+
+		for (const auto& point : points)
+		{
+			if (IsFinite(point.x) && IsFinite(point.y))
+			{
+				minX = Min(minX, point.x);
+				minY = Min(minY, point.y);
+				maxX = Max(maxX, point.x);
+				maxY = Max(maxY, point.y);
+			}
+		}
+
+		// 点の範囲を 16-bit の格子に量子化して、モートン順序で並べ替える
+		const double scaleX = ((minX < maxX) ? (65535.0 / (maxX - minX)) : 0.0);
+		const double scaleY = ((minY < maxY) ? (65535.0 / (maxY - minY)) : 0.0);
+
+		const auto quantize = [](const double t)
+		{
+			return static_cast<uint16>((0.0 <= t) ? Min(t, 65535.0) : 0.0);
+		};
+
+		Array<std::pair<Morton32, uint32>> order(points.size());
+
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			const uint16 x = quantize((points[i].x - minX) * scaleX);
+			const uint16 y = quantize((points[i].y - minY) * scaleY);
+			order[i] = { Morton::Encode2D32(x, y), static_cast<uint32>(i) };
+		}
+
+		std::sort(order.begin(), order.end());
+
+		// 1 つの点につき、頂点が 1 つと辺が 3 本追加される
+		m_internal.vertices.reserve(m_internal.vertices.size() + points.size());
+		m_internal.qEdges.reserve(m_internal.qEdges.size() + points.size() * 3);
+
+		for (const auto& [morton, index] : order)
+		{
+			vertexIDs[index] = addPoint(points[index]);
+		}
+
+		return vertexIDs;
+	}
+
 	inline constexpr Subdivision2D::Vertex::Vertex(const Vec2& _pt, const bool _isvirtual, const int32 _firstEdge)
 		: firstEdge{ _firstEdge }
 		, type{ _isvirtual }
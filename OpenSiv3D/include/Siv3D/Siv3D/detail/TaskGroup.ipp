@@ -0,0 +1,324 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	namespace detail
+	{
+		inline WorkStealingPool::WorkStealingPool(const size_t numWorkers)
+			: m_numWorkers{ numWorkers }
+		{
+			// ワーカーごとのキュー + ワーカー以外のスレッドが使う共有キュー
+			m_queues.reserve(numWorkers + 1);
+
+			for (size_t i = 0; i < (numWorkers + 1); ++i)
+			{
+				m_queues.push_back(std::make_unique<Queue>());
+			}
+
+			m_workers.reserve(numWorkers);
+
+			for (size_t i = 0; i < numWorkers; ++i)
+			{
+				m_workers.emplace_back([this, i]() { workerMain(i); });
+			}
+		}
+
+		inline WorkStealingPool::~WorkStealingPool()
+		{
+			{
+				std::lock_guard lock{ m_sleepMutex };
+				m_stop = true;
+			}
+
+			m_sleepCondition.notify_all();
+
+			for (auto& worker : m_workers)
+			{
+				worker.join();
+			}
+		}
+
+		inline size_t WorkStealingPool::numWorkers() const noexcept
+		{
+			return m_numWorkers;
+		}
+
+		inline void WorkStealingPool::submit(Job job)
+		{
+			const size_t queueIndex = Min(CurrentWorkerIndex(), numWorkers());
+
+			{
+				Queue& queue = *m_queues[queueIndex];
+				std::lock_guard lock{ queue.mutex };
+				queue.jobs.push_back(std::move(job));
+			}
+
+			m_queuedCount.fetch_add(1, std::memory_order_release);
+
+			if (m_numWorkers)
+			{
+				// 待機に入ろうとしているワーカーが通知を取りこぼさないよう、ロックを経由してから起こす
+				{
+					std::lock_guard lock{ m_sleepMutex };
+				}
+
+				m_sleepCondition.notify_one();
+			}
+		}
+
+		inline bool WorkStealingPool::tryRunOne()
+		{
+			const size_t queueIndex = Min(CurrentWorkerIndex(), numWorkers());
+
+			Job job;
+
+			if ((not pop(queueIndex, job))
+				&& (not steal(queueIndex, job)))
+			{
+				return false;
+			}
+
+			m_queuedCount.fetch_sub(1, std::memory_order_relaxed);
+
+			job();
+
+			return true;
+		}
+
+		inline WorkStealingPool& WorkStealingPool::Get()
+		{
+		# if !SIV3D_PLATFORM(WEB) || defined(__EMSCRIPTEN_PTHREADS__)
+			static WorkStealingPool pool{ Max<size_t>(Threading::GetConcurrency(), 1) - 1 };
+		# else
+			static WorkStealingPool pool{ 0 };
+		# endif
+			return pool;
+		}
+
+		inline size_t& WorkStealingPool::CurrentWorkerIndex() noexcept
+		{
+			static thread_local size_t index = SIZE_MAX;
+			return index;
+		}
+
+		inline bool WorkStealingPool::pop(const size_t queueIndex, Job& job)
+		{
+			Queue& queue = *m_queues[queueIndex];
+			std::lock_guard lock{ queue.mutex };
+
+			if (queue.jobs.empty())
+			{
+				return false;
+			}
+
+			// 自分のキューからは最後に積んだ (小さな) ジョブを取り出す
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+
+			return true;
+		}
+
+		inline bool WorkStealingPool::steal(const size_t thiefIndex, Job& job)
+		{
+			const size_t numQueues = m_queues.size();
+
+			for (size_t i = 1; i < numQueues; ++i)
+			{
+				Queue& queue = *m_queues[(thiefIndex + i) % numQueues];
+				std::lock_guard lock{ queue.mutex };
+
+				if (queue.jobs.empty())
+				{
+					continue;
+				}
+
+				// 他のキューからは最初に積まれた (大きな) ジョブを盗む
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+
+				return true;
+			}
+
+			return false;
+		}
+
+		inline void WorkStealingPool::workerMain(const size_t workerIndex)
+		{
+			CurrentWorkerIndex() = workerIndex;
+
+			for (;;)
+			{
+				if (tryRunOne())
+				{
+					continue;
+				}
+
+				std::unique_lock lock{ m_sleepMutex };
+
+				m_sleepCondition.wait(lock, [this]()
+				{
+					return (m_stop || (m_queuedCount.load(std::memory_order_acquire) != 0));
+				});
+
+				if (m_stop)
+				{
+					return;
+				}
+			}
+		}
+
+		template <class Fty>
+		inline void InvokeParallelForRange(Fty& f, const size_t first, const size_t last)
+		{
+			if constexpr (std::is_invocable_v<Fty&, size_t, size_t>)
+			{
+				f(first, last);
+			}
+			else
+			{
+				for (size_t i = first; i < last; ++i)
+				{
+					f(i);
+				}
+			}
+		}
+
+		template <class Fty>
+		inline void ParallelForSplit(TaskGroup& group, const size_t first, size_t last, const size_t grain, Fty& f)
+		{
+			// 後半をタスクとして積みながら、前半を自分で処理する
+			while (grain < (last - first))
+			{
+				const size_t middle = (first + (last - first) / 2);
+
+				group.run([&group, middle, last, grain, &f]()
+				{
+					ParallelForSplit(group, middle, last, grain, f);
+				});
+
+				last = middle;
+			}
+
+			InvokeParallelForRange(f, first, last);
+		}
+	}
+
+	inline TaskGroup::~TaskGroup()
+	{
+		waitPending();
+	}
+
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty>>*>
+	inline void TaskGroup::run(Fty f)
+	{
+		m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+
+		detail::WorkStealingPool::Get().submit([this, f = std::move(f)]() mutable
+		{
+			try
+			{
+				f();
+			}
+			catch (...)
+			{
+				std::lock_guard lock{ m_exceptionMutex };
+
+				if (not m_exception)
+				{
+					m_exception = std::current_exception();
+				}
+			}
+
+			m_pendingCount.fetch_sub(1, std::memory_order_release);
+		});
+	}
+
+	inline void TaskGroup::wait()
+	{
+		waitPending();
+
+		std::exception_ptr exception;
+		{
+			std::lock_guard lock{ m_exceptionMutex };
+			exception = std::exchange(m_exception, nullptr);
+		}
+
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+
+	inline bool TaskGroup::isDone() const noexcept
+	{
+		return (m_pendingCount.load(std::memory_order_acquire) == 0);
+	}
+
+	inline void TaskGroup::waitPending() noexcept
+	{
+		detail::WorkStealingPool& pool = detail::WorkStealingPool::Get();
+
+		// 待っている間も、キューに残っているタスクを実行する
+		while (not isDone())
+		{
+			if (not pool.tryRunOne())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	template <class Fty, std::enable_if_t<std::disjunction_v<std::is_invocable<Fty, size_t>, std::is_invocable<Fty, size_t, size_t>>>*>
+	inline void parallel_for(const size_t first, const size_t last, size_t grain, Fty f)
+	{
+		if (last <= first)
+		{
+			return;
+		}
+
+		const size_t count = (last - first);
+
+		if (grain == 0)
+		{
+			if (count <= Threading::ParallelSerialCutoff)
+			{
+				detail::InvokeParallelForRange(f, first, last);
+				return;
+			}
+
+			// ワーカーあたり数個の塊に分かれる程度の粒度にし、処理時間の偏りを盗み合いで吸収する
+			const size_t numThreads = (detail::WorkStealingPool::Get().numWorkers() + 1);
+			grain = Max<size_t>(1, (count / (numThreads * 8)));
+		}
+
+		if ((count <= grain)
+			|| (detail::WorkStealingPool::Get().numWorkers() == 0))
+		{
+			detail::InvokeParallelForRange(f, first, last);
+			return;
+		}
+
+		TaskGroup group;
+
+		detail::ParallelForSplit(group, first, last, grain, f);
+
+		group.wait();
+	}
+
+	template <class Fty, std::enable_if_t<std::disjunction_v<std::is_invocable<Fty, size_t>, std::is_invocable<Fty, size_t, size_t>>>*>
+	inline void parallel_for(const size_t first, const size_t last, Fty f)
+	{
+		parallel_for(first, last, 0, std::move(f));
+	}
+}
@@ -0,0 +1,324 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	template <class Type, size_t TileSize, class Allocator>
+	inline TiledGrid<Type, TileSize, Allocator>::TiledGrid(const size_type w, const size_type h)
+		: m_data(TilesFor(w) * TilesFor(h) * TileCells)
+		, m_width{ w }
+		, m_height{ h }
+		, m_tilesX{ TilesFor(w) } {}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline TiledGrid<Type, TileSize, Allocator>::TiledGrid(const size_type w, const size_type h, const value_type& value)
+		: m_data(TilesFor(w) * TilesFor(h) * TileCells, value)
+		, m_width{ w }
+		, m_height{ h }
+		, m_tilesX{ TilesFor(w) } {}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline TiledGrid<Type, TileSize, Allocator>::TiledGrid(const Size size)
+		: TiledGrid(size.x, size.y) {}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline TiledGrid<Type, TileSize, Allocator>::TiledGrid(const Size size, const value_type& value)
+		: TiledGrid(size.x, size.y, value) {}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline TiledGrid<Type, TileSize, Allocator>::TiledGrid(const Grid<Type, Allocator>& grid)
+		: TiledGrid(grid.width(), grid.height())
+	{
+		for (size_type y = 0; y < m_height; ++y)
+		{
+			const value_type* pSrc = grid[y];
+
+			for (size_type x = 0; x < m_width; ++x)
+			{
+				m_data[indexOf(x, y)] = pSrc[x];
+			}
+		}
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	template <class T, std::enable_if_t<std::is_same_v<T, Color>>*>
+	inline TiledGrid<Type, TileSize, Allocator>::TiledGrid(const Image& image)
+		: TiledGrid(image.width(), image.height())
+	{
+		for (size_type y = 0; y < m_height; ++y)
+		{
+			const Color* pSrc = image[y];
+
+			for (size_type x = 0; x < m_width; ++x)
+			{
+				m_data[indexOf(x, y)] = pSrc[x];
+			}
+		}
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline bool TiledGrid<Type, TileSize, Allocator>::inBounds(const int64 y, const int64 x) const noexcept
+	{
+		return ((0 <= y) && (y < static_cast<int64>(m_height))
+			&& (0 <= x) && (x < static_cast<int64>(m_width)));
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline bool TiledGrid<Type, TileSize, Allocator>::inBounds(const Point pos) const noexcept
+	{
+		return inBounds(pos.y, pos.x);
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline typename TiledGrid<Type, TileSize, Allocator>::value_type& TiledGrid<Type, TileSize, Allocator>::at(const Point pos)
+	{
+		if (not inBounds(pos))
+		{
+			throw std::out_of_range("TiledGrid::at(): index out of range");
+		}
+
+		return m_data[indexOf(pos.x, pos.y)];
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline const typename TiledGrid<Type, TileSize, Allocator>::value_type& TiledGrid<Type, TileSize, Allocator>::at(const Point pos) const
+	{
+		if (not inBounds(pos))
+		{
+			throw std::out_of_range("TiledGrid::at(): index out of range");
+		}
+
+		return m_data[indexOf(pos.x, pos.y)];
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline typename TiledGrid<Type, TileSize, Allocator>::value_type& TiledGrid<Type, TileSize, Allocator>::operator [](const Point pos) noexcept
+	{
+		return m_data[indexOf(pos.x, pos.y)];
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline const typename TiledGrid<Type, TileSize, Allocator>::value_type& TiledGrid<Type, TileSize, Allocator>::operator [](const Point pos) const noexcept
+	{
+		return m_data[indexOf(pos.x, pos.y)];
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	template <class U>
+	inline typename TiledGrid<Type, TileSize, Allocator>::value_type TiledGrid<Type, TileSize, Allocator>::fetch(const Point pos, U&& defaultValue) const
+	{
+		if (not inBounds(pos))
+		{
+			return std::forward<U>(defaultValue);
+		}
+
+		return m_data[indexOf(pos.x, pos.y)];
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline bool TiledGrid<Type, TileSize, Allocator>::empty() const noexcept
+	{
+		return ((m_width == 0) || (m_height == 0));
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline bool TiledGrid<Type, TileSize, Allocator>::isEmpty() const noexcept
+	{
+		return empty();
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline TiledGrid<Type, TileSize, Allocator>::operator bool() const noexcept
+	{
+		return (not empty());
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline typename TiledGrid<Type, TileSize, Allocator>::size_type TiledGrid<Type, TileSize, Allocator>::width() const noexcept
+	{
+		return m_width;
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline typename TiledGrid<Type, TileSize, Allocator>::size_type TiledGrid<Type, TileSize, Allocator>::height() const noexcept
+	{
+		return m_height;
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline Size TiledGrid<Type, TileSize, Allocator>::size() const noexcept
+	{
+		return{ m_width, m_height };
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline typename TiledGrid<Type, TileSize, Allocator>::size_type TiledGrid<Type, TileSize, Allocator>::num_elements() const noexcept
+	{
+		return (m_width * m_height);
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline const typename TiledGrid<Type, TileSize, Allocator>::container_type& TiledGrid<Type, TileSize, Allocator>::storage() const noexcept
+	{
+		return m_data;
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline TiledGrid<Type, TileSize, Allocator>& TiledGrid<Type, TileSize, Allocator>::fill(const value_type& value)
+	{
+		m_data.fill(value);
+
+		return *this;
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type&>>*>
+	inline TiledGrid<Type, TileSize, Allocator>& TiledGrid<Type, TileSize, Allocator>::each(Fty f)
+	{
+		auto g = [&f](Point, value_type& value) { f(value); };
+
+		eachIndexImpl(m_data.data(), g);
+
+		return *this;
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Type>>*>
+	inline const TiledGrid<Type, TileSize, Allocator>& TiledGrid<Type, TileSize, Allocator>::each(Fty f) const
+	{
+		auto g = [&f](Point, const value_type& value) { f(value); };
+
+		eachIndexImpl(m_data.data(), g);
+
+		return *this;
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Point, Type&>>*>
+	inline TiledGrid<Type, TileSize, Allocator>& TiledGrid<Type, TileSize, Allocator>::each_index(Fty f)
+	{
+		eachIndexImpl(m_data.data(), f);
+
+		return *this;
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	template <class Fty, std::enable_if_t<std::is_invocable_v<Fty, Point, Type>>*>
+	inline const TiledGrid<Type, TileSize, Allocator>& TiledGrid<Type, TileSize, Allocator>::each_index(Fty f) const
+	{
+		eachIndexImpl(m_data.data(), f);
+
+		return *this;
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline Grid<Type, Allocator> TiledGrid<Type, TileSize, Allocator>::asGrid() const
+	{
+		Grid<Type, Allocator> grid(m_width, m_height);
+
+		for (size_type y = 0; y < m_height; ++y)
+		{
+			value_type* pDst = grid[y];
+
+			for (size_type x = 0; x < m_width; ++x)
+			{
+				pDst[x] = m_data[indexOf(x, y)];
+			}
+		}
+
+		return grid;
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	template <class T, std::enable_if_t<std::is_same_v<T, Color>>*>
+	inline Image TiledGrid<Type, TileSize, Allocator>::toImage() const
+	{
+		Image image(m_width, m_height);
+
+		for (size_type y = 0; y < m_height; ++y)
+		{
+			Color* pDst = image[y];
+
+			for (size_type x = 0; x < m_width; ++x)
+			{
+				pDst[x] = m_data[indexOf(x, y)];
+			}
+		}
+
+		return image;
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline void TiledGrid<Type, TileSize, Allocator>::swap(TiledGrid& other) noexcept
+	{
+		m_data.swap(other.m_data);
+		std::swap(m_width, other.m_width);
+		std::swap(m_height, other.m_height);
+		std::swap(m_tilesX, other.m_tilesX);
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline constexpr typename TiledGrid<Type, TileSize, Allocator>::size_type TiledGrid<Type, TileSize, Allocator>::TilesFor(const size_type n) noexcept
+	{
+		return ((n + (TileSize - 1)) / TileSize);
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline typename TiledGrid<Type, TileSize, Allocator>::size_type TiledGrid<Type, TileSize, Allocator>::indexOf(const size_type x, const size_type y) const noexcept
+	{
+		const size_type tileIndex = (((y / TileSize) * m_tilesX) + (x / TileSize));
+		const uint32 cellIndex = Morton::Encode2D32(static_cast<uint16>(x % TileSize), static_cast<uint16>(y % TileSize));
+
+		return ((tileIndex * TileCells) + cellIndex);
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	template <class Pointer, class Fty>
+	inline void TiledGrid<Type, TileSize, Allocator>::eachIndexImpl(Pointer data, Fty& f) const
+	{
+		const size_type tilesY = TilesFor(m_height);
+
+		for (size_type ty = 0; ty < tilesY; ++ty)
+		{
+			const size_type y0 = (ty * TileSize);
+
+			for (size_type tx = 0; tx < m_tilesX; ++tx)
+			{
+				const size_type x0 = (tx * TileSize);
+				const bool isFullTile = (((x0 + TileSize) <= m_width) && ((y0 + TileSize) <= m_height));
+
+				for (uint32 i = 0; i < TileCells; ++i, ++data)
+				{
+					const Point cell = Morton::Decode2D32(i);
+					const size_type x = (x0 + static_cast<size_type>(cell.x));
+					const size_type y = (y0 + static_cast<size_type>(cell.y));
+
+					// 端数のタイルの余白はスキップする
+					if ((not isFullTile)
+						&& ((m_width <= x) || (m_height <= y)))
+					{
+						continue;
+					}
+
+					f(Point{ x, y }, *data);
+				}
+			}
+		}
+	}
+
+	template <class Type, size_t TileSize, class Allocator>
+	inline void swap(TiledGrid<Type, TileSize, Allocator>& a, TiledGrid<Type, TileSize, Allocator>& b) noexcept
+	{
+		a.swap(b);
+	}
+}
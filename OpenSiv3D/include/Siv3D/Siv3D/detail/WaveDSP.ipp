@@ -0,0 +1,513 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+
+namespace s3d
+{
+	namespace detail
+	{
+		/// @brief リサンプリングのフィルタの片側のゼロ交差の数
+		inline constexpr int32 WaveResampleZeroCrossings = 16;
+
+		/// @brief リサンプリングのフィルタの位相の分割数
+		inline constexpr int32 WaveResamplePhases = 256;
+
+		/// @brief 並列処理で 1 つのタスクが受け持つ出力のサンプル数
+		inline constexpr size_t WaveResampleBlockSize = 4096;
+
+		/// @brief リサンプリング用のポリフェーズフィルタ
+		struct WaveResampleFilter
+		{
+			/// @brief 1 つの位相のタップ数
+			int32 taps = 0;
+
+			/// @brief 位相ごとの重み。左右のチャンネル用に、各重みが 2 回ずつ並んでいます
+			Array<float> weights;
+
+			/// @brief 次の位相の重みとの差
+			Array<float> deltas;
+
+			WaveResampleFilter(const uint32 srcSampleRate, const uint32 dstSampleRate)
+			{
+				const double cutoff = Min(1.0, (static_cast<double>(dstSampleRate) / srcSampleRate));
+				const int32 halfTaps = static_cast<int32>(std::ceil(WaveResampleZeroCrossings / cutoff));
+				taps = (halfTaps * 2);
+
+				// 位相 p は、出力位置の小数部分が p / WaveResamplePhases のときのフィルタ
+				Array<float> table(static_cast<size_t>(WaveResamplePhases + 1) * taps);
+
+				for (int32 p = 0; p <= WaveResamplePhases; ++p)
+				{
+					const double frac = (static_cast<double>(p) / WaveResamplePhases);
+					float* row = (table.data() + static_cast<size_t>(p) * taps);
+					double sum = 0.0;
+
+					for (int32 t = 0; t < taps; ++t)
+					{
+						const double x = ((t - (halfTaps - 1)) - frac);
+						const double s = (cutoff * x);
+						const double sinc = ((s == 0.0) ? 1.0 : (std::sin(Math::Pi * s) / (Math::Pi * s)));
+						const double u = (Math::Pi * x / halfTaps);
+						const double window = ((std::abs(x) < halfTaps) ? (0.42 + 0.5 * std::cos(u) + 0.08 * std::cos(2.0 * u)) : 0.0);
+						const double w = (sinc * window);
+						row[t] = static_cast<float>(w);
+						sum += w;
+					}
+
+					for (int32 t = 0; t < taps; ++t)
+					{
+						row[t] = static_cast<float>(row[t] / sum);
+					}
+				}
+
+				weights.resize(static_cast<size_t>(WaveResamplePhases) * taps * 2);
+				deltas.resize(weights.size());
+
+				for (int32 p = 0; p < WaveResamplePhases; ++p)
+				{
+					const float* row = (table.data() + static_cast<size_t>(p) * taps);
+					const float* next = (row + taps);
+
+					for (int32 t = 0; t < taps; ++t)
+					{
+						const size_t i = ((static_cast<size_t>(p) * taps + t) * 2);
+						weights[i] = weights[i + 1] = row[t];
+						deltas[i] = deltas[i + 1] = (next[t] - row[t]);
+					}
+				}
+			}
+		};
+
+		[[nodiscard]]
+		inline __m128 WaveGainRamp(const float startGain, const float step, const size_t i) noexcept
+		{
+			const float g0 = (startGain + step * static_cast<float>(i));
+			const float g1 = (startGain + step * static_cast<float>(i + 1));
+			return _mm_setr_ps(g0, g0, g1, g1);
+		}
+	}
+
+	namespace WaveDSP
+	{
+		inline void MixAdd(WaveSample* dst, const WaveSample* src, const size_t count, const float gain) noexcept
+		{
+			MixAddRamp(dst, src, count, gain, gain);
+		}
+
+		inline void MixAddRamp(WaveSample* dst, const WaveSample* src, const size_t count, const float startGain, const float endGain) noexcept
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			const float step = ((endGain - startGain) / count);
+			float* pDst = reinterpret_cast<float*>(dst);
+			const float* pSrc = reinterpret_cast<const float*>(src);
+			size_t i = 0;
+
+			if (step == 0.0f)
+			{
+				const __m128 gain = _mm_set1_ps(startGain);
+
+				for (; (i + 2) <= count; i += 2)
+				{
+					const __m128 s = _mm_loadu_ps(pSrc + i * 2);
+					_mm_storeu_ps((pDst + i * 2), _mm_add_ps(_mm_loadu_ps(pDst + i * 2), _mm_mul_ps(s, gain)));
+				}
+			}
+			else
+			{
+				for (; (i + 2) <= count; i += 2)
+				{
+					const __m128 s = _mm_loadu_ps(pSrc + i * 2);
+					_mm_storeu_ps((pDst + i * 2), _mm_add_ps(_mm_loadu_ps(pDst + i * 2), _mm_mul_ps(s, detail::WaveGainRamp(startGain, step, i))));
+				}
+			}
+
+			for (; i < count; ++i)
+			{
+				const float gain = (startGain + step * static_cast<float>(i));
+				dst[i].left += (src[i].left * gain);
+				dst[i].right += (src[i].right * gain);
+			}
+		}
+
+		inline void MixAdd(Wave& dst, const Wave& src, const float gain, const size_t dstOffset)
+		{
+			MixAddRamp(dst, src, gain, gain, dstOffset);
+		}
+
+		inline void MixAddRamp(Wave& dst, const Wave& src, const float startGain, const float endGain, const size_t dstOffset)
+		{
+			if (src.isEmpty())
+			{
+				return;
+			}
+
+			if (&src == &dst)
+			{
+				const Wave copy = src;
+				MixAddRamp(dst, copy, startGain, endGain, dstOffset);
+				return;
+			}
+
+			if (dst.size() < (dstOffset + src.size()))
+			{
+				dst.resize((dstOffset + src.size()), WaveSample::Zero());
+			}
+
+			MixAddRamp((dst.data() + dstOffset), src.data(), src.size(), startGain, endGain);
+		}
+
+		inline void ApplyGain(WaveSample* samples, const size_t count, const float gain) noexcept
+		{
+			ApplyGainRamp(samples, count, gain, gain);
+		}
+
+		inline void ApplyGainRamp(WaveSample* samples, const size_t count, const float startGain, const float endGain) noexcept
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			const float step = ((endGain - startGain) / count);
+			float* p = reinterpret_cast<float*>(samples);
+			size_t i = 0;
+
+			if (step == 0.0f)
+			{
+				const __m128 gain = _mm_set1_ps(startGain);
+
+				for (; (i + 2) <= count; i += 2)
+				{
+					_mm_storeu_ps((p + i * 2), _mm_mul_ps(_mm_loadu_ps(p + i * 2), gain));
+				}
+			}
+			else
+			{
+				for (; (i + 2) <= count; i += 2)
+				{
+					_mm_storeu_ps((p + i * 2), _mm_mul_ps(_mm_loadu_ps(p + i * 2), detail::WaveGainRamp(startGain, step, i)));
+				}
+			}
+
+			for (; i < count; ++i)
+			{
+				const float gain = (startGain + step * static_cast<float>(i));
+				samples[i].left *= gain;
+				samples[i].right *= gain;
+			}
+		}
+
+		inline void ApplyGain(Wave& wave, const float gain) noexcept
+		{
+			ApplyGain(wave.data(), wave.size(), gain);
+		}
+
+		inline void ApplyGainRamp(Wave& wave, const float startGain, const float endGain) noexcept
+		{
+			ApplyGainRamp(wave.data(), wave.size(), startGain, endGain);
+		}
+
+		inline void Resample(const Wave& src, Wave& dst, const uint32 targetSampleRate)
+		{
+			if (not InRange(targetSampleRate, Wave::MinSampleRate, Wave::MaxSampleRate))
+			{
+				throw Error{ U"WaveDSP::Resample(): targetSampleRate {} is out of range"_fmt(targetSampleRate) };
+			}
+
+			const uint32 srcSampleRate = src.sampleRate();
+			const size_t srcLength = src.size();
+
+			if ((srcSampleRate == targetSampleRate) || (srcLength == 0))
+			{
+				if (&src != &dst)
+				{
+					dst.assign(src.begin(), src.end());
+				}
+
+				dst.setSampleRate(targetSampleRate);
+				return;
+			}
+
+			const detail::WaveResampleFilter filter{ srcSampleRate, targetSampleRate };
+			const int32 halfTaps = (filter.taps / 2);
+
+			// 前後を無音で埋めた入力
+			Array<WaveSample> padded(srcLength + static_cast<size_t>(filter.taps) + 2, WaveSample::Zero());
+			std::memcpy((padded.data() + halfTaps), src.data(), src.size_bytes());
+
+			const size_t dstLength = static_cast<size_t>(((static_cast<uint64>(srcLength) * targetSampleRate) + srcSampleRate - 1) / srcSampleRate);
+			dst.resize(dstLength);
+			dst.setSampleRate(targetSampleRate);
+
+			const float* input = reinterpret_cast<const float*>(padded.data());
+			WaveSample* output = dst.data();
+
+			auto processBlock = [&, input, output](const size_t block)
+			{
+				const size_t first = (block * detail::WaveResampleBlockSize);
+				const size_t last = Min((first + detail::WaveResampleBlockSize), dstLength);
+
+				for (size_t j = first; j < last; ++j)
+				{
+					// 入力上の位置を整数で正確に求める
+					const uint64 numerator = (static_cast<uint64>(j) * srcSampleRate);
+					const size_t position = static_cast<size_t>(numerator / targetSampleRate);
+					const double phase = (static_cast<double>(numerator % targetSampleRate) * detail::WaveResamplePhases / targetSampleRate);
+					const size_t p = static_cast<size_t>(phase);
+					const __m128 t = _mm_set1_ps(static_cast<float>(phase - p));
+
+					const float* x = (input + (position + 1) * 2);
+					const float* w = (filter.weights.data() + p * filter.taps * 2);
+					const float* d = (filter.deltas.data() + p * filter.taps * 2);
+					__m128 sum = _mm_setzero_ps();
+
+					for (int32 k = 0; k < (filter.taps * 2); k += 4)
+					{
+						const __m128 weight = _mm_add_ps(_mm_loadu_ps(w + k), _mm_mul_ps(t, _mm_loadu_ps(d + k)));
+						sum = _mm_add_ps(sum, _mm_mul_ps(weight, _mm_loadu_ps(x + k)));
+					}
+
+					alignas(16) float s[4];
+					_mm_store_ps(s, sum);
+					output[j] = WaveSample{ (s[0] + s[2]), (s[1] + s[3]) };
+				}
+			};
+
+			const size_t numBlocks = ((dstLength + detail::WaveResampleBlockSize - 1) / detail::WaveResampleBlockSize);
+
+		# ifndef SIV3D_NO_CONCURRENT_API
+
+			if (1 < numBlocks)
+			{
+				parallel_for(0, numBlocks, 1, processBlock);
+				return;
+			}
+
+		# endif
+
+			for (size_t i = 0; i < numBlocks; ++i)
+			{
+				processBlock(i);
+			}
+		}
+
+		inline Wave Resample(const Wave& src, const uint32 targetSampleRate)
+		{
+			Wave result;
+
+			Resample(src, result, targetSampleRate);
+
+			return result;
+		}
+
+		inline void ToInt16(const WaveSample* src, const size_t count, WaveSampleS16* dst) noexcept
+		{
+			const float* pSrc = reinterpret_cast<const float*>(src);
+			const __m128 scale = _mm_set1_ps(32768.0f);
+			const __m128 minValue = _mm_set1_ps(-32768.0f);
+			const __m128 maxValue = _mm_set1_ps(32767.0f);
+			size_t i = 0;
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(pSrc + i * 2), scale), minValue), maxValue);
+				const __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(pSrc + i * 2 + 4), scale), minValue), maxValue);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b)));
+			}
+
+			for (; i < count; ++i)
+			{
+				dst[i] = src[i].asWaveSampleS16();
+			}
+		}
+
+		inline void ToInt16(const Wave& src, Array<WaveSampleS16>& dst)
+		{
+			dst.resize(src.size());
+
+			ToInt16(src.data(), src.size(), dst.data());
+		}
+
+		inline void FromInt16(const WaveSampleS16* src, const size_t count, WaveSample* dst) noexcept
+		{
+			float* pDst = reinterpret_cast<float*>(dst);
+			const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+			size_t i = 0;
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+				const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+				_mm_storeu_ps((pDst + i * 2), _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+				_mm_storeu_ps((pDst + i * 2 + 4), _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+			}
+
+			for (; i < count; ++i)
+			{
+				dst[i] = src[i].asWaveSample();
+			}
+		}
+
+		inline void FromInt16(const Array<WaveSampleS16>& src, Wave& dst)
+		{
+			dst.resize(src.size());
+
+			FromInt16(src.data(), src.size(), dst.data());
+		}
+
+		inline WaveSample Peak(const WaveSample* samples, const size_t count) noexcept
+		{
+			const float* p = reinterpret_cast<const float*>(samples);
+			const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+			__m128 peak = _mm_setzero_ps();
+			size_t i = 0;
+
+			for (; (i + 2) <= count; i += 2)
+			{
+				peak = _mm_max_ps(peak, _mm_and_ps(_mm_loadu_ps(p + i * 2), absMask));
+			}
+
+			alignas(16) float v[4];
+			_mm_store_ps(v, peak);
+			WaveSample result{ Max(v[0], v[2]), Max(v[1], v[3]) };
+
+			for (; i < count; ++i)
+			{
+				result.left = Max(result.left, std::abs(samples[i].left));
+				result.right = Max(result.right, std::abs(samples[i].right));
+			}
+
+			return result;
+		}
+
+		inline WaveSample Peak(const Wave& wave) noexcept
+		{
+			return Peak(wave.data(), wave.size());
+		}
+
+		inline WaveSample RMS(const WaveSample* samples, const size_t count) noexcept
+		{
+			if (count == 0)
+			{
+				return WaveSample::Zero();
+			}
+
+			const float* p = reinterpret_cast<const float*>(samples);
+			__m128d sum0 = _mm_setzero_pd();
+			__m128d sum1 = _mm_setzero_pd();
+			size_t i = 0;
+
+			for (; (i + 2) <= count; i += 2)
+			{
+				const __m128 v = _mm_loadu_ps(p + i * 2);
+				const __m128d lo = _mm_cvtps_pd(v);
+				const __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+				sum0 = _mm_add_pd(sum0, _mm_mul_pd(lo, lo));
+				sum1 = _mm_add_pd(sum1, _mm_mul_pd(hi, hi));
+			}
+
+			alignas(16) double s[2];
+			_mm_store_pd(s, _mm_add_pd(sum0, sum1));
+
+			for (; i < count; ++i)
+			{
+				s[0] += (static_cast<double>(samples[i].left) * samples[i].left);
+				s[1] += (static_cast<double>(samples[i].right) * samples[i].right);
+			}
+
+			return{ static_cast<float>(std::sqrt(s[0] / count)), static_cast<float>(std::sqrt(s[1] / count)) };
+		}
+
+		inline WaveSample RMS(const Wave& wave) noexcept
+		{
+			return RMS(wave.data(), wave.size());
+		}
+
+		inline void Deinterleave(const WaveSample* src, const size_t count, float* left, float* right) noexcept
+		{
+			const float* p = reinterpret_cast<const float*>(src);
+			size_t i = 0;
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const __m128 a = _mm_loadu_ps(p + i * 2);
+				const __m128 b = _mm_loadu_ps(p + i * 2 + 4);
+				_mm_storeu_ps((left + i), _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+				_mm_storeu_ps((right + i), _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+			}
+
+			for (; i < count; ++i)
+			{
+				const WaveSample sample = src[i];
+				left[i] = sample.left;
+				right[i] = sample.right;
+			}
+		}
+
+		inline void Interleave(const float* left, const float* right, const size_t count, WaveSample* dst) noexcept
+		{
+			float* p = reinterpret_cast<float*>(dst);
+			size_t i = 0;
+
+			for (; (i + 4) <= count; i += 4)
+			{
+				const __m128 l = _mm_loadu_ps(left + i);
+				const __m128 r = _mm_loadu_ps(right + i);
+				_mm_storeu_ps((p + i * 2), _mm_unpacklo_ps(l, r));
+				_mm_storeu_ps((p + i * 2 + 4), _mm_unpackhi_ps(l, r));
+			}
+
+			for (; i < count; ++i)
+			{
+				dst[i] = WaveSample{ left[i], right[i] };
+			}
+		}
+
+		inline void Deinterleave(Wave& wave)
+		{
+			const size_t count = wave.size();
+
+			if (count == 0)
+			{
+				return;
+			}
+
+			Array<float> right(count);
+			float* p = reinterpret_cast<float*>(wave.data());
+
+			// 左チャンネルは読み込んだ位置より前にしか書き込まれないので、その場で詰められる
+			Deinterleave(wave.data(), count, p, right.data());
+
+			std::memcpy((p + count), right.data(), (count * sizeof(float)));
+		}
+
+		inline void Interleave(Wave& wave)
+		{
+			const size_t count = wave.size();
+
+			if (count == 0)
+			{
+				return;
+			}
+
+			Array<float> channels(count * 2);
+			std::memcpy(channels.data(), wave.data(), wave.size_bytes());
+
+			Interleave(channels.data(), (channels.data() + count), count, wave.data());
+		}
+	}
+}
@@ -0,0 +1,919 @@
+﻿//-----------------------------------------------
+//
+//	This file is part of the Siv3D Engine.
+//
+//	Copyright (c) 2008-2023 Ryo Suzuki
+//	Copyright (c) 2016-2023 OpenSiv3D Project
+//
+//	Licensed under the MIT License.
+//
+//-----------------------------------------------
+
+# pragma once
+# include <atomic>
+# include <cstring>
+# include <limits>
+# include "../FileSystem.hpp"
+# include "../BinaryWriter.hpp"
+# include "../Unicode.hpp"
+# include "../Threading.hpp"
+
+// zconf.h はグローバル名前空間に Byte を定義し、`using namespace s3d;` の下で s3d::Byte と曖昧になるため別名にする
+# define Byte ZLibByte
+# include <ThirdParty/zlib/zlib.h>
+# undef Byte
+
+namespace s3d
+{
+	namespace detail
+	{
+		[[nodiscard]]
+		inline uint16 ReadZIP16(const uint8* p) noexcept
+		{
+			return static_cast<uint16>(p[0] | (p[1] << 8));
+		}
+
+		[[nodiscard]]
+		inline uint32 ReadZIP32(const uint8* p) noexcept
+		{
+			return (static_cast<uint32>(p[0]) | (static_cast<uint32>(p[1]) << 8) | (static_cast<uint32>(p[2]) << 16) | (static_cast<uint32>(p[3]) << 24));
+		}
+
+		[[nodiscard]]
+		inline uint64 ReadZIP64(const uint8* p) noexcept
+		{
+			return (static_cast<uint64>(ReadZIP32(p)) | (static_cast<uint64>(ReadZIP32(p + 4)) << 32));
+		}
+
+		/// @brief CRC-32 を更新します。
+		/// @param crc これまでのデータの CRC-32。最初は 0
+		/// @param data データ
+		/// @param size データのサイズ（バイト）
+		/// @return 更新した CRC-32
+		[[nodiscard]]
+		inline uint32 UpdateZIPCRC32(const uint32 crc, const void* data, const size_t size) noexcept
+		{
+			return static_cast<uint32>(::crc32_z(crc, static_cast<const Bytef*>(data), size));
+		}
+
+		/// @brief Deflate 形式のデータを、出力先の空きに合わせて少しずつ展開するクラス
+		/// @remark 圧縮データはすべてメモリ上にあるものとし、zlib の `inflate()` で展開します。状態は zlib の 32 KiB のスライディングウィンドウと展開の状態だけです。
+		/// @remark zlib の状態は `z_stream` のアドレスを保持するため、移動はできません。
+		class ZIPInflater
+		{
+		public:
+
+			static constexpr size_t WindowSize = (size_t{ 1 } << MAX_WBITS);
+
+			/// @brief zlib の展開の状態（`inflate_state`）の大きさの目安
+			static constexpr size_t StateSize = (8 << 10);
+
+			ZIPInflater(const uint8* input, const size_t inputSize)
+				: m_input{ input }
+				, m_inputSize{ inputSize }
+			{
+				// ZIP のデータは zlib のヘッダを持たない raw Deflate のため、ウィンドウのビット数を負にする
+				m_initialized = (::inflateInit2(&m_stream, -MAX_WBITS) == Z_OK);
+
+				if (not m_initialized)
+				{
+					m_state = State::Error;
+				}
+			}
+
+			ZIPInflater(const ZIPInflater& other)
+				: m_input{ other.m_input }
+				, m_inputSize{ other.m_inputSize }
+				, m_consumed{ other.m_consumed }
+				, m_state{ other.m_state }
+			{
+				m_initialized = (other.m_initialized && (::inflateCopy(&m_stream, const_cast<z_stream*>(&other.m_stream)) == Z_OK));
+
+				if (not m_initialized)
+				{
+					m_state = State::Error;
+				}
+			}
+
+			ZIPInflater& operator =(const ZIPInflater&) = delete;
+
+			~ZIPInflater()
+			{
+				if (m_initialized)
+				{
+					::inflateEnd(&m_stream);
+				}
+			}
+
+			/// @brief データを展開します。
+			/// @param dst 出力先
+			/// @param size 展開する最大のサイズ（バイト）
+			/// @return 展開したサイズ（バイト）。データの終端に達するかエラーが発生した場合は size より小さくなります
+			size_t inflate(uint8* dst, const size_t size)
+			{
+				size_t produced = 0;
+
+				while ((produced < size) && (m_state == State::Inflating))
+				{
+					// avail_in と avail_out は 32 ビットのため、4 GiB を超えるデータは分けて渡す
+					if (m_stream.avail_in == 0)
+					{
+						const size_t chunk = Min<size_t>((m_inputSize - m_consumed), std::numeric_limits<uInt>::max());
+						m_stream.next_in = const_cast<Bytef*>(m_input + m_consumed);
+						m_stream.avail_in = static_cast<uInt>(chunk);
+						m_consumed += chunk;
+					}
+
+					const uInt avail = static_cast<uInt>(Min<size_t>((size - produced), std::numeric_limits<uInt>::max()));
+					m_stream.next_out = (dst + produced);
+					m_stream.avail_out = avail;
+
+					const int result = ::inflate(&m_stream, Z_NO_FLUSH);
+					produced += (avail - m_stream.avail_out);
+
+					if (result == Z_STREAM_END)
+					{
+						m_state = State::Done;
+					}
+					else if ((result != Z_OK)
+						// 入力を使い切っても終端に達しない場合は、データが途中で切れている
+						|| ((m_stream.avail_in == 0) && (m_consumed == m_inputSize) && (m_stream.avail_out != 0)))
+					{
+						m_state = State::Error;
+					}
+				}
+
+				return produced;
+			}
+
+			[[nodiscard]]
+			bool hasError() const noexcept
+			{
+				return (m_state == State::Error);
+			}
+
+		private:
+
+			enum class State : uint8
+			{
+				Inflating,
+
+				Done,
+
+				Error,
+			};
+
+			const uint8* m_input = nullptr;
+
+			size_t m_inputSize = 0;
+
+			/// @brief zlib に渡し終えた入力のサイズ（バイト）
+			size_t m_consumed = 0;
+
+			z_stream m_stream{};
+
+			State m_state = State::Inflating;
+
+			/// @brief `m_stream` を inflateEnd() で解放する必要がある場合 true
+			bool m_initialized = false;
+		};
+
+		/// @brief `*` と `?` を含むパターンに文字列が一致するかを返します。
+		[[nodiscard]]
+		inline bool MatchZIPPattern(const StringView pattern, const StringView s) noexcept
+		{
+			size_t p = 0, i = 0;
+			size_t starP = StringView::npos, starI = 0;
+
+			while (i < s.size())
+			{
+				if ((p < pattern.size()) && ((pattern[p] == U'?') || (pattern[p] == s[i])))
+				{
+					++p;
+					++i;
+				}
+				else if ((p < pattern.size()) && (pattern[p] == U'*'))
+				{
+					starP = p++;
+					starI = i;
+				}
+				else if (starP != StringView::npos)
+				{
+					p = (starP + 1);
+					i = ++starI;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			while ((p < pattern.size()) && (pattern[p] == U'*'))
+			{
+				++p;
+			}
+
+			return (p == pattern.size());
+		}
+
+		/// @brief アーカイブ内のパスが、展開先のディレクトリの外を指さないかを返します。
+		[[nodiscard]]
+		inline bool IsSafeZIPPath(const StringView path) noexcept
+		{
+			if (path.isEmpty() || (path[0] == U'/') || path.includes(U':'))
+			{
+				return false;
+			}
+
+			size_t begin = 0;
+
+			while (begin <= path.size())
+			{
+				size_t end = path.indexOf(U'/', begin);
+
+				if (end == StringView::npos)
+				{
+					end = path.size();
+				}
+
+				if (path.substr(begin, (end - begin)) == U"..")
+				{
+					return false;
+				}
+
+				begin = (end + 1);
+			}
+
+			return true;
+		}
+	}
+
+	inline bool ZIPEntryInfo::isDirectory() const noexcept
+	{
+		return path.ends_with(U'/');
+	}
+
+	inline bool ZIPEntryInfo::isStored() const noexcept
+	{
+		return (method == 0);
+	}
+
+	inline bool ZIPEntryInfo::isSupported() const noexcept
+	{
+		return (((method == 0) || (method == 8)) && (not encrypted));
+	}
+
+	inline ZIPEntryReader::ZIPEntryReader() = default;
+
+	inline ZIPEntryReader::ZIPEntryReader(const MemoryMappedFileView& file, const ZIPEntryInfo& entry)
+	{
+		if ((not file) || (not entry.isSupported()) || entry.isDirectory())
+		{
+			return;
+		}
+
+		m_file = file;
+		m_data = (reinterpret_cast<const uint8*>(file.data()) + entry.dataOffset);
+		m_compressedSize = static_cast<int64>(entry.compressedSize);
+		m_size = static_cast<int64>(entry.uncompressedSize);
+		m_expectedCRC = entry.crc32;
+
+		if (not entry.isStored())
+		{
+			m_inflater = std::make_unique<detail::ZIPInflater>(m_data, static_cast<size_t>(m_compressedSize));
+		}
+	}
+
+	inline ZIPEntryReader::ZIPEntryReader(const ZIPEntryReader& other)
+		: m_file{ other.m_file }
+		, m_data{ other.m_data }
+		, m_compressedSize{ other.m_compressedSize }
+		, m_size{ other.m_size }
+		, m_pos{ other.m_pos }
+		, m_expectedCRC{ other.m_expectedCRC }
+		, m_crc{ other.m_crc }
+		, m_crcPos{ other.m_crcPos }
+		, m_error{ other.m_error }
+		, m_inflater{ other.m_inflater ? std::make_unique<detail::ZIPInflater>(*other.m_inflater) : nullptr } {}
+
+	inline ZIPEntryReader::ZIPEntryReader(ZIPEntryReader&&) noexcept = default;
+
+	inline ZIPEntryReader::~ZIPEntryReader() = default;
+
+	inline ZIPEntryReader& ZIPEntryReader::operator =(const ZIPEntryReader& other)
+	{
+		if (this != &other)
+		{
+			ZIPEntryReader tmp{ other };
+			*this = std::move(tmp);
+		}
+
+		return *this;
+	}
+
+	inline ZIPEntryReader& ZIPEntryReader::operator =(ZIPEntryReader&&) noexcept = default;
+
+	inline bool ZIPEntryReader::supportsLookahead() const noexcept
+	{
+		return (m_data && (not m_inflater));
+	}
+
+	inline bool ZIPEntryReader::isOpen() const noexcept
+	{
+		return (m_data != nullptr);
+	}
+
+	inline int64 ZIPEntryReader::size() const
+	{
+		return m_size;
+	}
+
+	inline int64 ZIPEntryReader::getPos() const
+	{
+		return m_pos;
+	}
+
+	inline bool ZIPEntryReader::setPos(const int64 pos)
+	{
+		if ((not isOpen()) || (pos < 0) || (m_size < pos))
+		{
+			return false;
+		}
+
+		if (not m_inflater)
+		{
+			m_pos = pos;
+			return true;
+		}
+
+		if (pos < m_pos)
+		{
+			rewind();
+		}
+
+		// 目的の位置まで展開して読み捨てる
+		uint8 buffer[4096];
+
+		while (m_pos < pos)
+		{
+			if (readForward(buffer, Min<int64>(sizeof(buffer), (pos - m_pos))) == 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	inline int64 ZIPEntryReader::skip(const int64 offset)
+	{
+		setPos(Clamp<int64>((m_pos + offset), 0, m_size));
+		return m_pos;
+	}
+
+	inline int64 ZIPEntryReader::read(void* dst, const int64 size)
+	{
+		if ((not isOpen()) || (size <= 0))
+		{
+			return 0;
+		}
+
+		return readForward(dst, size);
+	}
+
+	inline int64 ZIPEntryReader::read(void* dst, const int64 pos, const int64 size)
+	{
+		if (not setPos(pos))
+		{
+			return 0;
+		}
+
+		return read(dst, size);
+	}
+
+	SIV3D_CONCEPT_TRIVIALLY_COPYABLE_
+	inline bool ZIPEntryReader::read(TriviallyCopyable& dst)
+	{
+		return (read(std::addressof(dst), sizeof(TriviallyCopyable)) == sizeof(TriviallyCopyable));
+	}
+
+	inline int64 ZIPEntryReader::lookahead(void* dst, const int64 size) const
+	{
+		return lookahead(dst, m_pos, size);
+	}
+
+	inline int64 ZIPEntryReader::lookahead(void* dst, const int64 pos, const int64 size) const
+	{
+		if ((not isOpen()) || (pos < 0) || (m_size < pos) || (size <= 0))
+		{
+			return 0;
+		}
+
+		if (not m_inflater)
+		{
+			const int64 n = Min(size, (m_size - pos));
+			std::memcpy(dst, (m_data + pos), static_cast<size_t>(n));
+			return n;
+		}
+
+		ZIPEntryReader reader{ *this };
+		return reader.read(dst, pos, size);
+	}
+
+	SIV3D_CONCEPT_TRIVIALLY_COPYABLE_
+	inline bool ZIPEntryReader::lookahead(TriviallyCopyable& dst) const
+	{
+		return (lookahead(std::addressof(dst), sizeof(TriviallyCopyable)) == sizeof(TriviallyCopyable));
+	}
+
+	inline bool ZIPEntryReader::hasError() const noexcept
+	{
+		return m_error;
+	}
+
+	inline void ZIPEntryReader::rewind()
+	{
+		m_inflater = std::make_unique<detail::ZIPInflater>(m_data, static_cast<size_t>(m_compressedSize));
+		m_pos = 0;
+		m_crc = 0;
+		m_crcPos = 0;
+	}
+
+	inline int64 ZIPEntryReader::readForward(void* dst, const int64 size)
+	{
+		int64 n = Min(size, (m_size - m_pos));
+
+		if (n <= 0)
+		{
+			return 0;
+		}
+
+		if (m_inflater)
+		{
+			const int64 inflated = static_cast<int64>(m_inflater->inflate(static_cast<uint8*>(dst), static_cast<size_t>(n)));
+
+			if (inflated < n)
+			{
+				m_error = true;
+				n = inflated;
+			}
+		}
+		else
+		{
+			std::memcpy(dst, (m_data + m_pos), static_cast<size_t>(n));
+		}
+
+		// 先頭から連続して読み込んでいる場合だけ CRC-32 を計算する
+		if (m_crcPos == m_pos)
+		{
+			m_crc = detail::UpdateZIPCRC32(m_crc, dst, static_cast<size_t>(n));
+			m_crcPos += n;
+
+			if ((m_crcPos == m_size) && (m_crc != m_expectedCRC))
+			{
+				m_error = true;
+			}
+		}
+
+		m_pos += n;
+		return n;
+	}
+
+	inline ZIPArchiveView::ZIPArchiveView(const FilePathView path)
+	{
+		open(path);
+	}
+
+	inline bool ZIPArchiveView::open(const FilePathView path)
+	{
+		close();
+
+		MemoryMappedFileView file{ path, MapAll::Yes };
+
+		if (not file)
+		{
+			return false;
+		}
+
+		const uint8* data = reinterpret_cast<const uint8*>(file.data());
+		const size_t size = file.mappedSize();
+
+		constexpr size_t EndRecordSize = 22;
+
+		if ((not data) || (size < EndRecordSize))
+		{
+			return false;
+		}
+
+		// 末尾のコメント（最大 65535 バイト）を飛ばして、セントラルディレクトリの終端レコードを探す
+		const size_t searchFirst = ((EndRecordSize + 0xFFFF) < size) ? (size - EndRecordSize - 0xFFFF) : 0;
+		size_t endRecord = (size - EndRecordSize);
+
+		while (detail::ReadZIP32(data + endRecord) != 0x06054b50)
+		{
+			if (endRecord == searchFirst)
+			{
+				return false;
+			}
+
+			--endRecord;
+		}
+
+		uint64 numEntries = detail::ReadZIP16(data + endRecord + 10);
+		uint64 directorySize = detail::ReadZIP32(data + endRecord + 12);
+		uint64 directoryOffset = detail::ReadZIP32(data + endRecord + 16);
+
+		// ZIP64
+		if ((20 <= endRecord) && (detail::ReadZIP32(data + endRecord - 20) == 0x07064b50))
+		{
+			const uint64 zip64Record = detail::ReadZIP64(data + endRecord - 20 + 8);
+
+			if (((zip64Record + 56) <= size) && (detail::ReadZIP32(data + zip64Record) == 0x06064b50))
+			{
+				numEntries = detail::ReadZIP64(data + zip64Record + 32);
+				directorySize = detail::ReadZIP64(data + zip64Record + 40);
+				directoryOffset = detail::ReadZIP64(data + zip64Record + 48);
+			}
+		}
+
+		if ((size < directoryOffset) || ((size - directoryOffset) < directorySize))
+		{
+			return false;
+		}
+
+		Array<ZIPEntryInfo> entries;
+		entries.reserve(static_cast<size_t>(Min<uint64>(numEntries, (directorySize / 46))));
+
+		const uint8* p = (data + directoryOffset);
+		const uint8* const directoryEnd = (p + directorySize);
+
+		for (uint64 i = 0; i < numEntries; ++i)
+		{
+			if (((directoryEnd - p) < 46) || (detail::ReadZIP32(p) != 0x02014b50))
+			{
+				return false;
+			}
+
+			const uint16 flags = detail::ReadZIP16(p + 8);
+			const size_t nameLength = detail::ReadZIP16(p + 28);
+			const size_t extraLength = detail::ReadZIP16(p + 30);
+			const size_t commentLength = detail::ReadZIP16(p + 32);
+
+			if (static_cast<size_t>(directoryEnd - p) < (46 + nameLength + extraLength + commentLength))
+			{
+				return false;
+			}
+
+			ZIPEntryInfo entry;
+			entry.method = detail::ReadZIP16(p + 10);
+			entry.crc32 = detail::ReadZIP32(p + 16);
+			entry.compressedSize = detail::ReadZIP32(p + 20);
+			entry.uncompressedSize = detail::ReadZIP32(p + 24);
+			entry.encrypted = ((flags & 1) != 0);
+			uint64 localOffset = detail::ReadZIP32(p + 42);
+
+			// ZIP64 拡張情報
+			for (const uint8* extra = (p + 46 + nameLength); (extra + 4) <= (p + 46 + nameLength + extraLength);)
+			{
+				const uint16 id = detail::ReadZIP16(extra);
+				const uint16 length = detail::ReadZIP16(extra + 2);
+				const uint8* field = (extra + 4);
+				const uint8* const fieldEnd = (field + length);
+
+				if ((p + 46 + nameLength + extraLength) < fieldEnd)
+				{
+					break;
+				}
+
+				if (id == 0x0001)
+				{
+					if ((entry.uncompressedSize == 0xFFFFFFFF) && ((field + 8) <= fieldEnd))
+					{
+						entry.uncompressedSize = detail::ReadZIP64(field);
+						field += 8;
+					}
+
+					if ((entry.compressedSize == 0xFFFFFFFF) && ((field + 8) <= fieldEnd))
+					{
+						entry.compressedSize = detail::ReadZIP64(field);
+						field += 8;
+					}
+
+					if ((localOffset == 0xFFFFFFFF) && ((field + 8) <= fieldEnd))
+					{
+						localOffset = detail::ReadZIP64(field);
+					}
+				}
+
+				extra = fieldEnd;
+			}
+
+			entry.path = Unicode::FromUTF8(std::string_view{ reinterpret_cast<const char*>(p + 46), nameLength }).replace(U'\\', U'/');
+
+			// ローカルファイルヘッダを飛ばしてデータの位置を求める
+			if ((size < localOffset) || ((size - localOffset) < 30) || (detail::ReadZIP32(data + localOffset) != 0x04034b50))
+			{
+				return false;
+			}
+
+			entry.dataOffset = (localOffset + 30 + detail::ReadZIP16(data + localOffset + 26) + detail::ReadZIP16(data + localOffset + 28));
+
+			if (entry.isSupported() && ((size < entry.dataOffset) || ((size - entry.dataOffset) < entry.compressedSize)))
+			{
+				return false;
+			}
+
+			if (entry.isStored() && (entry.compressedSize != entry.uncompressedSize))
+			{
+				return false;
+			}
+
+			entries << std::move(entry);
+			p += (46 + nameLength + extraLength + commentLength);
+		}
+
+		m_file = std::move(file);
+		m_entries = std::move(entries);
+
+		for (size_t i = 0; i < m_entries.size(); ++i)
+		{
+			m_paths << m_entries[i].path;
+			m_index.emplace(m_entries[i].path, i);
+		}
+
+		return true;
+	}
+
+	inline void ZIPArchiveView::close()
+	{
+		m_file = MemoryMappedFileView{};
+		m_entries.clear();
+		m_paths.clear();
+		m_index.clear();
+	}
+
+	inline bool ZIPArchiveView::isOpen() const
+	{
+		return m_file.isOpen();
+	}
+
+	inline ZIPArchiveView::operator bool() const
+	{
+		return isOpen();
+	}
+
+	inline const Array<FilePath>& ZIPArchiveView::enumPaths() const noexcept
+	{
+		return m_paths;
+	}
+
+	inline const Array<ZIPEntryInfo>& ZIPArchiveView::entries() const noexcept
+	{
+		return m_entries;
+	}
+
+	inline Optional<ZIPEntryInfo> ZIPArchiveView::getEntry(const FilePathView path) const
+	{
+		if (const auto index = findEntry(path))
+		{
+			return m_entries[*index];
+		}
+
+		return none;
+	}
+
+	inline ZIPEntryReader ZIPArchiveView::openEntry(const FilePathView path) const
+	{
+		if (const auto index = findEntry(path))
+		{
+			return ZIPEntryReader{ m_file, m_entries[*index] };
+		}
+
+		return{};
+	}
+
+	inline MemoryViewReader ZIPArchiveView::viewStored(const FilePathView path) const
+	{
+		if (const auto index = findEntry(path))
+		{
+			const ZIPEntryInfo& entry = m_entries[*index];
+
+			if (entry.isStored() && (not entry.isDirectory()))
+			{
+				return MemoryViewReader{ (m_file.data() + entry.dataOffset), static_cast<size_t>(entry.uncompressedSize) };
+			}
+		}
+
+		return{};
+	}
+
+	inline Blob ZIPArchiveView::extractToBlob(const FilePathView path) const
+	{
+		ZIPEntryReader reader = openEntry(path);
+
+		if (not reader.isOpen())
+		{
+			return{};
+		}
+
+		Blob blob(static_cast<size_t>(reader.size()));
+
+		if ((reader.read(blob.data(), reader.size()) != reader.size()) || reader.hasError())
+		{
+			return{};
+		}
+
+		return blob;
+	}
+
+	inline bool ZIPArchiveView::extractAll(const FilePathView targetDirectory, const size_t memoryBudget) const
+	{
+		Array<size_t> indices(m_entries.size());
+
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			indices[i] = i;
+		}
+
+		return extractEntries(indices, targetDirectory, memoryBudget);
+	}
+
+	inline bool ZIPArchiveView::extractFiles(const StringView pattern, const FilePathView targetDirectory, const size_t memoryBudget) const
+	{
+		Array<size_t> indices;
+
+		for (size_t i = 0; i < m_entries.size(); ++i)
+		{
+			if (detail::MatchZIPPattern(pattern, m_entries[i].path))
+			{
+				indices << i;
+			}
+		}
+
+		return extractEntries(indices, targetDirectory, memoryBudget);
+	}
+
+	inline Optional<size_t> ZIPArchiveView::findEntry(const FilePathView path) const
+	{
+		if (const auto it = m_index.find(FilePath{ path }); it != m_index.end())
+		{
+			return it->second;
+		}
+
+		return none;
+	}
+
+	inline bool ZIPArchiveView::extractEntry(const ZIPEntryInfo& entry, const FilePathView targetDirectory, Array<uint8>& buffer) const
+	{
+		if (not entry.isSupported())
+		{
+			return false;
+		}
+
+		BinaryWriter writer{ (FilePath{ targetDirectory } + entry.path) };
+
+		if (not writer)
+		{
+			return false;
+		}
+
+		if (entry.isStored())
+		{
+			// 無圧縮のファイルはメモリマップトファイルから直接書き込む
+			const Byte* data = (m_file.data() + entry.dataOffset);
+			const int64 size = static_cast<int64>(entry.uncompressedSize);
+
+			return ((writer.write(data, size) == size)
+				&& (detail::UpdateZIPCRC32(0, data, static_cast<size_t>(size)) == entry.crc32));
+		}
+
+		ZIPEntryReader reader{ m_file, entry };
+
+		for (;;)
+		{
+			const int64 n = reader.read(buffer.data(), static_cast<int64>(buffer.size()));
+
+			if (n <= 0)
+			{
+				break;
+			}
+
+			if (writer.write(buffer.data(), n) != n)
+			{
+				return false;
+			}
+		}
+
+		return ((reader.getPos() == reader.size()) && (not reader.hasError()));
+	}
+
+	inline bool ZIPArchiveView::extractEntries(const Array<size_t>& indices, const FilePathView targetDirectory, const size_t memoryBudget) const
+	{
+		if (not isOpen())
+		{
+			return false;
+		}
+
+		FilePath directory{ targetDirectory };
+
+		if (directory && (not directory.ends_with(U'/')))
+		{
+			directory.push_back(U'/');
+		}
+
+		bool result = true;
+
+		// ディレクトリはタスクの間で競合しないよう、先にまとめて作成する
+		HashTable<FilePath, bool> directories;
+		Array<size_t> files;
+
+		for (const size_t index : indices)
+		{
+			const ZIPEntryInfo& entry = m_entries[index];
+
+			if (not detail::IsSafeZIPPath(entry.path))
+			{
+				result = false;
+				continue;
+			}
+
+			const size_t slash = entry.path.lastIndexOf(U'/');
+
+			if (slash != String::npos)
+			{
+				directories.emplace((directory + entry.path.substr(0, (slash + 1))), true);
+			}
+			else if (directory)
+			{
+				directories.emplace(directory, true);
+			}
+
+			if (not entry.isDirectory())
+			{
+				files << index;
+			}
+		}
+
+		for (const auto& [path, unused] : directories)
+		{
+			if ((not FileSystem::Exists(path)) && (not FileSystem::CreateDirectories(path)))
+			{
+				result = false;
+			}
+		}
+
+		if (not files)
+		{
+			return result;
+		}
+
+		// 同時に展開するファイルの数を、メモリの上限とスレッド数から決める
+		constexpr size_t MemoryPerTask = (ExtractBufferSize + detail::ZIPInflater::WindowSize + detail::ZIPInflater::StateSize + sizeof(detail::ZIPInflater));
+		const size_t numTasks = Min({ Max<size_t>(Threading::GetConcurrency(), 1), Max<size_t>((memoryBudget / MemoryPerTask), 1), files.size() });
+
+		// 大きいファイルから順に、最も負荷の小さいタスクに割り当てる
+		files.sort_by([&](size_t a, size_t b) { return (m_entries[b].compressedSize < m_entries[a].compressedSize); });
+
+		Array<Array<size_t>> tasks(numTasks);
+		Array<uint64> loads(numTasks, 0);
+
+		for (const size_t index : files)
+		{
+			const size_t task = static_cast<size_t>(std::min_element(loads.begin(), loads.end()) - loads.begin());
+			tasks[task] << index;
+			loads[task] += (m_entries[index].compressedSize + 1);
+		}
+
+		std::atomic<bool> succeeded{ result };
+
+		const auto runTask = [&](const size_t task)
+		{
+			Array<uint8> buffer(ExtractBufferSize);
+
+			for (const size_t index : tasks[task])
+			{
+				if (not extractEntry(m_entries[index], directory, buffer))
+				{
+					succeeded = false;
+				}
+			}
+		};
+
+	# ifndef SIV3D_NO_CONCURRENT_API
+
+		if (1 < numTasks)
+		{
+			parallel_for(0, numTasks, 1, runTask);
+			return succeeded;
+		}
+
+	# endif
+
+		for (size_t task = 0; task < numTasks; ++task)
+		{
+			runTask(task);
+		}
+
+		return succeeded;
+	}
+}
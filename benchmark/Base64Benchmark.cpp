@@ -0,0 +1,118 @@
+//
+// Base64 のエンコード・デコードのスループットのベンチマーク
+//
+// ビルド方法は benchmark/README.md を参照してください。
+// Multiplayer_Photon がイベントの送受信で行う変換（先頭に 1 文字付けたエンコードと、そのデコード）を、
+// 文字列や Blob を毎回作成する方法と、バッファを使い回す方法で比較します。
+//
+
+# include <Siv3D.hpp>
+# include "BenchmarkCommon.hpp"
+
+namespace
+{
+	constexpr size_t Iterations = 9;
+
+	/// @brief 1 回の計測で処理する合計バイト数の目安
+	constexpr size_t BytesPerMeasurement = (16 << 20);
+
+	/// @brief f を複数回実行し、処理時間の中央値とスループットを出力します。
+	/// @param bytes f が 1 回の実行で処理するバイト数
+	template <class Fty>
+	void MeasureThroughput(const StringView name, const size_t bytes, Fty f)
+	{
+		const double ms = MeasureMedian(Iterations, f);
+		Report(U"{}: {:.2f} ms ({:.1f} MB/s)"_fmt(name, ms, (bytes / (1024.0 * 1024.0) / (ms / 1000.0))));
+	}
+
+	void BenchmarkSize(const size_t size)
+	{
+		const size_t repeats = Max<size_t>(1, (BytesPerMeasurement / size));
+		const size_t totalBytes = (repeats * size);
+
+		Blob data(size);
+		Reseed(size);
+
+		for (auto& byte : data)
+		{
+			byte = Byte{ static_cast<uint8>(Random(0, 255)) };
+		}
+
+		std::string encoded;
+		Base64::Encode(data.data(), data.size(), encoded);
+		const std::string_view message{ encoded };
+
+		Console << U"--- {} bytes x {} ---"_fmt(size, repeats);
+
+		MeasureThroughput(U"Encode (new std::string + insert)", totalBytes, [&]()
+			{
+				size_t length = 0;
+
+				for (size_t i = 0; i < repeats; ++i)
+				{
+					std::string s;
+					Base64::Encode(data.data(), data.size(), s);
+					s.insert(s.begin(), '#');
+					length += s.size();
+				}
+
+				return length;
+			});
+
+		MeasureThroughput(U"Encode (char*, reused buffer)", totalBytes, [&]()
+			{
+				size_t length = 0;
+				std::string buffer;
+
+				for (size_t i = 0; i < repeats; ++i)
+				{
+					buffer.resize(1 + Base64::EncodedLength(data.size()));
+					buffer[0] = '#';
+					buffer.resize(1 + Base64::Encode(data.data(), data.size(), (buffer.data() + 1)));
+					length += buffer.size();
+				}
+
+				return length;
+			});
+
+		MeasureThroughput(U"Decode (new Blob)", totalBytes, [&]()
+			{
+				size_t length = 0;
+
+				for (size_t i = 0; i < repeats; ++i)
+				{
+					length += Base64::Decode(message, SkipValidation::Yes).size();
+				}
+
+				return length;
+			});
+
+		MeasureThroughput(U"Decode (reused Blob)", totalBytes, [&]()
+			{
+				size_t length = 0;
+				Blob buffer;
+
+				for (size_t i = 0; i < repeats; ++i)
+				{
+					Base64::Decode(message, buffer, SkipValidation::Yes);
+					length += buffer.size();
+				}
+
+				return length;
+			});
+	}
+}
+
+void Main()
+{
+	// 小さなイベントから、CPU のキャッシュに収まらない大きなデータまで
+	for (const size_t size : { 16, 64, 1024, (64 << 10), (1 << 20), (16 << 20) })
+	{
+		BenchmarkSize(size);
+	}
+
+	while (System::Update())
+	{
+
+	}
+}
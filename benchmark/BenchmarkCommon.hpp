@@ -0,0 +1,49 @@
+//
+// ベンチマークで共通に使う変数と関数
+//
+
+# pragma once
+# include <Siv3D.hpp>
+
+/// @brief 最適化で計算が省略されないように結果を書き込む先
+inline volatile uint64 g_sink = 0;
+
+/// @brief 計測結果をコンソールと画面に出力します。
+/// @param result 計測結果
+inline void Report(const String& result)
+{
+	Console << result;
+	Print << result;
+}
+
+/// @brief f を複数回実行し、処理時間の中央値を返します。
+/// @param iterations 実行する回数
+/// @param f 計測する関数。戻り値は g_sink に加算されます
+/// @return 処理時間の中央値（ミリ秒）
+template <class Fty>
+[[nodiscard]]
+double MeasureMedian(const size_t iterations, Fty f)
+{
+	Array<double> times(Max<size_t>(iterations, 1));
+
+	for (auto& time : times)
+	{
+		const uint64 start = Time::GetMicrosec();
+		g_sink = (g_sink + static_cast<uint64>(f()));
+		time = ((Time::GetMicrosec() - start) / 1000.0);
+	}
+
+	times.sort();
+
+	return times[times.size() / 2];
+}
+
+/// @brief f を複数回実行し、処理時間の中央値を出力します。
+/// @param name 項目名
+/// @param iterations 実行する回数
+/// @param f 計測する関数。戻り値は g_sink に加算されます
+template <class Fty>
+void Measure(const StringView name, const size_t iterations, Fty f)
+{
+	Report(U"{}: {:.2f} ms"_fmt(name, MeasureMedian(iterations, f)));
+}
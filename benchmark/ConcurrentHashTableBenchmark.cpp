@@ -0,0 +1,148 @@
+//
+// ConcurrentHashTable と、ミューテックスで保護した HashTable のベンチマーク
+//
+// ビルド方法は benchmark/README.md を参照してください。
+// 複数のスレッドを使うため、スレッドを有効にしてビルドする必要があります。
+//
+
+# include <Siv3D.hpp>
+# include "BenchmarkCommon.hpp"
+
+namespace
+{
+	constexpr size_t Iterations = 5;
+
+	/// @brief 挿入するキーの数
+	constexpr size_t NumKeys = (1 << 20);
+
+	/// @brief 1 つのキーあたりの検索回数
+	constexpr size_t LookupsPerKey = 4;
+
+	[[nodiscard]]
+	constexpr uint64 KeyAt(const size_t i) noexcept
+	{
+		return (i * 0x9E3779B97F4A7C15ull);
+	}
+
+	/// @brief numTasks 個のタスクに分けて、各タスクがキーの 1 区間を挿入したあと全体を検索します。
+	template <class Insert, class Lookup>
+	[[nodiscard]]
+	size_t InsertAndLookup(const size_t numTasks, Insert insert, Lookup lookup)
+	{
+		std::atomic<size_t> found = 0;
+
+		parallel_for(0, numTasks, 1, [&](const size_t task)
+			{
+				const size_t first = (NumKeys * task / numTasks);
+				const size_t last = (NumKeys * (task + 1) / numTasks);
+
+				for (size_t i = first; i < last; ++i)
+				{
+					insert(KeyAt(i), static_cast<uint32>(i));
+				}
+
+				size_t count = 0;
+
+				for (size_t n = 0; n < (LookupsPerKey * (last - first)); ++n)
+				{
+					count += lookup(KeyAt((first * 7 + n * 13) % NumKeys));
+				}
+
+				found += count;
+			});
+
+		return found;
+	}
+
+	void BenchmarkTasks(const size_t numTasks)
+	{
+		Console << U"--- {} task(s), {} keys, {} lookups ---"_fmt(numTasks, NumKeys, (NumKeys * LookupsPerKey));
+
+		Measure(U"HashTable + std::mutex", Iterations, [&]()
+			{
+				HashTable<uint64, uint32> table;
+				std::mutex mutex;
+
+				return InsertAndLookup(numTasks,
+					[&](const uint64 key, const uint32 value)
+					{
+						std::lock_guard lock{ mutex };
+						table.emplace(key, value);
+					},
+					[&](const uint64 key)
+					{
+						std::lock_guard lock{ mutex };
+						return table.contains(key);
+					});
+			});
+
+		Measure(U"HashTable + std::shared_mutex", Iterations, [&]()
+			{
+				HashTable<uint64, uint32> table;
+				std::shared_mutex mutex;
+
+				return InsertAndLookup(numTasks,
+					[&](const uint64 key, const uint32 value)
+					{
+						std::unique_lock lock{ mutex };
+						table.emplace(key, value);
+					},
+					[&](const uint64 key)
+					{
+						std::shared_lock lock{ mutex };
+						return table.contains(key);
+					});
+			});
+
+		Measure(U"ConcurrentHashTable", Iterations, [&]()
+			{
+				ConcurrentHashTable<uint64, uint32> table;
+
+				return InsertAndLookup(numTasks,
+					[&](const uint64 key, const uint32 value)
+					{
+						table.emplace(key, value);
+					},
+					[&](const uint64 key)
+					{
+						return table.contains(key);
+					});
+			});
+	}
+}
+
+void Main()
+{
+	const size_t concurrency = Max<size_t>(1, Threading::GetConcurrency());
+
+	BenchmarkTasks(1);
+
+	if (1 < concurrency)
+	{
+		BenchmarkTasks(concurrency);
+	}
+
+	// 保存は要素をコピーしてから書き出す
+	{
+		ConcurrentHashTable<uint64, uint32> table;
+
+		for (size_t i = 0; i < NumKeys; ++i)
+		{
+			table.emplace(KeyAt(i), static_cast<uint32>(i));
+		}
+
+		Console << U"--- save {} elements ---"_fmt(NumKeys);
+
+		Measure(U"ConcurrentHashTable save", Iterations, [&]()
+			{
+				Serializer<MemoryWriter> writer;
+				writer(table);
+				return static_cast<size_t>(writer->size());
+			});
+	}
+
+	while (System::Update())
+	{
+
+	}
+}
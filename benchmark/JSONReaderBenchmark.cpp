@@ -0,0 +1,120 @@
+//
+// JSON（DOM）と JSONReader の読み取りのベンチマーク
+//
+// ビルド方法は benchmark/README.md を参照してください。
+// example/ フォルダのファイルを使うため、`.vscode/Link.rsp` に `--preload-file example@/example` を追加してください。
+//
+
+# include <Siv3D.hpp>
+# include "BenchmarkCommon.hpp"
+
+namespace
+{
+	constexpr size_t Iterations = 9;
+
+	/// @brief 小さなファイルを 1 回の計測で読み取る回数
+	constexpr size_t SmallFileRepeats = 1000;
+
+	/// @brief データの終端まですべてのトークンを読み取り、トークンの数を返します。
+	[[nodiscard]]
+	size_t CountTokens(JSONReader& reader)
+	{
+		size_t count = 0;
+
+		for (;;)
+		{
+			const JSONTokenType type = reader.nextToken();
+
+			if ((type == JSONTokenType::End) || (type == JSONTokenType::Error))
+			{
+				return count;
+			}
+
+			++count;
+		}
+	}
+
+	void BenchmarkGeoJSON(const FilePathView path)
+	{
+		Console << U"--- {} ({} bytes) ---"_fmt(path, FileSystem::FileSize(path));
+
+		Measure(U"JSON::Load + names", Iterations, [&]()
+			{
+				const JSON json = JSON::Load(path);
+				Array<String> names;
+
+				for (const auto& feature : json[U"features"].arrayView())
+				{
+					names << feature[U"properties"][U"name"].getString();
+				}
+
+				return names.size();
+			});
+
+		Measure(U"JSONReader extract names", Iterations, [&]()
+			{
+				JSONReader reader{ path };
+				Array<String> names;
+
+				reader.extract(U"/features/*/properties/name", [&](JSONReader& r)
+					{
+						names << r.getString();
+					});
+
+				return names.size();
+			});
+
+		Measure(U"JSONReader all tokens", Iterations, [&]()
+			{
+				JSONReader reader{ path };
+				return CountTokens(reader);
+			});
+	}
+
+	void BenchmarkSmallFile(const FilePathView path)
+	{
+		const Blob blob{ path };
+		const std::string_view utf8{ reinterpret_cast<const char*>(blob.data()), blob.size() };
+
+		Console << U"--- {} ({} bytes) x {} ---"_fmt(path, blob.size(), SmallFileRepeats);
+
+		Measure(U"JSON::Load (memory)", Iterations, [&]()
+			{
+				size_t count = 0;
+
+				for (size_t i = 0; i < SmallFileRepeats; ++i)
+				{
+					count += JSON::Load(MemoryReader{ blob }).size();
+				}
+
+				return count;
+			});
+
+		Measure(U"JSONReader all tokens (memory)", Iterations, [&]()
+			{
+				size_t count = 0;
+
+				for (size_t i = 0; i < SmallFileRepeats; ++i)
+				{
+					JSONReader reader{ utf8 };
+					count += CountTokens(reader);
+				}
+
+				return count;
+			});
+	}
+}
+
+void Main()
+{
+	BenchmarkGeoJSON(U"example/geojson/countries.geojson");
+
+	BenchmarkSmallFile(U"example/json/config.json");
+
+	BenchmarkSmallFile(U"example/json/test.json");
+
+	while (System::Update())
+	{
+
+	}
+}
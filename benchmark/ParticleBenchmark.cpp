@@ -0,0 +1,185 @@
+//
+// ParticleSystem2D と BulkParticleSystem2D の更新のスループットのベンチマーク
+//
+// ビルド方法は benchmark/README.md を参照してください。
+// 同じパラメータとエミッタで、パーティクル数が上限に達した状態から 120 フレーム分を更新し、
+// 1 ミリ秒あたりに更新したパーティクル数を比較します（描画は含みません）。
+//
+
+# include <Siv3D.hpp>
+# include "BenchmarkCommon.hpp"
+
+namespace
+{
+	constexpr size_t Iterations = 5;
+
+	constexpr int32 Frames = 120;
+
+	constexpr double DeltaTime = (1.0 / 60.0);
+
+	constexpr double LifeTime = 2.0;
+
+	/// @brief f を複数回実行し、処理時間の中央値と 1 ミリ秒あたりに更新したパーティクル数を出力します。
+	/// @param f 更新したパーティクル数の合計を返す関数
+	template <class Fty>
+	void MeasureParticles(const StringView name, Fty f)
+	{
+		size_t particles = 0;
+
+		const double ms = MeasureMedian(Iterations, [&]()
+			{
+				particles = f();
+				return particles;
+			});
+
+		Report(U"{}: {:.2f} ms ({:.0f} particles/ms)"_fmt(name, ms, (particles / ms)));
+	}
+
+	/// @brief 円の中からランダムな方向に放出し、`emitBulk()` でまとめて放出するエミッタ
+	struct BulkCircleEmitter2D : IBulkEmitter2D
+	{
+		double sourceRadius = 5.0;
+
+		Emission2D emit(const Vec2& emitterPosition, const double startSpeed) override
+		{
+			return{ RandomVec2(Circle{ emitterPosition, sourceRadius }), RandomVec2(startSpeed) };
+		}
+
+		void emitBulk(const Vec2& emitterPosition, const double startSpeed, Emission2D* dst, const size_t count) override
+		{
+			auto& rng = GetDefaultRNG();
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				dst[i] = { RandomVec2(Circle{ emitterPosition, sourceRadius }, rng), RandomVec2(startSpeed, rng) };
+			}
+		}
+
+		void drawDebug(const Vec2& emitterPosition) const override
+		{
+			Circle{ emitterPosition, sourceRadius }.drawFrame(1.0, ColorF{ 1.0, 0.5 });
+		}
+	};
+
+	[[nodiscard]]
+	ParticleSystem2DParameters MakeParameters(const size_t maxParticles)
+	{
+		ParticleSystem2DParameters parameters;
+		parameters.maxParticles = static_cast<double>(maxParticles);
+		parameters.rate = (maxParticles / LifeTime);
+		parameters.startLifeTime = LifeTime;
+		parameters.startSpeed = 200.0;
+		parameters.startAngularVelocityDeg = 90.0;
+		return parameters;
+	}
+
+	/// @brief パーティクルシステムを上限まで満たしてから Frames フレーム更新し、更新したパーティクル数の合計を返します。
+	template <class System, class Emitter>
+	[[nodiscard]]
+	size_t Run(const size_t maxParticles, const Emitter& emitter)
+	{
+		System system{ Scene::CenterF(), Vec2{ 0, 100 }, emitter, MakeParameters(maxParticles), Texture{} };
+		system.prewarm();
+
+		size_t particles = 0;
+
+		for (int32 frame = 0; frame < Frames; ++frame)
+		{
+			particles += system.num_particles();
+			system.update(DeltaTime);
+		}
+
+		return particles;
+	}
+
+	void Benchmark(const size_t maxParticles)
+	{
+		Console << U"--- up to {} particles x {} frames ---"_fmt(maxParticles, Frames);
+
+		MeasureParticles(U"ParticleSystem2D (CircleEmitter2D)", [&]()
+			{
+				return Run<ParticleSystem2D>(maxParticles, CircleEmitter2D{});
+			});
+
+		MeasureParticles(U"BulkParticleSystem2D (CircleEmitter2D)", [&]()
+			{
+				return Run<BulkParticleSystem2D>(maxParticles, CircleEmitter2D{});
+			});
+
+		MeasureParticles(U"BulkParticleSystem2D (IBulkEmitter2D)", [&]()
+			{
+				return Run<BulkParticleSystem2D>(maxParticles, BulkCircleEmitter2D{});
+			});
+	}
+
+	/// @brief 複数のパーティクルシステムを 1 つずつ更新する場合と、UpdateAll() でまとめて更新する場合を比較します。
+	void BenchmarkUpdateAll(const size_t numSystems, const size_t maxParticles)
+	{
+		Console << U"--- {} systems, up to {} particles each x {} frames ---"_fmt(numSystems, maxParticles, Frames);
+
+		Array<BulkParticleSystem2D> systems;
+
+		for (size_t i = 0; i < numSystems; ++i)
+		{
+			systems.emplace_back(Scene::CenterF(), Vec2{ 0, 100 }, BulkCircleEmitter2D{}, MakeParameters(maxParticles), Texture{});
+			systems.back().prewarm();
+		}
+
+		Array<BulkParticleSystem2D*> pointers;
+
+		for (auto& system : systems)
+		{
+			pointers << &system;
+		}
+
+		const auto countParticles = [&]()
+		{
+			return systems.map([](const BulkParticleSystem2D& system) { return system.num_particles(); }).sum();
+		};
+
+		MeasureParticles(U"BulkParticleSystem2D::update() x systems", [&]()
+			{
+				size_t particles = 0;
+
+				for (int32 frame = 0; frame < Frames; ++frame)
+				{
+					particles += countParticles();
+
+					for (auto& system : systems)
+					{
+						system.update(DeltaTime);
+					}
+				}
+
+				return particles;
+			});
+
+		MeasureParticles(U"BulkParticleSystem2D::UpdateAll()", [&]()
+			{
+				size_t particles = 0;
+
+				for (int32 frame = 0; frame < Frames; ++frame)
+				{
+					particles += countParticles();
+					BulkParticleSystem2D::UpdateAll(pointers, DeltaTime);
+				}
+
+				return particles;
+			});
+	}
+}
+
+void Main()
+{
+	for (const size_t maxParticles : { 1'000, 10'000, 100'000 })
+	{
+		Benchmark(maxParticles);
+	}
+
+	BenchmarkUpdateAll(8, 10'000);
+
+	while (System::Update())
+	{
+
+	}
+}
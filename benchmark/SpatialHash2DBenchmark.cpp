@@ -0,0 +1,146 @@
+//
+// SpatialHash2D と交差判定のフィルタのベンチマーク
+//
+// ビルド方法は benchmark/README.md を参照してください。
+// 弾（小さい円）と敵（大きい円）の交差する組を求める処理について、
+// すべての組を Geometry2D::Intersect() で判定する総当たりと、
+// SpatialHash2D で候補の組を求めてから、スカラーのループまたは Geometry2D::FilterIntersectingCircles() で絞り込む場合を比較します。
+// 候補の組の絞り込みだけの時間も、円と長方形のそれぞれについて計測します。
+//
+
+# include <Siv3D.hpp>
+# include "BenchmarkCommon.hpp"
+
+namespace
+{
+	constexpr size_t Iterations = 9;
+
+	constexpr RectF Area{ 0, 0, 4000, 4000 };
+
+	[[nodiscard]]
+	Array<Circle> MakeCircles(const size_t count, const double r)
+	{
+		Array<Circle> circles(count);
+
+		for (auto& circle : circles)
+		{
+			circle = Circle{ RandomVec2(Area), Random(r * 0.5, r) };
+		}
+
+		return circles;
+	}
+
+	[[nodiscard]]
+	SpatialHash2D<uint32> MakeHash(const Array<Circle>& circles, const double cellSize)
+	{
+		SpatialHash2D<uint32> hash{ cellSize };
+
+		for (uint32 i = 0; i < circles.size(); ++i)
+		{
+			hash.insert(i, circles[i].boundingRect());
+		}
+
+		return hash;
+	}
+
+	void Benchmark(const size_t numBullets, const size_t numEnemies)
+	{
+		Console << U"--- {} bullets, {} enemies ---"_fmt(numBullets, numEnemies);
+
+		Reseed(numBullets + numEnemies);
+		const Array<Circle> bullets = MakeCircles(numBullets, 4.0);
+		const Array<Circle> enemies = MakeCircles(numEnemies, 32.0);
+		const SpatialHash2D<uint32> bulletHash = MakeHash(bullets, 64.0);
+		const SpatialHash2D<uint32> enemyHash = MakeHash(enemies, 64.0);
+
+		const auto bulletOf = [&](const uint32 i) { return bullets[i]; };
+		const auto enemyOf = [&](const uint32 i) { return enemies[i]; };
+
+		Array<std::pair<uint32, uint32>> pairs;
+
+		if (numBullets * numEnemies <= 10'000'000)
+		{
+			Measure(U"brute force", Iterations, [&]()
+				{
+					size_t count = 0;
+
+					for (const auto& bullet : bullets)
+					{
+						for (const auto& enemy : enemies)
+						{
+							count += Geometry2D::Intersect(bullet, enemy);
+						}
+					}
+
+					return count;
+				});
+		}
+
+		Measure(U"queryPairs() + scalar loop", Iterations, [&]()
+			{
+				bulletHash.queryPairs(enemyHash, pairs);
+				pairs.remove_if([&](const auto& pair) { return (not Geometry2D::Intersect(bullets[pair.first], enemies[pair.second])); });
+				return pairs.size();
+			});
+
+		Measure(U"queryPairs() + FilterIntersectingCircles()", Iterations, [&]()
+			{
+				bulletHash.queryPairs(enemyHash, pairs);
+				Geometry2D::FilterIntersectingCircles(pairs, bulletOf, enemyOf);
+				return pairs.size();
+			});
+
+		// 絞り込みだけを比較するため、候補の組を先に求めておく
+		Array<std::pair<uint32, uint32>> candidates;
+		bulletHash.queryPairs(enemyHash, candidates);
+		Console << U"{} candidate pairs"_fmt(candidates.size());
+
+		Measure(U"circles: scalar loop", Iterations, [&]()
+			{
+				pairs = candidates;
+				pairs.remove_if([&](const auto& pair) { return (not Geometry2D::Intersect(bullets[pair.first], enemies[pair.second])); });
+				return pairs.size();
+			});
+
+		Measure(U"circles: FilterIntersectingCircles()", Iterations, [&]()
+			{
+				pairs = candidates;
+				Geometry2D::FilterIntersectingCircles(pairs, bulletOf, enemyOf);
+				return pairs.size();
+			});
+
+		const auto bulletRectOf = [&](const uint32 i) { return bullets[i].boundingRect(); };
+		const auto enemyRectOf = [&](const uint32 i) { return enemies[i].boundingRect(); };
+
+		Measure(U"rects: scalar loop", Iterations, [&]()
+			{
+				pairs = candidates;
+				pairs.remove_if([&](const auto& pair)
+					{
+						const RectF a = bulletRectOf(pair.first);
+						const RectF b = enemyRectOf(pair.second);
+						return (not ((a.x <= (b.x + b.w)) && (b.x <= (a.x + a.w)) && (a.y <= (b.y + b.h)) && (b.y <= (a.y + a.h))));
+					});
+				return pairs.size();
+			});
+
+		Measure(U"rects: FilterIntersectingRects()", Iterations, [&]()
+			{
+				pairs = candidates;
+				Geometry2D::FilterIntersectingRects(pairs, bulletRectOf, enemyRectOf);
+				return pairs.size();
+			});
+	}
+}
+
+void Main()
+{
+	Benchmark(1'000, 100);
+	Benchmark(10'000, 1'000);
+	Benchmark(100'000, 1'000);
+
+	while (System::Update())
+	{
+
+	}
+}
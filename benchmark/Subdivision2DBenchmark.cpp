@@ -0,0 +1,101 @@
+//
+// Subdivision2D の点の一括追加のベンチマーク
+//
+// ビルド方法は benchmark/README.md を参照してください。
+// 一様乱数の点と、格子状に並んだ点について、1 点ずつ addPoint() する場合、addPoints() する場合、
+// addPointsSorted() でモートン順序に並べ替えてから追加する場合の Delaunay 分割の構築時間を比較します。
+//
+
+# include <Siv3D.hpp>
+# include "BenchmarkCommon.hpp"
+
+namespace
+{
+	constexpr size_t Iterations = 5;
+
+	constexpr RectF Area{ 0, 0, 1000, 1000 };
+
+	void Benchmark(const StringView label, const Array<Vec2>& points)
+	{
+		Console << U"--- {}, {} points ---"_fmt(label, points.size());
+
+		Measure(U"addPoint() x N", Iterations, [&]()
+			{
+				Subdivision2D subdiv{ Area };
+
+				for (const auto& point : points)
+				{
+					subdiv.addPoint(point);
+				}
+
+				return subdiv.calculateTriangles().size();
+			});
+
+		Measure(U"addPoints()", Iterations, [&]()
+			{
+				Subdivision2D subdiv{ Area };
+				subdiv.addPoints(points);
+				return subdiv.calculateTriangles().size();
+			});
+
+		Measure(U"addPointsSorted()", Iterations, [&]()
+			{
+				Subdivision2D subdiv{ Area };
+				subdiv.addPointsSorted(points);
+				return subdiv.calculateTriangles().size();
+			});
+	}
+
+	[[nodiscard]]
+	Array<Vec2> MakeRandomPoints(const size_t count)
+	{
+		Reseed(count);
+		Array<Vec2> points(count);
+
+		for (auto& point : points)
+		{
+			point = RandomVec2(Area);
+		}
+
+		return points;
+	}
+
+	[[nodiscard]]
+	Array<Vec2> MakeGridPoints(const size_t count)
+	{
+		// 格子点を少しずらし、同一円周上に 4 点が並ぶ退化を避ける
+		const size_t side = static_cast<size_t>(std::sqrt(static_cast<double>(count)));
+		const double step = (Area.w / (side + 1));
+		Reseed(side);
+		Array<Vec2> points;
+		points.reserve(side * side);
+
+		for (size_t y = 0; y < side; ++y)
+		{
+			for (size_t x = 0; x < side; ++x)
+			{
+				points.emplace_back(((x + 1) * step + Random(-0.01, 0.01)), ((y + 1) * step + Random(-0.01, 0.01)));
+			}
+		}
+
+		return points;
+	}
+}
+
+void Main()
+{
+	for (const size_t count : { 1'000, 10'000, 100'000 })
+	{
+		Benchmark(U"Random", MakeRandomPoints(count));
+	}
+
+	for (const size_t count : { 10'000, 100'000 })
+	{
+		Benchmark(U"Grid", MakeGridPoints(count));
+	}
+
+	while (System::Update())
+	{
+
+	}
+}
@@ -0,0 +1,103 @@
+//
+// Grid と TiledGrid の走査のベンチマーク
+//
+// ビルド方法は benchmark/README.md を参照してください。
+//
+
+# include <Siv3D.hpp>
+# include "BenchmarkCommon.hpp"
+
+namespace
+{
+	constexpr int32 Width = 2048;
+
+	constexpr int32 Height = 2048;
+
+	constexpr size_t Iterations = 9;
+
+	template <class GridType>
+	[[nodiscard]]
+	int64 SumRows(const GridType& grid)
+	{
+		int64 sum = 0;
+
+		for (int32 y = 0; y < Height; ++y)
+		{
+			for (int32 x = 0; x < Width; ++x)
+			{
+				sum += grid[Point{ x, y }];
+			}
+		}
+
+		return sum;
+	}
+
+	template <class GridType>
+	[[nodiscard]]
+	int64 SumColumns(const GridType& grid)
+	{
+		int64 sum = 0;
+
+		for (int32 x = 0; x < Width; ++x)
+		{
+			for (int32 y = 0; y < Height; ++y)
+			{
+				sum += grid[Point{ x, y }];
+			}
+		}
+
+		return sum;
+	}
+
+	template <class GridType>
+	[[nodiscard]]
+	int64 SumNeighbors(const GridType& grid)
+	{
+		int64 sum = 0;
+
+		for (int32 y = 1; y < (Height - 1); ++y)
+		{
+			for (int32 x = 1; x < (Width - 1); ++x)
+			{
+				for (int32 dy = -1; dy <= 1; ++dy)
+				{
+					for (int32 dx = -1; dx <= 1; ++dx)
+					{
+						sum += grid[Point{ (x + dx), (y + dy) }];
+					}
+				}
+			}
+		}
+
+		return sum;
+	}
+}
+
+void Main()
+{
+	Grid<int32> grid(Width, Height);
+
+	for (int32 y = 0; y < Height; ++y)
+	{
+		for (int32 x = 0; x < Width; ++x)
+		{
+			grid[y][x] = ((x * 7 + y * 13) & 0xFF);
+		}
+	}
+
+	const TiledGrid<int32> tiledGrid{ grid };
+
+	Console << U"{}x{} int32"_fmt(Width, Height);
+
+	Measure(U"Grid      rows", Iterations, [&]() { return SumRows(grid); });
+	Measure(U"TiledGrid rows", Iterations, [&]() { return SumRows(tiledGrid); });
+	Measure(U"Grid      columns", Iterations, [&]() { return SumColumns(grid); });
+	Measure(U"TiledGrid columns", Iterations, [&]() { return SumColumns(tiledGrid); });
+	Measure(U"Grid      3x3 neighbors", Iterations, [&]() { return SumNeighbors(grid); });
+	Measure(U"TiledGrid 3x3 neighbors", Iterations, [&]() { return SumNeighbors(tiledGrid); });
+
+	while (System::Update())
+	{
+
+	}
+}
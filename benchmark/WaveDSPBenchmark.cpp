@@ -0,0 +1,335 @@
+//
+// WaveDSP の各処理とスカラーのループのベンチマーク
+//
+// ビルド方法は benchmark/README.md を参照してください。
+// 10 秒間の 48 kHz ステレオの音声について、WaveDSP の関数と、同じ計算を 1 サンプルずつ行うループを比較します。
+// Deinterleave / Interleave は、別の配列に分ける版と、Wave をその場で並べ替える版の両方を比較します。
+// Resample は、同じポリフェーズフィルタを 1 スレッドのスカラーの積和で適用する場合と比較します。
+//
+
+# include <Siv3D.hpp>
+# include "BenchmarkCommon.hpp"
+
+namespace
+{
+	constexpr size_t Iterations = 9;
+
+	constexpr uint32 SampleRate = 48000;
+
+	constexpr size_t SampleCount = (SampleRate * 10);
+
+	[[nodiscard]]
+	size_t ToSink(const WaveSample sample) noexcept
+	{
+		return static_cast<size_t>((sample.left + sample.right) * 1000.0f);
+	}
+
+	[[nodiscard]]
+	Wave MakeNoise(const uint64 seed)
+	{
+		Wave wave(SampleCount, Arg::sampleRate = SampleRate);
+		Reseed(seed);
+
+		for (auto& sample : wave)
+		{
+			sample = WaveSample{ static_cast<float>(Random(-0.5, 0.5)), static_cast<float>(Random(-0.5, 0.5)) };
+		}
+
+		return wave;
+	}
+
+	/// @brief WaveDSP::Resample() と同じフィルタを、1 スレッドのスカラーの積和で適用します。
+	void ResampleScalar(const Wave& src, Wave& dst, const uint32 targetSampleRate)
+	{
+		const uint32 srcSampleRate = src.sampleRate();
+		const size_t srcLength = src.size();
+		const detail::WaveResampleFilter filter{ srcSampleRate, targetSampleRate };
+		const int32 halfTaps = (filter.taps / 2);
+
+		Array<WaveSample> padded(srcLength + static_cast<size_t>(filter.taps) + 2, WaveSample::Zero());
+		std::memcpy((padded.data() + halfTaps), src.data(), src.size_bytes());
+
+		const size_t dstLength = static_cast<size_t>(((static_cast<uint64>(srcLength) * targetSampleRate) + srcSampleRate - 1) / srcSampleRate);
+		dst.resize(dstLength);
+		dst.setSampleRate(targetSampleRate);
+
+		for (size_t j = 0; j < dstLength; ++j)
+		{
+			const uint64 numerator = (static_cast<uint64>(j) * srcSampleRate);
+			const size_t position = static_cast<size_t>(numerator / targetSampleRate);
+			const double phase = (static_cast<double>(numerator % targetSampleRate) * detail::WaveResamplePhases / targetSampleRate);
+			const size_t p = static_cast<size_t>(phase);
+			const float t = static_cast<float>(phase - p);
+
+			const WaveSample* x = (padded.data() + position + 1);
+			const float* w = (filter.weights.data() + p * filter.taps * 2);
+			const float* d = (filter.deltas.data() + p * filter.taps * 2);
+			float left = 0.0f, right = 0.0f;
+
+			for (int32 k = 0; k < filter.taps; ++k)
+			{
+				const float weight = (w[k * 2] + t * d[k * 2]);
+				left += (weight * x[k].left);
+				right += (weight * x[k].right);
+			}
+
+			dst[j] = WaveSample{ left, right };
+		}
+	}
+}
+
+void Main()
+{
+	const Wave source = MakeNoise(1);
+	Wave target = MakeNoise(2);
+
+	Console << U"--- {} samples, {} Hz, stereo ---"_fmt(SampleCount, SampleRate);
+
+	Measure(U"MixAdd (scalar)", Iterations, [&]()
+		{
+			for (size_t i = 0; i < SampleCount; ++i)
+			{
+				target[i].left += (source[i].left * 0.5f);
+				target[i].right += (source[i].right * 0.5f);
+			}
+
+			return ToSink(target[SampleCount / 2]);
+		});
+
+	Measure(U"MixAdd (WaveDSP)", Iterations, [&]()
+		{
+			WaveDSP::MixAdd(target, source, 0.5f);
+			return ToSink(target[SampleCount / 2]);
+		});
+
+	Measure(U"ApplyGain (scalar)", Iterations, [&]()
+		{
+			for (auto& sample : target)
+			{
+				sample.left *= 0.5f;
+				sample.right *= 0.5f;
+			}
+
+			return ToSink(target[SampleCount / 2]);
+		});
+
+	Measure(U"ApplyGain (WaveDSP)", Iterations, [&]()
+		{
+			WaveDSP::ApplyGain(target, 0.5f);
+			return ToSink(target[SampleCount / 2]);
+		});
+
+	Measure(U"MixAddRamp (scalar)", Iterations, [&]()
+		{
+			const float step = ((0.75f - 0.25f) / SampleCount);
+
+			for (size_t i = 0; i < SampleCount; ++i)
+			{
+				const float gain = (0.25f + step * static_cast<float>(i));
+				target[i].left += (source[i].left * gain);
+				target[i].right += (source[i].right * gain);
+			}
+
+			return ToSink(target[SampleCount / 2]);
+		});
+
+	Measure(U"MixAddRamp (WaveDSP)", Iterations, [&]()
+		{
+			WaveDSP::MixAddRamp(target, source, 0.25f, 0.75f);
+			return ToSink(target[SampleCount / 2]);
+		});
+
+	// 繰り返し掛けても値が小さくなりすぎないよう、1.0 の前後で変化させる
+	Measure(U"ApplyGainRamp (scalar)", Iterations, [&]()
+		{
+			const float step = ((1.1f - 0.9f) / SampleCount);
+
+			for (size_t i = 0; i < SampleCount; ++i)
+			{
+				const float gain = (0.9f + step * static_cast<float>(i));
+				target[i].left *= gain;
+				target[i].right *= gain;
+			}
+
+			return ToSink(target[SampleCount / 2]);
+		});
+
+	Measure(U"ApplyGainRamp (WaveDSP)", Iterations, [&]()
+		{
+			WaveDSP::ApplyGainRamp(target, 0.9f, 1.1f);
+			return ToSink(target[SampleCount / 2]);
+		});
+
+	{
+		Array<WaveSampleS16> pcm(SampleCount);
+
+		Measure(U"ToInt16 (scalar)", Iterations, [&]()
+			{
+				for (size_t i = 0; i < SampleCount; ++i)
+				{
+					pcm[i] = source[i].asWaveSampleS16();
+				}
+
+				return static_cast<size_t>(pcm[SampleCount / 2].left);
+			});
+
+		Measure(U"ToInt16 (WaveDSP)", Iterations, [&]()
+			{
+				WaveDSP::ToInt16(source, pcm);
+				return static_cast<size_t>(pcm[SampleCount / 2].left);
+			});
+
+		Measure(U"FromInt16 (scalar)", Iterations, [&]()
+			{
+				for (size_t i = 0; i < SampleCount; ++i)
+				{
+					target[i] = pcm[i].asWaveSample();
+				}
+
+				return ToSink(target[SampleCount / 2]);
+			});
+
+		Measure(U"FromInt16 (WaveDSP)", Iterations, [&]()
+			{
+				WaveDSP::FromInt16(pcm, target);
+				return ToSink(target[SampleCount / 2]);
+			});
+	}
+
+	Measure(U"Peak (scalar)", Iterations, [&]()
+		{
+			WaveSample peak = WaveSample::Zero();
+
+			for (const auto& sample : source)
+			{
+				peak.left = Max(peak.left, std::abs(sample.left));
+				peak.right = Max(peak.right, std::abs(sample.right));
+			}
+
+			return ToSink(peak);
+		});
+
+	Measure(U"Peak (WaveDSP)", Iterations, [&]()
+		{
+			return ToSink(WaveDSP::Peak(source));
+		});
+
+	Measure(U"RMS (scalar)", Iterations, [&]()
+		{
+			double left = 0.0, right = 0.0;
+
+			for (const auto& sample : source)
+			{
+				left += (static_cast<double>(sample.left) * sample.left);
+				right += (static_cast<double>(sample.right) * sample.right);
+			}
+
+			return ToSink(WaveSample{ static_cast<float>(std::sqrt(left / SampleCount)), static_cast<float>(std::sqrt(right / SampleCount)) });
+		});
+
+	Measure(U"RMS (WaveDSP)", Iterations, [&]()
+		{
+			return ToSink(WaveDSP::RMS(source));
+		});
+
+	{
+		Array<float> left(SampleCount), right(SampleCount);
+
+		Measure(U"Deinterleave (scalar)", Iterations, [&]()
+			{
+				for (size_t i = 0; i < SampleCount; ++i)
+				{
+					left[i] = source[i].left;
+					right[i] = source[i].right;
+				}
+
+				return static_cast<size_t>(left[SampleCount / 2] * 1000.0f);
+			});
+
+		Measure(U"Deinterleave (WaveDSP)", Iterations, [&]()
+			{
+				WaveDSP::Deinterleave(source.data(), SampleCount, left.data(), right.data());
+				return static_cast<size_t>(left[SampleCount / 2] * 1000.0f);
+			});
+
+		Measure(U"Interleave (scalar)", Iterations, [&]()
+			{
+				for (size_t i = 0; i < SampleCount; ++i)
+				{
+					target[i] = WaveSample{ left[i], right[i] };
+				}
+
+				return ToSink(target[SampleCount / 2]);
+			});
+
+		Measure(U"Interleave (WaveDSP)", Iterations, [&]()
+			{
+				WaveDSP::Interleave(left.data(), right.data(), SampleCount, target.data());
+				return ToSink(target[SampleCount / 2]);
+			});
+	}
+
+	// その場で並べ替える版は、WaveDSP と同じく一時的な配列を毎回確保する
+	Measure(U"Deinterleave in place (scalar)", Iterations, [&]()
+		{
+			Array<float> right(SampleCount);
+			float* p = reinterpret_cast<float*>(target.data());
+
+			for (size_t i = 0; i < SampleCount; ++i)
+			{
+				const float l = p[i * 2];
+				right[i] = p[i * 2 + 1];
+				p[i] = l;
+			}
+
+			std::memcpy((p + SampleCount), right.data(), (SampleCount * sizeof(float)));
+			return static_cast<size_t>(p[SampleCount / 2] * 1000.0f);
+		});
+
+	Measure(U"Deinterleave in place (WaveDSP)", Iterations, [&]()
+		{
+			WaveDSP::Deinterleave(target);
+			return ToSink(target[SampleCount / 2]);
+		});
+
+	Measure(U"Interleave in place (scalar)", Iterations, [&]()
+		{
+			Array<float> channels(SampleCount * 2);
+			std::memcpy(channels.data(), target.data(), target.size_bytes());
+
+			for (size_t i = 0; i < SampleCount; ++i)
+			{
+				target[i] = WaveSample{ channels[i], channels[SampleCount + i] };
+			}
+
+			return ToSink(target[SampleCount / 2]);
+		});
+
+	Measure(U"Interleave in place (WaveDSP)", Iterations, [&]()
+		{
+			WaveDSP::Interleave(target);
+			return ToSink(target[SampleCount / 2]);
+		});
+
+	{
+		const Wave source44100 = WaveDSP::Resample(source, 44100);
+		Wave resampled;
+
+		Measure(U"Resample 44100 -> 48000 (scalar, 1 thread)", Iterations, [&]()
+			{
+				ResampleScalar(source44100, resampled, 48000);
+				return ToSink(resampled[resampled.size() / 2]);
+			});
+
+		Measure(U"Resample 44100 -> 48000 (WaveDSP)", Iterations, [&]()
+			{
+				WaveDSP::Resample(source44100, resampled, 48000);
+				return ToSink(resampled[resampled.size() / 2]);
+			});
+	}
+
+	while (System::Update())
+	{
+
+	}
+}
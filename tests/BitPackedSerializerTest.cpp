@@ -0,0 +1,201 @@
+//
+// BitPackedSerializer / BitPackedDeserializer のラウンドトリップテスト
+//
+// ビルド方法は tests/README.md を参照してください。
+//
+
+# include <Siv3D.hpp>
+# include "TestCommon.hpp"
+# include "../BitPackedSerializer.hpp"
+
+namespace
+{
+	template <class Type>
+	[[nodiscard]]
+	Type RoundTrip(const Type& value)
+	{
+		BitPackedSerializer writer;
+		writer(value);
+
+		BitPackedDeserializer reader{ writer.data(), writer.size() };
+		Type result{};
+		reader(result);
+		return result;
+	}
+
+	struct PlayerState
+	{
+		float x = 0.0f;
+
+		int32 hp = 0;
+
+		int32 previousHp = 0;
+
+		bool alive = false;
+
+		String name;
+
+		template <class Archive>
+		void SIV3D_SERIALIZE(Archive& archive)
+		{
+			archive(Quantize<-100.0, 100.0, 12>(x), DeltaFrom(hp, previousHp), alive, name);
+		}
+	};
+
+	void TestBits()
+	{
+		BitPackedSerializer writer;
+		writer.writeBits(0b101, 3);
+		writer.writeBits(0xABCD, 16);
+		writer.writeBits(~uint64{ 0 }, 64);
+		writer.writeBits(1, 1);
+
+		Check((writer.bitSize() == (3 + 16 + 64 + 1)), U"writeBits: bitSize");
+		Check((writer.size() == 11), U"writeBits: size is rounded up to bytes");
+
+		BitPackedDeserializer reader{ writer.data(), writer.size() };
+		Check((reader.readBits(3) == 0b101), U"readBits: 3 bits");
+		Check((reader.readBits(16) == 0xABCD), U"readBits: 16 bits across byte boundaries");
+		Check((reader.readBits(64) == ~uint64{ 0 }), U"readBits: 64 bits");
+		Check((reader.readBits(1) == 1), U"readBits: 1 bit");
+		Check((reader.remainingBits() == 4), U"readBits: padding bits remain");
+	}
+
+	void TestVarint()
+	{
+		const uint64 values[] = { 0, 1, 127, 128, 300, 0xFFFF'FFFF, ~uint64{ 0 } };
+
+		BitPackedSerializer writer;
+
+		for (const auto value : values)
+		{
+			writer.writeVarint(value);
+		}
+
+		writer.writeZigZag(0);
+		writer.writeZigZag(-1);
+		writer.writeZigZag(Largest<int64>);
+		writer.writeZigZag(Smallest<int64>);
+
+		BitPackedDeserializer reader{ writer.data(), writer.size() };
+		bool varints = true;
+
+		for (const auto value : values)
+		{
+			varints &= (reader.readVarint() == value);
+		}
+
+		Check(varints, U"varint: round trip");
+		Check((reader.readZigZag() == 0), U"zigzag: 0");
+		Check((reader.readZigZag() == -1), U"zigzag: -1");
+		Check((reader.readZigZag() == Largest<int64>), U"zigzag: max");
+		Check((reader.readZigZag() == Smallest<int64>), U"zigzag: min");
+	}
+
+	void TestArithmetic()
+	{
+		Check((RoundTrip(true) == true), U"bool");
+		Check((RoundTrip(false) == false), U"bool false");
+		Check((RoundTrip(int8{ -128 }) == -128), U"int8");
+		Check((RoundTrip(uint8{ 255 }) == 255), U"uint8");
+		Check((RoundTrip(int32{ -42 }) == -42), U"int32");
+		Check((RoundTrip(Smallest<int32>) == Smallest<int32>), U"int32 min");
+		Check((RoundTrip(Largest<uint64>) == Largest<uint64>), U"uint64 max");
+		Check((RoundTrip(3.25f) == 3.25f), U"float");
+		Check((RoundTrip(-1.0e300) == -1.0e300), U"double");
+
+		BitPackedSerializer writer;
+		writer(true, false, true);
+		Check((writer.bitSize() == 3), U"bool is written as a single bit");
+
+		BitPackedSerializer small;
+		small(int32{ 5 });
+		Check((small.size() == 1), U"small int32 is written in a single byte");
+	}
+
+	void TestString()
+	{
+		Check((RoundTrip(String{}) == U""), U"String: empty");
+		Check((RoundTrip(String{ U"BitPacked" }) == U"BitPacked"), U"String: ASCII");
+		Check((RoundTrip(String{ U"ビットパック 🎮" }) == U"ビットパック 🎮"), U"String: non-ASCII");
+
+		// ビット境界がずれた状態でも文字列を読み書きできる
+		BitPackedSerializer writer;
+		writer(true, String{ U"abc" }, false);
+
+		BitPackedDeserializer reader{ writer.data(), writer.size() };
+		bool a = false, b = true;
+		String s;
+		reader(a, s, b);
+		Check((a and (s == U"abc") and (not b)), U"String: unaligned");
+	}
+
+	void TestQuantizedAndDelta()
+	{
+		using Q = Quantized<float, 0, 100, 10>;
+
+		BitPackedSerializer writer;
+		writer(Q{ 50.0f }, Q{ -10.0f }, Q{ 1000.0f });
+		Check((writer.bitSize() == 30), U"Quantized: bit count");
+
+		BitPackedDeserializer reader{ writer.data(), writer.size() };
+		Q a, b, c;
+		reader(a, b, c);
+		Check((Abs(a.value - 50.0f) <= (100.0f / Q::MaxIndex)), U"Quantized: value within one step");
+		Check((b.value == 0.0f), U"Quantized: clamped to min");
+		Check((c.value == 100.0f), U"Quantized: clamped to max");
+
+		// NaN は最小値として送られる
+		Check((Q::Encode(std::numeric_limits<float>::quiet_NaN()) == 0), U"Quantized: NaN encodes to 0");
+		Check((Quantized<float, -1, 1, 32>::Encode(1.0f) == UINT32_MAX), U"Quantized: 32-bit max index");
+
+		const PlayerState state{ .x = 12.5f, .hp = 90, .previousHp = 100, .alive = true, .name = U"Siv" };
+		BitPackedSerializer stateWriter;
+		stateWriter(state);
+
+		BitPackedDeserializer stateReader{ stateWriter.data(), stateWriter.size() };
+		PlayerState loaded{ .previousHp = 100 };
+		stateReader(loaded);
+		Check((Abs(loaded.x - state.x) <= (200.0f / 4095)), U"PlayerState: quantized member");
+		Check((loaded.hp == state.hp), U"PlayerState: delta member");
+		Check((loaded.alive == state.alive) and (loaded.name == state.name), U"PlayerState: other members");
+	}
+
+	void TestErrors()
+	{
+		BitPackedSerializer writer;
+		writer(String{ U"truncated" });
+
+		BitPackedDeserializer reader{ writer.data(), (writer.size() - 1) };
+		String s;
+		bool thrown = false;
+
+		try
+		{
+			reader(s);
+		}
+		catch (const cereal::Exception&)
+		{
+			thrown = true;
+		}
+
+		Check(thrown, U"truncated input throws cereal::Exception");
+	}
+}
+
+void Main()
+{
+	TestBits();
+	TestVarint();
+	TestArithmetic();
+	TestString();
+	TestQuantizedAndDelta();
+	TestErrors();
+
+	ReportTestResults();
+
+	while (System::Update())
+	{
+
+	}
+}
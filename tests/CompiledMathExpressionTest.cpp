@@ -0,0 +1,323 @@
+//
+// CompiledMathExpression の評価結果が MathParser::eval() とビット単位で一致することのテスト
+//
+// ビルド方法は tests/README.md を参照してください。
+//
+
+# include <Siv3D.hpp>
+# include "TestCommon.hpp"
+
+namespace
+{
+	/// @brief 並列評価の境界を越える行数
+	constexpr size_t LargeRowCount = (CompiledMathExpression::ParallelChunkSize * 2 + 1);
+
+	/// @brief ブロックと並列評価の境界の前後の行数
+	constexpr size_t RowCounts[] = { 1, 255, 256, 257, (CompiledMathExpression::ParallelChunkSize + 1), LargeRowCount };
+
+	/// @brief 変数の名前
+	const Array<String> VariableNames = { U"x", U"a", U"c" };
+
+	/// @brief すべての書き換えと読み取りの経路を通る数式
+	const Array<String> Expressions =
+	{
+		// a * x + b への融合
+		U"2*x+1",
+		U"3-x",
+		U"x-3",
+		U"2*x+3*x",
+		U"x+x",
+		U"(2*x+1)/4",
+		U"(2*x+1)*3",
+		U"3*(2*x+1)",
+		U"x*2*3",
+		U"2*(x*3)",
+		U"(x*a)/c",
+		U"x/0",
+		U"(2*x)/0",
+
+		// 低次のべき乗の展開
+		U"x*x",
+		U"x^0",
+		U"x^1",
+		U"x^2",
+		U"x^3",
+		U"x^4",
+		U"x^5",
+		U"x^0.5",
+		U"x^a",
+		U"-2^2",
+		U"-x^2",
+		U"2^-x",
+
+		// 単項演算子
+		U"-x",
+		U"+x*2",
+		U"-(x+1)",
+		U"--x",
+		U"-(-3)*x",
+
+		// 定数の畳み込み
+		U"2*3+x",
+		U"(1+2)*(3+4)*x",
+		U"sin(1)+x",
+		U"sqrt(2)*x+log(10)",
+		U"1/3+x",
+		U"_pi",
+		U"_pi*x",
+		U"_e^x",
+		U"2*_pi*x+_e",
+
+		// 論理演算の畳み込み
+		U"1 && 0",
+		U"2.5 && 0.5",
+		U"0.5 || 0",
+		U"0.4 || 0.6",
+		U"x && 1",
+		U"(x > 0) || (a < 0)",
+		U"(x > a) && (c > 1) || (x < -5)",
+
+		// 比較
+		U"x < a",
+		U"x > a",
+		U"x <= a",
+		U"x >= a",
+		U"x == a",
+		U"x != a",
+		U"2 < 3",
+
+		// 条件演算子
+		U"x > 0 ? a : c",
+		U"1 ? x : a",
+		U"0 ? x : a",
+		U"x < 0 ? -x : x*2",
+		U"x > 0 ? (a > 0 ? 1 : 2) : 3",
+
+		// 可変長引数の関数
+		U"sum(x, a, c)",
+		U"sum(1, 2, 3)",
+		U"avg(x, 1, 2)",
+		U"min(x, a)",
+		U"max(x, a, c, 3)",
+		U"min(x)",
+		U"sum(x*2+1, a^2)",
+
+		// 1 引数の関数
+		U"rint(x)",
+		U"rint(2.5)",
+		U"rint(-2.5)",
+		U"sign(x)",
+		U"sign(-0)",
+		U"sign(0)",
+		U"abs(x)",
+		U"sqrt(abs(x))",
+		U"log(abs(x)+1)",
+		U"ln(abs(x)+1)",
+		U"log2(abs(x)+1)",
+		U"log10(abs(x)+1)",
+		U"exp(x/10)",
+		U"sin(x)+cos(a)*tan(c)",
+		U"asin(x/10)+acos(a/3)+atan(c)",
+		U"sinh(x/10)+cosh(a)+tanh(c)",
+		U"asinh(x)+acosh(c+1)+atanh(a/4)",
+
+		// 数値の読み取り
+		U"1e3*x",
+		U"2.5E-2+x",
+		U"1e+2",
+		U"1E-310*x",
+		U".5*x",
+		U"5.*x",
+		U"0.1+0.2",
+		U"123456789.123456789*x",
+		U"1.5e308*10",
+		U"1e400",
+
+		// 組み合わせ
+		U"(x*a)/c + sum(x, a)*2",
+		U"x^2 + 2*x*a + a^2",
+		U"(x+1)*(x-1)/(c+1)",
+		U"max(x, 0) > 1 ? rint(x*a) : sign(c-2)*_pi",
+	};
+
+	[[nodiscard]]
+	bool BitEqual(const double a, const double b) noexcept
+	{
+		// NaN のペイロードは比較しない
+		if (std::isnan(a) && std::isnan(b))
+		{
+			return true;
+		}
+
+		return (std::memcmp(&a, &b, sizeof(double)) == 0);
+	}
+
+	/// @brief 変数の値の列を作成します。整数、0.5 の端数、0 と負の 0 を含めます。
+	[[nodiscard]]
+	Array<Array<double>> MakeColumns()
+	{
+		Reseed(12345);
+
+		Array<Array<double>> columns(VariableNames.size(), Array<double>(LargeRowCount));
+
+		for (size_t i = 0; i < LargeRowCount; ++i)
+		{
+			columns[0][i] = Random(-10.0, 10.0);
+			columns[1][i] = Random(-3.0, 3.0);
+			columns[2][i] = Random(0.5, 4.0);
+
+			if ((i % 5) == 0)
+			{
+				columns[0][i] = static_cast<double>((i / 5) % 21) - 10.0;
+			}
+			else if ((i % 7) == 0)
+			{
+				columns[0][i] = static_cast<double>((i / 7) % 21) - 10.5;
+			}
+			else if ((i % 11) == 0)
+			{
+				columns[0][i] = (((i / 11) % 2) ? -0.0 : 0.0);
+				columns[1][i] = columns[0][i];
+			}
+		}
+
+		return columns;
+	}
+
+	void TestExpression(const StringView expression, const Array<Array<double>>& columns)
+	{
+		Array<double> values(VariableNames.size());
+		MathParser parser;
+
+		for (size_t i = 0; i < VariableNames.size(); ++i)
+		{
+			parser.setVaribale(VariableNames[i], &values[i]);
+		}
+
+		parser.setExpression(expression);
+
+		const CompiledMathExpression compiled = parser.compile();
+
+		if (not compiled)
+		{
+			Check(false, U"{}: compile ({})"_fmt(expression, compiled.getErrorMessage()));
+			return;
+		}
+
+		// MathParser::eval() による期待値と、変数のポインタを使う eval() の結果
+		Array<double> expected(LargeRowCount);
+		bool evalMatches = true;
+
+		for (size_t row = 0; row < LargeRowCount; ++row)
+		{
+			for (size_t i = 0; i < VariableNames.size(); ++i)
+			{
+				values[i] = columns[i][row];
+			}
+
+			expected[row] = parser.eval();
+			evalMatches &= BitEqual(compiled.eval(), expected[row]);
+		}
+
+		Check(evalMatches, U"{}: eval()"_fmt(expression));
+
+		// evalBatch() の列は getVariableNames() の順に並べる
+		Array<const double*> batchColumns;
+
+		for (const auto& name : compiled.getVariableNames())
+		{
+			const size_t column = (std::find(VariableNames.begin(), VariableNames.end(), name) - VariableNames.begin());
+			batchColumns << columns[column].data();
+		}
+
+		for (const size_t count : RowCounts)
+		{
+			// 範囲外に書き込まないことを確かめるため、末尾に番兵を置く
+			Array<double> results((count + 1), 777.0);
+			compiled.evalBatch(batchColumns, results.data(), count);
+
+			bool batchMatches = (results[count] == 777.0);
+
+			for (size_t row = 0; row < count; ++row)
+			{
+				batchMatches &= BitEqual(results[row], expected[row]);
+			}
+
+			Check(batchMatches, U"{}: evalBatch() {} rows"_fmt(expression, count));
+		}
+	}
+
+	void TestArrayOverload(const Array<Array<double>>& columns)
+	{
+		double x = 0.0;
+		MathParser parser{ U"x * 2 + 1" };
+		parser.setVaribale(U"x", &x);
+
+		const CompiledMathExpression compiled = parser.compile();
+
+		Array<double> results;
+		compiled.evalBatch(Array<Array<double>>{ columns[0] }, results);
+
+		bool matches = (results.size() == LargeRowCount);
+
+		for (size_t row = 0; (row < results.size()) && matches; ++row)
+		{
+			x = columns[0][row];
+			matches &= BitEqual(results[row], parser.eval());
+		}
+
+		Check(matches, U"evalBatch(Array<Array<double>>)");
+	}
+
+	void TestErrors()
+	{
+		double x = 0.0;
+		MathParser parser;
+		parser.setVaribale(U"x", &x);
+
+		parser.setExpression(U"x + y");
+		Check((not parser.compile()), U"unknown variable fails to compile");
+
+		parser.setExpression(U"x, 1");
+		Check((not parser.compile()), U"multiple expressions fail to compile");
+
+		parser.setExpression(U"x +");
+		const CompiledMathExpression compiled = parser.compile();
+		Check((not compiled) && std::isnan(compiled.eval()), U"invalid expression evaluates to NaN");
+
+		parser.setExpression(U"x * 2");
+		bool thrown = false;
+
+		try
+		{
+			double result = 0.0;
+			parser.compile().evalBatch(Array<const double*>{}, &result, 1);
+		}
+		catch (const Error&)
+		{
+			thrown = true;
+		}
+
+		Check(thrown, U"evalBatch() throws on a column count mismatch");
+	}
+}
+
+void Main()
+{
+	const Array<Array<double>> columns = MakeColumns();
+
+	for (const auto& expression : Expressions)
+	{
+		TestExpression(expression, columns);
+	}
+
+	TestArrayOverload(columns);
+	TestErrors();
+
+	ReportTestResults();
+
+	while (System::Update())
+	{
+
+	}
+}
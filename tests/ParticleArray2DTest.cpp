@@ -0,0 +1,186 @@
+//
+// ParticleArray2D の SIMD による更新が、スカラーの更新とビット単位で一致することのテスト
+//
+// ビルド方法は tests/README.md を参照してください。
+//
+
+# include <Siv3D.hpp>
+# include "TestCommon.hpp"
+
+namespace
+{
+	[[nodiscard]]
+	bool BitEqual(const float a, const float b) noexcept
+	{
+		return (std::memcmp(&a, &b, sizeof(float)) == 0);
+	}
+
+	[[nodiscard]]
+	bool BitEqual(const Particle2D& a, const Particle2D& b) noexcept
+	{
+		return BitEqual(a.position.x, b.position.x)
+			&& BitEqual(a.position.y, b.position.y)
+			&& BitEqual(a.velocity.x, b.velocity.x)
+			&& BitEqual(a.velocity.y, b.velocity.y)
+			&& BitEqual(a.startColor.x, b.startColor.x)
+			&& BitEqual(a.startColor.y, b.startColor.y)
+			&& BitEqual(a.startColor.z, b.startColor.z)
+			&& BitEqual(a.startColor.w, b.startColor.w)
+			&& BitEqual(a.startSize, b.startSize)
+			&& BitEqual(a.rotation, b.rotation)
+			&& BitEqual(a.startAngularVelocity, b.startAngularVelocity)
+			&& BitEqual(a.startLifeTime, b.startLifeTime)
+			&& BitEqual(a.remainingLifeTime, b.remainingLifeTime);
+	}
+
+	[[nodiscard]]
+	float RandomFloat(const double min, const double max)
+	{
+		return static_cast<float>(Random(min, max));
+	}
+
+	[[nodiscard]]
+	Array<Particle2D> MakeParticles(const size_t count)
+	{
+		Reseed(count);
+		Array<Particle2D> particles(count);
+
+		for (auto& particle : particles)
+		{
+			particle.position = { RandomFloat(-1000, 1000), RandomFloat(-1000, 1000) };
+			particle.velocity = { RandomFloat(-300, 300), RandomFloat(-300, 300) };
+			particle.startColor = { RandomFloat(0, 1), RandomFloat(0, 1), RandomFloat(0, 1), RandomFloat(0, 1) };
+			particle.startSize = RandomFloat(1, 64);
+			particle.rotation = RandomFloat(-10, 10);
+			particle.startAngularVelocity = RandomFloat(-5, 5);
+			particle.startLifeTime = RandomFloat(0.5, 4);
+			particle.remainingLifeTime = RandomFloat(0, 4);
+		}
+
+		return particles;
+	}
+
+	[[nodiscard]]
+	ParticleArray2D ToParticleArray(const Array<Particle2D>& particles)
+	{
+		ParticleArray2D result{ particles.size() };
+
+		for (const auto& particle : particles)
+		{
+			result.push_back(particle);
+		}
+
+		return result;
+	}
+
+	[[nodiscard]]
+	bool BitEqual(const ParticleArray2D& a, const Array<Particle2D>& b)
+	{
+		if (a.size() != b.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < b.size(); ++i)
+		{
+			if (not BitEqual(a.get(i), b[i]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// 端数の処理、SIMD の処理、並列の処理のそれぞれを通るパーティクル数
+	constexpr size_t Sizes[] = { 1, 3, 4, 7, 1000, 1003, (ParticleArray2D::ParallelThreshold + 5) };
+
+	constexpr int32 Frames = 120;
+
+	constexpr float DeltaTime = (1.0f / 60.0f);
+
+	constexpr Float2 DeltaVelocity{ 0.03125f, -9.8f / 60.0f };
+
+	/// @brief `ParticleArray2D::update()` の結果を、1 つずつ `Particle2D::update()` した結果と比べます。
+	void TestMatchesParticle2D()
+	{
+		for (const size_t size : Sizes)
+		{
+			Array<Particle2D> expected = MakeParticles(size);
+			ParticleArray2D particles = ToParticleArray(expected);
+
+			for (int32 frame = 0; frame < Frames; ++frame)
+			{
+				for (auto& particle : expected)
+				{
+					particle.update(DeltaTime, DeltaVelocity);
+				}
+
+				particles.update(DeltaTime, DeltaVelocity);
+			}
+
+			Check(BitEqual(particles, expected), U"update() matches Particle2D::update() ({} particles)"_fmt(size));
+		}
+	}
+
+	/// @brief 範囲全体の更新の結果を、1 つずつの範囲（SIMD を使わない経路）で更新した結果と比べます。
+	void TestMatchesScalarRange()
+	{
+		for (const size_t size : Sizes)
+		{
+			const Array<Particle2D> source = MakeParticles(size);
+			ParticleArray2D simd = ToParticleArray(source);
+			ParticleArray2D scalar = ToParticleArray(source);
+
+			for (int32 frame = 0; frame < Frames; ++frame)
+			{
+				simd.update(DeltaTime, DeltaVelocity);
+
+				for (size_t i = 0; i < size; ++i)
+				{
+					scalar.update(DeltaTime, DeltaVelocity, i, (i + 1));
+				}
+			}
+
+			Array<Particle2D> expected(size);
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				expected[i] = scalar.get(i);
+			}
+
+			Check(BitEqual(simd, expected), U"update() matches the per-particle range update ({} particles)"_fmt(size));
+		}
+	}
+
+	/// @brief 4 の倍数でない範囲の更新が、範囲外のパーティクルを変更しないことを確かめます。
+	void TestUnalignedRange()
+	{
+		const Array<Particle2D> source = MakeParticles(64);
+		ParticleArray2D particles = ToParticleArray(source);
+		Array<Particle2D> expected = source;
+
+		particles.update(DeltaTime, DeltaVelocity, 3, 41);
+
+		for (size_t i = 3; i < 41; ++i)
+		{
+			expected[i].update(DeltaTime, DeltaVelocity);
+		}
+
+		Check(BitEqual(particles, expected), U"update(first, last) only touches [first, last)");
+	}
+}
+
+void Main()
+{
+	TestMatchesParticle2D();
+	TestMatchesScalarRange();
+	TestUnalignedRange();
+
+	ReportTestResults();
+
+	while (System::Update())
+	{
+
+	}
+}
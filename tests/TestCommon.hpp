@@ -0,0 +1,30 @@
+//
+// テストで共通に使う変数と関数
+//
+
+# pragma once
+# include <Siv3D.hpp>
+
+/// @brief 失敗したテストの数
+inline size_t g_failures = 0;
+
+/// @brief テストの結果を記録し、コンソールに出力します。
+/// @param passed テストに成功した場合 true
+/// @param name テストの名前
+inline void Check(const bool passed, const StringView name)
+{
+	if (not passed)
+	{
+		++g_failures;
+	}
+
+	Console << (passed ? U"[ OK ] " : U"[FAIL] ") << name;
+}
+
+/// @brief 失敗したテストの数をコンソールと画面に出力します。
+inline void ReportTestResults()
+{
+	Console << U"{} failure(s)"_fmt(g_failures);
+
+	Print << ((g_failures == 0) ? U"All tests passed" : U"{} test(s) failed"_fmt(g_failures));
+}
@@ -0,0 +1,286 @@
+//
+// ZIPArchiveView の展開結果が ZIPReader::extractToBlob() と一致し、壊れたアーカイブや不正なパスを安全に扱うことのテスト
+//
+// ビルド方法は tests/README.md を参照してください。
+// tests/zip/ の ZIP ファイルを使うため `--preload-file tests/zip@/tests/zip` が必要です。
+// ZIP ファイルは tests/zip/MakeFixtures.py で作成しています。
+//
+
+# include <Siv3D.hpp>
+# include "TestCommon.hpp"
+
+namespace
+{
+	const FilePath ArchivePath = U"tests/zip/archive.zip";
+
+	const FilePath TruncatedEntryArchivePath = U"tests/zip/truncated-entry.zip";
+
+	const FilePath ZipSlipArchivePath = U"tests/zip/zipslip.zip";
+
+	/// @brief テスト中に作成するファイルの置き場所
+	const FilePath TemporaryDirectory = U"zip_test_tmp/";
+
+	/// @brief ZIPReader で展開した、アーカイブ内のファイルの内容
+	using ReferenceTable = HashTable<FilePath, Blob>;
+
+	[[nodiscard]]
+	ReferenceTable LoadReference(const ZIPArchiveView& archive)
+	{
+		const ZIPReader reader{ ArchivePath };
+		ReferenceTable reference;
+
+		for (const auto& entry : archive.entries())
+		{
+			if (not entry.isDirectory())
+			{
+				reference.emplace(entry.path, reader.extractToBlob(entry.path));
+			}
+		}
+
+		return reference;
+	}
+
+	[[nodiscard]]
+	bool Equals(const Array<uint8>& data, const Blob& blob, const size_t offset = 0)
+	{
+		return ((offset + data.size()) <= blob.size())
+			&& ((data.size() == 0) || (std::memcmp(data.data(), (blob.data() + offset), data.size()) == 0));
+	}
+
+	/// @brief エントリを最後まで読み込みます。
+	/// @param chunkSize 1 回の read() で読み込むサイズ
+	[[nodiscard]]
+	Array<uint8> ReadAll(ZIPEntryReader& reader, const size_t chunkSize)
+	{
+		Array<uint8> result;
+		Array<uint8> buffer(chunkSize);
+
+		for (;;)
+		{
+			const int64 n = reader.read(buffer.data(), static_cast<int64>(buffer.size()));
+
+			if (n <= 0)
+			{
+				break;
+			}
+
+			result.insert(result.end(), buffer.begin(), (buffer.begin() + static_cast<size_t>(n)));
+		}
+
+		return result;
+	}
+
+	/// @brief エントリの最初の Deflate ブロックの種類 (BTYPE) を返します。
+	[[nodiscard]]
+	uint32 FirstBlockType(const Blob& file, const ZIPEntryInfo& entry)
+	{
+		return ((static_cast<uint8>(file.data()[entry.dataOffset]) >> 1) & 3);
+	}
+
+	void TestFixtures(const ZIPArchiveView& archive, const ReferenceTable& reference)
+	{
+		const Blob file{ ArchivePath };
+
+		Check(archive.getEntry(U"stored.txt").map([](const ZIPEntryInfo& e) { return e.isStored(); }).value_or(false), U"fixture: stored.txt is stored");
+		Check(archive.getEntry(U"fixed.txt").map([&](const ZIPEntryInfo& e) { return (FirstBlockType(file, e) == 1); }).value_or(false), U"fixture: fixed.txt starts with a fixed Huffman block");
+		Check(archive.getEntry(U"dynamic.txt").map([&](const ZIPEntryInfo& e) { return (FirstBlockType(file, e) == 2); }).value_or(false), U"fixture: dynamic.txt starts with a dynamic Huffman block");
+		Check((reference.size() == 7), U"fixture: ZIPReader extracts every file");
+	}
+
+	void TestExtractToBlob(const ZIPArchiveView& archive, const ReferenceTable& reference)
+	{
+		for (const auto& [path, expected] : reference)
+		{
+			Check((archive.extractToBlob(path) == expected), U"extractToBlob: {}"_fmt(path));
+		}
+	}
+
+	void TestSmallReads(const ZIPArchiveView& archive, const ReferenceTable& reference)
+	{
+		for (const auto& [path, expected] : reference)
+		{
+			for (const size_t chunkSize : { 1, 7, 4099 })
+			{
+				ZIPEntryReader reader = archive.openEntry(path);
+				const Array<uint8> data = ReadAll(reader, chunkSize);
+
+				Check(((data.size() == expected.size()) && Equals(data, expected) && (not reader.hasError())),
+					U"read() in {}-byte chunks: {}"_fmt(chunkSize, path));
+			}
+		}
+	}
+
+	void TestSetPos(const ZIPArchiveView& archive, const ReferenceTable& reference)
+	{
+		for (const FilePath path : { U"dynamic.txt", U"window.bin", U"mixed.bin", U"stored.txt" })
+		{
+			const Blob& expected = reference.at(path);
+			const int64 size = static_cast<int64>(expected.size());
+			ZIPEntryReader reader = archive.openEntry(path);
+
+			[[maybe_unused]] const Array<uint8> all = ReadAll(reader, 65536);
+
+			// 後ろに戻る
+			const bool backward = reader.setPos(size / 2);
+			const Array<uint8> tail = ReadAll(reader, 5000);
+			Check((backward && (tail.size() == static_cast<size_t>(size - size / 2)) && Equals(tail, expected, static_cast<size_t>(size / 2))),
+				U"setPos() backwards: {}"_fmt(path));
+
+			// 32 KiB のウィンドウを越えた位置から読む
+			Array<uint8> middle(5000);
+			const int64 pos = Min<int64>(40000, (size - 5000));
+			middle.resize(static_cast<size_t>(Max<int64>(reader.read(middle.data(), pos, 5000), 0)));
+			Check(((middle.size() == 5000) && Equals(middle, expected, static_cast<size_t>(pos))), U"read(dst, pos, size): {}"_fmt(path));
+
+			// lookahead() は位置を変えない
+			uint8 peek[16];
+			const int64 before = reader.getPos();
+			const bool lookahead = (reader.lookahead(peek, 16) == 16);
+			Check((lookahead && (reader.getPos() == before) && (std::memcmp(peek, (expected.data() + before), 16) == 0)), U"lookahead(): {}"_fmt(path));
+
+			// 先頭に戻して最後まで読むと、CRC-32 も改めて検証される
+			reader.setPos(0);
+			const Array<uint8> again = ReadAll(reader, 3000);
+			Check(((again.size() == expected.size()) && Equals(again, expected) && (not reader.hasError())), U"setPos(0) and read again: {}"_fmt(path));
+		}
+	}
+
+	void TestTruncatedEntry()
+	{
+		const ZIPArchiveView archive{ TruncatedEntryArchivePath };
+		Check(archive.isOpen(), U"truncated entry: archive opens");
+
+		ZIPEntryReader reader = archive.openEntry(U"dynamic.txt");
+		const Array<uint8> data = ReadAll(reader, 4096);
+		Check((reader.hasError() && (data.size() < static_cast<size_t>(reader.size()))), U"truncated entry: hasError()");
+		Check(archive.extractToBlob(U"dynamic.txt").isEmpty(), U"truncated entry: extractToBlob() returns an empty Blob");
+		Check((not archive.extractToBlob(U"fixed.txt").isEmpty()), U"truncated entry: other entries are still readable");
+	}
+
+	[[nodiscard]]
+	bool WriteFile(const FilePath& path, const Byte* data, const size_t size)
+	{
+		BinaryWriter writer{ path };
+		return (writer && (writer.write(data, static_cast<int64>(size)) == static_cast<int64>(size)));
+	}
+
+	void TestCorruptData(const ZIPArchiveView& archive)
+	{
+		const Blob original{ ArchivePath };
+		const FilePath path = (TemporaryDirectory + U"corrupt.zip");
+
+		for (const auto& entry : archive.entries())
+		{
+			if (entry.isDirectory() || (entry.compressedSize < 8))
+			{
+				continue;
+			}
+
+			bool detected = true;
+
+			// 最後のバイトは Deflate のパディングのビットを含むことがあるため、それより前を壊す
+			for (uint64 k = 0; k < 4; ++k)
+			{
+				Blob corrupt = original;
+				corrupt.data()[entry.dataOffset + (entry.compressedSize - 2) * k / 3] ^= Byte{ 0xA5 };
+
+				if (not WriteFile(path, corrupt.data(), corrupt.size()))
+				{
+					detected = false;
+					continue;
+				}
+
+				const ZIPArchiveView view{ path };
+				ZIPEntryReader reader = view.openEntry(entry.path);
+				[[maybe_unused]] const Array<uint8> data = ReadAll(reader, 4096);
+				detected &= reader.hasError();
+			}
+
+			Check(detected, U"corrupt data sets hasError(): {}"_fmt(entry.path));
+		}
+
+		// セントラルディレクトリの無いファイルは開けない
+		const bool written = WriteFile(path, original.data(), (original.size() / 2));
+		Check((written && (not ZIPArchiveView{ path }.isOpen())), U"truncated file fails to open");
+
+		// ヘッダを含むランダムな位置を壊しても、クラッシュしない
+		Reseed(47);
+
+		for (int32 i = 0; i < 300; ++i)
+		{
+			Blob corrupt = original;
+
+			for (int32 k = 0; k < 4; ++k)
+			{
+				corrupt.data()[Random<size_t>(0, (corrupt.size() - 1))] = Byte{ static_cast<uint8>(Random(0, 255)) };
+			}
+
+			if (not WriteFile(path, corrupt.data(), corrupt.size()))
+			{
+				continue;
+			}
+
+			const ZIPArchiveView view{ path };
+
+			for (const auto& entry : view.entries())
+			{
+				ZIPEntryReader reader = view.openEntry(entry.path);
+				[[maybe_unused]] const Array<uint8> data = ReadAll(reader, 8192);
+			}
+		}
+
+		Check(true, U"random corruption does not crash");
+	}
+
+	void TestExtractAll(const ZIPArchiveView& archive, const ReferenceTable& reference)
+	{
+		const FilePath directory = (TemporaryDirectory + U"all/");
+		Check(archive.extractAll(directory), U"extractAll: succeeds");
+
+		for (const auto& [path, expected] : reference)
+		{
+			Check((Blob{ directory + path } == expected), U"extractAll: {}"_fmt(path));
+		}
+	}
+
+	void TestZipSlip()
+	{
+		const ZIPArchiveView archive{ ZipSlipArchivePath };
+		const FilePath directory = (TemporaryDirectory + U"slip/out/");
+
+		Check((not archive.extractAll(directory)), U"zip slip: extractAll() reports unsafe entries");
+		Check(FileSystem::Exists(directory + U"safe.txt"), U"zip slip: safe entries are extracted");
+		Check((not FileSystem::Exists(TemporaryDirectory + U"slip/evil.txt")), U"zip slip: \"../\" entry is rejected");
+		Check((not FileSystem::Exists(TemporaryDirectory + U"evil2.txt")), U"zip slip: backslash entry is rejected");
+		Check((not FileSystem::Exists(U"/absolute.txt")), U"zip slip: absolute entry is rejected");
+	}
+}
+
+void Main()
+{
+	FileSystem::Remove(TemporaryDirectory);
+	FileSystem::CreateDirectories(TemporaryDirectory);
+
+	const ZIPArchiveView archive{ ArchivePath };
+	Check(archive.isOpen(), U"archive opens");
+
+	const ReferenceTable reference = LoadReference(archive);
+
+	TestFixtures(archive, reference);
+	TestExtractToBlob(archive, reference);
+	TestSmallReads(archive, reference);
+	TestSetPos(archive, reference);
+	TestTruncatedEntry();
+	TestCorruptData(archive);
+	TestExtractAll(archive, reference);
+	TestZipSlip();
+
+	FileSystem::Remove(TemporaryDirectory);
+
+	ReportTestResults();
+
+	while (System::Update())
+	{
+
+	}
+}
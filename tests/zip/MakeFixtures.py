@@ -0,0 +1,108 @@
+#
+# ZIPArchiveViewTest.cpp で使う ZIP ファイルを作成するスクリプト
+#
+# Info-ZIP の zip コマンドと Python の zipfile モジュールで作成します。
+# 実行方法: python3 tests/zip/MakeFixtures.py
+#
+
+import os
+import random
+import shutil
+import struct
+import subprocess
+import tempfile
+import zipfile
+
+OUTPUT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+
+WORDS = ["siv3d", "photon", "room", "player", "event", "texture", "audio", "font", "grid", "wave"]
+
+
+def make_text(rng, size):
+    words = []
+    length = 0
+    while length < size:
+        word = rng.choice(WORDS)
+        words.append(word)
+        length += len(word) + 1
+    return " ".join(words)[:size].encode("ascii")
+
+
+def make_files(rng):
+    files = {}
+    # zip -0 で無圧縮で格納する
+    files["stored.txt"] = make_text(rng, 3000)
+    # 短いデータは固定ハフマン符号のブロックになる
+    files["fixed.txt"] = b"Hello, Siv3D! Hello, Siv3D! Hello, Photon!\n"
+    # 長いテキストは複数の動的ハフマン符号のブロックになる
+    files["dynamic.txt"] = make_text(rng, 200000)
+    # 32000 バイトのランダムなデータを繰り返し、32 KiB のウィンドウの終端付近を参照する一致を作る
+    block = bytes(rng.getrandbits(8) for _ in range(32000))
+    files["window.bin"] = block * 4
+    # 圧縮できないデータの部分は、Deflate の無圧縮ブロックになる
+    files["mixed.bin"] = make_text(rng, 20000) + bytes(rng.getrandbits(8) for _ in range(40000)) + make_text(rng, 20000)
+    files["empty.txt"] = b""
+    files["dir/nested.txt"] = make_text(rng, 5000)
+    return files
+
+
+def make_archive(files, path):
+    with tempfile.TemporaryDirectory() as work:
+        for name, data in files.items():
+            os.makedirs(os.path.join(work, os.path.dirname(name)), exist_ok=True)
+            with open(os.path.join(work, name), "wb") as f:
+                f.write(data)
+
+        if os.path.exists(path):
+            os.remove(path)
+
+        subprocess.run(["zip", "-X", "-0", path, "stored.txt"], cwd=work, check=True, stdout=subprocess.DEVNULL)
+        names = [name for name in files if name != "stored.txt"]
+        subprocess.run(["zip", "-X", "-9", path, "dir/"] + names, cwd=work, check=True, stdout=subprocess.DEVNULL)
+
+
+def make_zip_slip(path):
+    with zipfile.ZipFile(path, "w", zipfile.ZIP_DEFLATED) as archive:
+        archive.writestr("safe.txt", b"safe")
+        archive.writestr("../evil.txt", b"evil")
+        archive.writestr("dir\\..\\..\\evil2.txt", b"evil")
+        archive.writestr("/absolute.txt", b"evil")
+
+
+def make_truncated_entry(source, path, name):
+    # ローカルファイルヘッダとセントラルディレクトリの圧縮後のサイズを半分にして、Deflate のデータを途中で終わらせる
+    shutil.copyfile(source, path)
+
+    with zipfile.ZipFile(source) as archive:
+        info = archive.getinfo(name)
+
+    truncated = info.compress_size // 2
+
+    with open(path, "r+b") as f:
+        data = bytearray(f.read())
+        struct.pack_into("<I", data, info.header_offset + 18, truncated)
+        encoded = name.encode("utf-8")
+        central = data.find(b"PK\x01\x02")
+
+        while central >= 0:
+            name_length = struct.unpack_from("<H", data, central + 28)[0]
+
+            if data[central + 46:central + 46 + name_length] == encoded:
+                struct.pack_into("<I", data, central + 20, truncated)
+
+            central = data.find(b"PK\x01\x02", central + 46)
+
+        f.seek(0)
+        f.write(data)
+
+
+def main():
+    rng = random.Random(3)
+    archive = os.path.join(OUTPUT_DIRECTORY, "archive.zip")
+    make_archive(make_files(rng), archive)
+    make_zip_slip(os.path.join(OUTPUT_DIRECTORY, "zipslip.zip"))
+    make_truncated_entry(archive, os.path.join(OUTPUT_DIRECTORY, "truncated-entry.zip"), "dynamic.txt")
+
+
+if __name__ == "__main__":
+    main()